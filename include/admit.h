@@ -0,0 +1,58 @@
+/**
+ * @file admit.h
+ * @brief uSched
+ *        Request admission control interface header - Daemon
+ *
+ * Date: 18-10-2026
+ * 
+ * Copyright 2014-2015 Pedro A. Hortas (pah@ucodev.org)
+ *
+ * This file is part of usched.
+ *
+ * usched is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * usched is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with usched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef USCHED_ADMIT_H
+#define USCHED_ADMIT_H
+
+#include <stdint.h>
+#include <time.h>
+
+#include <sys/types.h>
+
+#include <rtsaio/rtsaio.h>
+
+#include "config.h"
+
+/* Structures */
+struct usched_admit_entry {
+	uid_t uid;		/* Requester UID (remote requesters: UID of the configured user) */
+	char username[CONFIG_USCHED_AUTH_USERNAME_MAX]; /* Remote username. Empty for local and UID records */
+	uint64_t tokens;	/* Available NEW requests, in thousandths of a request */
+	struct timespec t_refill; /* Last token refill */
+	unsigned int active;	/* Active entries owned by the UID (UID records only) */
+};
+
+/* Prototypes */
+int admit_daemon_init(void);
+void admit_daemon_destroy(void);
+int admit_daemon_request(const struct async_op *aop);
+int admit_daemon_request_batch(uid_t uid, const char *username, unsigned int count);
+int admit_daemon_entry_hold(uid_t uid);
+void admit_daemon_entry_restore(uid_t uid);
+void admit_daemon_entry_release(uid_t uid);
+
+#endif
+
@@ -29,20 +29,96 @@
 #ifndef USCHED_AUTH_H
 #define USCHED_AUTH_H
 
+#include <stdint.h>
+#include <time.h>
 #include <unistd.h>
 
 #include <panet/panet.h>
 
+#include <psec/hash.h>
+
 #include "config.h"
 
+/*
+ * Remote session tickets
+ *
+ * After a successful CHREKE exchange, both parties derive a ticket (identifier and key) from the
+ * agreed key. The daemon advertises the ticket lifetime in the session field it sends to the
+ * client, right after the CHREKE server session (32 bits, network byte order, 0: no tickets).
+ *
+ * Later requests (on the same or on a new connection) flagged with USCHED_ENTRY_FLAG_RESUME
+ * skip the CHREKE exchange:
+ *
+ *  - client -> daemon (header):  | ticket id (32 bytes) | client nonce (32 bytes) |
+ *  - daemon -> client:           | server nonce (32 bytes) |
+ *  - client -> daemon:           | proof (32 bytes) |
+ *
+ * The request key is blake2s(ticket key + client nonce + server nonce) and the proof is
+ * blake2s(request key + label). Payloads are then encrypted with the request key, as usual.
+ */
+
+/* Structures */
+#if CONFIG_CLIENT_ONLY == 0
+struct usched_auth_ticket {
+	unsigned char id[CONFIG_USCHED_AUTH_TICKET_SIZE];
+	unsigned char key[CONFIG_USCHED_AUTH_TICKET_SIZE];
+	unsigned char pwhash[CONFIG_USCHED_AUTH_TICKET_SIZE];	/* Digest of the user password hash when issued */
+	char username[CONFIG_USCHED_AUTH_USERNAME_MAX];
+	time_t expire;		/* Monotonic clock, in seconds */
+};
+
+/*
+ * Remote users table
+ *
+ * Built from the users configuration when the daemon is initialized (or reloaded), so the
+ * authentication path doesn't need to search the users list, decode the stored password hash
+ * nor hash the username salt on every request. Lookups copy the entry while holding
+ * rund.mutex_users, so a new table can be published at any time.
+ */
+struct usched_auth_user {
+	char username[CONFIG_USCHED_AUTH_USERNAME_MAX + 1];
+	uid_t uid;
+	gid_t gid;
+	unsigned char pwhash[HASH_DIGEST_SIZE_SHA512 + 3];	/* Decoded password hash */
+	unsigned char salt[HASH_DIGEST_SIZE_BLAKE2S];		/* blake2s of the padded username */
+	unsigned char pwdigest[CONFIG_USCHED_AUTH_TICKET_SIZE];	/* Binds session tickets to pwhash */
+	uint64_t hash;		/* hash_string_create(username) */
+	size_t next;		/* Next user on the same bucket (>= nmemb: none) */
+};
+
+struct usched_auth_users {
+	struct usched_auth_user *user;
+	size_t nmemb;
+	size_t *bucket;		/* Index of the first user on each bucket (>= nmemb: empty) */
+	size_t bucket_mask;	/* Number of buckets - 1 (power of 2) */
+};
+#endif /* CONFIG_CLIENT_ONLY == 0 */
+
+struct usched_auth_client_ticket {
+	unsigned char id[CONFIG_USCHED_AUTH_TICKET_SIZE];
+	unsigned char key[CONFIG_USCHED_AUTH_TICKET_SIZE];
+	char username[CONFIG_USCHED_AUTH_USERNAME_MAX + 1];
+	char hostname[256];
+	char port[6];
+	time_t expire;		/* 0 if no ticket is held */
+};
+
 /* Prototypes */
 #if CONFIG_CLIENT_ONLY == 0
+int auth_daemon_init(void);
+void auth_daemon_destroy(void);
+int auth_daemon_users_reload(void);
+int auth_daemon_users_get(const char *username, struct usched_auth_user *user);
 int auth_daemon_local(sock_t fd, uid_t *uid, gid_t *gid);
 int auth_daemon_remote_session_create(const char *username, unsigned char *session, unsigned char *context);
 int auth_daemon_remote_session_verify(const char *username, const unsigned char *session, unsigned char *context, unsigned char *agreed_key, uid_t *uid, gid_t *gid);
+int auth_daemon_remote_ticket_issue(const char *username, const unsigned char *ticket_id, const unsigned char *ticket_key);
+int auth_daemon_remote_ticket_lookup(const char *username, const unsigned char *ticket_id, unsigned char *ticket_key);
+int auth_daemon_remote_ticket_verify(const char *username, const unsigned char *session, const unsigned char *proof, uid_t *uid, gid_t *gid);
 #endif /* CONFIG_CLIENT_ONLY == 0 */
 int auth_client_remote_session_create(unsigned char *session, const char *username, const char *plain_passwd, unsigned char *context);
 int auth_client_remote_session_process(unsigned char *session, const char *username, const char *plain_passwd, unsigned char *context, unsigned char *agreed_key);
+uint32_t auth_client_remote_session_ticket_ttl(const unsigned char *session);
 
 /* Auth admin prototypes (usa only) */
 int auth_admin_commit(void);
@@ -68,6 +144,12 @@ int auth_admin_whitelist_uid_show(void);
 int auth_admin_whitelist_uid_change(const char *whitelist_uid_list);
 int auth_admin_whitelist_uid_add(const char *whitelist_uid);
 int auth_admin_whitelist_uid_delete(const char *whitelist_uid);
+int auth_admin_rate_limit_show(void);
+int auth_admin_rate_limit_change(const char *rate_limit);
+int auth_admin_rate_burst_show(void);
+int auth_admin_rate_burst_change(const char *rate_burst);
+int auth_admin_quota_entries_show(void);
+int auth_admin_quota_entries_change(const char *quota_entries);
 
 #endif
 
@@ -0,0 +1,39 @@
+/**
+ * @file cgroup.h
+ * @brief uSched
+ *        Executer cgroup placement interface header
+ *
+ * Date: 18-10-2026
+ * 
+ * Copyright 2014-2015 Pedro A. Hortas (pah@ucodev.org)
+ *
+ * This file is part of usched.
+ *
+ * usched is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * usched is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with usched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef USCHED_CGROUP_H
+#define USCHED_CGROUP_H
+
+#include "worker.h"
+
+/* Prototypes */
+void cgroup_exec_init(void);
+void cgroup_exec_destroy(void);
+int cgroup_exec_create(struct usched_exec_task *task);
+void cgroup_exec_collect(struct usched_exec_task *task);
+
+#endif
@@ -52,6 +52,9 @@
 #define CONFIG_USCHED_FILE_AUTH_WL_UID		"whitelist.uid"
 #define CONFIG_USCHED_FILE_AUTH_LOCAL_USE	"local.use"
 #define CONFIG_USCHED_FILE_AUTH_REMOTE_USERS	"remote.users"
+#define CONFIG_USCHED_FILE_AUTH_RATE_LIMIT	"rate.limit"
+#define CONFIG_USCHED_FILE_AUTH_RATE_BURST	"rate.burst"
+#define CONFIG_USCHED_FILE_AUTH_QUOTA_ENTRIES	"quota.entries"
 #define CONFIG_USCHED_FILE_CORE_DELTA_RELOAD	"delta.reload"
 #define CONFIG_USCHED_FILE_CORE_JAIL_DIR	"jail.dir"
 #define CONFIG_USCHED_FILE_CORE_PRIVDROP_USER	"privdrop.user"
@@ -60,11 +63,29 @@
 #define CONFIG_USCHED_FILE_CORE_THREAD_PRIORITY	"thread.priority"
 #define CONFIG_USCHED_FILE_CORE_THREAD_WORKERS	"thread.workers"
 #define CONFIG_USCHED_FILE_EXEC_DELTA_NOEXEC	"delta.noexec"
+#define CONFIG_USCHED_FILE_EXEC_RETRY_DEPTH	"retry.depth"
+#define CONFIG_USCHED_FILE_EXEC_RETRY_DELAY	"retry.delay"
+#define CONFIG_USCHED_FILE_EXEC_SPILL_USE	"spill.use"
+#define CONFIG_USCHED_FILE_EXEC_SPILL_FILE	"spill.file"
+#define CONFIG_USCHED_FILE_EXEC_CHILDREN_MAX	"children.max"
+#define CONFIG_USCHED_FILE_EXEC_QUEUE_DEPTH	"queue.depth"
+#define CONFIG_USCHED_FILE_EXEC_THREAD_WORKERS	"thread.workers"
+#define CONFIG_USCHED_FILE_EXEC_OUTPUT_MAX	"output.max"
+#define CONFIG_USCHED_FILE_EXEC_SPOOL_USE	"spool.use"
+#define CONFIG_USCHED_FILE_EXEC_SPOOL_DIR	"spool.dir"
+#define CONFIG_USCHED_FILE_EXEC_SPOOL_MAX	"spool.max"
+#define CONFIG_USCHED_FILE_EXEC_CGROUP_USE	"cgroup.use"
+#define CONFIG_USCHED_FILE_EXEC_CGROUP_DIR	"cgroup.dir"
+#define CONFIG_USCHED_FILE_EXEC_CGROUP_GROUP	"cgroup.group"
+#define CONFIG_USCHED_FILE_EXEC_CGROUP_CPU	"cgroup.cpu"
+#define CONFIG_USCHED_FILE_EXEC_CGROUP_MEMORY	"cgroup.memory"
+#define CONFIG_USCHED_FILE_EXEC_CGROUP_IO	"cgroup.io"
 #define CONFIG_USCHED_FILE_IPC_AUTH_KEY		"auth.key"
 #define CONFIG_USCHED_FILE_IPC_ID_KEY		"id.key"
 #define CONFIG_USCHED_FILE_IPC_ID_NAME		"id.name"
 #define CONFIG_USCHED_FILE_IPC_MSG_MAX		"msg.max"
 #define CONFIG_USCHED_FILE_IPC_MSG_SIZE		"msg.size"
+#define CONFIG_USCHED_FILE_IPC_MSG_TRANSPORT	"msg.transport"
 #define CONFIG_USCHED_FILE_IPC_JAIL_DIR		"jail.dir"
 #define CONFIG_USCHED_FILE_IPC_PRIVDROP_USER	"privdrop.user"
 #define CONFIG_USCHED_FILE_IPC_PRIVDROP_GROUP	"privdrop.group"
@@ -73,6 +94,7 @@
 #define CONFIG_USCHED_FILE_NETWORK_CONN_LIMIT	"conn.limit"
 #define CONFIG_USCHED_FILE_NETWORK_CONN_TIMEOUT	"conn.timeout"
 #define CONFIG_USCHED_FILE_NETWORK_SOCK_NAME	"sock.name"
+#define CONFIG_USCHED_FILE_NETWORK_ACCEPT_WORKERS	"accept.workers"
 #define CONFIG_USCHED_FILE_STAT_JAIL_DIR	"jail.dir"
 #define CONFIG_USCHED_FILE_STAT_PRIVDROP_USER	"privdrop.user"
 #define CONFIG_USCHED_FILE_STAT_PRIVDROP_GROUP	"privdrop.group"
@@ -95,10 +117,54 @@
 #define CONFIG_USCHED_AUTH_USERNAME_MAX		32
 #define CONFIG_USCHED_AUTH_PASSWORD_MAX		256
 #define CONFIG_USCHED_AUTH_PASSWORD_MIN		8
+#define CONFIG_USCHED_AUTH_RATE_LIMIT_MAX	100000 /* Max NEW requests per second, per requester */
+#define CONFIG_USCHED_AUTH_RATE_BURST_MAX	100000 /* Max NEW requests accepted in a single burst */
+#define CONFIG_USCHED_AUTH_QUOTA_ENTRIES_MAX	1000000 /* Max active entries per UID */
 #define CONFIG_USCHED_AUTH_SESSION_MAX		272  /* Current mac: 257 */
+#define CONFIG_USCHED_AUTH_TICKET_SIZE		32   /* Size of session ticket identifiers, keys and nonces */
+#define CONFIG_USCHED_AUTH_TICKET_TTL		300  /* Lifetime of remote session tickets (seconds, 0 disables) */
+#define CONFIG_USCHED_AUTH_TICKET_MAX		4096 /* Max number of session tickets held by the daemon */
 #define CONFIG_USCHED_AUTH_IPC_SIZE_MIN		32   /* Min. Size of IPC authentication string */
 #define CONFIG_USCHED_AUTH_IPC_SIZE_MAX		128  /* Max. Size of IPC authentication string */
+#define CONFIG_USCHED_IPC_TRANSPORT_PIPC	"pipc" /* Message queues managed by usi (default) */
+#define CONFIG_USCHED_IPC_TRANSPORT_SHM		"shm" /* Shared memory rings created by usi */
+#define CONFIG_USCHED_IPC_SHM_NAME_MAX		64   /* Max. size of a shared memory ring name */
+#define CONFIG_USCHED_IPC_SHM_SLOTS_MAX		1048576 /* Max number of slots of a shared memory ring */
+#define CONFIG_USCHED_IPC_SHM_CACHELINE		64   /* Distance between the producer and consumer indexes */
+#define CONFIG_USCHED_IPC_SHM_WAIT_TIMEOUT	1000 /* Max time (ms) sleeping on a ring before checking for cancellation */
+#define CONFIG_USCHED_IPC_SHM_POLL_INTERVAL	1000 /* Ring polling interval (us) when futexes are not available */
+#define CONFIG_USCHED_IPC_RECV_BATCH_MAX	32   /* Max. number of IPC messages handled per worker wakeup */
 #define CONFIG_USCHED_EXEC_OUTPUT_MAX		4096 /* Max number of bytes to store output data */
+#define CONFIG_USCHED_EXEC_RETRY_DEPTH_MAX	65536 /* Max number of deferred executions in memory */
+#define CONFIG_USCHED_EXEC_RETRY_INTERVAL	100  /* Redelivery interval (ms) while use queue is full */
+#define CONFIG_USCHED_EXEC_CONCURRENCY_MAX	1024 /* Max number of concurrent executions per entry */
+#define CONFIG_USCHED_EXEC_CHILDREN_MAX		65536 /* Max number of concurrent children of the executer */
+#define CONFIG_USCHED_EXEC_QUEUE_DEPTH_MAX	65536 /* Max number of executions waiting in the run queue */
+#define CONFIG_USCHED_EXEC_PRIORITY_CLASSES	3    /* Number of entry priority classes (low, normal, high) */
+#define CONFIG_USCHED_EXEC_WORKERS_MAX		64   /* Max number of executer worker threads */
+#define CONFIG_USCHED_EXEC_CHILDREN_BUCKETS	1024 /* Number of buckets of the executer children table */
+#define CONFIG_USCHED_EXEC_REAP_EVENTS_MAX	64   /* Max number of events collected by the reaper per wakeup */
+#define CONFIG_USCHED_EXEC_REAP_OUTPUT_READS	16   /* Max number of output reads per child and reaper wakeup */
+#define CONFIG_USCHED_EXEC_REAP_DRAIN_INTERVAL	100  /* Output polling interval (ms) when epoll isn't available */
+#define CONFIG_USCHED_EXEC_WORKER_DEQUE_SIZE	64   /* Initial number of slots of each worker deque (power of 2) */
+#define CONFIG_USCHED_EXEC_CREDIT_INTERVAL	1000 /* Max interval (ms) between executer capacity advertisements */
+#define CONFIG_USCHED_EXEC_SPAWN_STACK_SIZE	65536 /* Stack size (bytes) of a spawned child until it executes the command */
+#define CONFIG_USCHED_EXEC_CGROUP_NAME_MAX	64   /* Max length of the cgroup path of an execution, relative to exec.cgroup.dir */
+#define CONFIG_USCHED_NET_ACCEPT_WORKERS_MAX	16   /* Max number of acceptor threads (SO_REUSEPORT) */
+#define CONFIG_USCHED_NET_ACCEPT_BATCH		64   /* Max connections accepted per listener wakeup */
+#define CONFIG_USCHED_NET_ACCEPT_EVENTS		8    /* Max listener events retrieved per wakeup */
+#define CONFIG_USCHED_NET_RTABLE_MAX		1048576 /* Max number of slots in the receiving table */
+#define CONFIG_USCHED_NET_RBUF_MAX		65536 /* Max size of the reusable receive buffer kept per connection */
+#define CONFIG_USCHED_NET_PARTIAL_RESUMES_MAX	32   /* Max times a partial read or write is resumed */
+#define CONFIG_USCHED_ENTRY_HDR_VERSION		1    /* Version of the entry request header (zero is the original, unversioned, header) */
+#define CONFIG_USCHED_BATCH_VERSION		1    /* Version of the batch request frame */
+#define CONFIG_USCHED_BATCH_NMEMB_MAX		1024 /* Max number of operations per batch request */
+#define CONFIG_USCHED_GET_CHUNK_SIZE		65536 /* Max records size per streamed GET response chunk */
+#define CONFIG_USCHED_SUBSCRIBE_MAX		1024 /* Max number of active subscriptions */
+#define CONFIG_USCHED_SUBSCRIBE_IDS_MAX		1024 /* Max number of entry IDs per subscription */
+#define CONFIG_USCHED_SUBSCRIBE_OUTDATA_MAX	256  /* Max output bytes carried by a completion record */
+#define CONFIG_USCHED_SUBSCRIBE_QUEUE_MAX	65536 /* Max size of the pending records of a subscriber */
+#define CONFIG_USCHED_SUBSCRIBE_IDLE_TIMEOUT	86400 /* Max time (s) a subscription is kept without records */
 #define CONFIG_USCHED_HASH_FNV1A		1
 #define CONFIG_USCHED_HASH_DJB2			0
 
@@ -151,9 +217,40 @@
 #ifndef CONFIG_USE_SELECT
  #define CONFIG_USE_SELECT			0
 #endif
+#ifndef CONFIG_USE_EPOLL
+ #if CONFIG_SYS_LINUX == 1 && CONFIG_USE_SELECT == 0
+  #define CONFIG_USE_EPOLL			1
+ #else
+  #define CONFIG_USE_EPOLL			0
+ #endif
+#endif
+#ifndef CONFIG_USE_FUTEX
+ #if CONFIG_SYS_LINUX == 1 && CONFIG_POSIX_STRICT == 0
+  #define CONFIG_USE_FUTEX			1
+ #else
+  #define CONFIG_USE_FUTEX			0
+ #endif
+#endif
+#ifndef CONFIG_USE_SPAWN
+ #if CONFIG_SYS_LINUX == 1 && CONFIG_POSIX_STRICT == 0
+  #define CONFIG_USE_SPAWN			1
+ #else
+  #define CONFIG_USE_SPAWN			0
+ #endif
+#endif
+#ifndef CONFIG_USE_CGROUP
+ #if CONFIG_SYS_LINUX == 1 && CONFIG_POSIX_STRICT == 0
+  #define CONFIG_USE_CGROUP			1
+ #else
+  #define CONFIG_USE_CGROUP			0
+ #endif
+#endif
 
 
 /* Configuration compliance checks */
+#if CONFIG_USE_EPOLL == 1 && CONFIG_USE_SELECT == 1
+ #error "CONFIG_USE_EPOLL and CONFIG_USE_SELECT are mutually exclusive."
+#endif
 #if CONFIG_POSIX_STRICT == 1 && (CONFIG_USCHED_JAIL == 1 || CONFIG_USE_SYNCFS == 1)
  #error "CONFIG_POSIX_STRICT is incompatible with the following options: CONFIG_USCHED_JAIL, CONFIG_USE_SYNCFS"
 #endif
@@ -281,6 +378,9 @@ struct usched_config_auth {
 	unsigned int local_use;
 	unsigned int pam_use;
 	unsigned int remote_users;
+	unsigned int rate_limit;
+	unsigned int rate_burst;
+	unsigned int quota_entries;
 };
 
 struct usched_config_core {
@@ -297,6 +397,23 @@ struct usched_config_core {
 
 struct usched_config_exec {
 	unsigned int delta_noexec;
+	unsigned int retry_depth;
+	unsigned int retry_delay;
+	unsigned int spill_use;
+	char *spill_file;
+	unsigned int children_max;
+	unsigned int queue_depth;
+	unsigned int thread_workers;
+	unsigned int output_max;
+	unsigned int spool_use;
+	char *spool_dir;
+	unsigned int spool_max;
+	unsigned int cgroup_use;
+	char *cgroup_dir;
+	char *cgroup_group;
+	unsigned int cgroup_cpu;
+	unsigned int cgroup_memory;	/* In MiB. Zero means no limit. */
+	unsigned int cgroup_io;
 };
 
 struct usched_config_ipc {
@@ -305,6 +422,8 @@ struct usched_config_ipc {
 	char *id_name;
 	long msg_max;
 	long msg_size;
+	char *msg_transport;
+	unsigned int transport_shm;
 	char *jail_dir;
 	char *privdrop_user;
 	char *privdrop_group;
@@ -318,6 +437,7 @@ struct usched_config_network {
 	unsigned int conn_limit;
 	unsigned int conn_timeout;
 	char *sock_name;
+	unsigned int accept_workers;
 };
 
 struct usched_config_stat {
@@ -36,6 +36,12 @@
 
 #ifndef COMPILE_WIN32
 #include <arpa/inet.h>
+#include <sys/uio.h>
+#else
+struct iovec {
+	void *iov_base;
+	size_t iov_len;
+};
 #endif
 
 /* Macros */
@@ -65,6 +71,7 @@ void conn_client_destroy(void);
 #if CONFIG_CLIENT_ONLY == 0
 int conn_daemon_init(void);
 int conn_daemon_process_all(void);
+void conn_daemon_process_cancel(void);
 void conn_daemon_client_close(sock_t fd);
 void conn_daemon_destroy(void);
 #endif /* CONFIG_CLIENT_ONLY == 0 */
@@ -73,6 +80,7 @@ int conn_is_remote(sock_t fd);
 int conn_set_nonblock(sock_t fd);
 ssize_t conn_read_blocking(sock_t fd, void *buf, size_t count);
 ssize_t conn_write_blocking(sock_t fd, const void *buf, size_t count);
+ssize_t conn_writev_blocking(sock_t fd, struct iovec *iov, int iovcnt);
 
 #endif
 
@@ -0,0 +1,47 @@
+/**
+ * @file credit.h
+ * @brief uSched
+ *        Executer flow control interface header
+ *
+ * Date: 18-10-2026
+ * 
+ * Copyright 2014-2015 Pedro A. Hortas (pah@ucodev.org)
+ *
+ * This file is part of usched.
+ *
+ * usched is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * usched is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with usched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef USCHED_CREDIT_H
+#define USCHED_CREDIT_H
+
+#include <sys/types.h>
+
+#include "ipc.h"
+
+/* Prototypes */
+int credit_daemon_init(void);
+void credit_daemon_destroy(void);
+void credit_daemon_recv(const char *msg, size_t len);
+int credit_daemon_acquire(void);
+void credit_daemon_restore(void);
+void credit_daemon_counters(struct ipc_counters_hdr *hdr);
+int credit_exec_init(void);
+void credit_exec_destroy(void);
+void credit_exec_received(size_t count);
+void credit_exec_notify(void);
+
+#endif
+
@@ -73,9 +73,81 @@ typedef enum USCHED_ENTRY_FLAGS {
 	USCHED_ENTRY_FLAG_INVALID,	/* Entry is in an invalid state */
 	USCHED_ENTRY_FLAG_EXPIRED,	/* TODO: Entry is expired (entry.c:367) */
 	USCHED_ENTRY_FLAG_PAUSED,	/* TODO: Entry is paused */
-	USCHED_ENTRY_FLAG_REMOVED	/* Entry was marked to be removed */
+	USCHED_ENTRY_FLAG_REMOVED,	/* Entry was marked to be removed */
+
+	/* Remote flags appended after the local ones, so serialized flag values remain valid */
+	USCHED_ENTRY_FLAG_BATCH,	/* Payload is a batch of NEW, DEL and GET operations */
+	USCHED_ENTRY_FLAG_RESUME,	/* Remote session is resumed from a session ticket */
+	USCHED_ENTRY_FLAG_PROJECT,	/* GET response is field projected and streamed in chunks */
+	USCHED_ENTRY_FLAG_SUBSCRIBE,	/* Push the execution results of the requested entries */
+
+	/* Execution mode flags (remote). Without any of them, the daemon decides at admission. */
+	USCHED_ENTRY_FLAG_EXEC_SHELL,	/* Subject is executed by the shell */
+	USCHED_ENTRY_FLAG_EXEC_DIRECT	/* Subject is split into arguments and executed without a shell */
 } usched_entry_flag_t;
 
+/* Entry fields that can be requested by a projected GET (USCHED_ENTRY_FLAG_PROJECT). The entry
+ * ID is always present.
+ */
+typedef enum USCHED_ENTRY_FIELDS {
+	USCHED_ENTRY_FIELD_FLAGS = 0,
+	USCHED_ENTRY_FIELD_UID,
+	USCHED_ENTRY_FIELD_GID,
+	USCHED_ENTRY_FIELD_TRIGGER,
+	USCHED_ENTRY_FIELD_STEP,
+	USCHED_ENTRY_FIELD_EXPIRE,
+	USCHED_ENTRY_FIELD_OVERLAP,
+	USCHED_ENTRY_FIELD_CONCURRENCY,
+	USCHED_ENTRY_FIELD_PRIORITY,
+	USCHED_ENTRY_FIELD_PID,
+	USCHED_ENTRY_FIELD_STATUS,
+	USCHED_ENTRY_FIELD_EXEC_TIME,
+	USCHED_ENTRY_FIELD_LATENCY,
+	USCHED_ENTRY_FIELD_OUTDATA,
+	USCHED_ENTRY_FIELD_USERNAME,
+	USCHED_ENTRY_FIELD_SUBJ,
+	USCHED_ENTRY_FIELD_MAX
+} usched_entry_field_t;
+
+#define USCHED_ENTRY_FIELDS_ALL		((uint32_t) ((1 << USCHED_ENTRY_FIELD_MAX) - 1))
+
+/* Entry overlap policies */
+typedef enum USCHED_ENTRY_OVERLAP {
+	USCHED_ENTRY_OVERLAP_ALLOW = 0,	/* Start a new execution while below the concurrency limit */
+	USCHED_ENTRY_OVERLAP_SKIP,	/* Skip the new execution */
+	USCHED_ENTRY_OVERLAP_QUEUE,	/* Queue one execution, started when a running one finishes */
+	USCHED_ENTRY_OVERLAP_KILL	/* Kill the running executions and start the new one */
+} usched_entry_overlap_t;
+
+/* Entry execution priority classes */
+typedef enum USCHED_ENTRY_PRIORITY {
+	USCHED_ENTRY_PRIORITY_NORMAL = 0,	/* Default class */
+	USCHED_ENTRY_PRIORITY_HIGH,		/* Jumps ahead of normal and low classes */
+	USCHED_ENTRY_PRIORITY_LOW		/* Only runs when no other class is waiting */
+} usched_entry_priority_t;
+
+/* Serialized entry record versions. Every change to the record layout must add a new version
+ * and keep entry_daemon_unserialize() able to read the previous ones. Fields missing from older
+ * records are loaded with their default (zero) values.
+ */
+#define USCHED_ENTRY_SERIALIZE_VERSION_LEGACY	0	/* Files without a header */
+#define USCHED_ENTRY_SERIALIZE_VERSION_OVERLAP	1	/* Adds overlap and concurrency */
+#define USCHED_ENTRY_SERIALIZE_VERSION_PRIORITY	2	/* Adds priority */
+#define USCHED_ENTRY_SERIALIZE_VERSION		USCHED_ENTRY_SERIALIZE_VERSION_PRIORITY
+
+/* Requests rejected before being processed are answered, in place of the session field, with
+ * USCHED_ENTRY_REJECT_MAGIC followed by the reason (network byte order). The remaining bytes of
+ * the session field are zero and the daemon closes the connection afterwards.
+ */
+#define USCHED_ENTRY_REJECT_MAGIC	"uSchedRJ"
+#define USCHED_ENTRY_REJECT_MAGIC_SIZE	8
+
+typedef enum USCHED_ENTRY_REJECT {
+	USCHED_ENTRY_REJECT_NONE = 0,
+	USCHED_ENTRY_REJECT_RATE,	/* The request rate limit of the requester was exceeded */
+	USCHED_ENTRY_REJECT_QUOTA	/* The active entries quota of the UID was reached */
+} usched_entry_reject_t;
+
 /* uSched Entry Structure */
 #ifndef USCHED_NO_PRAGMA_PACK
  #pragma pack(push)
@@ -88,6 +160,10 @@ __attribute__ ((packed, aligned(4)))
 usched_entry_reserved {
 #if CONFIG_CLIENT_ONLY == 0
 	pschedid_t psched_id;		/* The libpsched entry identifier */
+	struct {
+		uint32_t fields;	/* Requested fields (usched_entry_field_t bits) */
+		uint32_t cursor;	/* Next ID to be streamed (IDs are held in entry->payload) */
+	} stream;			/* Projected GET requests (never scheduled) */
 #endif
 	unsigned char _reserved[32];
 };
@@ -139,6 +215,23 @@ usched_entry_crypto {
  * @var usched_entry::expire
  *   The timestamp that once triggered will force the scheduler entry to be removed.
  *
+ * @var usched_entry::version
+ *   The version of the entry header (CONFIG_USCHED_ENTRY_HDR_VERSION). It takes the offset of the
+ *   'pid' field of the original header, which clients always sent as zero, so requests from clients
+ *   built against the original header are rejected instead of being misparsed.
+ *
+ * @var usched_entry::overlap
+ *   The policy applied when the entry is triggered while the number of its running executions
+ *   already reached the concurrency limit (see usched_entry_overlap_t).
+ *
+ * @var usched_entry::concurrency
+ *   The maximum number of concurrent executions of the entry. Zero means unlimited when the overlap
+ *   policy is 'allow', and one for any other policy.
+ *
+ * @var usched_entry::priority
+ *   The priority class of the entry executions while waiting in the executer run queue (see
+ *   usched_entry_priority_t).
+ *
  * @var usched_entry::username
  *   The username used for the remote authentication. Local authentications will have this field
  *   unset.
@@ -165,6 +258,10 @@ usched_entry {
 	uint32_t trigger;
 	uint32_t step;
 	uint32_t expire;
+	uint32_t version;
+	uint32_t overlap;
+	uint32_t concurrency;
+	uint32_t priority;
 	uint32_t pid;
 	uint32_t status;
 	uint64_t exec_time;	/* In nanoseconds */
@@ -221,12 +318,132 @@ usched_entry {
  #pragma pack(pop)
 #endif
 
+/**
+ * @struct usched_entry_batch_op
+ *
+ * @brief
+ *   Header of each operation carried by a batch request (USCHED_ENTRY_FLAG_BATCH). All fields are
+ *   in network byte order and each header is followed by 'psize' bytes of operation payload.
+ *
+ *   Batch request payload layout:
+ *
+ *   +=============+=================================+
+ *   | Field       | Size                            |
+ *   +=============+=================================+   --+
+ *   | version     | 32 bits                         |      > Header
+ *   | nmemb       | 32 bits                         |     |
+ *   +-------------+---------------------------------+   --+
+ *   | flags       | 32 bits                         |     |
+ *   | trigger     | 32 bits                         |     |
+ *   | step        | 32 bits                         |     |
+ *   | expire      | 32 bits                         |     |
+ *   | overlap     | 32 bits                         |      > Operation #1
+ *   | concurrency | 32 bits                         |     |
+ *   | priority    | 32 bits                         |     |
+ *   | psize       | 32 bits                         |     |
+ *   | payload     | psize                           |     |
+ *   +-------------+---------------------------------+   --+
+ *   |    .....    |              ....               |      > Operation #2 ...
+ *
+ *   Batch response payload layout:
+ *
+ *   +=============+=================================+
+ *   | version     | 32 bits                         |      > Header
+ *   | nmemb       | 32 bits                         |     |
+ *   +-------------+---------------------------------+   --+
+ *   | status      | 32 bits (0 or errno value)      |     |
+ *   | rsize       | 32 bits                         |      > Result #1
+ *   | rdata       | rsize (single request response) |     |
+ *   +-------------+---------------------------------+   --+
+ *   |    .....    |              ....               |      > Result #2 ...
+ *
+ */
+struct usched_entry_batch_op {
+	uint32_t flags;
+	uint32_t trigger;
+	uint32_t step;
+	uint32_t expire;
+	uint32_t overlap;
+	uint32_t concurrency;
+	uint32_t priority;
+	uint32_t psize;
+};
+
+/*
+ * Projected GET (USCHED_ENTRY_FLAG_GET | USCHED_ENTRY_FLAG_PROJECT)
+ *
+ *   Request payload layout:
+ *
+ *   +=============+=================================+
+ *   | fields      | 32 bits (usched_entry_field_t)  |
+ *   | reserved    | 32 bits (0)                     |
+ *   | id          | 64 bits (USCHED_SUBJ_ALL: all)  |
+ *   |    .....    |              ....               |
+ *   +-------------+---------------------------------+
+ *
+ *   The response is a sequence of chunks, each one sent as a regular encrypted response
+ *   (| size (32 bits) | encrypted chunk |). The records of a chunk don't exceed
+ *   CONFIG_USCHED_GET_CHUNK_SIZE, unless a single record is larger than that.
+ *
+ *   +=============+=================================+
+ *   | more        | 32 bits (0: last chunk)         |      > Chunk header
+ *   | nmemb       | 32 bits                         |     |
+ *   +-------------+---------------------------------+   --+
+ *   | id          | 64 bits                         |     |
+ *   | <field>     | 32 bits (64 bits for exec_time  |      > Record #1 (requested fields only,
+ *   |             | and latency)                    |     |   in usched_entry_field_t order)
+ *   | <field>     | 32 bits len + len bytes for     |     |
+ *   |             | outdata, username and subj      |     |
+ *   +-------------+---------------------------------+   --+
+ *   |    .....    |              ....               |      > Record #2 ...
+ *
+ */
+
+/*
+ * Execution results subscription (USCHED_ENTRY_FLAG_SUBSCRIBE)
+ *
+ *   Request payload layout:
+ *
+ *   +=============+=================================+
+ *   | id          | 64 bits (USCHED_SUBJ_ALL: all)  |
+ *   |    .....    |              ....               |
+ *   +-------------+---------------------------------+
+ *
+ *   The daemon replies with the number of subscribed entry IDs (32 bits, 0 for all the entries
+ *   of the requester) and keeps the connection open. From then on, the completion records of
+ *   the subscribed entries are pushed as regular encrypted responses, as executions finish.
+ *   Records queued while a response is being written are sent together.
+ *
+ *   +=============+=================================+
+ *   | nmemb       | 32 bits                         |      > Header
+ *   +-------------+---------------------------------+   --+
+ *   | id          | 64 bits                         |     |
+ *   | status      | 32 bits                         |     |
+ *   | pid         | 32 bits                         |     |
+ *   | exec_time   | 64 bits                         |      > Record #1
+ *   | latency     | 64 bits                         |     |
+ *   | outdata_len | 32 bits                         |     |
+ *   | outdata     | outdata_len bytes (truncated)   |     |
+ *   +-------------+---------------------------------+   --+
+ *   |    .....    |              ....               |      > Record #2 ...
+ *
+ *   The output is truncated to CONFIG_USCHED_SUBSCRIBE_OUTDATA_MAX bytes. A subscriber that
+ *   doesn't keep up with the completions is disconnected.
+ *
+ */
+
 /* Prototypes */
+struct usched_auth_client_ticket;
+
 struct usched_entry *entry_client_init(uid_t uid, gid_t gid, time_t trigger, void *payload, size_t psize);
 int entry_client_remote_session_create(struct usched_entry *entry, const char *password);
 int entry_client_remote_session_process(struct usched_entry *entry, const char *password);
+int entry_client_remote_session_resume(struct usched_entry *entry, const struct usched_auth_client_ticket *ticket);
+int entry_client_remote_ticket_create(const struct usched_entry *entry, uint32_t ttl, struct usched_auth_client_ticket *ticket);
 void entry_cleanup_session(struct usched_entry *entry);
 void entry_cleanup_crypto(struct usched_entry *entry);
+void entry_reject_set(unsigned char *session, usched_entry_reject_t reason);
+usched_entry_reject_t entry_reject_get(const unsigned char *session);
 void entry_update_signature(struct usched_entry *entry);
 int entry_check_signature(struct usched_entry *entry);
 void entry_set_id(struct usched_entry *entry, uint32_t id);
@@ -240,11 +457,18 @@ void entry_set_gid(struct usched_entry *entry, gid_t gid);
 void entry_set_trigger(struct usched_entry *entry, time_t trigger);
 void entry_set_step(struct usched_entry *entry, time_t step);
 void entry_set_expire(struct usched_entry *entry, time_t expire);
+void entry_set_overlap(struct usched_entry *entry, usched_entry_overlap_t overlap);
+void entry_set_concurrency(struct usched_entry *entry, unsigned int concurrency);
+void entry_set_priority(struct usched_entry *entry, usched_entry_priority_t priority);
 void entry_set_psize(struct usched_entry *entry, size_t size);
 void entry_set_subj_size(struct usched_entry *entry, size_t size);
 int entry_set_payload(struct usched_entry *entry, const char *payload, size_t len);
 int entry_payload_decrypt(struct usched_entry *entry);
+int entry_set_payload_decrypt(struct usched_entry *entry, const char *payload, size_t len);
 int entry_payload_encrypt(struct usched_entry *entry, size_t lpad);
+int entry_ticket_derive(const struct usched_entry *entry, unsigned char *ticket_id, unsigned char *ticket_key);
+int entry_ticket_session_key(struct usched_entry *entry, const unsigned char *ticket_key, const unsigned char *client_nonce, const unsigned char *server_nonce);
+int entry_ticket_session_proof(const struct usched_entry *entry, unsigned char *proof);
 void entry_unset_payload(struct usched_entry *entry);
 int entry_set_subj(struct usched_entry *entry, const char *subj, size_t len);
 void entry_unset_subj(struct usched_entry *entry);
@@ -253,6 +477,7 @@ int entry_compare(const void *e1, const void *e2);
 int entry_daemon_authorize(struct usched_entry *entry, sock_t fd);
 int entry_daemon_remote_session_create(struct usched_entry *entry);
 int entry_daemon_remote_session_process(struct usched_entry *entry);
+int entry_daemon_exec_mode_set(struct usched_entry *entry);
 void entry_daemon_exec_dispatch(void *arg);
 void entry_zero(struct usched_entry *entry);
 void entry_destroy(void *elem);
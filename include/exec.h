@@ -33,6 +33,40 @@ int exec_admin_rollback(void);
 int exec_admin_show(void);
 int exec_admin_delta_noexec_show(void);
 int exec_admin_delta_noexec_change(const char *ipc_msgmax);
+int exec_admin_retry_depth_show(void);
+int exec_admin_retry_depth_change(const char *retry_depth);
+int exec_admin_retry_delay_show(void);
+int exec_admin_retry_delay_change(const char *retry_delay);
+int exec_admin_spill_use_show(void);
+int exec_admin_spill_use_change(const char *spill_use);
+int exec_admin_spill_file_show(void);
+int exec_admin_spill_file_change(const char *spill_file);
+int exec_admin_children_max_show(void);
+int exec_admin_children_max_change(const char *children_max);
+int exec_admin_queue_depth_show(void);
+int exec_admin_queue_depth_change(const char *queue_depth);
+int exec_admin_thread_workers_show(void);
+int exec_admin_thread_workers_change(const char *thread_workers);
+int exec_admin_output_max_show(void);
+int exec_admin_output_max_change(const char *output_max);
+int exec_admin_spool_use_show(void);
+int exec_admin_spool_use_change(const char *spool_use);
+int exec_admin_spool_dir_show(void);
+int exec_admin_spool_dir_change(const char *spool_dir);
+int exec_admin_spool_max_show(void);
+int exec_admin_spool_max_change(const char *spool_max);
+int exec_admin_cgroup_use_show(void);
+int exec_admin_cgroup_use_change(const char *cgroup_use);
+int exec_admin_cgroup_dir_show(void);
+int exec_admin_cgroup_dir_change(const char *cgroup_dir);
+int exec_admin_cgroup_group_show(void);
+int exec_admin_cgroup_group_change(const char *cgroup_group);
+int exec_admin_cgroup_cpu_show(void);
+int exec_admin_cgroup_cpu_change(const char *cgroup_cpu);
+int exec_admin_cgroup_memory_show(void);
+int exec_admin_cgroup_memory_change(const char *cgroup_memory);
+int exec_admin_cgroup_io_show(void);
+int exec_admin_cgroup_io_change(const char *cgroup_io);
 
 #endif
 
@@ -49,6 +49,8 @@ struct ipc_usd_hdr {
 	uint64_t id;
 	uint64_t exec_time;	/* In nanoseconds */
 	uint64_t latency;	/* In nanoseconds */
+	uint64_t cpu_usec;	/* CPU time used by the execution cgroup (0 if none) */
+	uint64_t mem_peak;	/* Peak memory usage of the execution cgroup (0 if none) */
 	uint32_t pid;
 	uint32_t status;
 	uint32_t outdata_len;
@@ -59,9 +61,37 @@ struct ipc_use_hdr {
 	uint32_t uid;		/* Entry UID */
 	uint32_t gid;		/* Entry GID */
 	uint32_t trigger;	/* Entry Trigger */
+	uint32_t overlap;	/* Entry overlap policy */
+	uint32_t concurrency;	/* Entry max concurrent executions */
+	uint32_t priority;	/* Entry priority class */
+	struct timespec t_recv;	/* Time of reception by the executer (set by use) */
+	uint32_t argc;		/* Number of NULL separated arguments in cmd. Zero if cmd is a shell command. */
 	uint32_t cmd_len;	/* Command length */
 };
 
+/* Executer capacity advertisement (use -> usd). Each advertisement fully describes the state
+ * of the executer, so lost or repeated ones are harmless.
+ */
+struct ipc_credit_hdr {
+	uint64_t epoch;		/* Executer instance. Changes whenever use is (re)initialized. */
+	uint64_t received;	/* Execution requests received by this instance */
+	uint32_t free;		/* Executions that can still be accepted (child slots + run queue) */
+};
+
+/* Daemon counters (usd -> uss). Each message carries every counter, so lost or repeated ones
+ * are harmless.
+ */
+struct ipc_counters_hdr {
+	uint64_t admit_rate_rejected;	/* Requests rejected by the request rate limit */
+	uint64_t admit_quota_rejected;	/* Requests rejected by the active entries quota */
+	uint64_t credit_inflight;	/* Credits in use: executions sent but not yet received by use */
+	uint64_t credit_exhaustions;	/* Times the executer ran out of credits */
+	uint64_t credit_stalls;		/* Dispatches held due to the lack of credits */
+	uint64_t retry_pending;		/* Executions held in the deferred executions queue */
+	uint32_t credit_free;		/* Free executer capacity, as last advertised by use */
+	uint32_t credit_available;	/* Credits that can still be used */
+};
+
 struct ipc_uss_hdr {
 	uint64_t id;
 	uint32_t uid;
@@ -69,18 +99,45 @@ struct ipc_uss_hdr {
 	uint32_t pid;
 	uint32_t status;
 	struct timespec t_trigger;
+	struct timespec t_recv;
 	struct timespec t_start;
 	struct timespec t_end;
+	uint64_t cpu_usec;		/* CPU time used by the execution cgroup (0 if none) */
+	uint64_t mem_peak;		/* Peak memory usage of the execution cgroup (0 if none) */
+	uint64_t outdata_dropped;
 	uint32_t outdata_len;
 };
 
+/* Exact length of each message: the header followed by its variable length payload */
+#define IPC_USD_FRAME_LEN(hdr)	(sizeof(struct ipc_usd_hdr) + (size_t) (hdr)->outdata_len)
+#define IPC_USE_FRAME_LEN(hdr)	(sizeof(struct ipc_use_hdr) + (size_t) (hdr)->cmd_len)
+#define IPC_USS_FRAME_LEN(hdr)	(sizeof(struct ipc_uss_hdr) + (size_t) (hdr)->outdata_len)
+
+/* Distance between frames in a batch receive buffer. Keeps each header suitably aligned. */
+#define IPC_RECV_BATCH_STRIDE(count)	(((size_t) (count) + 1 + 15) & ~((size_t) 15))
+
+/* Handler of the messages received from a source other than the expected one (see
+ * ipc_recv_frames()). The message is only valid until the handler returns.
+ */
+typedef void (*ipc_recv_other_t) (long src_id, const char *msg, size_t len);
+
 /* Prototypes */
 ssize_t ipc_send(pipcd_t *pipcd, long src_id, long dst_id, const char *msg, size_t count);
 ssize_t ipc_send_nowait(pipcd_t *pipcd, long src_id, long dst_id, const char *msg, size_t count);
 ssize_t ipc_recv(pipcd_t *pipcd, long *src_id, long *dst_id, char *msg, size_t count);
 ssize_t ipc_recv_nowait(pipcd_t *pipcd, long *src_id, long *dst_id, char *msg, size_t count);
+ssize_t ipc_recv_frame(pipcd_t *pipcd, long src_id, long dst_id, char *msg, size_t count, size_t hdr_size, size_t len_offset, ipc_recv_other_t other);
+ssize_t ipc_recv_frames(pipcd_t *pipcd, long src_id, long dst_id, char *msgs, size_t count, size_t nmemb, size_t *lens, size_t hdr_size, size_t len_offset, ipc_recv_other_t other);
 int ipc_pending(pipcd_t *pipcd);
 void ipc_close(pipcd_t *pipcd);
+int ipc_shm_create(const struct usched_config_ipc *ipc);
+void ipc_shm_unlink(const struct usched_config_ipc *ipc);
+int ipc_shm_attach(const struct usched_config_ipc *ipc, long id);
+void ipc_shm_detach(void);
+char *ipc_buf_get(size_t size);
+void ipc_buf_reset(size_t len);
+void ipc_buf_dirty(size_t len);
+void ipc_buf_destroy(void);
 int ipc_daemon_init(void);
 int ipc_exec_init(void);
 int ipc_stat_init(void);
@@ -102,6 +159,8 @@ int ipc_admin_msg_max_show(void);
 int ipc_admin_msg_max_change(const char *msg_max);
 int ipc_admin_msg_size_show(void);
 int ipc_admin_msg_size_change(const char *msg_size);
+int ipc_admin_msg_transport_show(void);
+int ipc_admin_msg_transport_change(const char *msg_transport);
 int ipc_admin_jail_dir_show(void);
 int ipc_admin_jail_dir_change(const char *jail_dir);
 int ipc_admin_privdrop_user_show(void);
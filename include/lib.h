@@ -57,6 +57,8 @@ int usched_init(void);
 /**
  * @brief
  *   Perform the scheduling request contained in the parameter 'req'.
+ *   The connection to the daemon is kept open and reused by subsequent requests with the
+ *   same destination, until usched_destroy() is called.
  *
  * @param req
  *   A NULL terminated string containing a valid uSched Client request.
@@ -175,6 +177,120 @@ DLLIMPORT
 #endif
 int usched_opt_set_remote_password(char *password);
 
+/**
+ * @brief
+ *   Set the execution 'overlap' policy of the entries created by subsequent RUN requests. The
+ *   policy is applied when an entry is triggered while the number of its running executions
+ *   already reached the concurrency limit.
+ *
+ * @param overlap
+ *   A NULL terminated string containing one of the following policies: "allow" (default),
+ *   "skip", "queue" or "kill".
+ *
+ * @return
+ *   On success, zero is returned. On error, -1 is returned and errno is set appropriately.
+ *   \n\n
+ *   Errors: EINVAL
+ *
+ * @see usched_opt_set_exec_concurrency()
+ *
+ */ 
+#ifdef COMPILE_WIN32
+DLLIMPORT
+#endif
+int usched_opt_set_exec_overlap(char *overlap);
+
+/**
+ * @brief
+ *   Set the maximum number of concurrent executions of the entries created by subsequent RUN
+ *   requests.
+ *
+ * @param concurrency
+ *   A NULL terminated string containing a decimal value. Zero (default) means unlimited for the
+ *   "allow" overlap policy and one for the remaining policies.
+ *
+ * @return
+ *   On success, zero is returned. On error, -1 is returned and errno is set appropriately.
+ *   \n\n
+ *   Errors: EINVAL
+ *
+ * @see usched_opt_set_exec_overlap()
+ *
+ */ 
+#ifdef COMPILE_WIN32
+DLLIMPORT
+#endif
+int usched_opt_set_exec_concurrency(char *concurrency);
+
+/**
+ * @brief
+ *   Set the priority class of the entries created by subsequent RUN requests. Executions of
+ *   higher classes are started first when the executer run queue is not empty.
+ *
+ * @param priority
+ *   A NULL terminated string containing one of the following classes: "low", "normal" (default)
+ *   or "high".
+ *
+ * @return
+ *   On success, zero is returned. On error, -1 is returned and errno is set appropriately.
+ *   \n\n
+ *   Errors: EINVAL
+ *
+ * @see usched_opt_set_exec_overlap()
+ * @see usched_opt_set_exec_concurrency()
+ *
+ */ 
+#ifdef COMPILE_WIN32
+DLLIMPORT
+#endif
+int usched_opt_set_exec_priority(char *priority);
+
+/**
+ * @brief
+ *   Set the entry fields fetched by subsequent SHOW requests. Entries are streamed by the daemon
+ *   in bounded chunks and only the requested fields are transmitted. Fields that weren't
+ *   requested are left zeroed (or NULL) in the results of usched_result_get_show().
+ *
+ * @param fields
+ *   A NULL terminated string containing a comma separated list of the following fields: "all"
+ *   (default), "id", "flags", "uid", "gid", "trigger", "step", "expire", "overlap",
+ *   "concurrency", "priority", "pid", "status", "exectime", "latency", "output", "username" and
+ *   "command". The entry ID is always fetched.
+ *
+ * @return
+ *   On success, zero is returned. On error, -1 is returned and errno is set appropriately.
+ *   \n\n
+ *   Errors: EINVAL
+ *
+ * @see usched_result_get_show()
+ *
+ */ 
+#ifdef COMPILE_WIN32
+DLLIMPORT
+#endif
+int usched_opt_set_show_fields(char *fields);
+
+/**
+ * @brief
+ *   Set the function that receives the completion records of subsequent SUBSCRIBE requests
+ *   ("subscribe <id>[,<id>...]" or "subscribe all"). A SUBSCRIBE request performed by
+ *   usched_request() only returns when the connection to the daemon is terminated or when the
+ *   handler returns a negative value. The connection isn't reused by further requests.
+ *
+ * @param handler
+ *   A function called for each completion record pushed by the daemon. Only the id, status,
+ *   pid, exec_time, latency, outdata_len and outdata fields of 'record' are set, and 'outdata'
+ *   is truncated to CONFIG_USCHED_SUBSCRIBE_OUTDATA_MAX bytes. The record is only valid during
+ *   the call. Return a negative value to terminate the subscription.
+ *
+ * @see usched_request()
+ *
+ */ 
+#ifdef COMPILE_WIN32
+DLLIMPORT
+#endif
+void usched_opt_set_subscribe_handler(int (*handler) (const struct usched_entry *record));
+
 /**
  * @brief
  *   Retrieves the results of a successful RUN request, performed by usched_request(). The results
@@ -320,7 +436,7 @@ char *usched_usage_error_str(usched_usage_client_err_t error);
 
 /**
  * @brief
- *   Unitializes the uSched Client library interface.
+ *   Unitializes the uSched Client library interface, closing any open connection.
  *
  * @see usched_init()
  * @see usched_request()
@@ -38,6 +38,7 @@ int logic_client_process_hold(void);
 int logic_client_process_run(void);
 int logic_client_process_stop(void);
 int logic_client_process_show(void);
+int logic_client_process_subscribe(void);
 
 #endif
 
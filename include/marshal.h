@@ -28,6 +28,20 @@
 #ifndef USCHED_MARSHAL_H
 #define USCHED_MARSHAL_H
 
+#include <stdint.h>
+
+/* Definitions */
+#define MARSHAL_HEADER_MAGIC	0x5553534d	/* "USSM" */
+
+/* Structures */
+/* Header of the serialization file. Files written before it was introduced start directly with
+ * the active pool and hold USCHED_ENTRY_SERIALIZE_VERSION_LEGACY records.
+ */
+struct marshal_header {
+	uint32_t magic;
+	uint32_t version;	/* Entry record version (USCHED_ENTRY_SERIALIZE_VERSION) */
+};
+
 /* Prototypes */
 int marshal_daemon_monitor_init(void);
 int marshal_daemon_init(void);
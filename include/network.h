@@ -42,6 +42,8 @@ int network_admin_conn_timeout_show(void);
 int network_admin_conn_timeout_change(const char *conn_timeout);
 int network_admin_sock_name_show(void);
 int network_admin_sock_name_change(const char *sock_named);
+int network_admin_accept_workers_show(void);
+int network_admin_accept_workers_change(const char *accept_workers);
 
 #endif
 
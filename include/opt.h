@@ -27,6 +27,8 @@
 #ifndef USCHED_OPT_H
 #define USCHED_OPT_H
 
+#include <stdint.h>
+
 #include "config.h"
 
 struct usched_opt_client {
@@ -38,9 +40,17 @@ struct usched_opt_client {
 	char remote_port[6];		/* 5 digits (5 bytes + 1 '\0') */
 	char remote_username[CONFIG_USCHED_AUTH_USERNAME_MAX + 1];	/* Max 32 bytes */
 	char remote_password[CONFIG_USCHED_AUTH_PASSWORD_MAX + 1];	/* Max 256 bytes */
+	unsigned int exec_overlap;	/* Overlap policy of new entries (usched_entry_overlap_t) */
+	unsigned int exec_concurrency;	/* Max concurrent executions of new entries */
+	unsigned int exec_priority;	/* Priority class of new entries (usched_entry_priority_t) */
+	uint32_t show_fields;		/* Fields fetched by SHOW requests (usched_entry_field_t bits) */
 };
 
 /* Prototypes */
+int opt_client_exec_overlap_parse(const char *overlap);
+int opt_client_exec_concurrency_parse(const char *concurrency);
+int opt_client_exec_priority_parse(const char *priority);
+int opt_client_show_fields_parse(const char *fields, uint32_t *mask);
 int opt_client_process(int argc, char **argv, struct usched_opt_client *opt_client);
 
 #endif
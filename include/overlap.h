@@ -0,0 +1,65 @@
+/**
+ * @file overlap.h
+ * @brief uSched
+ *        Execution overlap control interface header - Exec
+ *
+ * Date: 18-10-2026
+ * 
+ * Copyright 2014-2015 Pedro A. Hortas (pah@ucodev.org)
+ *
+ * This file is part of usched.
+ *
+ * usched is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * usched is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with usched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef USCHED_OVERLAP_H
+#define USCHED_OVERLAP_H
+
+#include <stdint.h>
+
+#include <sys/types.h>
+
+/* Admission verdicts */
+typedef enum USCHED_OVERLAP_VERDICT {
+	OVERLAP_EXEC_START = 1,	/* Start the execution now */
+	OVERLAP_EXEC_SKIP,	/* Discard the execution */
+	OVERLAP_EXEC_QUEUED	/* The execution request is now owned by the overlap table */
+} usched_overlap_verdict_t;
+
+/* Structures */
+struct usched_overlap_pid {
+	pid_t pid;		/* PID of a running execution, not reaped yet */
+	int pidfd;		/* Process descriptor of the execution (-1 if none) */
+};
+
+struct usched_overlap_entry {
+	uint64_t id;		/* Entry ID */
+	unsigned int running;	/* Number of running executions */
+	unsigned int pids_nmemb;/* Number of known PIDs of the running executions */
+	struct usched_overlap_pid *pids; /* Running executions that can be terminated */
+	char *queued;		/* Pending execution request (queue policy) */
+};
+
+/* Prototypes */
+int overlap_exec_init(void);
+void overlap_exec_destroy(void);
+int overlap_exec_admit(char *buf);
+void overlap_exec_admit_batch(char **bufs, int *verdicts, size_t nmemb);
+void overlap_exec_pid_set(uint64_t id, pid_t pid, int pidfd);
+void overlap_exec_pid_clear(uint64_t id, pid_t pid);
+char *overlap_exec_finish(uint64_t id, pid_t pid);
+
+#endif
+
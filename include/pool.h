@@ -28,6 +28,11 @@
 #ifndef USCHED_POOL_H
 #define USCHED_POOL_H
 
+#include "config.h"
+#include "entry.h"
+
+#include <panet/panet.h>
+
 /* Prototypes */
 int pool_client_init(void);
 int pool_daemon_init(void);
@@ -35,6 +40,17 @@ int pool_stat_init(void);
 void pool_client_destroy(void);
 void pool_daemon_destroy(void);
 void pool_stat_destroy(void);
+#if CONFIG_CLIENT_ONLY == 0
+int pool_daemon_conn_open(sock_t fd);
+int pool_daemon_conn_insert(sock_t fd, struct usched_entry *entry);
+struct usched_entry *pool_daemon_conn_pop(sock_t fd);
+void pool_daemon_conn_close(sock_t fd);
+void *pool_daemon_conn_buf(sock_t fd, size_t size);
+void pool_daemon_conn_buf_release(sock_t fd, void *data);
+struct usched_conn_partial *pool_daemon_conn_partial(sock_t fd);
+void pool_daemon_conn_reject(sock_t fd);
+int pool_daemon_conn_rejected(sock_t fd);
+#endif /* CONFIG_CLIENT_ONLY == 0 */
 
 #endif
 
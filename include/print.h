@@ -47,6 +47,7 @@ void print_client_result_hold(const uint64_t *entry_list, size_t count);
 void print_client_result_run(uint64_t entry_id);
 void print_client_result_del(const uint64_t *entry_list, size_t count);
 void print_client_result_show(const struct usched_entry *entry_list, size_t count);
+void print_client_result_subscribe(const struct usched_entry *entry);
 
 #endif
 
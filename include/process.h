@@ -38,13 +38,20 @@
 
 /* Prototypes */
 #if CONFIG_CLIENT_ONLY == 0
+int process_daemon_recv_prepare(struct async_op *aop);
+int process_daemon_recv_admit(struct async_op *aop);
 struct usched_entry *process_daemon_recv_create(struct async_op *aop);
 int process_daemon_recv_update(struct async_op *aop, struct usched_entry *entry);
+int process_daemon_send_reply(struct async_op *aop, struct usched_entry *entry);
+int process_daemon_send_pending(const struct usched_entry *entry);
+int process_daemon_send_update(struct async_op *aop, struct usched_entry *entry);
 #endif /* CONFIG_CLIENT_ONLY == 0 */
 int process_client_recv_hold(struct usched_entry *entry);
 int process_client_recv_run(struct usched_entry *entry);
 int process_client_recv_stop(struct usched_entry *entry);
 int process_client_recv_show(struct usched_entry *entry);
+int process_client_recv_subscribe(struct usched_entry *entry);
+int process_client_recv_batch(struct usched_entry *entry, struct usched_entry **ops, uint32_t nmemb);
 
 #endif
 
@@ -0,0 +1,54 @@
+/**
+ * @file retry.h
+ * @brief uSched
+ *        Deferred execution retry interface header - Daemon
+ *
+ * Date: 18-10-2026
+ * 
+ * Copyright 2014-2015 Pedro A. Hortas (pah@ucodev.org)
+ *
+ * This file is part of usched.
+ *
+ * usched is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * usched is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with usched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef USCHED_RETRY_H
+#define USCHED_RETRY_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+/* Structures */
+struct usched_retry_msg {
+	time_t deferred;	/* Time of deferral */
+	size_t len;		/* Length of the IPC message (header + command) */
+	char msg[];
+};
+
+struct usched_retry_spill_hdr {
+	uint64_t deferred;
+	uint32_t len;
+};
+
+/* Prototypes */
+int retry_daemon_init(void);
+void retry_daemon_destroy(void);
+int retry_daemon_defer(const char *msg, size_t len);
+size_t retry_daemon_pending(void);
+void retry_daemon_wake(void);
+
+#endif
+
@@ -0,0 +1,94 @@
+/**
+ * @file ring.h
+ * @brief uSched
+ *        Shared memory ring interface header
+ *
+ * Date: 18-10-2026
+ *
+ * Copyright 2014-2015 Pedro A. Hortas (pah@ucodev.org)
+ *
+ * This file is part of usched.
+ *
+ * usched is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * usched is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with usched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef USCHED_RING_H
+#define USCHED_RING_H
+
+#include <stdint.h>
+#include <pthread.h>
+
+#include <sys/types.h>
+
+#include "config.h"
+
+/* Definitions */
+#define RING_MAGIC		0x55535252	/* "USRR" */
+#define RING_SLOT_HDR_SIZE	sizeof(uint64_t)
+
+/* Structures */
+/*
+ * Layout of a single-producer, single-consumer ring in shared memory. The producer only
+ * writes 'head' and the consumer only writes 'tail', so no locks are shared between
+ * processes. Both indexes are free running counters. Each side keeps its own futex word
+ * ('*_seq'), bumped after every index update, and a count of sleepers so that wakeups are
+ * only issued when someone is actually waiting.
+ */
+struct ring_shm {
+	uint32_t magic;
+	uint32_t slots;		/* Number of message slots */
+	uint32_t slot_size;	/* Max. message size */
+	uint32_t stride;	/* Slot size, including the length prefix */
+	char _pad0[CONFIG_USCHED_IPC_SHM_CACHELINE - (4 * sizeof(uint32_t))];
+
+	/* Written by the producer */
+	uint32_t head;		/* Messages written */
+	uint32_t data_seq;	/* Bumped after each write */
+	uint32_t data_waiters;	/* Consumers sleeping on data_seq */
+	char _pad1[CONFIG_USCHED_IPC_SHM_CACHELINE - (3 * sizeof(uint32_t))];
+
+	/* Written by the consumer */
+	uint32_t tail;		/* Messages read */
+	uint32_t space_seq;	/* Bumped after each read */
+	uint32_t space_waiters;	/* Producers sleeping on space_seq */
+	char _pad2[CONFIG_USCHED_IPC_SHM_CACHELINE - (3 * sizeof(uint32_t))];
+
+	/* Message slots follow: [ uint32_t len | pad | msg (slot_size) ] * slots */
+};
+
+/* Process local handler of an attached ring */
+struct ring {
+	struct ring_shm *shm;
+	char *base;			/* First message slot */
+	size_t size;			/* Size of the mapping */
+	uint32_t slots;			/* Geometry validated on attach. The shared copy is */
+	uint32_t slot_size;		/* never trusted afterwards. */
+	uint32_t stride;
+	pthread_mutex_t mutex_push;	/* Serializes the producers of this process */
+	pthread_mutex_t mutex_pop;	/* Serializes the consumers of this process */
+};
+
+/* Prototypes */
+int ring_create(const char *name, size_t slots, size_t slot_size, uid_t uid, gid_t gid, mode_t mode);
+int ring_unlink(const char *name);
+struct ring *ring_attach(const char *name);
+void ring_detach(struct ring *ring);
+ssize_t ring_push(struct ring *ring, const char *msg, size_t count, int block);
+ssize_t ring_pop(struct ring *ring, char *msg, size_t count, int block);
+size_t ring_pending(struct ring *ring);
+
+#endif
+
@@ -0,0 +1,47 @@
+/**
+ * @file runq.h
+ * @brief uSched
+ *        Executer run queue interface header - Exec
+ *
+ * Date: 18-10-2026
+ * 
+ * Copyright 2014-2015 Pedro A. Hortas (pah@ucodev.org)
+ *
+ * This file is part of usched.
+ *
+ * usched is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * usched is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with usched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef USCHED_RUNQ_H
+#define USCHED_RUNQ_H
+
+#include <sys/types.h>
+
+/* Submission verdicts */
+typedef enum USCHED_RUNQ_VERDICT {
+	RUNQ_EXEC_START = 1,	/* A child slot was reserved. Start the execution now */
+	RUNQ_EXEC_QUEUED	/* The execution request is now owned by the run queue */
+} usched_runq_verdict_t;
+
+/* Prototypes */
+int runq_exec_init(void);
+void runq_exec_destroy(void);
+int runq_exec_submit(char *buf);
+void runq_exec_submit_batch(char **bufs, int *verdicts, size_t nmemb);
+char *runq_exec_release(void);
+unsigned int runq_exec_free(void);
+
+#endif
+
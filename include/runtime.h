@@ -52,6 +52,10 @@
 #include "usched.h"
 #include "usage.h"
 #include "opt.h"
+#include "auth.h"
+#if CONFIG_EXEC_SPECIFIC == 1 || CONFIG_COMMON == 1
+ #include "worker.h"
+#endif
 
 /* Flags */
 typedef enum USCHED_RUNTIME_FLAGS {
@@ -78,8 +82,14 @@ struct usched_runtime_client {
 	struct fifo_handler *epool;	/* Entries pool */
 	void *result;
 	size_t result_nmemb;
+	int (*subscribe_handler) (const struct usched_entry *record); /* Library subscription records handler */
 
 	sock_t fd;
+	unsigned int fd_open;		/* Set while runc.fd is connected */
+	char fd_hostname[256];		/* Destination of runc.fd (empty for local connections) */
+	char fd_port[6];
+
+	struct usched_auth_client_ticket ticket;	/* Remote session ticket, if any */
 
 	volatile usched_runtime_flag_t flags;
 
@@ -113,6 +123,23 @@ struct usched_runtime_admin {
 #endif /* CONFIG_ADMIN_SPECIFIC */
 
 #if CONFIG_DAEMON_SPECIFIC == 1 || CONFIG_COMMON == 1
+struct usched_conn_partial {
+	char *base;			/* Buffer of the operation being resumed */
+	size_t count;			/* Total amount of data of the operation */
+	size_t offset;			/* Amount of data already transferred */
+	unsigned int resumes;		/* Number of times the operation was resumed */
+};
+
+struct usched_conn_slot {
+	struct usched_entry *entry;	/* Entry being received on this connection, if any */
+	uint32_t gen;			/* Incremented whenever the descriptor is (re)opened or closed */
+	uint32_t entry_gen;		/* Generation of the connection that owns 'entry' */
+	char *buf;			/* Reusable receive buffer of this connection */
+	size_t buf_size;		/* Size of the receive buffer */
+	struct usched_conn_partial partial; /* Partial read or write in progress, if any */
+	int rejected;			/* Close once the pending rejection reply is written */
+};
+
 struct usched_runtime_daemon {
 	int argc;
 	char **argv;
@@ -121,15 +148,31 @@ struct usched_runtime_daemon {
 
 	sock_t fd_unix;
 	sock_t fd_remote;
+	sock_t fd_accept[CONFIG_USCHED_NET_ACCEPT_WORKERS_MAX]; /* Remote listener of each acceptor */
+	unsigned int accept_nmemb;	/* Number of acceptors (epoll backend) */
 	volatile usched_runtime_flag_t flags;
 	struct sigaction sa_save;
 
-	struct cll_handler *rpool;	/* Receiving pool */
+	struct usched_conn_slot *rtable;	/* Receiving table (indexed by file descriptor) */
+	size_t rtable_nmemb;		/* Number of slots in the receiving table */
 	struct cll_handler *apool;	/* Active pool */
+	struct fifo_handler *qpool;	/* Deferred executions pool */
+	struct cll_handler *admit;	/* Admission control (rate buckets and quotas) */
+	struct cll_handler *tickets;	/* Remote session tickets */
+	struct usched_auth_users *users; /* Remote users table (decoded credentials) */
+	struct cll_handler *subs;	/* Execution results subscriptions */
 
 	pthread_mutex_t mutex_interrupt;
+	pthread_mutex_t mutex_conn;
 	pthread_mutex_t mutex_rpool;
 	pthread_mutex_t mutex_apool;
+	pthread_mutex_t mutex_qpool;
+	pthread_mutex_t mutex_admit;
+	pthread_mutex_t mutex_ticket;
+	pthread_mutex_t mutex_users;
+	pthread_mutex_t mutex_subs;
+	pthread_mutex_t mutex_credit;
+	pthread_cond_t cond_qpool;
 #if CONFIG_USCHED_SERIALIZE_ON_REQ == 1
 	pthread_mutex_t mutex_marshal;
 	pthread_cond_t cond_marshal;
@@ -141,6 +184,27 @@ struct usched_runtime_daemon {
 	pipcd_t *pipcd; /* IPC descriptor */
 
 	pall_fd_t ser_fd;
+	uint32_t ser_version;		/* Entry record version of the file being unserialized */
+
+	int spill_fd;			/* Deferred executions spill file */
+	off_t spill_off;		/* Offset of the next spilled record */
+	size_t spill_count;		/* Number of spilled records pending */
+
+	uint64_t retry_deferred;	/* Executions deferred due to a full executer queue */
+	uint64_t retry_delivered;	/* Deferred executions successfully redelivered */
+	uint64_t retry_dropped;		/* Deferred executions that were never delivered */
+
+	uint64_t credit_epoch;		/* Executer instance the credits refer to (0 if unknown) */
+	uint64_t credit_sent;		/* Execution requests sent, counted as the executer does */
+	uint64_t credit_recv;		/* Execution requests received, as last advertised by use */
+	unsigned int credit_free;	/* Free executer capacity, as last advertised by use */
+	int credit_exhausted;		/* Set while dispatches are being held for lack of credits */
+	uint64_t credit_adverts;	/* Capacity advertisements received */
+	uint64_t credit_stalls;		/* Dispatches held due to the lack of credits */
+	uint64_t credit_exhaustions;	/* Times the credits ran out */
+
+	uint64_t admit_rate_rejected;	/* NEW requests rejected due to the rate limit */
+	uint64_t admit_quota_rejected;	/* NEW requests rejected due to the active entries quota */
 
 	size_t conn_cur;
 
@@ -148,8 +212,11 @@ struct usched_runtime_daemon {
 
 	pthread_t t_runtime;		/* main thread */
 	pthread_t t_unix, t_remote;	/* connection management threads */
+	pthread_t t_accept[CONFIG_USCHED_NET_ACCEPT_WORKERS_MAX]; /* epoll acceptor threads */
 	pthread_t t_delta, t_marshal;	/* monitoring threads */
 	pthread_t t_stat;		/* Status and Statistics worker */
+	pthread_t t_retry;		/* Deferred executions redelivery worker */
+	pthread_t t_credit;		/* Executer capacity advertisements worker */
 
 	time_t time_last;
 	int64_t delta_last;
@@ -165,6 +232,33 @@ struct usched_runtime_exec {
 	struct sigaction sa_save;
 
 	pthread_mutex_t mutex_interrupt;
+	pthread_mutex_t mutex_opool;
+	pthread_mutex_t mutex_runq;
+	pthread_mutex_t mutex_credit;
+	pthread_cond_t cond_credit;
+	pthread_mutex_t mutex_workers;
+	pthread_cond_t cond_workers;
+
+	struct usched_worker *workers;	/* Execution worker pool */
+	unsigned int workers_nmemb;	/* Number of workers */
+	unsigned int workers_next;	/* Next worker receiving external submissions */
+	size_t workers_pending;		/* Tasks waiting in the worker deques */
+	int workers_stop;		/* Workers must drain their deques and terminate */
+	void (*workers_routine) (struct usched_exec_task *);
+
+	pthread_t t_credit;		/* Capacity advertisements worker */
+	pthread_t t_reap;		/* Children reaper */
+	pthread_t t_drain;		/* Children output drainer (without epoll) */
+	uint64_t credit_epoch;		/* Identifies this instance to usd */
+	uint64_t credit_received;	/* Execution requests received and already admitted */
+	int credit_notify;		/* Capacity changed since the last advertisement */
+	int credit_stop;		/* Advertisements worker must terminate */
+
+	struct cll_handler *opool;	/* Running executions per entry (overlap control) */
+
+	struct fifo_handler *runq[CONFIG_USCHED_EXEC_PRIORITY_CLASSES]; /* Run queue per priority class */
+	unsigned int runq_children;	/* Number of reserved child slots */
+	size_t runq_waiting;		/* Number of executions waiting in the run queue */
 
 	pipck_t pipck;
 	pipcd_t *pipcd; /* IPC descriptor */
@@ -187,12 +281,16 @@ struct usched_runtime_stat {
 	pthread_t tid_incoming;
 	pthread_t tid_dispatch;
 	pthread_t tid_report;
+	pthread_t tid_counters;
 
 	pthread_cond_t cond_dpool;
 
 	pthread_mutex_t mutex_interrupt;
 	pthread_mutex_t mutex_dpool;
 	pthread_mutex_t mutex_spool;
+	pthread_mutex_t mutex_counters;
+
+	struct ipc_counters_hdr counters;	/* Last counters received from usd */
 
 	pipck_t pipck;
 	pipcd_t *pipcd; /* IPC descriptor */
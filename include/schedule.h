@@ -39,6 +39,7 @@ void schedule_daemon_destroy(void);
 int schedule_daemon_active(void);
 int schedule_entry_create(struct usched_entry *entry);
 struct usched_entry *schedule_entry_get_copy(uint64_t entry_id);
+int schedule_entry_get_projection(uint64_t entry_id, uid_t uid, uint32_t fields, char *buf, size_t *len);
 int schedule_entry_get_by_uid(uid_t uid, uint64_t **entry_list, uint32_t *count);
 struct usched_entry *schedule_entry_disable(struct usched_entry *entry);
 int schedule_entry_delete(struct usched_entry *entry);
@@ -34,9 +34,13 @@ struct usched_stat_exec {
 	pid_t pid;			/* The Entry PID */
 	int status;			/* The Entry exit status */
 	struct timespec trigger;	/* Timestamp of the Entry trigger */
+	struct timespec received;	/* Timestamp of when the Entry was received by the executer */
 	struct timespec start;		/* Timestamp of when the Entry processing was started */
 	struct timespec end;		/* Timestamp of when the Entry finished processing */
+	uint64_t cpu_usec;		/* CPU time (microseconds) used by the execution cgroup */
+	uint64_t mem_peak;		/* Peak memory usage (bytes) of the execution cgroup */
 	size_t outdata_len;		/* Length of the Entry output (may be truncated) */
+	uint64_t outdata_dropped;	/* Number of output bytes left out of outdata */
 	char outdata[CONFIG_USCHED_EXEC_OUTPUT_MAX + 1]; /* Entry output (may be truncated) */
 };
 
@@ -67,6 +71,7 @@ int stat_admin_report_mode_show(void);
 int stat_admin_report_mode_change(const char *report_mode);
 int stat_daemon_init(void);
 void stat_daemon_destroy(void);
+void stat_daemon_counters_send(void);
 int stat_compare(const void *s1, const void *s2);
 struct usched_stat_entry *stat_dup(const struct usched_stat_entry *s);
 void stat_zero(struct usched_stat_entry *s);
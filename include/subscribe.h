@@ -0,0 +1,71 @@
+/**
+ * @file subscribe.h
+ * @brief uSched
+ *        Execution results subscription interface header - Daemon
+ *
+ * Date: 18-10-2026
+ * 
+ * Copyright 2014-2015 Pedro A. Hortas (pah@ucodev.org)
+ *
+ * This file is part of usched.
+ *
+ * usched is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * usched is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with usched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef USCHED_SUBSCRIBE_H
+#define USCHED_SUBSCRIBE_H
+
+#include <stdint.h>
+#include <time.h>
+
+#include <sys/types.h>
+
+#include <rtsaio/rtsaio.h>
+#include <panet/panet.h>
+
+#include "config.h"
+#include "entry.h"
+
+/* Structures */
+struct usched_subscription {
+	sock_t fd;			/* Connection of the subscriber */
+	uid_t uid;			/* Authenticated UID of the subscriber */
+	uint64_t *ids;			/* Subscribed entry IDs, sorted. NULL: All the entries of 'uid' */
+	size_t ids_nmemb;		/* Number of subscribed entry IDs */
+	struct usched_entry *entry;	/* Subscription request (holds the session cryptographic context) */
+	struct async_op *aop;		/* Connection aop. Only used by the publisher while idle. */
+	struct async_op *raop;		/* Read armed on the connection to notice its termination */
+	unsigned char probe;		/* Receive buffer of 'raop'. Subscribers don't send anything. */
+	time_t t_active;		/* Registration time, or time of the last published record */
+	char *queue;			/* Pending records, preceded by the records count */
+	size_t queue_len;		/* Size of the pending records, including the records count */
+	uint32_t queue_nmemb;		/* Number of pending records */
+	unsigned int busy;		/* A response is being written to the connection */
+	unsigned int overflow;		/* The subscriber isn't keeping up with the completions */
+	unsigned int closing;		/* The connection is closed once no I/O is pending on it */
+};
+
+/* Prototypes */
+int subscribe_daemon_init(void);
+void subscribe_daemon_destroy(void);
+int subscribe_daemon_register(sock_t fd, struct usched_entry *entry, uint64_t *ids, size_t ids_nmemb);
+int subscribe_daemon_sent(struct async_op *aop);
+int subscribe_daemon_received(struct async_op *aop);
+int subscribe_daemon_failed(struct async_op *aop);
+void subscribe_daemon_close(sock_t fd);
+void subscribe_daemon_forget(uint64_t id);
+void subscribe_daemon_publish(uint64_t id, uid_t uid, pid_t pid, uint32_t status, uint64_t exec_time, uint64_t latency, const char *outdata, size_t outdata_len);
+
+#endif
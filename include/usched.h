@@ -33,33 +33,50 @@
 #include "entry.h"
 
 /* Components - Human */
+#define USCHED_COMPONENT_ACCEPT_STR	"accept"
 #define USCHED_COMPONENT_AUTH_STR	"auth"
 #define USCHED_COMPONENT_BIND_STR	"bind"
 #define USCHED_COMPONENT_BLACKLIST_STR	"blacklist"
+#define USCHED_COMPONENT_CHILDREN_STR	"children"
+#define USCHED_COMPONENT_CGROUP_STR	"cgroup"
 #define USCHED_COMPONENT_CONN_STR	"conn"
 #define USCHED_COMPONENT_DELTA_STR	"delta"
 #define USCHED_COMPONENT_JAIL_STR	"jail"
 #define USCHED_COMPONENT_LOCAL_STR	"local"
 #define USCHED_COMPONENT_ID_STR		"id"
 #define USCHED_COMPONENT_MSG_STR	"msg"
+#define USCHED_COMPONENT_OUTPUT_STR	"output"
 #define USCHED_COMPONENT_PRIVDROP_STR	"privdrop"
+#define USCHED_COMPONENT_QUEUE_STR	"queue"
+#define USCHED_COMPONENT_QUOTA_STR	"quota"
+#define USCHED_COMPONENT_RATE_STR	"rate"
 #define USCHED_COMPONENT_REMOTE_STR	"remote"
 #define USCHED_COMPONENT_REPORT_STR	"report"
+#define USCHED_COMPONENT_RETRY_STR	"retry"
 #define USCHED_COMPONENT_SERIALIZE_STR	"serialize"
 #define USCHED_COMPONENT_SOCK_STR	"sock"
+#define USCHED_COMPONENT_SPOOL_STR	"spool"
+#define USCHED_COMPONENT_SPILL_STR	"spill"
 #define USCHED_COMPONENT_THREAD_STR	"thread"
 #define USCHED_COMPONENT_WHITELIST_STR	"whitelist"
 
 /* Properties - Human */
 #define USCHED_PROPERTY_ADDR_STR	"addr"
+#define USCHED_PROPERTY_BURST_STR	"burst"
+#define USCHED_PROPERTY_CPU_STR		"cpu"
+#define USCHED_PROPERTY_DELAY_STR	"delay"
+#define USCHED_PROPERTY_DEPTH_STR	"depth"
 #define USCHED_PROPERTY_DIR_STR		"dir"
+#define USCHED_PROPERTY_ENTRIES_STR	"entries"
 #define USCHED_PROPERTY_FILE_STR	"file"
 #define USCHED_PROPERTY_FREQ_STR	"freq"
 #define USCHED_PROPERTY_GID_STR		"gid"
 #define USCHED_PROPERTY_GROUP_STR	"group"
+#define USCHED_PROPERTY_IO_STR		"io"
 #define USCHED_PROPERTY_KEY_STR		"key"
 #define USCHED_PROPERTY_LIMIT_STR	"limit"
 #define USCHED_PROPERTY_MAX_STR		"max"
+#define USCHED_PROPERTY_MEMORY_STR	"memory"
 #define USCHED_PROPERTY_MODE_STR	"mode"
 #define USCHED_PROPERTY_NAME_STR	"name"
 #define USCHED_PROPERTY_NOEXEC_STR	"noexec"
@@ -68,6 +85,7 @@
 #define USCHED_PROPERTY_RELOAD_STR	"reload"
 #define USCHED_PROPERTY_SIZE_STR	"size"
 #define USCHED_PROPERTY_TIMEOUT_STR	"timeout"
+#define USCHED_PROPERTY_TRANSPORT_STR	"transport"
 #define USCHED_PROPERTY_UID_STR		"uid"
 #define USCHED_PROPERTY_USE_STR		"use"
 #define USCHED_PROPERTY_USER_STR	"user"
@@ -89,6 +107,7 @@
 #define USCHED_OP_STOP_STR		"stop"
 #define USCHED_OP_SHOW_STR		"show"
 #define USCHED_OP_HOLD_STR		"hold"
+#define USCHED_OP_SUBSCRIBE_STR		"subscribe"
 #define USCHED_OP_ADD_STR		"add"
 #define USCHED_OP_DELETE_STR		"delete"
 #define USCHED_OP_CHANGE_STR		"change"
@@ -130,9 +149,48 @@
 #define USCHED_CONJ_UNTIL_STR		"until"
 #define USCHED_CONJ_WHILE_STR		"while"
 
+/* Overlap policies - Human */
+#define USCHED_OVERLAP_ALLOW_STR	"allow"
+#define USCHED_OVERLAP_SKIP_STR		"skip"
+#define USCHED_OVERLAP_QUEUE_STR	"queue"
+#define USCHED_OVERLAP_KILL_STR		"kill"
+
+/* Execution modes - Human */
+#define USCHED_MODE_SHELL_STR		"shell"
+#define USCHED_MODE_DIRECT_STR		"direct"
+
+/* cgroup grouping of executions - Human */
+#define USCHED_CGROUP_GROUP_UID_STR	"uid"
+#define USCHED_CGROUP_GROUP_CLASS_STR	"class"
+
+/* Priority classes - Human */
+#define USCHED_PRIORITY_NORMAL_STR	"normal"
+#define USCHED_PRIORITY_HIGH_STR	"high"
+#define USCHED_PRIORITY_LOW_STR		"low"
+
 /* Subject - Human */
 #define USCHED_SUBJ_ALL_STR		"all"
 
+/* Entry fields - Human */
+#define USCHED_FIELD_ALL_STR		"all"
+#define USCHED_FIELD_ID_STR		"id"
+#define USCHED_FIELD_FLAGS_STR		"flags"
+#define USCHED_FIELD_UID_STR		"uid"
+#define USCHED_FIELD_GID_STR		"gid"
+#define USCHED_FIELD_TRIGGER_STR	"trigger"
+#define USCHED_FIELD_STEP_STR		"step"
+#define USCHED_FIELD_EXPIRE_STR		"expire"
+#define USCHED_FIELD_OVERLAP_STR	"overlap"
+#define USCHED_FIELD_CONCURRENCY_STR	"concurrency"
+#define USCHED_FIELD_PRIORITY_STR	"priority"
+#define USCHED_FIELD_PID_STR		"pid"
+#define USCHED_FIELD_STATUS_STR		"status"
+#define USCHED_FIELD_EXEC_TIME_STR	"exectime"
+#define USCHED_FIELD_LATENCY_STR	"latency"
+#define USCHED_FIELD_OUTDATA_STR	"output"
+#define USCHED_FIELD_USERNAME_STR	"username"
+#define USCHED_FIELD_SUBJ_STR		"command"
+
 /* Weekdays - Human */
 #define USCHED_WEEKDAY_MONDAY_STR	"monday"
 #define USCHED_WEEKDAY_TUESDAY_STR	"tuesday"
@@ -164,7 +222,8 @@ typedef enum OP {
 	USCHED_OP_DELETE,	/* Used by administration tools only */
 	USCHED_OP_CHANGE,	/* Used by administration tools only */
 	USCHED_OP_COMMIT,	/* Used by administration tools only */
-	USCHED_OP_ROLLBACK	/* Used by administration tools only */
+	USCHED_OP_ROLLBACK,	/* Used by administration tools only */
+	USCHED_OP_SUBSCRIBE
 } usched_op_t;
 
 /* Prepositions - Machine */
@@ -219,7 +278,9 @@ typedef enum WEEKDAY {
 /* uSched request flags */
 typedef enum USCHED_REQUEST_FLAGS {
 	USCHED_REQ_FLAG_MONTHDAY_ALIGN = 1,
-	USCHED_REQ_FLAG_YEARDAY_ALIGN
+	USCHED_REQ_FLAG_YEARDAY_ALIGN,
+	USCHED_REQ_FLAG_EXEC_SHELL,	/* Subject is always executed by the shell */
+	USCHED_REQ_FLAG_EXEC_DIRECT	/* Subject is always executed without a shell */
 } usched_request_flag_t;
 
 /* uSched Admin Request Structure */
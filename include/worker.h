@@ -0,0 +1,122 @@
+/**
+ * @file worker.h
+ * @brief uSched
+ *        Executer worker pool interface header
+ *
+ * Date: 18-10-2026
+ * 
+ * Copyright 2014-2015 Pedro A. Hortas (pah@ucodev.org)
+ *
+ * This file is part of usched.
+ *
+ * usched is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * usched is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with usched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef USCHED_WORKER_H
+#define USCHED_WORKER_H
+
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+
+#include <sys/types.h>
+
+#include "config.h"
+
+/* Type definitions */
+typedef enum WORKER_TASK_TYPE {
+	WORKER_TASK_LAUNCH = 1,		/* Fork and execute a command */
+	WORKER_TASK_COMPLETE		/* Process the exit of a child */
+} usched_worker_task_type_t;
+
+typedef enum REAP_EVENT_TYPE {
+	REAP_EVENT_EXIT = 1,		/* Process descriptor of a child is readable */
+	REAP_EVENT_OUTPUT,		/* Output pipe of a child is readable */
+	REAP_EVENT_SIGNAL		/* SIGCHLD is pending */
+} usched_reap_event_type_t;
+
+/* Structures */
+struct usched_exec_task;
+
+struct usched_reap_event {
+	struct usched_exec_task *task;
+	usched_reap_event_type_t type;
+};
+
+struct usched_exec_task {
+	usched_worker_task_type_t type;
+	char *buf;			/* | struct ipc_use_hdr | cmd (...) ... | (NULL for placeholders) */
+	pid_t pid;
+	int status;			/* Exit status, as reported by waitpid() */
+	int exited;			/* Exit status was collected */
+	int ofd;			/* Read end of the child output pipe (-1 if none) */
+	int pidfd;			/* Process descriptor of the child (-1 if none) */
+	struct timespec t_start;
+	struct timespec t_end;
+
+	/* Output capture. The first bytes are kept in outdata and the last ones in the outtail
+	 * ring. Both are joined into outdata when the child exits.
+	 */
+	size_t outlen;			/* Bytes kept in outdata */
+	size_t head_max;		/* Max bytes kept from the start of the output */
+	size_t tail_max;		/* Max bytes kept from the end of the output */
+	size_t tail_len;		/* Bytes kept in outtail */
+	size_t tail_pos;		/* Next write position of outtail */
+	uint64_t outtotal;		/* Bytes written by the child */
+	uint64_t outdropped;		/* Bytes left out of outdata */
+	char outdata[CONFIG_USCHED_EXEC_OUTPUT_MAX];
+	char outtail[CONFIG_USCHED_EXEC_OUTPUT_MAX];
+
+	int sfd;			/* Spool file with the full output (-1 if none) */
+	uint64_t spool_max;		/* Max bytes written to the spool file (0 for no limit) */
+	uint64_t spooled;		/* Bytes written to the spool file */
+
+	/* Resource accounting of the execution cgroup (cgroup.c) */
+	int cgfd;			/* Directory of the execution cgroup (-1 if none) */
+	char cgname[CONFIG_USCHED_EXEC_CGROUP_NAME_MAX]; /* Relative to exec.cgroup.dir */
+	uint64_t cpu_usec;		/* CPU time used by the execution, in microseconds */
+	uint64_t mem_peak;		/* Peak memory usage of the execution, in bytes */
+
+	struct usched_reap_event ev_exit;
+	struct usched_reap_event ev_out;
+
+	struct usched_exec_task *next;	/* Children table chaining (reap.c) */
+};
+
+/*
+ * Each worker owns a deque of tasks. The owner pushes and pops at the bottom, so the most
+ * recent (and cache hot) task is the next one it runs. Idle workers steal from the top of
+ * the other deques, taking the oldest tasks first.
+ */
+struct usched_worker {
+	pthread_t tid;
+	unsigned int index;
+
+	pthread_mutex_t mutex;
+	struct usched_exec_task **tasks;	/* Circular buffer */
+	size_t size;				/* Allocated slots (power of 2) */
+	size_t top;				/* Steal end */
+	size_t bottom;				/* Owner end */
+
+	uint64_t executed;			/* Tasks run by this worker */
+	uint64_t stolen;			/* Tasks taken from other workers */
+};
+
+/* Prototypes */
+int worker_exec_init(void (*routine) (struct usched_exec_task *));
+void worker_exec_destroy(void);
+int worker_exec_submit(struct usched_exec_task *task);
+
+#endif
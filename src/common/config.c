@@ -27,6 +27,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <errno.h>
 
 #include <sys/types.h>
@@ -42,6 +43,7 @@
 #include "mm.h"
 #include "log.h"
 #include "str.h"
+#include "usched.h"
 
 
 static int _list_uint_compare(const void *d1, const void *d2) {
@@ -405,6 +407,30 @@ static int _config_validate_auth_remote_users(const struct usched_config_auth *a
 	return (auth->remote_users == 0) || (auth->remote_users == 1);
 }
 
+static int _config_init_auth_rate_limit(struct usched_config_auth *auth) {
+	return _value_init_uint_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_AUTH "/" CONFIG_USCHED_FILE_AUTH_RATE_LIMIT, &auth->rate_limit);
+}
+
+static int _config_validate_auth_rate_limit(const struct usched_config_auth *auth) {
+	return auth->rate_limit <= CONFIG_USCHED_AUTH_RATE_LIMIT_MAX;
+}
+
+static int _config_init_auth_rate_burst(struct usched_config_auth *auth) {
+	return _value_init_uint_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_AUTH "/" CONFIG_USCHED_FILE_AUTH_RATE_BURST, &auth->rate_burst);
+}
+
+static int _config_validate_auth_rate_burst(const struct usched_config_auth *auth) {
+	return auth->rate_burst && (auth->rate_burst <= CONFIG_USCHED_AUTH_RATE_BURST_MAX);
+}
+
+static int _config_init_auth_quota_entries(struct usched_config_auth *auth) {
+	return _value_init_uint_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_AUTH "/" CONFIG_USCHED_FILE_AUTH_QUOTA_ENTRIES, &auth->quota_entries);
+}
+
+static int _config_validate_auth_quota_entries(const struct usched_config_auth *auth) {
+	return auth->quota_entries <= CONFIG_USCHED_AUTH_QUOTA_ENTRIES_MAX;
+}
+
 int config_init_auth(struct usched_config_auth *auth) {
 	int errsv = 0;
 
@@ -498,6 +524,51 @@ int config_init_auth(struct usched_config_auth *auth) {
 		return -1;
 	}
 
+	/* Read rate limit */
+	if (_config_init_auth_rate_limit(auth) < 0) {
+		errsv = errno;
+		log_warn("_config_init_auth(): _config_init_auth_rate_limit(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate rate limit */
+	if (!_config_validate_auth_rate_limit(auth)) {
+		log_warn("_config_init_auth(): _config_validate_auth_rate_limit(): Invalid auth.rate.limit value.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Read rate burst */
+	if (_config_init_auth_rate_burst(auth) < 0) {
+		errsv = errno;
+		log_warn("_config_init_auth(): _config_init_auth_rate_burst(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate rate burst */
+	if (!_config_validate_auth_rate_burst(auth)) {
+		log_warn("_config_init_auth(): _config_validate_auth_rate_burst(): Invalid auth.rate.burst value.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Read quota entries */
+	if (_config_init_auth_quota_entries(auth) < 0) {
+		errsv = errno;
+		log_warn("_config_init_auth(): _config_init_auth_quota_entries(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate quota entries */
+	if (!_config_validate_auth_quota_entries(auth)) {
+		log_warn("_config_init_auth(): _config_validate_auth_quota_entries(): Invalid auth.quota.entries value.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
 	/* Success */
 	return 0;
 }
@@ -722,6 +793,155 @@ static int _config_validate_exec_delta_noexec(const struct usched_config_exec *e
 	return exec->delta_noexec != 0;
 }
 
+static int _config_init_exec_retry_depth(struct usched_config_exec *exec) {
+	return _value_init_uint_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_RETRY_DEPTH, &exec->retry_depth);
+}
+
+static int _config_validate_exec_retry_depth(const struct usched_config_exec *exec) {
+	return exec->retry_depth <= CONFIG_USCHED_EXEC_RETRY_DEPTH_MAX;
+}
+
+static int _config_init_exec_retry_delay(struct usched_config_exec *exec) {
+	return _value_init_uint_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_RETRY_DELAY, &exec->retry_delay);
+}
+
+static int _config_validate_exec_retry_delay(const struct usched_config_exec *exec) {
+	return exec->retry_delay && (exec->retry_delay < exec->delta_noexec);
+}
+
+static int _config_init_exec_spill_use(struct usched_config_exec *exec) {
+	return _value_init_uint_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_SPILL_USE, &exec->spill_use);
+}
+
+static int _config_validate_exec_spill_use(const struct usched_config_exec *exec) {
+	return (exec->spill_use == 0) || (exec->spill_use == 1);
+}
+
+static int _config_init_exec_spill_file(struct usched_config_exec *exec) {
+	if (!(exec->spill_file = _value_init_string_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_SPILL_FILE)))
+		return -1;
+
+	return 0;
+}
+
+static int _config_validate_exec_spill_file(const struct usched_config_exec *exec) {
+	return exec->spill_file[0] == '/';
+}
+
+static int _config_init_exec_children_max(struct usched_config_exec *exec) {
+	return _value_init_uint_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_CHILDREN_MAX, &exec->children_max);
+}
+
+static int _config_validate_exec_children_max(const struct usched_config_exec *exec) {
+	return exec->children_max && (exec->children_max <= CONFIG_USCHED_EXEC_CHILDREN_MAX);
+}
+
+static int _config_init_exec_queue_depth(struct usched_config_exec *exec) {
+	return _value_init_uint_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_QUEUE_DEPTH, &exec->queue_depth);
+}
+
+static int _config_validate_exec_queue_depth(const struct usched_config_exec *exec) {
+	return exec->queue_depth <= CONFIG_USCHED_EXEC_QUEUE_DEPTH_MAX;
+}
+
+static int _config_init_exec_thread_workers(struct usched_config_exec *exec) {
+	return _value_init_uint_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_THREAD_WORKERS, &exec->thread_workers);
+}
+
+static int _config_validate_exec_thread_workers(const struct usched_config_exec *exec) {
+	return exec->thread_workers && (exec->thread_workers <= CONFIG_USCHED_EXEC_WORKERS_MAX);
+}
+
+static int _config_init_exec_output_max(struct usched_config_exec *exec) {
+	return _value_init_uint_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_OUTPUT_MAX, &exec->output_max);
+}
+
+static int _config_validate_exec_output_max(const struct usched_config_exec *exec) {
+	return exec->output_max && (exec->output_max < CONFIG_USCHED_EXEC_OUTPUT_MAX);
+}
+
+static int _config_init_exec_spool_use(struct usched_config_exec *exec) {
+	return _value_init_uint_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_SPOOL_USE, &exec->spool_use);
+}
+
+static int _config_validate_exec_spool_use(const struct usched_config_exec *exec) {
+	return (exec->spool_use == 0) || (exec->spool_use == 1);
+}
+
+static int _config_init_exec_spool_dir(struct usched_config_exec *exec) {
+	if (!(exec->spool_dir = _value_init_string_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_SPOOL_DIR)))
+		return -1;
+
+	return 0;
+}
+
+static int _config_validate_exec_spool_dir(const struct usched_config_exec *exec) {
+	return exec->spool_dir[0] == '/';
+}
+
+static int _config_init_exec_spool_max(struct usched_config_exec *exec) {
+	return _value_init_uint_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_SPOOL_MAX, &exec->spool_max);
+}
+
+static int _config_validate_exec_spool_max(const struct usched_config_exec *exec) {
+	/* Any size is valid. 0 means no limit. */
+	return 1;
+}
+
+static int _config_init_exec_cgroup_use(struct usched_config_exec *exec) {
+	return _value_init_uint_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_CGROUP_USE, &exec->cgroup_use);
+}
+
+static int _config_validate_exec_cgroup_use(const struct usched_config_exec *exec) {
+	return (exec->cgroup_use == 0) || (exec->cgroup_use == 1);
+}
+
+static int _config_init_exec_cgroup_dir(struct usched_config_exec *exec) {
+	if (!(exec->cgroup_dir = _value_init_string_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_CGROUP_DIR)))
+		return -1;
+
+	return 0;
+}
+
+static int _config_validate_exec_cgroup_dir(const struct usched_config_exec *exec) {
+	return exec->cgroup_dir[0] == '/';
+}
+
+static int _config_init_exec_cgroup_group(struct usched_config_exec *exec) {
+	if (!(exec->cgroup_group = _value_init_string_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_CGROUP_GROUP)))
+		return -1;
+
+	return 0;
+}
+
+static int _config_validate_exec_cgroup_group(const struct usched_config_exec *exec) {
+	return !strcmp(exec->cgroup_group, USCHED_CGROUP_GROUP_UID_STR) || !strcmp(exec->cgroup_group, USCHED_CGROUP_GROUP_CLASS_STR);
+}
+
+static int _config_init_exec_cgroup_cpu(struct usched_config_exec *exec) {
+	return _value_init_uint_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_CGROUP_CPU, &exec->cgroup_cpu);
+}
+
+static int _config_validate_exec_cgroup_cpu(const struct usched_config_exec *exec) {
+	return (exec->cgroup_cpu >= 1) && (exec->cgroup_cpu <= 10000);
+}
+
+static int _config_init_exec_cgroup_memory(struct usched_config_exec *exec) {
+	return _value_init_uint_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_CGROUP_MEMORY, &exec->cgroup_memory);
+}
+
+static int _config_validate_exec_cgroup_memory(const struct usched_config_exec *exec) {
+	return 1;
+}
+
+static int _config_init_exec_cgroup_io(struct usched_config_exec *exec) {
+	return _value_init_uint_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_CGROUP_IO, &exec->cgroup_io);
+}
+
+static int _config_validate_exec_cgroup_io(const struct usched_config_exec *exec) {
+	return (exec->cgroup_io >= 1) && (exec->cgroup_io <= 10000);
+}
+
 int config_init_exec(struct usched_config_exec *exec) {
 	int errsv = 0;
 
@@ -740,6 +960,261 @@ int config_init_exec(struct usched_config_exec *exec) {
 		return -1;
 	}
 
+	/* Read retry depth */
+	if (_config_init_exec_retry_depth(exec) < 0) {
+		errsv = errno;
+		log_warn("_config_init_exec(): _config_init_exec_retry_depth(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate retry depth */
+	if (!_config_validate_exec_retry_depth(exec)) {
+		log_warn("_config_init_exec(): _config_validate_exec_retry_depth(): Invalid exec.retry.depth value.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Read retry delay */
+	if (_config_init_exec_retry_delay(exec) < 0) {
+		errsv = errno;
+		log_warn("_config_init_exec(): _config_init_exec_retry_delay(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate retry delay */
+	if (!_config_validate_exec_retry_delay(exec)) {
+		log_warn("_config_init_exec(): _config_validate_exec_retry_delay(): Invalid exec.retry.delay value.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Read spill use */
+	if (_config_init_exec_spill_use(exec) < 0) {
+		errsv = errno;
+		log_warn("_config_init_exec(): _config_init_exec_spill_use(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate spill use */
+	if (!_config_validate_exec_spill_use(exec)) {
+		log_warn("_config_init_exec(): _config_validate_exec_spill_use(): Invalid exec.spill.use value.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Read spill file */
+	if (_config_init_exec_spill_file(exec) < 0) {
+		errsv = errno;
+		log_warn("_config_init_exec(): _config_init_exec_spill_file(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate spill file */
+	if (!_config_validate_exec_spill_file(exec)) {
+		log_warn("_config_init_exec(): _config_validate_exec_spill_file(): Invalid exec.spill.file value.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Read children max */
+	if (_config_init_exec_children_max(exec) < 0) {
+		errsv = errno;
+		log_warn("_config_init_exec(): _config_init_exec_children_max(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate children max */
+	if (!_config_validate_exec_children_max(exec)) {
+		log_warn("_config_init_exec(): _config_validate_exec_children_max(): Invalid exec.children.max value.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Read queue depth */
+	if (_config_init_exec_queue_depth(exec) < 0) {
+		errsv = errno;
+		log_warn("_config_init_exec(): _config_init_exec_queue_depth(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate queue depth */
+	if (!_config_validate_exec_queue_depth(exec)) {
+		log_warn("_config_init_exec(): _config_validate_exec_queue_depth(): Invalid exec.queue.depth value.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Read thread workers */
+	if (_config_init_exec_thread_workers(exec) < 0) {
+		errsv = errno;
+		log_warn("_config_init_exec(): _config_init_exec_thread_workers(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate thread workers */
+	if (!_config_validate_exec_thread_workers(exec)) {
+		log_warn("_config_init_exec(): _config_validate_exec_thread_workers(): Invalid exec.thread.workers value.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Read output max */
+	if (_config_init_exec_output_max(exec) < 0) {
+		errsv = errno;
+		log_warn("_config_init_exec(): _config_init_exec_output_max(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate output max */
+	if (!_config_validate_exec_output_max(exec)) {
+		log_warn("_config_init_exec(): _config_validate_exec_output_max(): Invalid exec.output.max value.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Read spool use */
+	if (_config_init_exec_spool_use(exec) < 0) {
+		errsv = errno;
+		log_warn("_config_init_exec(): _config_init_exec_spool_use(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate spool use */
+	if (!_config_validate_exec_spool_use(exec)) {
+		log_warn("_config_init_exec(): _config_validate_exec_spool_use(): Invalid exec.spool.use value.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Read spool dir */
+	if (_config_init_exec_spool_dir(exec) < 0) {
+		errsv = errno;
+		log_warn("_config_init_exec(): _config_init_exec_spool_dir(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate spool dir */
+	if (!_config_validate_exec_spool_dir(exec)) {
+		log_warn("_config_init_exec(): _config_validate_exec_spool_dir(): Invalid exec.spool.dir value.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Read spool max */
+	if (_config_init_exec_spool_max(exec) < 0) {
+		errsv = errno;
+		log_warn("_config_init_exec(): _config_init_exec_spool_max(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate spool max */
+	if (!_config_validate_exec_spool_max(exec)) {
+		log_warn("_config_init_exec(): _config_validate_exec_spool_max(): Invalid exec.spool.max value.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Read cgroup use */
+	if (_config_init_exec_cgroup_use(exec) < 0) {
+		errsv = errno;
+		log_warn("_config_init_exec(): _config_init_exec_cgroup_use(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate cgroup use */
+	if (!_config_validate_exec_cgroup_use(exec)) {
+		log_warn("_config_init_exec(): _config_validate_exec_cgroup_use(): Invalid exec.cgroup.use value.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Read cgroup dir */
+	if (_config_init_exec_cgroup_dir(exec) < 0) {
+		errsv = errno;
+		log_warn("_config_init_exec(): _config_init_exec_cgroup_dir(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate cgroup dir */
+	if (!_config_validate_exec_cgroup_dir(exec)) {
+		log_warn("_config_init_exec(): _config_validate_exec_cgroup_dir(): Invalid exec.cgroup.dir value.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Read cgroup group */
+	if (_config_init_exec_cgroup_group(exec) < 0) {
+		errsv = errno;
+		log_warn("_config_init_exec(): _config_init_exec_cgroup_group(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate cgroup group */
+	if (!_config_validate_exec_cgroup_group(exec)) {
+		log_warn("_config_init_exec(): _config_validate_exec_cgroup_group(): Invalid exec.cgroup.group value.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Read cgroup cpu */
+	if (_config_init_exec_cgroup_cpu(exec) < 0) {
+		errsv = errno;
+		log_warn("_config_init_exec(): _config_init_exec_cgroup_cpu(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate cgroup cpu */
+	if (!_config_validate_exec_cgroup_cpu(exec)) {
+		log_warn("_config_init_exec(): _config_validate_exec_cgroup_cpu(): Invalid exec.cgroup.cpu value.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Read cgroup memory */
+	if (_config_init_exec_cgroup_memory(exec) < 0) {
+		errsv = errno;
+		log_warn("_config_init_exec(): _config_init_exec_cgroup_memory(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate cgroup memory */
+	if (!_config_validate_exec_cgroup_memory(exec)) {
+		log_warn("_config_init_exec(): _config_validate_exec_cgroup_memory(): Invalid exec.cgroup.memory value.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Read cgroup io */
+	if (_config_init_exec_cgroup_io(exec) < 0) {
+		errsv = errno;
+		log_warn("_config_init_exec(): _config_init_exec_cgroup_io(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate cgroup io */
+	if (!_config_validate_exec_cgroup_io(exec)) {
+		log_warn("_config_init_exec(): _config_validate_exec_cgroup_io(): Invalid exec.cgroup.io value.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
 	/* Success */
 	return 0;
 }
@@ -798,6 +1273,24 @@ static int _config_validate_ipc_msg_size(const struct usched_config_ipc *ipc) {
 	return ipc->msg_size > 0;
 }
 
+static int _config_init_ipc_msg_transport(struct usched_config_ipc *ipc) {
+	if (!(ipc->msg_transport = _value_init_string_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_IPC "/" CONFIG_USCHED_FILE_IPC_MSG_TRANSPORT)))
+		return -1;
+
+	return 0;
+}
+
+static int _config_validate_ipc_msg_transport(const struct usched_config_ipc *ipc) {
+	if (!strcmp(ipc->msg_transport, CONFIG_USCHED_IPC_TRANSPORT_PIPC))
+		return 1;
+
+	/* Each message is stored in a single ring slot. The number of slots is a power of two. */
+	if (!strcmp(ipc->msg_transport, CONFIG_USCHED_IPC_TRANSPORT_SHM))
+		return !(ipc->msg_max & (ipc->msg_max - 1)) && (ipc->msg_max <= CONFIG_USCHED_IPC_SHM_SLOTS_MAX) && (ipc->msg_size <= UINT32_MAX);
+
+	return 0;
+}
+
 static int _config_init_ipc_jail_dir(struct usched_config_ipc *ipc) {
 	if (!(ipc->jail_dir = _value_init_string_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_IPC "/" CONFIG_USCHED_FILE_IPC_JAIL_DIR)))
 		return -1;
@@ -920,6 +1413,23 @@ int config_init_ipc(struct usched_config_ipc *ipc) {
 		return -1;
 	}
 
+	/* Read msg transport */
+	if (_config_init_ipc_msg_transport(ipc) < 0) {
+		errsv = errno;
+		log_warn("_config_init_ipc(): _config_init_ipc_msg_transport(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate msg transport */
+	if (!_config_validate_ipc_msg_transport(ipc)) {
+		log_warn("_config_init_ipc(): _config_validate_ipc_msg_transport(): Invalid ipc.msg.transport value, or ipc.msg.max and ipc.msg.size not supported by it (shm requires a power of two ipc.msg.max).\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	ipc->transport_shm = !strcmp(ipc->msg_transport, CONFIG_USCHED_IPC_TRANSPORT_SHM);
+
 	/* Read the jail directory */
 	if (_config_init_ipc_jail_dir(ipc) < 0) {
 		errsv = errno;
@@ -1052,6 +1562,14 @@ static int _config_validate_network_sock_name(const struct usched_config_network
 	return 1;
 }
 
+static int _config_init_network_accept_workers(struct usched_config_network *network) {
+	return _value_init_uint_from_file(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_NETWORK "/" CONFIG_USCHED_FILE_NETWORK_ACCEPT_WORKERS, &network->accept_workers);
+}
+
+static int _config_validate_network_accept_workers(const struct usched_config_network *network) {
+	return network->accept_workers && (network->accept_workers <= CONFIG_USCHED_NET_ACCEPT_WORKERS_MAX);
+}
+
 int config_init_network(struct usched_config_network *network) {
 	int errsv = 0;
 
@@ -1130,6 +1648,21 @@ int config_init_network(struct usched_config_network *network) {
 		return -1;
 	}
 
+	/* Read accept workers */
+	if (_config_init_network_accept_workers(network) < 0) {
+		errsv = errno;
+		log_warn("_config_init_network(): _config_init_network_accept_workers(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate accept workers */
+	if (!_config_validate_network_accept_workers(network)) {
+		log_warn("_config_init_network(): _config_validate_network_accept_workers(): Invalid network.accept.workers value.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
 	/* Success */
 	return 0;
 }
@@ -1602,6 +2135,15 @@ void config_destroy_core(struct usched_config_core *core) {
 }
 
 void config_destroy_exec(struct usched_config_exec *exec) {
+	memset(exec->spill_file, 0, strlen(exec->spill_file));
+	mm_free(exec->spill_file);
+	memset(exec->cgroup_group, 0, strlen(exec->cgroup_group));
+	mm_free(exec->cgroup_group);
+	memset(exec->cgroup_dir, 0, strlen(exec->cgroup_dir));
+	mm_free(exec->cgroup_dir);
+	memset(exec->spool_dir, 0, strlen(exec->spool_dir));
+	mm_free(exec->spool_dir);
+
 	memset(exec, 0, sizeof(struct usched_config_exec));
 }
 
@@ -1610,6 +2152,8 @@ void config_destroy_ipc(struct usched_config_ipc *ipc) {
 	mm_free(ipc->auth_key);
 	memset(ipc->id_name, 0, strlen(ipc->id_name));
 	mm_free(ipc->id_name);
+	memset(ipc->msg_transport, 0, strlen(ipc->msg_transport));
+	mm_free(ipc->msg_transport);
 	memset(ipc->jail_dir, 0, strlen(ipc->jail_dir));
 	mm_free(ipc->jail_dir);
 	memset(ipc->privdrop_user, 0, strlen(ipc->privdrop_user));
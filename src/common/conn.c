@@ -158,3 +158,62 @@ ssize_t conn_write_blocking(sock_t fd, const void *buf, size_t count) {
 	return count - count_local;
 }
 
+ssize_t conn_writev_blocking(sock_t fd, struct iovec *iov, int iovcnt) {
+	int errsv = 0;
+	ssize_t len = 0, count = 0;
+#ifdef COMPILE_WIN32
+	int i = 0;
+
+	/* No vectored I/O available. Write each buffer in turn. */
+	for (i = 0; i < iovcnt; i ++) {
+		if ((len = conn_write_blocking(fd, iov[i].iov_base, iov[i].iov_len)) < 0)
+			return -1;
+
+		count += len;
+
+		if ((size_t) len != iov[i].iov_len)
+			break;
+	}
+#else
+	/* Send all the buffers in place, without gathering them into a contiguous one first.
+	 * NOTE: The contents of 'iov' are modified to track partial writes.
+	 */
+	while (iovcnt) {
+		len = writev(fd, iov, iovcnt);
+
+		/* EOF ? */
+		if (!len)
+			break;
+
+		/* Check for errors */
+		if (len < 0) {
+			if (errno == EINTR)
+				continue;
+
+			errsv = errno;
+			log_warn("conn_writev_blocking(): writev(): %s\n", strerror(errno));
+			errno = errsv;
+			return -1;
+		}
+
+		count += len;
+
+		/* Skip the buffers that were completely written */
+		while (iovcnt && ((size_t) len >= iov->iov_len)) {
+			len -= iov->iov_len;
+			iov ++;
+			iovcnt --;
+		}
+
+		/* Advance over the partially written buffer, if any */
+		if (iovcnt) {
+			iov->iov_base = ((char *) iov->iov_base) + len;
+			iov->iov_len -= len;
+		}
+	}
+#endif
+
+	debug_printf(DEBUG_INFO, "conn_writev_blocking(): %zd.\n", count);
+
+	return count;
+}
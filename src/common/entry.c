@@ -54,6 +54,30 @@ void entry_cleanup_crypto(struct usched_entry *entry) {
 	memset(&entry->crypto, 0, sizeof(entry->crypto));
 }
 
+void entry_reject_set(unsigned char *session, usched_entry_reject_t reason) {
+	memset(session, 0, CONFIG_USCHED_AUTH_SESSION_MAX);
+	memcpy(session, USCHED_ENTRY_REJECT_MAGIC, USCHED_ENTRY_REJECT_MAGIC_SIZE);
+	memcpy(session + USCHED_ENTRY_REJECT_MAGIC_SIZE, (uint32_t [1]) { htonl((uint32_t) reason) }, 4);
+}
+
+usched_entry_reject_t entry_reject_get(const unsigned char *session) {
+	size_t i = 0;
+	uint32_t reason = 0;
+
+	if (memcmp(session, USCHED_ENTRY_REJECT_MAGIC, USCHED_ENTRY_REJECT_MAGIC_SIZE))
+		return USCHED_ENTRY_REJECT_NONE;
+
+	/* A genuine session never matches the whole rejection layout */
+	for (i = USCHED_ENTRY_REJECT_MAGIC_SIZE + 4; i < CONFIG_USCHED_AUTH_SESSION_MAX; i ++) {
+		if (session[i])
+			return USCHED_ENTRY_REJECT_NONE;
+	}
+
+	memcpy(&reason, session + USCHED_ENTRY_REJECT_MAGIC_SIZE, 4);
+
+	return (usched_entry_reject_t) ntohl(reason);
+}
+
 void entry_update_signature(struct usched_entry *entry) {
 	psec_low_hash_t context;
 
@@ -85,6 +109,56 @@ int entry_check_signature(struct usched_entry *entry) {
 	return !memcmp(entry->signature, signature, sizeof(signature));
 }
 
+#if KE_KEY_SIZE_CHREKE != CONFIG_USCHED_AUTH_TICKET_SIZE || HASH_DIGEST_SIZE_BLAKE2S != CONFIG_USCHED_AUTH_TICKET_SIZE
+ #error "Session tickets require KE_KEY_SIZE_CHREKE and HASH_DIGEST_SIZE_BLAKE2S to match CONFIG_USCHED_AUTH_TICKET_SIZE."
+#endif
+
+int entry_ticket_derive(const struct usched_entry *entry, unsigned char *ticket_id, unsigned char *ticket_key) {
+	psec_low_hash_t context;
+
+	/* Both parties derive the ticket from the key agreed on a full authentication exchange, so
+	 * the ticket itself is never transmitted.
+	 */
+	hash_low_blake2s_init(&context);
+	hash_low_blake2s_update(&context, entry->crypto.agreed_key, sizeof(entry->crypto.agreed_key));
+	hash_low_blake2s_update(&context, (unsigned char *) "usched.ticket.id", 16);
+	hash_low_blake2s_final(&context, ticket_id);
+
+	hash_low_blake2s_init(&context);
+	hash_low_blake2s_update(&context, entry->crypto.agreed_key, sizeof(entry->crypto.agreed_key));
+	hash_low_blake2s_update(&context, (unsigned char *) "usched.ticket.key", 17);
+	hash_low_blake2s_final(&context, ticket_key);
+
+	return 0;
+}
+
+int entry_ticket_session_key(struct usched_entry *entry, const unsigned char *ticket_key, const unsigned char *client_nonce, const unsigned char *server_nonce) {
+	psec_low_hash_t context;
+
+	/* Each resumed request uses its own key, bound to the nonces of both parties */
+	hash_low_blake2s_init(&context);
+	hash_low_blake2s_update(&context, (unsigned char *) ticket_key, CONFIG_USCHED_AUTH_TICKET_SIZE);
+	hash_low_blake2s_update(&context, (unsigned char *) client_nonce, CONFIG_USCHED_AUTH_TICKET_SIZE);
+	hash_low_blake2s_update(&context, (unsigned char *) server_nonce, CONFIG_USCHED_AUTH_TICKET_SIZE);
+	hash_low_blake2s_final(&context, entry->crypto.agreed_key);
+
+	/* Set nonce to 0 */
+	entry->crypto.nonce = 0;
+
+	return 0;
+}
+
+int entry_ticket_session_proof(const struct usched_entry *entry, unsigned char *proof) {
+	psec_low_hash_t context;
+
+	hash_low_blake2s_init(&context);
+	hash_low_blake2s_update(&context, (unsigned char *) entry->crypto.agreed_key, sizeof(entry->crypto.agreed_key));
+	hash_low_blake2s_update(&context, (unsigned char *) "usched.ticket.proof", 19);
+	hash_low_blake2s_final(&context, proof);
+
+	return 0;
+}
+
 void entry_set_id(struct usched_entry *entry, uint32_t id) {
 	entry->id = id;
 }
@@ -96,8 +170,8 @@ void entry_set_flags(struct usched_entry *entry, uint32_t flags) {
 void entry_unset_flags_local(struct usched_entry *entry) {
 	unsigned int n = 0;
 
-	/* Clear all local flags */
-	for (n = USCHED_ENTRY_FLAG_INIT; n < (unsigned int) (sizeof(entry->flags) - 1); n ++)
+	/* Clear all local flags. Remote flags appended after the local ones are preserved. */
+	for (n = USCHED_ENTRY_FLAG_INIT; n <= USCHED_ENTRY_FLAG_REMOVED; n ++)
 		entry_unset_flag(entry, n);
 }
 
@@ -133,6 +207,18 @@ void entry_set_expire(struct usched_entry *entry, time_t expire) {
 	entry->expire = (uint32_t) expire;
 }
 
+void entry_set_overlap(struct usched_entry *entry, usched_entry_overlap_t overlap) {
+	entry->overlap = (uint32_t) overlap;
+}
+
+void entry_set_concurrency(struct usched_entry *entry, unsigned int concurrency) {
+	entry->concurrency = (uint32_t) concurrency;
+}
+
+void entry_set_priority(struct usched_entry *entry, usched_entry_priority_t priority) {
+	entry->priority = (uint32_t) priority;
+}
+
 void entry_set_psize(struct usched_entry *entry, size_t size) {
 	entry->psize = (uint32_t) size;
 }
@@ -204,6 +290,47 @@ int entry_payload_decrypt(struct usched_entry *entry) {
 }
 
 
+int entry_set_payload_decrypt(struct usched_entry *entry, const char *payload, size_t len) {
+	int errsv = 0;
+	unsigned char *payload_dec = NULL;
+	size_t out_len = 0;
+
+	/* Grant that the ciphered payload is, at least, large enough to carry the MAC */
+	if (len < CRYPT_EXTRA_SIZE_CHACHA20POLY1305) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Alloc memory for decrypted payload. Reserve an extra byte for NULL termination. */
+	if (!(payload_dec = mm_alloc(len - CRYPT_EXTRA_SIZE_CHACHA20POLY1305 + 1))) {
+		errsv = errno;
+		log_warn("entry_set_payload_decrypt(): mm_alloc(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Increment nonce */
+	entry->crypto.nonce ++;
+
+	/* Decrypt the payload straight from the source buffer, without an intermediate copy */
+	if (!(crypt_decrypt_chacha20poly1305(payload_dec, &out_len, (const unsigned char *) payload, len, (unsigned char *) (uint64_t [1]) { htonll(entry->crypto.nonce) }, entry->crypto.agreed_key))) {
+		errsv = errno;
+		log_warn("entry_set_payload_decrypt(): crypt_decrypt_chacha20poly1305(): %s\n", strerror(errno));
+		mm_free(payload_dec);
+		errno = errsv;
+		return -1;
+	}
+
+	payload_dec[out_len] = 0;
+
+	/* Set the new payload */
+	entry->payload = (char *) payload_dec;
+	entry->psize = out_len;
+
+	/* All good */
+	return 0;
+}
+
 int entry_payload_encrypt(struct usched_entry *entry, size_t lpad) {
 	int errsv = 0;
 	unsigned char *payload_enc = NULL;
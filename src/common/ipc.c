@@ -26,32 +26,264 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
 #include <errno.h>
+#include <pthread.h>
 
 #include <pipc/pipc.h>
 
 #include "config.h"
 #include "ipc.h"
 #include "log.h"
+#include "mm.h"
+#include "ring.h"
+
+/* Shared memory transport: one single-producer, single-consumer ring per direction */
+static const long _ipc_shm_routes[][2] = {
+	{ IPC_USD_ID, IPC_USE_ID },
+	{ IPC_USE_ID, IPC_USS_ID },
+	{ IPC_USS_ID, IPC_USD_ID },
+	{ IPC_USE_ID, IPC_USD_ID },
+	{ IPC_USD_ID, IPC_USS_ID }
+};
+
+#define IPC_SHM_ROUTES	(sizeof(_ipc_shm_routes) / sizeof(_ipc_shm_routes[0]))
+
+static struct ring *_ipc_shm_rings[IPC_SHM_ROUTES];
+static long _ipc_shm_id = 0;	/* Module using the rings, or 0 if pipc is in use */
+
+/* Detached threads of some modules may still be sending while the rings are detached */
+static pthread_rwlock_t _ipc_shm_rwlock = PTHREAD_RWLOCK_INITIALIZER;
+
+static int _ipc_shm_name(char *name, size_t size, const char *id_name, size_t route) {
+	/* The name is a single path component */
+	if (strchr(id_name, '/')) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (snprintf(name, size, "/usched.%s.%ld.%ld", id_name, _ipc_shm_routes[route][0], _ipc_shm_routes[route][1]) >= (int) size) {
+		errno = ENAMETOOLONG;
+		return -1;
+	}
+
+	return 0;
+}
+
+static struct ring *_ipc_shm_ring(long src_id, long dst_id) {
+	size_t i = 0;
+
+	for (i = 0; i < IPC_SHM_ROUTES; i ++) {
+		if ((_ipc_shm_routes[i][0] == src_id) && (_ipc_shm_routes[i][1] == dst_id) && _ipc_shm_rings[i])
+			return _ipc_shm_rings[i];
+	}
+
+	/* Not attached (anymore) */
+	errno = EIDRM;
+
+	return NULL;
+}
+
+static void _ipc_shm_unlock(void *arg) {
+	pthread_rwlock_unlock(&_ipc_shm_rwlock);
+}
+
+static ssize_t _ipc_shm_send(long src_id, long dst_id, const char *msg, size_t count, int block) {
+	ssize_t ret = -1;
+	struct ring *ring = NULL;
+
+	pthread_rwlock_rdlock(&_ipc_shm_rwlock);
+
+	if ((ring = _ipc_shm_ring(src_id, dst_id)))
+		ret = ring_push(ring, msg, count, block);
+
+	pthread_rwlock_unlock(&_ipc_shm_rwlock);
+
+	return ret;
+}
+
+static ssize_t _ipc_shm_recv(long src_id, long dst_id, char *msg, size_t count, int block) {
+	ssize_t ret = -1;
+	struct ring *ring = NULL;
+
+	pthread_rwlock_rdlock(&_ipc_shm_rwlock);
+
+	/* Receivers may be cancelled while waiting for a message */
+	pthread_cleanup_push(&_ipc_shm_unlock, NULL);
+
+	if ((ring = _ipc_shm_ring(src_id, dst_id)))
+		ret = ring_pop(ring, msg, count, block);
+
+	pthread_cleanup_pop(1);
+
+	return ret;
+}
 
 ssize_t ipc_send(pipcd_t *pipcd, long src_id, long dst_id, const char *msg, size_t count) {
-	return pipc_send(pipcd, src_id, dst_id, msg, count);
+	if (!_ipc_shm_id)
+		return pipc_send(pipcd, src_id, dst_id, msg, count);
+
+	return _ipc_shm_send(src_id, dst_id, msg, count, 1);
 }
 
 ssize_t ipc_send_nowait(pipcd_t *pipcd, long src_id, long dst_id, const char *msg, size_t count) {
-	return pipc_send_nowait(pipcd, src_id, dst_id, msg, count);
+	if (!_ipc_shm_id)
+		return pipc_send_nowait(pipcd, src_id, dst_id, msg, count);
+
+	return _ipc_shm_send(src_id, dst_id, msg, count, 0);
 }
 
 ssize_t ipc_recv(pipcd_t *pipcd, long *src_id, long *dst_id, char *msg, size_t count) {
-	return pipc_recv(pipcd, src_id, dst_id, msg, count);
+	if (!_ipc_shm_id)
+		return pipc_recv(pipcd, src_id, dst_id, msg, count);
+
+	return _ipc_shm_recv(*src_id, *dst_id, msg, count, 1);
 }
 
 ssize_t ipc_recv_nowait(pipcd_t *pipcd, long *src_id, long *dst_id, char *msg, size_t count) {
-	return pipc_recv_nowait(pipcd, src_id, dst_id, msg, count);
+	if (!_ipc_shm_id)
+		return pipc_recv_nowait(pipcd, src_id, dst_id, msg, count);
+
+	return _ipc_shm_recv(*src_id, *dst_id, msg, count, 0);
+}
+
+static ssize_t _ipc_frame_check(char *msg, ssize_t ret, size_t hdr_size, size_t len_offset) {
+	uint32_t len = 0;
+
+	/* The frame must carry a complete header ... */
+	if ((size_t) ret < hdr_size) {
+		errno = EBADMSG;
+		return -1;
+	}
+
+	memcpy(&len, msg + len_offset, sizeof(uint32_t));
+
+	/* ... followed by exactly the number of payload bytes it announces */
+	if (((size_t) ret - hdr_size) != (size_t) len) {
+		errno = EBADMSG;
+		return -1;
+	}
+
+	/* Bytes past the frame may belong to a previous message. Terminate the payload here. */
+	msg[ret] = 0;
+
+	return ret;
+}
+
+/* With pipc, every message addressed to a module is taken from the same queue, whatever its
+ * source, so each module has a single receiver and the messages of its other routes are
+ * passed to other(), or dropped if there's no handler. With shm, each route has its own
+ * ring and only messages from src_id are received. Returns 1 if the message was handled
+ * here, which also clears it from the buffer, or 0 if it's from src_id.
+ */
+static int _ipc_recv_other(long src_id, long from_id, char *msg, ssize_t ret, ipc_recv_other_t other) {
+	if (from_id == src_id)
+		return 0;
+
+	if (other) {
+		other(from_id, msg, (size_t) ret);
+	} else {
+		log_warn("_ipc_recv_other(): Dropped unexpected message from module %ld (%zd bytes).\n", from_id, ret);
+	}
+
+	memset(msg, 0, (size_t) ret + 1);
+
+	return 1;
+}
+
+/* Receives a single frame (see IPC_*_FRAME_LEN()) from src_id and validates its length. The
+ * payload length field is found at len_offset of the header. Messages from other sources are
+ * passed to other(). NOTE: msg must have room for count + 1 bytes.
+ */
+ssize_t ipc_recv_frame(pipcd_t *pipcd, long src_id, long dst_id, char *msg, size_t count, size_t hdr_size, size_t len_offset, ipc_recv_other_t other) {
+	ssize_t ret = 0;
+	long from_id = 0;
+
+	do {
+		from_id = src_id;
+
+		if ((ret = ipc_recv(pipcd, &from_id, (long [1]) { dst_id }, msg, count)) < 0)
+			return -1;
+	} while (_ipc_recv_other(src_id, from_id, msg, ret, other));
+
+	return _ipc_frame_check(msg, ret, hdr_size, len_offset);
+}
+
+/* Waits for one frame and then drains, without blocking, up to nmemb - 1 frames that are
+ * already queued. Frame i is stored at msgs + (i * IPC_RECV_BATCH_STRIDE(count)) and its
+ * length at lens[i]. Messages from sources other than src_id are passed to other() as they
+ * arrive. Returns the number of frames received, which is at least one.
+ * NOTE: msgs must have room for nmemb * IPC_RECV_BATCH_STRIDE(count) bytes.
+ */
+ssize_t ipc_recv_frames(pipcd_t *pipcd, long src_id, long dst_id, char *msgs, size_t count, size_t nmemb, size_t *lens, size_t hdr_size, size_t len_offset, ipc_recv_other_t other) {
+	int errsv = 0;
+	ssize_t ret = 0;
+	size_t n = 0;
+	long from_id = 0;
+	char *msg = NULL;
+
+	if (!nmemb) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Block for the first frame */
+	if ((ret = ipc_recv_frame(pipcd, src_id, dst_id, msgs, count, hdr_size, len_offset, other)) < 0)
+		return -1;
+
+	lens[n ++] = (size_t) ret;
+
+	/* Collect whatever is already waiting */
+	while (n < nmemb) {
+		msg = msgs + (n * IPC_RECV_BATCH_STRIDE(count));
+		from_id = src_id;
+
+		if ((ret = ipc_recv_nowait(pipcd, &from_id, (long [1]) { dst_id }, msg, count)) < 0) {
+			/* Queue is empty. Any other error will be reported by the next blocking receive. */
+			if ((errno != EAGAIN) && (errno != ENOMSG)) {
+				errsv = errno;
+				log_warn("ipc_recv_frames(): ipc_recv_nowait(): %s\n", strerror(errno));
+				errno = errsv;
+			}
+
+			break;
+		}
+
+		/* The slot is reused by the next frame */
+		if (_ipc_recv_other(src_id, from_id, msg, ret, other))
+			continue;
+
+		/* Drop invalid frames, but keep the ones already collected */
+		if (_ipc_frame_check(msg, ret, hdr_size, len_offset) < 0) {
+			errsv = errno;
+			log_warn("ipc_recv_frames(): _ipc_frame_check(): %s\n", strerror(errno));
+			errno = errsv;
+			continue;
+		}
+
+		lens[n ++] = (size_t) ret;
+	}
+
+	return (ssize_t) n;
 }
 
 int ipc_pending(pipcd_t *pipcd) {
-	return pipc_pending(pipcd);
+	size_t i = 0, pending = 0;
+
+	if (!_ipc_shm_id)
+		return pipc_pending(pipcd);
+
+	pthread_rwlock_rdlock(&_ipc_shm_rwlock);
+
+	/* Messages waiting to be received by this module */
+	for (i = 0; i < IPC_SHM_ROUTES; i ++) {
+		if ((_ipc_shm_routes[i][1] == _ipc_shm_id) && _ipc_shm_rings[i])
+			pending += ring_pending(_ipc_shm_rings[i]);
+	}
+
+	pthread_rwlock_unlock(&_ipc_shm_rwlock);
+
+	return (int) pending;
 }
 
 void ipc_close(pipcd_t *pipcd) {
@@ -59,3 +291,247 @@ void ipc_close(pipcd_t *pipcd) {
 	return ;
 }
 
+int ipc_shm_create(const struct usched_config_ipc *ipc) {
+	int errsv = 0;
+	size_t i = 0;
+	char name[CONFIG_USCHED_IPC_SHM_NAME_MAX];
+
+	for (i = 0; i < IPC_SHM_ROUTES; i ++) {
+		if (_ipc_shm_name(name, sizeof(name), ipc->id_name, i) < 0) {
+			errsv = errno;
+			log_warn("ipc_shm_create(): _ipc_shm_name(): %s\n", strerror(errno));
+			goto _failure;
+		}
+
+		if (ring_create(name, (size_t) ipc->msg_max, (size_t) ipc->msg_size, ipc->privdrop_uid, ipc->privdrop_gid, 0660) < 0) {
+			errsv = errno;
+			log_warn("ipc_shm_create(): ring_create(): %s\n", strerror(errno));
+			goto _failure;
+		}
+	}
+
+	/* All good */
+	return 0;
+
+_failure:
+	/* Remove the rings already created */
+	while (i --) {
+		if (!_ipc_shm_name(name, sizeof(name), ipc->id_name, i))
+			ring_unlink(name);
+	}
+
+	errno = errsv;
+
+	return -1;
+}
+
+void ipc_shm_unlink(const struct usched_config_ipc *ipc) {
+	size_t i = 0;
+	char name[CONFIG_USCHED_IPC_SHM_NAME_MAX];
+
+	for (i = 0; i < IPC_SHM_ROUTES; i ++) {
+		if (_ipc_shm_name(name, sizeof(name), ipc->id_name, i) < 0)
+			continue;
+
+		if (ring_unlink(name) < 0)
+			log_warn("ipc_shm_unlink(): ring_unlink(): %s\n", strerror(errno));
+	}
+}
+
+int ipc_shm_attach(const struct usched_config_ipc *ipc, long id) {
+	int errsv = 0;
+	size_t i = 0;
+	char name[CONFIG_USCHED_IPC_SHM_NAME_MAX];
+
+	pthread_rwlock_wrlock(&_ipc_shm_rwlock);
+
+	/* Only the rings with this module on one of the ends are attached */
+	for (i = 0; i < IPC_SHM_ROUTES; i ++) {
+		if ((_ipc_shm_routes[i][0] != id) && (_ipc_shm_routes[i][1] != id))
+			continue;
+
+		if (_ipc_shm_name(name, sizeof(name), ipc->id_name, i) < 0) {
+			errsv = errno;
+			log_warn("ipc_shm_attach(): _ipc_shm_name(): %s\n", strerror(errno));
+			goto _failure;
+		}
+
+		if (!(_ipc_shm_rings[i] = ring_attach(name))) {
+			errsv = errno;
+			log_warn("ipc_shm_attach(): ring_attach(): %s\n", strerror(errno));
+			goto _failure;
+		}
+
+		/* Both ends must agree on the message size */
+		if (_ipc_shm_rings[i]->slot_size != (uint32_t) ipc->msg_size) {
+			log_warn("ipc_shm_attach(): Ring %s was created with a different msg.size (%u).\n", name, _ipc_shm_rings[i]->slot_size);
+			errsv = EINVAL;
+			goto _failure;
+		}
+	}
+
+	_ipc_shm_id = id;
+
+	pthread_rwlock_unlock(&_ipc_shm_rwlock);
+
+	/* All good */
+	return 0;
+
+_failure:
+	for (i = 0; i < IPC_SHM_ROUTES; i ++) {
+		ring_detach(_ipc_shm_rings[i]);
+
+		_ipc_shm_rings[i] = NULL;
+	}
+
+	pthread_rwlock_unlock(&_ipc_shm_rwlock);
+
+	errno = errsv;
+
+	return -1;
+}
+
+void ipc_shm_detach(void) {
+	size_t i = 0;
+
+	/* NOTE: _ipc_shm_id is kept, so late senders fail with EIDRM instead of reaching pipc */
+	pthread_rwlock_wrlock(&_ipc_shm_rwlock);
+
+	for (i = 0; i < IPC_SHM_ROUTES; i ++) {
+		ring_detach(_ipc_shm_rings[i]);
+
+		_ipc_shm_rings[i] = NULL;
+	}
+
+	pthread_rwlock_unlock(&_ipc_shm_rwlock);
+}
+
+
+/* Per-thread reusable message buffers */
+struct ipc_buf {
+	char *data;
+	size_t size;	/* Usable size. An extra trailing byte is always kept zeroed. */
+	size_t dirty;	/* Number of leading bytes that may contain non-zero data */
+};
+
+static pthread_key_t _ipc_buf_key;
+static pthread_once_t _ipc_buf_once = PTHREAD_ONCE_INIT;
+static int _ipc_buf_key_errno = 0;
+
+static void _ipc_buf_free(void *arg) {
+	struct ipc_buf *buf = arg;
+
+	if (!buf)
+		return;
+
+	if (buf->data)
+		mm_free(buf->data);
+
+	mm_free(buf);
+}
+
+static void _ipc_buf_key_create(void) {
+	_ipc_buf_key_errno = pthread_key_create(&_ipc_buf_key, &_ipc_buf_free);
+}
+
+static struct ipc_buf *_ipc_buf_self(void) {
+	if (pthread_once(&_ipc_buf_once, &_ipc_buf_key_create) || _ipc_buf_key_errno)
+		return NULL;
+
+	return pthread_getspecific(_ipc_buf_key);
+}
+
+char *ipc_buf_get(size_t size) {
+	int errsv = 0;
+	struct ipc_buf *buf = NULL;
+
+	/* Initialize the thread-specific data key, if not already initialized */
+	if ((errno = pthread_once(&_ipc_buf_once, &_ipc_buf_key_create)) || (errno = _ipc_buf_key_errno)) {
+		errsv = errno;
+		log_warn("ipc_buf_get(): pthread_key_create(): %s\n", strerror(errno));
+		errno = errsv;
+		return NULL;
+	}
+
+	/* Create the buffer descriptor for this thread, if it doesn't exist yet */
+	if (!(buf = pthread_getspecific(_ipc_buf_key))) {
+		if (!(buf = mm_alloc(sizeof(struct ipc_buf)))) {
+			errsv = errno;
+			log_warn("ipc_buf_get(): mm_alloc(): %s\n", strerror(errno));
+			errno = errsv;
+			return NULL;
+		}
+
+		memset(buf, 0, sizeof(struct ipc_buf));
+
+		if ((errno = pthread_setspecific(_ipc_buf_key, buf))) {
+			errsv = errno;
+			log_warn("ipc_buf_get(): pthread_setspecific(): %s\n", strerror(errno));
+			mm_free(buf);
+			errno = errsv;
+			return NULL;
+		}
+	}
+
+	/* Reuse the current buffer if the message size didn't change (eg, on reload) */
+	if (buf->data && (buf->size == size))
+		return buf->data;
+
+	if (buf->data)
+		mm_free(buf->data);
+
+	buf->size = 0;
+	buf->dirty = 0;
+
+	/* Zeroed only once, when allocated. From now on, only the used bytes are cleared. */
+	if (!(buf->data = mm_calloc(size + 1, 1))) {
+		errsv = errno;
+		log_warn("ipc_buf_get(): mm_calloc(): %s\n", strerror(errno));
+		errno = errsv;
+		return NULL;
+	}
+
+	buf->size = size;
+
+	return buf->data;
+}
+
+void ipc_buf_reset(size_t len) {
+	struct ipc_buf *buf = NULL;
+
+	if (!(buf = _ipc_buf_self()) || !buf->data)
+		return;
+
+	if (len > buf->size)
+		len = buf->size;
+
+	/* Clear the bytes about to be used and any leftovers from a previous (larger) message */
+	memset(buf->data, 0, len > buf->dirty ? len : buf->dirty);
+
+	buf->dirty = len;
+}
+
+void ipc_buf_dirty(size_t len) {
+	struct ipc_buf *buf = NULL;
+
+	if (!(buf = _ipc_buf_self()) || !buf->data)
+		return;
+
+	if (len > buf->size)
+		len = buf->size;
+
+	if (len > buf->dirty)
+		buf->dirty = len;
+}
+
+void ipc_buf_destroy(void) {
+	struct ipc_buf *buf = NULL;
+
+	if (!(buf = _ipc_buf_self()))
+		return;
+
+	pthread_setspecific(_ipc_buf_key, NULL);
+
+	_ipc_buf_free(buf);
+}
+
@@ -0,0 +1,388 @@
+/**
+ * @file ring.c
+ * @brief uSched
+ *        Shared memory ring interface
+ *
+ * Date: 18-10-2026
+ *
+ * Copyright 2014-2015 Pedro A. Hortas (pah@ucodev.org)
+ *
+ * This file is part of usched.
+ *
+ * usched is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * usched is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with usched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#include "config.h"
+#include "log.h"
+#include "mm.h"
+#include "ring.h"
+
+#if CONFIG_USE_FUTEX == 1
+ #include <linux/futex.h>
+ #include <sys/syscall.h>
+#endif
+
+static size_t _ring_stride(size_t slot_size) {
+	/* Keep every slot aligned to its length prefix */
+	return RING_SLOT_HDR_SIZE + ((slot_size + RING_SLOT_HDR_SIZE - 1) & ~(RING_SLOT_HDR_SIZE - 1));
+}
+
+static int _ring_wait(uint32_t *word, uint32_t val) {
+#if CONFIG_USE_FUTEX == 1
+	struct timespec ts = { CONFIG_USCHED_IPC_SHM_WAIT_TIMEOUT / 1000, (CONFIG_USCHED_IPC_SHM_WAIT_TIMEOUT % 1000) * 1000000 };
+
+	/* The word is in a shared mapping, so the non-private futex operations are required */
+	if (syscall(SYS_futex, word, FUTEX_WAIT, val, &ts, NULL, 0) < 0) {
+		/* The word changed before we slept, or we just timed out. Either way, re-check. */
+		if (errno == EAGAIN || errno == ETIMEDOUT)
+			return 0;
+
+		return -1;
+	}
+
+	return 0;
+#else
+	struct timespec ts = { 0, CONFIG_USCHED_IPC_SHM_POLL_INTERVAL * 1000 };
+
+	return nanosleep(&ts, NULL);
+#endif
+}
+
+static void _ring_wake(uint32_t *word) {
+#if CONFIG_USE_FUTEX == 1
+	syscall(SYS_futex, word, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+}
+
+int ring_create(const char *name, size_t slots, size_t slot_size, uid_t uid, gid_t gid, mode_t mode) {
+	int errsv = 0, fd = -1;
+	size_t size = 0;
+	struct ring_shm *shm = NULL;
+
+	/* Slot indexes are taken from free running 32 bit counters, so the slot count must divide
+	 * 2^32 for the indexes to remain contiguous when the counters wrap.
+	 */
+	if (!slots || (slots & (slots - 1)) || (slots > CONFIG_USCHED_IPC_SHM_SLOTS_MAX) || !slot_size || (slot_size > UINT32_MAX)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	size = sizeof(struct ring_shm) + (slots * _ring_stride(slot_size));
+
+	/* Remove any leftovers from a previous instance that didn't terminate cleanly */
+	if ((shm_unlink(name) < 0) && (errno != ENOENT)) {
+		errsv = errno;
+		log_warn("ring_create(): shm_unlink(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if ((fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, mode)) < 0) {
+		errsv = errno;
+		log_warn("ring_create(): shm_open(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Grant the requested ownership and permissions, regardless of the current umask */
+	if ((fchown(fd, uid, gid) < 0) || (fchmod(fd, mode) < 0)) {
+		errsv = errno;
+		log_warn("ring_create(): fchown()/fchmod(): %s\n", strerror(errno));
+		goto _failure;
+	}
+
+	/* The new object is zero filled, so all the indexes start at 0 */
+	if (ftruncate(fd, (off_t) size) < 0) {
+		errsv = errno;
+		log_warn("ring_create(): ftruncate(): %s\n", strerror(errno));
+		goto _failure;
+	}
+
+	if ((shm = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED) {
+		errsv = errno;
+		log_warn("ring_create(): mmap(): %s\n", strerror(errno));
+		goto _failure;
+	}
+
+	close(fd);
+
+	shm->slots = (uint32_t) slots;
+	shm->slot_size = (uint32_t) slot_size;
+	shm->stride = (uint32_t) _ring_stride(slot_size);
+
+	/* Publish the ring only after its geometry is set */
+	__atomic_store_n(&shm->magic, RING_MAGIC, __ATOMIC_RELEASE);
+
+	munmap(shm, size);
+
+	/* All good */
+	return 0;
+
+_failure:
+	close(fd);
+	shm_unlink(name);
+
+	errno = errsv;
+
+	return -1;
+}
+
+int ring_unlink(const char *name) {
+	return shm_unlink(name);
+}
+
+struct ring *ring_attach(const char *name) {
+	int errsv = 0, fd = -1;
+	struct stat st;
+	struct ring *ring = NULL;
+
+	if ((fd = shm_open(name, O_RDWR, 0)) < 0) {
+		errsv = errno;
+		log_warn("ring_attach(): shm_open(): %s\n", strerror(errno));
+		errno = errsv;
+		return NULL;
+	}
+
+	if (fstat(fd, &st) < 0) {
+		errsv = errno;
+		log_warn("ring_attach(): fstat(): %s\n", strerror(errno));
+		close(fd);
+		errno = errsv;
+		return NULL;
+	}
+
+	if ((size_t) st.st_size < sizeof(struct ring_shm)) {
+		log_warn("ring_attach(): Shared memory object is too small (%lu bytes).\n", (unsigned long) st.st_size);
+		close(fd);
+		errno = EINVAL;
+		return NULL;
+	}
+
+	if (!(ring = mm_alloc(sizeof(struct ring)))) {
+		errsv = errno;
+		log_warn("ring_attach(): mm_alloc(): %s\n", strerror(errno));
+		close(fd);
+		errno = errsv;
+		return NULL;
+	}
+
+	memset(ring, 0, sizeof(struct ring));
+
+	ring->size = (size_t) st.st_size;
+
+	if ((ring->shm = mmap(NULL, ring->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED) {
+		errsv = errno;
+		log_warn("ring_attach(): mmap(): %s\n", strerror(errno));
+		close(fd);
+		mm_free(ring);
+		errno = errsv;
+		return NULL;
+	}
+
+	close(fd);
+
+	/* Take a private copy of the ring geometry (published before the magic) and validate it
+	 * against the object size.
+	 */
+	if (__atomic_load_n(&ring->shm->magic, __ATOMIC_ACQUIRE) == RING_MAGIC) {
+		ring->slots = ring->shm->slots;
+		ring->slot_size = ring->shm->slot_size;
+		ring->stride = ring->shm->stride;
+	}
+
+	if (!ring->slots || (ring->slots & (ring->slots - 1)) || !ring->slot_size || (ring->stride != _ring_stride(ring->slot_size)) ||
+	    (ring->size != (sizeof(struct ring_shm) + ((size_t) ring->slots * ring->stride)))) {
+		log_warn("ring_attach(): Invalid ring: %s\n", name);
+		munmap(ring->shm, ring->size);
+		mm_free(ring);
+		errno = EINVAL;
+		return NULL;
+	}
+
+	ring->base = ((char *) ring->shm) + sizeof(struct ring_shm);
+
+	pthread_mutex_init(&ring->mutex_push, NULL);
+	pthread_mutex_init(&ring->mutex_pop, NULL);
+
+	/* All good */
+	return ring;
+}
+
+void ring_detach(struct ring *ring) {
+	if (!ring)
+		return;
+
+	pthread_mutex_destroy(&ring->mutex_push);
+	pthread_mutex_destroy(&ring->mutex_pop);
+
+	munmap(ring->shm, ring->size);
+
+	mm_free(ring);
+}
+
+ssize_t ring_push(struct ring *ring, const char *msg, size_t count, int block) {
+	int errsv = 0;
+	uint32_t head = 0, seq = 0, len = (uint32_t) count;
+	struct ring_shm *shm = ring->shm;
+	char *slot = NULL;
+
+	if (count > ring->slot_size) {
+		errno = EMSGSIZE;
+		return -1;
+	}
+
+	pthread_mutex_lock(&ring->mutex_push);
+
+	/* Only this side writes the head, so there's no need to synchronize its read */
+	head = __atomic_load_n(&shm->head, __ATOMIC_RELAXED);
+
+	while ((uint32_t) (head - __atomic_load_n(&shm->tail, __ATOMIC_ACQUIRE)) >= ring->slots) {
+		if (!block) {
+			pthread_mutex_unlock(&ring->mutex_push);
+			errno = EAGAIN;
+			return -1;
+		}
+
+		/* Announce the sleeper before sampling the sequence, then check for space again,
+		 * so a read completed in between is never missed.
+		 */
+		__atomic_add_fetch(&shm->space_waiters, 1, __ATOMIC_SEQ_CST);
+
+		seq = __atomic_load_n(&shm->space_seq, __ATOMIC_SEQ_CST);
+
+		if ((uint32_t) (head - __atomic_load_n(&shm->tail, __ATOMIC_SEQ_CST)) < ring->slots) {
+			__atomic_sub_fetch(&shm->space_waiters, 1, __ATOMIC_SEQ_CST);
+			break;
+		}
+
+		if (_ring_wait(&shm->space_seq, seq) < 0) {
+			errsv = errno;
+			__atomic_sub_fetch(&shm->space_waiters, 1, __ATOMIC_SEQ_CST);
+			pthread_mutex_unlock(&ring->mutex_push);
+			errno = errsv;
+			return -1;
+		}
+
+		__atomic_sub_fetch(&shm->space_waiters, 1, __ATOMIC_SEQ_CST);
+	}
+
+	slot = ring->base + ((size_t) (head & (ring->slots - 1)) * ring->stride);
+
+	memcpy(slot, &len, sizeof(uint32_t));
+	memcpy(slot + RING_SLOT_HDR_SIZE, msg, count);
+
+	/* Publish the message and wake up the consumer, if it's sleeping */
+	__atomic_store_n(&shm->head, head + 1, __ATOMIC_RELEASE);
+	__atomic_add_fetch(&shm->data_seq, 1, __ATOMIC_SEQ_CST);
+
+	if (__atomic_load_n(&shm->data_waiters, __ATOMIC_SEQ_CST))
+		_ring_wake(&shm->data_seq);
+
+	pthread_mutex_unlock(&ring->mutex_push);
+
+	return (ssize_t) count;
+}
+
+ssize_t ring_pop(struct ring *ring, char *msg, size_t count, int block) {
+	int errsv = 0;
+	uint32_t tail = 0, seq = 0, len = 0;
+	struct ring_shm *shm = ring->shm;
+	const char *slot = NULL;
+
+	for (;;) {
+		pthread_mutex_lock(&ring->mutex_pop);
+
+		tail = __atomic_load_n(&shm->tail, __ATOMIC_RELAXED);
+
+		if (__atomic_load_n(&shm->head, __ATOMIC_ACQUIRE) != tail)
+			break;
+
+		pthread_mutex_unlock(&ring->mutex_pop);
+
+		if (!block) {
+			errno = EAGAIN;
+			return -1;
+		}
+
+		/* Same protocol as the producer. The local lock isn't held while sleeping, so
+		 * the thread can be safely cancelled once the wait times out.
+		 */
+		__atomic_add_fetch(&shm->data_waiters, 1, __ATOMIC_SEQ_CST);
+
+		seq = __atomic_load_n(&shm->data_seq, __ATOMIC_SEQ_CST);
+
+		if (__atomic_load_n(&shm->head, __ATOMIC_SEQ_CST) != __atomic_load_n(&shm->tail, __ATOMIC_SEQ_CST)) {
+			__atomic_sub_fetch(&shm->data_waiters, 1, __ATOMIC_SEQ_CST);
+			continue;
+		}
+
+		if (_ring_wait(&shm->data_seq, seq) < 0) {
+			errsv = errno;
+			__atomic_sub_fetch(&shm->data_waiters, 1, __ATOMIC_SEQ_CST);
+			errno = errsv;
+			return -1;
+		}
+
+		__atomic_sub_fetch(&shm->data_waiters, 1, __ATOMIC_SEQ_CST);
+
+		pthread_testcancel();
+	}
+
+	slot = ring->base + ((size_t) (tail & (ring->slots - 1)) * ring->stride);
+
+	memcpy(&len, slot, sizeof(uint32_t));
+
+	/* Messages are never truncated. An oversized one is discarded, as msgrcv() would. */
+	if ((len > ring->slot_size) || (len > count)) {
+		errsv = E2BIG;
+	} else {
+		memcpy(msg, slot + RING_SLOT_HDR_SIZE, len);
+	}
+
+	/* Release the slot and wake up the producer, if it's sleeping */
+	__atomic_store_n(&shm->tail, tail + 1, __ATOMIC_RELEASE);
+	__atomic_add_fetch(&shm->space_seq, 1, __ATOMIC_SEQ_CST);
+
+	if (__atomic_load_n(&shm->space_waiters, __ATOMIC_SEQ_CST))
+		_ring_wake(&shm->space_seq);
+
+	pthread_mutex_unlock(&ring->mutex_pop);
+
+	if (errsv) {
+		errno = errsv;
+		return -1;
+	}
+
+	return (ssize_t) len;
+}
+
+size_t ring_pending(struct ring *ring) {
+	return (uint32_t) (__atomic_load_n(&ring->shm->head, __ATOMIC_ACQUIRE) - __atomic_load_n(&ring->shm->tail, __ATOMIC_ACQUIRE));
+}
+
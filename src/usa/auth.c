@@ -101,6 +101,30 @@ int auth_admin_commit(void) {
 		return -1;
 	}
 
+	/* rate.limit */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_AUTH "/." CONFIG_USCHED_FILE_AUTH_RATE_LIMIT, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_AUTH "/" CONFIG_USCHED_FILE_AUTH_RATE_LIMIT, 128) < 0) {
+		errsv = errno;
+		log_crit("auth_admin_commit(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* rate.burst */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_AUTH "/." CONFIG_USCHED_FILE_AUTH_RATE_BURST, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_AUTH "/" CONFIG_USCHED_FILE_AUTH_RATE_BURST, 128) < 0) {
+		errsv = errno;
+		log_crit("auth_admin_commit(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* quota.entries */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_AUTH "/." CONFIG_USCHED_FILE_AUTH_QUOTA_ENTRIES, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_AUTH "/" CONFIG_USCHED_FILE_AUTH_QUOTA_ENTRIES, 128) < 0) {
+		errsv = errno;
+		log_crit("auth_admin_commit(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
 	/* All good */
 	return 0;
 }
@@ -156,6 +180,30 @@ int auth_admin_rollback(void) {
 		return -1;
 	}
 
+	/* rate.limit */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_AUTH "/" CONFIG_USCHED_FILE_AUTH_RATE_LIMIT, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_AUTH "/." CONFIG_USCHED_FILE_AUTH_RATE_LIMIT, 128) < 0) {
+		errsv = errno;
+		log_crit("auth_admin_rollback(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* rate.burst */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_AUTH "/" CONFIG_USCHED_FILE_AUTH_RATE_BURST, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_AUTH "/." CONFIG_USCHED_FILE_AUTH_RATE_BURST, 128) < 0) {
+		errsv = errno;
+		log_crit("auth_admin_rollback(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* quota.entries */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_AUTH "/" CONFIG_USCHED_FILE_AUTH_QUOTA_ENTRIES, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_AUTH "/." CONFIG_USCHED_FILE_AUTH_QUOTA_ENTRIES, 128) < 0) {
+		errsv = errno;
+		log_crit("auth_admin_rollback(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
 	/* All good */
 	return 0;
 }
@@ -205,6 +253,27 @@ int auth_admin_show(void) {
 		return -1;
 	}
 
+	if (auth_admin_rate_limit_show() < 0) {
+		errsv = errno;
+		log_crit("auth_admin_show(): auth_admin_rate_limit_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (auth_admin_rate_burst_show() < 0) {
+		errsv = errno;
+		log_crit("auth_admin_show(): auth_admin_rate_burst_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (auth_admin_quota_entries_show() < 0) {
+		errsv = errno;
+		log_crit("auth_admin_show(): auth_admin_quota_entries_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
 	return 0;
 }
 
@@ -1086,3 +1155,105 @@ int auth_admin_whitelist_uid_delete(const char *whitelist_uid) {
 	return 0;
 }
 
+int auth_admin_rate_limit_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_AUTH, USCHED_CATEGORY_AUTH_STR, CONFIG_USCHED_FILE_AUTH_RATE_LIMIT) < 0) {
+		errsv = errno;
+		log_crit("auth_admin_rate_limit_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int auth_admin_rate_limit_change(const char *rate_limit) {
+	int errsv = 0;
+
+	if (admin_property_change(CONFIG_USCHED_DIR_AUTH, CONFIG_USCHED_FILE_AUTH_RATE_LIMIT, rate_limit) < 0) {
+		errsv = errno;
+		log_crit("auth_admin_rate_limit_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (auth_admin_rate_limit_show() < 0) {
+		errsv = errno;
+		log_crit("auth_admin_rate_limit_change(): auth_admin_rate_limit_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+int auth_admin_rate_burst_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_AUTH, USCHED_CATEGORY_AUTH_STR, CONFIG_USCHED_FILE_AUTH_RATE_BURST) < 0) {
+		errsv = errno;
+		log_crit("auth_admin_rate_burst_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int auth_admin_rate_burst_change(const char *rate_burst) {
+	int errsv = 0;
+
+	if (admin_property_change(CONFIG_USCHED_DIR_AUTH, CONFIG_USCHED_FILE_AUTH_RATE_BURST, rate_burst) < 0) {
+		errsv = errno;
+		log_crit("auth_admin_rate_burst_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (auth_admin_rate_burst_show() < 0) {
+		errsv = errno;
+		log_crit("auth_admin_rate_burst_change(): auth_admin_rate_burst_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+int auth_admin_quota_entries_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_AUTH, USCHED_CATEGORY_AUTH_STR, CONFIG_USCHED_FILE_AUTH_QUOTA_ENTRIES) < 0) {
+		errsv = errno;
+		log_crit("auth_admin_quota_entries_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int auth_admin_quota_entries_change(const char *quota_entries) {
+	int errsv = 0;
+
+	if (admin_property_change(CONFIG_USCHED_DIR_AUTH, CONFIG_USCHED_FILE_AUTH_QUOTA_ENTRIES, quota_entries) < 0) {
+		errsv = errno;
+		log_crit("auth_admin_quota_entries_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (auth_admin_quota_entries_show() < 0) {
+		errsv = errno;
+		log_crit("auth_admin_quota_entries_change(): auth_admin_quota_entries_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
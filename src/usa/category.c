@@ -351,6 +351,57 @@ int category_auth_change(size_t argc, char **args) {
 		log_warn("category_auth_change(): Invalid 'whitelist' property: %s\n", args[1]);
 		errno = EINVAL;
 
+		return -1;
+	} else if (!strcasecmp(args[0], USCHED_COMPONENT_RATE_STR)) {
+		if (!strcasecmp(args[1], USCHED_PROPERTY_LIMIT_STR)) {
+			/* set rate.limit */
+			if (auth_admin_rate_limit_change(args[2]) < 0) {
+				errsv = errno;
+				log_warn("category_auth_change(): auth_admin_rate_limit_change(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		} else if (!strcasecmp(args[1], USCHED_PROPERTY_BURST_STR)) {
+			/* set rate.burst */
+			if (auth_admin_rate_burst_change(args[2]) < 0) {
+				errsv = errno;
+				log_warn("category_auth_change(): auth_admin_rate_burst_change(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		/* Unknown property */
+		usage_admin_error_set(USCHED_USAGE_ADMIN_ERR_INVALID_PROPERTY, "change auth rate");
+		log_warn("category_auth_change(): Invalid 'rate' property: %s\n", args[1]);
+		errno = EINVAL;
+
+		return -1;
+	} else if (!strcasecmp(args[0], USCHED_COMPONENT_QUOTA_STR)) {
+		if (!strcasecmp(args[1], USCHED_PROPERTY_ENTRIES_STR)) {
+			/* set quota.entries */
+			if (auth_admin_quota_entries_change(args[2]) < 0) {
+				errsv = errno;
+				log_warn("category_auth_change(): auth_admin_quota_entries_change(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		/* Unknown property */
+		usage_admin_error_set(USCHED_USAGE_ADMIN_ERR_INVALID_PROPERTY, "change auth quota");
+		log_warn("category_auth_change(): Invalid 'quota' property: %s\n", args[1]);
+		errno = EINVAL;
+
 		return -1;
 	}
 
@@ -563,6 +614,57 @@ int category_auth_show(size_t argc, char **args) {
 		log_warn("category_auth_show(): Invalid 'whitelist' property: %s\n", args[1]);
 		errno = EINVAL;
 
+		return -1;
+	} else if (!strcasecmp(args[0], USCHED_COMPONENT_RATE_STR)) {
+		if (!strcasecmp(args[1], USCHED_PROPERTY_LIMIT_STR)) {
+			/* show rate.limit */
+			if (auth_admin_rate_limit_show() < 0) {
+				errsv = errno;
+				log_warn("category_auth_show(): auth_admin_rate_limit_show(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		} else if (!strcasecmp(args[1], USCHED_PROPERTY_BURST_STR)) {
+			/* show rate.burst */
+			if (auth_admin_rate_burst_show() < 0) {
+				errsv = errno;
+				log_warn("category_auth_show(): auth_admin_rate_burst_show(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		/* Unknown property */
+		usage_admin_error_set(USCHED_USAGE_ADMIN_ERR_INVALID_PROPERTY, "show auth rate");
+		log_warn("category_auth_show(): Invalid 'rate' property: %s\n", args[1]);
+		errno = EINVAL;
+
+		return -1;
+	} else if (!strcasecmp(args[0], USCHED_COMPONENT_QUOTA_STR)) {
+		if (!strcasecmp(args[1], USCHED_PROPERTY_ENTRIES_STR)) {
+			/* show quota.entries */
+			if (auth_admin_quota_entries_show() < 0) {
+				errsv = errno;
+				log_warn("category_auth_show(): auth_admin_quota_entries_show(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		/* Unknown property */
+		usage_admin_error_set(USCHED_USAGE_ADMIN_ERR_INVALID_PROPERTY, "show auth quota");
+		log_warn("category_auth_show(): Invalid 'quota' property: %s\n", args[1]);
+		errno = EINVAL;
+
 		return -1;
 	}
 
@@ -979,6 +1081,279 @@ int category_exec_change(size_t argc, char **args) {
 		log_warn("category_exec_change(): Invalid 'delta' property: %s\n", args[1]);
 		errno = EINVAL;
 
+		return -1;
+	} else if (!strcasecmp(args[0], USCHED_COMPONENT_RETRY_STR)) {
+		if (!strcasecmp(args[1], USCHED_PROPERTY_DEPTH_STR)) {
+			/* set retry.depth */
+			if (exec_admin_retry_depth_change(args[2]) < 0) {
+				errsv = errno;
+				log_warn("category_exec_change(): exec_admin_retry_depth_change(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		} else if (!strcasecmp(args[1], USCHED_PROPERTY_DELAY_STR)) {
+			/* set retry.delay */
+			if (exec_admin_retry_delay_change(args[2]) < 0) {
+				errsv = errno;
+				log_warn("category_exec_change(): exec_admin_retry_delay_change(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		/* Unknown property */
+		usage_admin_error_set(USCHED_USAGE_ADMIN_ERR_INVALID_PROPERTY, "change exec retry");
+		log_warn("category_exec_change(): Invalid 'retry' property: %s\n", args[1]);
+		errno = EINVAL;
+
+		return -1;
+	} else if (!strcasecmp(args[0], USCHED_COMPONENT_SPILL_STR)) {
+		if (!strcasecmp(args[1], USCHED_PROPERTY_USE_STR)) {
+			/* set spill.use */
+			if (exec_admin_spill_use_change(args[2]) < 0) {
+				errsv = errno;
+				log_warn("category_exec_change(): exec_admin_spill_use_change(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		} else if (!strcasecmp(args[1], USCHED_PROPERTY_FILE_STR)) {
+			/* set spill.file */
+			if (exec_admin_spill_file_change(args[2]) < 0) {
+				errsv = errno;
+				log_warn("category_exec_change(): exec_admin_spill_file_change(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		/* Unknown property */
+		usage_admin_error_set(USCHED_USAGE_ADMIN_ERR_INVALID_PROPERTY, "change exec spill");
+		log_warn("category_exec_change(): Invalid 'spill' property: %s\n", args[1]);
+		errno = EINVAL;
+
+		return -1;
+	} else if (!strcasecmp(args[0], USCHED_COMPONENT_CHILDREN_STR)) {
+		if (!strcasecmp(args[1], USCHED_PROPERTY_MAX_STR)) {
+			/* set children.max */
+			if (exec_admin_children_max_change(args[2]) < 0) {
+				errsv = errno;
+				log_warn("category_exec_change(): exec_admin_children_max_change(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		/* Unknown property */
+		usage_admin_error_set(USCHED_USAGE_ADMIN_ERR_INVALID_PROPERTY, "change exec children");
+		log_warn("category_exec_change(): Invalid 'children' property: %s\n", args[1]);
+		errno = EINVAL;
+
+		return -1;
+	} else if (!strcasecmp(args[0], USCHED_COMPONENT_QUEUE_STR)) {
+		if (!strcasecmp(args[1], USCHED_PROPERTY_DEPTH_STR)) {
+			/* set queue.depth */
+			if (exec_admin_queue_depth_change(args[2]) < 0) {
+				errsv = errno;
+				log_warn("category_exec_change(): exec_admin_queue_depth_change(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		/* Unknown property */
+		usage_admin_error_set(USCHED_USAGE_ADMIN_ERR_INVALID_PROPERTY, "change exec queue");
+		log_warn("category_exec_change(): Invalid 'queue' property: %s\n", args[1]);
+		errno = EINVAL;
+
+		return -1;
+	} else if (!strcasecmp(args[0], USCHED_COMPONENT_THREAD_STR)) {
+		if (!strcasecmp(args[1], USCHED_PROPERTY_WORKERS_STR)) {
+			/* set thread.workers */
+			if (exec_admin_thread_workers_change(args[2]) < 0) {
+				errsv = errno;
+				log_warn("category_exec_change(): exec_admin_thread_workers_change(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		/* Unknown property */
+		usage_admin_error_set(USCHED_USAGE_ADMIN_ERR_INVALID_PROPERTY, "change exec thread");
+		log_warn("category_exec_change(): Invalid 'thread' property: %s\n", args[1]);
+		errno = EINVAL;
+
+		return -1;
+	} else if (!strcasecmp(args[0], USCHED_COMPONENT_OUTPUT_STR)) {
+		if (!strcasecmp(args[1], USCHED_PROPERTY_MAX_STR)) {
+			/* set output.max */
+			if (exec_admin_output_max_change(args[2]) < 0) {
+				errsv = errno;
+				log_warn("category_exec_change(): exec_admin_output_max_change(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		/* Unknown property */
+		usage_admin_error_set(USCHED_USAGE_ADMIN_ERR_INVALID_PROPERTY, "change exec output");
+		log_warn("category_exec_change(): Invalid 'output' property: %s\n", args[1]);
+		errno = EINVAL;
+
+		return -1;
+	} else if (!strcasecmp(args[0], USCHED_COMPONENT_SPOOL_STR)) {
+		if (!strcasecmp(args[1], USCHED_PROPERTY_USE_STR)) {
+			/* set spool.use */
+			if (exec_admin_spool_use_change(args[2]) < 0) {
+				errsv = errno;
+				log_warn("category_exec_change(): exec_admin_spool_use_change(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		if (!strcasecmp(args[1], USCHED_PROPERTY_DIR_STR)) {
+			/* set spool.dir */
+			if (exec_admin_spool_dir_change(args[2]) < 0) {
+				errsv = errno;
+				log_warn("category_exec_change(): exec_admin_spool_dir_change(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		if (!strcasecmp(args[1], USCHED_PROPERTY_MAX_STR)) {
+			/* set spool.max */
+			if (exec_admin_spool_max_change(args[2]) < 0) {
+				errsv = errno;
+				log_warn("category_exec_change(): exec_admin_spool_max_change(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		/* Unknown property */
+		usage_admin_error_set(USCHED_USAGE_ADMIN_ERR_INVALID_PROPERTY, "change exec spool");
+		log_warn("category_exec_change(): Invalid 'spool' property: %s\n", args[1]);
+		errno = EINVAL;
+
+		return -1;
+	} else if (!strcasecmp(args[0], USCHED_COMPONENT_CGROUP_STR)) {
+		if (!strcasecmp(args[1], USCHED_PROPERTY_USE_STR)) {
+			/* set cgroup.use */
+			if (exec_admin_cgroup_use_change(args[2]) < 0) {
+				errsv = errno;
+				log_warn("category_exec_change(): exec_admin_cgroup_use_change(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		if (!strcasecmp(args[1], USCHED_PROPERTY_DIR_STR)) {
+			/* set cgroup.dir */
+			if (exec_admin_cgroup_dir_change(args[2]) < 0) {
+				errsv = errno;
+				log_warn("category_exec_change(): exec_admin_cgroup_dir_change(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		if (!strcasecmp(args[1], USCHED_PROPERTY_GROUP_STR)) {
+			/* set cgroup.group */
+			if (exec_admin_cgroup_group_change(args[2]) < 0) {
+				errsv = errno;
+				log_warn("category_exec_change(): exec_admin_cgroup_group_change(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		if (!strcasecmp(args[1], USCHED_PROPERTY_CPU_STR)) {
+			/* set cgroup.cpu */
+			if (exec_admin_cgroup_cpu_change(args[2]) < 0) {
+				errsv = errno;
+				log_warn("category_exec_change(): exec_admin_cgroup_cpu_change(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		if (!strcasecmp(args[1], USCHED_PROPERTY_MEMORY_STR)) {
+			/* set cgroup.memory */
+			if (exec_admin_cgroup_memory_change(args[2]) < 0) {
+				errsv = errno;
+				log_warn("category_exec_change(): exec_admin_cgroup_memory_change(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		if (!strcasecmp(args[1], USCHED_PROPERTY_IO_STR)) {
+			/* set cgroup.io */
+			if (exec_admin_cgroup_io_change(args[2]) < 0) {
+				errsv = errno;
+				log_warn("category_exec_change(): exec_admin_cgroup_io_change(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		/* Unknown property */
+		usage_admin_error_set(USCHED_USAGE_ADMIN_ERR_INVALID_PROPERTY, "change exec cgroup");
+		log_warn("category_exec_change(): Invalid 'cgroup' property: %s\n", args[1]);
+		errno = EINVAL;
+
 		return -1;
 	}
 
@@ -1025,6 +1400,279 @@ int category_exec_show(size_t argc, char **args) {
 		log_warn("category_exec_show(): Invalid 'delta' property: %s\n", args[1]);
 		errno = EINVAL;
 
+		return -1;
+	} else if (!strcasecmp(args[0], USCHED_COMPONENT_RETRY_STR)) {
+		if (!strcasecmp(args[1], USCHED_PROPERTY_DEPTH_STR)) {
+			/* show retry.depth */
+			if (exec_admin_retry_depth_show() < 0) {
+				errsv = errno;
+				log_warn("category_exec_show(): exec_admin_retry_depth_show(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		} else if (!strcasecmp(args[1], USCHED_PROPERTY_DELAY_STR)) {
+			/* show retry.delay */
+			if (exec_admin_retry_delay_show() < 0) {
+				errsv = errno;
+				log_warn("category_exec_show(): exec_admin_retry_delay_show(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		/* Unknown property */
+		usage_admin_error_set(USCHED_USAGE_ADMIN_ERR_INVALID_PROPERTY, "show exec retry");
+		log_warn("category_exec_show(): Invalid 'retry' property: %s\n", args[1]);
+		errno = EINVAL;
+
+		return -1;
+	} else if (!strcasecmp(args[0], USCHED_COMPONENT_SPILL_STR)) {
+		if (!strcasecmp(args[1], USCHED_PROPERTY_USE_STR)) {
+			/* show spill.use */
+			if (exec_admin_spill_use_show() < 0) {
+				errsv = errno;
+				log_warn("category_exec_show(): exec_admin_spill_use_show(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		} else if (!strcasecmp(args[1], USCHED_PROPERTY_FILE_STR)) {
+			/* show spill.file */
+			if (exec_admin_spill_file_show() < 0) {
+				errsv = errno;
+				log_warn("category_exec_show(): exec_admin_spill_file_show(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		/* Unknown property */
+		usage_admin_error_set(USCHED_USAGE_ADMIN_ERR_INVALID_PROPERTY, "show exec spill");
+		log_warn("category_exec_show(): Invalid 'spill' property: %s\n", args[1]);
+		errno = EINVAL;
+
+		return -1;
+	} else if (!strcasecmp(args[0], USCHED_COMPONENT_CHILDREN_STR)) {
+		if (!strcasecmp(args[1], USCHED_PROPERTY_MAX_STR)) {
+			/* show children.max */
+			if (exec_admin_children_max_show() < 0) {
+				errsv = errno;
+				log_warn("category_exec_show(): exec_admin_children_max_show(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		/* Unknown property */
+		usage_admin_error_set(USCHED_USAGE_ADMIN_ERR_INVALID_PROPERTY, "show exec children");
+		log_warn("category_exec_show(): Invalid 'children' property: %s\n", args[1]);
+		errno = EINVAL;
+
+		return -1;
+	} else if (!strcasecmp(args[0], USCHED_COMPONENT_QUEUE_STR)) {
+		if (!strcasecmp(args[1], USCHED_PROPERTY_DEPTH_STR)) {
+			/* show queue.depth */
+			if (exec_admin_queue_depth_show() < 0) {
+				errsv = errno;
+				log_warn("category_exec_show(): exec_admin_queue_depth_show(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		/* Unknown property */
+		usage_admin_error_set(USCHED_USAGE_ADMIN_ERR_INVALID_PROPERTY, "show exec queue");
+		log_warn("category_exec_show(): Invalid 'queue' property: %s\n", args[1]);
+		errno = EINVAL;
+
+		return -1;
+	} else if (!strcasecmp(args[0], USCHED_COMPONENT_THREAD_STR)) {
+		if (!strcasecmp(args[1], USCHED_PROPERTY_WORKERS_STR)) {
+			/* show thread.workers */
+			if (exec_admin_thread_workers_show() < 0) {
+				errsv = errno;
+				log_warn("category_exec_show(): exec_admin_thread_workers_show(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		/* Unknown property */
+		usage_admin_error_set(USCHED_USAGE_ADMIN_ERR_INVALID_PROPERTY, "show exec thread");
+		log_warn("category_exec_show(): Invalid 'thread' property: %s\n", args[1]);
+		errno = EINVAL;
+
+		return -1;
+	} else if (!strcasecmp(args[0], USCHED_COMPONENT_OUTPUT_STR)) {
+		if (!strcasecmp(args[1], USCHED_PROPERTY_MAX_STR)) {
+			/* show output.max */
+			if (exec_admin_output_max_show() < 0) {
+				errsv = errno;
+				log_warn("category_exec_show(): exec_admin_output_max_show(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		/* Unknown property */
+		usage_admin_error_set(USCHED_USAGE_ADMIN_ERR_INVALID_PROPERTY, "show exec output");
+		log_warn("category_exec_show(): Invalid 'output' property: %s\n", args[1]);
+		errno = EINVAL;
+
+		return -1;
+	} else if (!strcasecmp(args[0], USCHED_COMPONENT_SPOOL_STR)) {
+		if (!strcasecmp(args[1], USCHED_PROPERTY_USE_STR)) {
+			/* show spool.use */
+			if (exec_admin_spool_use_show() < 0) {
+				errsv = errno;
+				log_warn("category_exec_show(): exec_admin_spool_use_show(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		if (!strcasecmp(args[1], USCHED_PROPERTY_DIR_STR)) {
+			/* show spool.dir */
+			if (exec_admin_spool_dir_show() < 0) {
+				errsv = errno;
+				log_warn("category_exec_show(): exec_admin_spool_dir_show(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		if (!strcasecmp(args[1], USCHED_PROPERTY_MAX_STR)) {
+			/* show spool.max */
+			if (exec_admin_spool_max_show() < 0) {
+				errsv = errno;
+				log_warn("category_exec_show(): exec_admin_spool_max_show(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		/* Unknown property */
+		usage_admin_error_set(USCHED_USAGE_ADMIN_ERR_INVALID_PROPERTY, "show exec spool");
+		log_warn("category_exec_show(): Invalid 'spool' property: %s\n", args[1]);
+		errno = EINVAL;
+
+		return -1;
+	} else if (!strcasecmp(args[0], USCHED_COMPONENT_CGROUP_STR)) {
+		if (!strcasecmp(args[1], USCHED_PROPERTY_USE_STR)) {
+			/* show cgroup.use */
+			if (exec_admin_cgroup_use_show() < 0) {
+				errsv = errno;
+				log_warn("category_exec_show(): exec_admin_cgroup_use_show(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		if (!strcasecmp(args[1], USCHED_PROPERTY_DIR_STR)) {
+			/* show cgroup.dir */
+			if (exec_admin_cgroup_dir_show() < 0) {
+				errsv = errno;
+				log_warn("category_exec_show(): exec_admin_cgroup_dir_show(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		if (!strcasecmp(args[1], USCHED_PROPERTY_GROUP_STR)) {
+			/* show cgroup.group */
+			if (exec_admin_cgroup_group_show() < 0) {
+				errsv = errno;
+				log_warn("category_exec_show(): exec_admin_cgroup_group_show(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		if (!strcasecmp(args[1], USCHED_PROPERTY_CPU_STR)) {
+			/* show cgroup.cpu */
+			if (exec_admin_cgroup_cpu_show() < 0) {
+				errsv = errno;
+				log_warn("category_exec_show(): exec_admin_cgroup_cpu_show(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		if (!strcasecmp(args[1], USCHED_PROPERTY_MEMORY_STR)) {
+			/* show cgroup.memory */
+			if (exec_admin_cgroup_memory_show() < 0) {
+				errsv = errno;
+				log_warn("category_exec_show(): exec_admin_cgroup_memory_show(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		if (!strcasecmp(args[1], USCHED_PROPERTY_IO_STR)) {
+			/* show cgroup.io */
+			if (exec_admin_cgroup_io_show() < 0) {
+				errsv = errno;
+				log_warn("category_exec_show(): exec_admin_cgroup_io_show(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		/* Unknown property */
+		usage_admin_error_set(USCHED_USAGE_ADMIN_ERR_INVALID_PROPERTY, "show exec cgroup");
+		log_warn("category_exec_show(): Invalid 'cgroup' property: %s\n", args[1]);
+		errno = EINVAL;
+
 		return -1;
 	}
 
@@ -1160,6 +1808,17 @@ int category_ipc_change(size_t argc, char **args) {
 				return -1;
 			}
 
+			/* All good */
+			return 0;
+		} else if (!strcasecmp(args[1], USCHED_PROPERTY_TRANSPORT_STR)) {
+			/* set msg.transport */
+			if (ipc_admin_msg_transport_change(args[2]) < 0) {
+				errsv = errno;
+				log_warn("category_ipc_change(): ipc_admin_msg_transport_change(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
 			/* All good */
 			return 0;
 		}
@@ -1318,6 +1977,17 @@ int category_ipc_show(size_t argc, char **args) {
 				return -1;
 			}
 
+			/* All good */
+			return 0;
+		} else if (!strcasecmp(args[1], USCHED_PROPERTY_TRANSPORT_STR)) {
+			/* set msg.transport */
+			if (ipc_admin_msg_transport_show() < 0) {
+				errsv = errno;
+				log_warn("category_ipc_show(): ipc_admin_msg_transport_show(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
 			/* All good */
 			return 0;
 		}
@@ -1524,6 +2194,26 @@ int category_network_change(size_t argc, char **args) {
 		log_warn("category_network_change(): Invalid 'sock' property: %s\n", args[1]);
 		errno = EINVAL;
 
+		return -1;
+	} else if (!strcasecmp(args[0], USCHED_COMPONENT_ACCEPT_STR)) {
+		if (!strcasecmp(args[1], USCHED_PROPERTY_WORKERS_STR)) {
+			/* set accept.workers */
+			if (network_admin_accept_workers_change(args[2]) < 0) {
+				errsv = errno;
+				log_warn("category_network_change(): network_admin_accept_workers_change(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		/* Unknown property */
+		usage_admin_error_set(USCHED_USAGE_ADMIN_ERR_INVALID_PROPERTY, "change network accept");
+		log_warn("category_network_change(): Invalid 'accept' property: %s\n", args[1]);
+		errno = EINVAL;
+
 		return -1;
 	}
 	
@@ -1632,6 +2322,26 @@ int category_network_show(size_t argc, char **args) {
 		log_warn("category_network_show(): Invalid 'sock' property: %s\n", args[1]);
 		errno = EINVAL;
 
+		return -1;
+	} else if (!strcasecmp(args[0], USCHED_COMPONENT_ACCEPT_STR)) {
+		if (!strcasecmp(args[1], USCHED_PROPERTY_WORKERS_STR)) {
+			/* show accept.workers */
+			if (network_admin_accept_workers_show() < 0) {
+				errsv = errno;
+				log_warn("category_network_show(): network_admin_accept_workers_show(): %s\n", strerror(errno));
+				errno = errsv;
+				return -1;
+			}
+
+			/* All good */
+			return 0;
+		}
+
+		/* Unknown property */
+		usage_admin_error_set(USCHED_USAGE_ADMIN_ERR_INVALID_PROPERTY, "show network accept");
+		log_warn("category_network_show(): Invalid 'accept' property: %s\n", args[1]);
+		errno = EINVAL;
+
 		return -1;
 	}
 	
@@ -77,6 +77,142 @@ int exec_admin_commit(void) {
 		return -1;
 	}
 
+	/* retry.depth */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_RETRY_DEPTH, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_RETRY_DEPTH, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_commit(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* retry.delay */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_RETRY_DELAY, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_RETRY_DELAY, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_commit(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* spill.use */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_SPILL_USE, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_SPILL_USE, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_commit(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* spill.file */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_SPILL_FILE, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_SPILL_FILE, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_commit(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* children.max */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_CHILDREN_MAX, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_CHILDREN_MAX, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_commit(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* queue.depth */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_QUEUE_DEPTH, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_QUEUE_DEPTH, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_commit(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* thread.workers */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_THREAD_WORKERS, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_THREAD_WORKERS, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_commit(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* output.max */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_OUTPUT_MAX, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_OUTPUT_MAX, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_commit(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* spool.use */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_SPOOL_USE, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_SPOOL_USE, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_commit(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* spool.dir */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_SPOOL_DIR, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_SPOOL_DIR, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_commit(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* spool.max */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_SPOOL_MAX, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_SPOOL_MAX, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_commit(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* cgroup.use */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_CGROUP_USE, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_CGROUP_USE, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_commit(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* cgroup.dir */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_CGROUP_DIR, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_CGROUP_DIR, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_commit(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* cgroup.group */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_CGROUP_GROUP, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_CGROUP_GROUP, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_commit(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* cgroup.cpu */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_CGROUP_CPU, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_CGROUP_CPU, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_commit(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* cgroup.memory */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_CGROUP_MEMORY, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_CGROUP_MEMORY, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_commit(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* cgroup.io */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_CGROUP_IO, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_CGROUP_IO, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_commit(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
 	/* Re-initialize the configuration */
 	if (config_admin_init() < 0) {
 		errsv = errno;
@@ -100,6 +236,142 @@ int exec_admin_rollback(void) {
 		return -1;
 	}
 
+	/* retry.depth */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_RETRY_DEPTH, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_RETRY_DEPTH, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_rollback(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* retry.delay */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_RETRY_DELAY, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_RETRY_DELAY, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_rollback(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* spill.use */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_SPILL_USE, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_SPILL_USE, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_rollback(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* spill.file */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_SPILL_FILE, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_SPILL_FILE, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_rollback(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* children.max */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_CHILDREN_MAX, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_CHILDREN_MAX, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_rollback(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* queue.depth */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_QUEUE_DEPTH, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_QUEUE_DEPTH, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_rollback(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* thread.workers */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_THREAD_WORKERS, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_THREAD_WORKERS, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_rollback(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* output.max */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_OUTPUT_MAX, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_OUTPUT_MAX, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_rollback(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* spool.use */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_SPOOL_USE, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_SPOOL_USE, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_rollback(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* spool.dir */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_SPOOL_DIR, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_SPOOL_DIR, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_rollback(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* spool.max */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_SPOOL_MAX, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_SPOOL_MAX, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_rollback(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* cgroup.use */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_CGROUP_USE, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_CGROUP_USE, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_rollback(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* cgroup.dir */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_CGROUP_DIR, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_CGROUP_DIR, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_rollback(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* cgroup.group */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_CGROUP_GROUP, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_CGROUP_GROUP, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_rollback(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* cgroup.cpu */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_CGROUP_CPU, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_CGROUP_CPU, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_rollback(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* cgroup.memory */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_CGROUP_MEMORY, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_CGROUP_MEMORY, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_rollback(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* cgroup.io */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/" CONFIG_USCHED_FILE_EXEC_CGROUP_IO, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_EXEC "/." CONFIG_USCHED_FILE_EXEC_CGROUP_IO, 128) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_rollback(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
 	/* All good */
 	return 0;
 }
@@ -114,36 +386,733 @@ int exec_admin_show(void) {
 		return -1;
 	}
 
-	return 0;
-}
+	if (exec_admin_retry_depth_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_show(): exec_admin_retry_depth_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
 
-int exec_admin_delta_noexec_show(void) {
-	int errsv = 0;
+	if (exec_admin_retry_delay_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_show(): exec_admin_retry_delay_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
 
-	if (admin_property_show(CONFIG_USCHED_DIR_EXEC, USCHED_CATEGORY_EXEC_STR, CONFIG_USCHED_FILE_EXEC_DELTA_NOEXEC) < 0) {
+	if (exec_admin_spill_use_show() < 0) {
 		errsv = errno;
-		log_crit("exec_admin_delta_noexec_show(): admin_property_show(): %s\n", strerror(errno));
+		log_crit("exec_admin_show(): exec_admin_spill_use_show(): %s\n", strerror(errno));
 		errno = errsv;
 		return -1;
 	}
 
-	/* All good */
-	return 0;
-}
+	if (exec_admin_spill_file_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_show(): exec_admin_spill_file_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
 
-int exec_admin_delta_noexec_change(const char *delta_noexec) {
-	int errsv = 0;
+	if (exec_admin_children_max_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_show(): exec_admin_children_max_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
 
-	if (admin_property_change(CONFIG_USCHED_DIR_EXEC, CONFIG_USCHED_FILE_EXEC_DELTA_NOEXEC, delta_noexec) < 0) {
+	if (exec_admin_queue_depth_show() < 0) {
 		errsv = errno;
-		log_crit("exec_admin_delta_noexec_change(): admin_property_change(): %s\n", strerror(errno));
+		log_crit("exec_admin_show(): exec_admin_queue_depth_show(): %s\n", strerror(errno));
 		errno = errsv;
 		return -1;
 	}
 
-	if (exec_admin_delta_noexec_show() < 0) {
+	if (exec_admin_thread_workers_show() < 0) {
 		errsv = errno;
-		log_crit("exec_admin_delta_noexec_change(): exec_admin_delta_noexec_show(): %s\n", strerror(errno));
+		log_crit("exec_admin_show(): exec_admin_thread_workers_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_output_max_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_show(): exec_admin_output_max_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_spool_use_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_show(): exec_admin_spool_use_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_spool_dir_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_show(): exec_admin_spool_dir_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_spool_max_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_show(): exec_admin_spool_max_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_cgroup_use_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_show(): exec_admin_cgroup_use_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_cgroup_dir_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_show(): exec_admin_cgroup_dir_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_cgroup_group_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_show(): exec_admin_cgroup_group_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_cgroup_cpu_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_show(): exec_admin_cgroup_cpu_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_cgroup_memory_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_show(): exec_admin_cgroup_memory_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_cgroup_io_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_show(): exec_admin_cgroup_io_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+int exec_admin_delta_noexec_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_EXEC, USCHED_CATEGORY_EXEC_STR, CONFIG_USCHED_FILE_EXEC_DELTA_NOEXEC) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_delta_noexec_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int exec_admin_delta_noexec_change(const char *delta_noexec) {
+	int errsv = 0;
+
+	if (admin_property_change(CONFIG_USCHED_DIR_EXEC, CONFIG_USCHED_FILE_EXEC_DELTA_NOEXEC, delta_noexec) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_delta_noexec_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_delta_noexec_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_delta_noexec_change(): exec_admin_delta_noexec_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+int exec_admin_retry_depth_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_EXEC, USCHED_CATEGORY_EXEC_STR, CONFIG_USCHED_FILE_EXEC_RETRY_DEPTH) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_retry_depth_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int exec_admin_retry_depth_change(const char *retry_depth) {
+	int errsv = 0;
+
+	if (admin_property_change(CONFIG_USCHED_DIR_EXEC, CONFIG_USCHED_FILE_EXEC_RETRY_DEPTH, retry_depth) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_retry_depth_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_retry_depth_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_retry_depth_change(): exec_admin_retry_depth_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+int exec_admin_retry_delay_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_EXEC, USCHED_CATEGORY_EXEC_STR, CONFIG_USCHED_FILE_EXEC_RETRY_DELAY) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_retry_delay_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int exec_admin_retry_delay_change(const char *retry_delay) {
+	int errsv = 0;
+
+	if (admin_property_change(CONFIG_USCHED_DIR_EXEC, CONFIG_USCHED_FILE_EXEC_RETRY_DELAY, retry_delay) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_retry_delay_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_retry_delay_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_retry_delay_change(): exec_admin_retry_delay_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+int exec_admin_spill_use_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_EXEC, USCHED_CATEGORY_EXEC_STR, CONFIG_USCHED_FILE_EXEC_SPILL_USE) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_spill_use_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int exec_admin_spill_use_change(const char *spill_use) {
+	int errsv = 0;
+
+	if (admin_property_change(CONFIG_USCHED_DIR_EXEC, CONFIG_USCHED_FILE_EXEC_SPILL_USE, spill_use) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_spill_use_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_spill_use_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_spill_use_change(): exec_admin_spill_use_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+int exec_admin_spill_file_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_EXEC, USCHED_CATEGORY_EXEC_STR, CONFIG_USCHED_FILE_EXEC_SPILL_FILE) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_spill_file_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int exec_admin_spill_file_change(const char *spill_file) {
+	int errsv = 0;
+
+	if (admin_property_change(CONFIG_USCHED_DIR_EXEC, CONFIG_USCHED_FILE_EXEC_SPILL_FILE, spill_file) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_spill_file_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_spill_file_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_spill_file_change(): exec_admin_spill_file_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+int exec_admin_children_max_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_EXEC, USCHED_CATEGORY_EXEC_STR, CONFIG_USCHED_FILE_EXEC_CHILDREN_MAX) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_children_max_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int exec_admin_children_max_change(const char *children_max) {
+	int errsv = 0;
+
+	if (admin_property_change(CONFIG_USCHED_DIR_EXEC, CONFIG_USCHED_FILE_EXEC_CHILDREN_MAX, children_max) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_children_max_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_children_max_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_children_max_change(): exec_admin_children_max_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+int exec_admin_queue_depth_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_EXEC, USCHED_CATEGORY_EXEC_STR, CONFIG_USCHED_FILE_EXEC_QUEUE_DEPTH) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_queue_depth_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int exec_admin_queue_depth_change(const char *queue_depth) {
+	int errsv = 0;
+
+	if (admin_property_change(CONFIG_USCHED_DIR_EXEC, CONFIG_USCHED_FILE_EXEC_QUEUE_DEPTH, queue_depth) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_queue_depth_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_queue_depth_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_queue_depth_change(): exec_admin_queue_depth_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+int exec_admin_thread_workers_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_EXEC, USCHED_CATEGORY_EXEC_STR, CONFIG_USCHED_FILE_EXEC_THREAD_WORKERS) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_thread_workers_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int exec_admin_thread_workers_change(const char *thread_workers) {
+	int errsv = 0;
+
+	if (admin_property_change(CONFIG_USCHED_DIR_EXEC, CONFIG_USCHED_FILE_EXEC_THREAD_WORKERS, thread_workers) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_thread_workers_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_thread_workers_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_thread_workers_change(): exec_admin_thread_workers_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+int exec_admin_output_max_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_EXEC, USCHED_CATEGORY_EXEC_STR, CONFIG_USCHED_FILE_EXEC_OUTPUT_MAX) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_output_max_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int exec_admin_output_max_change(const char *output_max) {
+	int errsv = 0;
+
+	if (admin_property_change(CONFIG_USCHED_DIR_EXEC, CONFIG_USCHED_FILE_EXEC_OUTPUT_MAX, output_max) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_output_max_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_output_max_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_output_max_change(): exec_admin_output_max_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+int exec_admin_spool_use_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_EXEC, USCHED_CATEGORY_EXEC_STR, CONFIG_USCHED_FILE_EXEC_SPOOL_USE) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_spool_use_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int exec_admin_spool_use_change(const char *spool_use) {
+	int errsv = 0;
+
+	if (admin_property_change(CONFIG_USCHED_DIR_EXEC, CONFIG_USCHED_FILE_EXEC_SPOOL_USE, spool_use) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_spool_use_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_spool_use_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_spool_use_change(): exec_admin_spool_use_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+int exec_admin_spool_dir_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_EXEC, USCHED_CATEGORY_EXEC_STR, CONFIG_USCHED_FILE_EXEC_SPOOL_DIR) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_spool_dir_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int exec_admin_spool_dir_change(const char *spool_dir) {
+	int errsv = 0;
+
+	if (admin_property_change(CONFIG_USCHED_DIR_EXEC, CONFIG_USCHED_FILE_EXEC_SPOOL_DIR, spool_dir) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_spool_dir_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_spool_dir_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_spool_dir_change(): exec_admin_spool_dir_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+int exec_admin_spool_max_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_EXEC, USCHED_CATEGORY_EXEC_STR, CONFIG_USCHED_FILE_EXEC_SPOOL_MAX) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_spool_max_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int exec_admin_spool_max_change(const char *spool_max) {
+	int errsv = 0;
+
+	if (admin_property_change(CONFIG_USCHED_DIR_EXEC, CONFIG_USCHED_FILE_EXEC_SPOOL_MAX, spool_max) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_spool_max_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_spool_max_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_spool_max_change(): exec_admin_spool_max_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+int exec_admin_cgroup_use_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_EXEC, USCHED_CATEGORY_EXEC_STR, CONFIG_USCHED_FILE_EXEC_CGROUP_USE) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_cgroup_use_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int exec_admin_cgroup_use_change(const char *cgroup_use) {
+	int errsv = 0;
+
+	if (admin_property_change(CONFIG_USCHED_DIR_EXEC, CONFIG_USCHED_FILE_EXEC_CGROUP_USE, cgroup_use) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_cgroup_use_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_cgroup_use_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_cgroup_use_change(): exec_admin_cgroup_use_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+int exec_admin_cgroup_dir_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_EXEC, USCHED_CATEGORY_EXEC_STR, CONFIG_USCHED_FILE_EXEC_CGROUP_DIR) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_cgroup_dir_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int exec_admin_cgroup_dir_change(const char *cgroup_dir) {
+	int errsv = 0;
+
+	if (admin_property_change(CONFIG_USCHED_DIR_EXEC, CONFIG_USCHED_FILE_EXEC_CGROUP_DIR, cgroup_dir) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_cgroup_dir_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_cgroup_dir_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_cgroup_dir_change(): exec_admin_cgroup_dir_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+int exec_admin_cgroup_group_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_EXEC, USCHED_CATEGORY_EXEC_STR, CONFIG_USCHED_FILE_EXEC_CGROUP_GROUP) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_cgroup_group_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int exec_admin_cgroup_group_change(const char *cgroup_group) {
+	int errsv = 0;
+
+	if (admin_property_change(CONFIG_USCHED_DIR_EXEC, CONFIG_USCHED_FILE_EXEC_CGROUP_GROUP, cgroup_group) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_cgroup_group_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_cgroup_group_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_cgroup_group_change(): exec_admin_cgroup_group_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+int exec_admin_cgroup_cpu_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_EXEC, USCHED_CATEGORY_EXEC_STR, CONFIG_USCHED_FILE_EXEC_CGROUP_CPU) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_cgroup_cpu_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int exec_admin_cgroup_cpu_change(const char *cgroup_cpu) {
+	int errsv = 0;
+
+	if (admin_property_change(CONFIG_USCHED_DIR_EXEC, CONFIG_USCHED_FILE_EXEC_CGROUP_CPU, cgroup_cpu) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_cgroup_cpu_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_cgroup_cpu_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_cgroup_cpu_change(): exec_admin_cgroup_cpu_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+int exec_admin_cgroup_memory_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_EXEC, USCHED_CATEGORY_EXEC_STR, CONFIG_USCHED_FILE_EXEC_CGROUP_MEMORY) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_cgroup_memory_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int exec_admin_cgroup_memory_change(const char *cgroup_memory) {
+	int errsv = 0;
+
+	if (admin_property_change(CONFIG_USCHED_DIR_EXEC, CONFIG_USCHED_FILE_EXEC_CGROUP_MEMORY, cgroup_memory) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_cgroup_memory_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_cgroup_memory_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_cgroup_memory_change(): exec_admin_cgroup_memory_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+int exec_admin_cgroup_io_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_EXEC, USCHED_CATEGORY_EXEC_STR, CONFIG_USCHED_FILE_EXEC_CGROUP_IO) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_cgroup_io_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int exec_admin_cgroup_io_change(const char *cgroup_io) {
+	int errsv = 0;
+
+	if (admin_property_change(CONFIG_USCHED_DIR_EXEC, CONFIG_USCHED_FILE_EXEC_CGROUP_IO, cgroup_io) < 0) {
+		errsv = errno;
+		log_crit("exec_admin_cgroup_io_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (exec_admin_cgroup_io_show() < 0) {
+		errsv = errno;
+		log_crit("exec_admin_cgroup_io_change(): exec_admin_cgroup_io_show(): %s\n", strerror(errno));
 		errno = errsv;
 		return -1;
 	}
@@ -110,6 +110,14 @@ int ipc_admin_commit(void) {
 		return -1;
 	}
 
+	/* msg.transport */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_IPC "/." CONFIG_USCHED_FILE_IPC_MSG_TRANSPORT, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_IPC "/" CONFIG_USCHED_FILE_IPC_MSG_TRANSPORT, 128) < 0) {
+		errsv = errno;
+		log_crit("ipc_admin_commit(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
 	/* jail.dir */
 	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_IPC "/." CONFIG_USCHED_FILE_IPC_JAIL_DIR, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_IPC "/" CONFIG_USCHED_FILE_IPC_JAIL_DIR, 128) < 0) {
 		errsv = errno;
@@ -189,6 +197,14 @@ int ipc_admin_rollback(void) {
 		return -1;
 	}
 
+	/* msg.transport */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_IPC "/" CONFIG_USCHED_FILE_IPC_MSG_TRANSPORT, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_IPC "/." CONFIG_USCHED_FILE_IPC_MSG_TRANSPORT, 128) < 0) {
+		errsv = errno;
+		log_crit("ipc_admin_rollback(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
 	/* jail.dir */
 	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_IPC "/" CONFIG_USCHED_FILE_IPC_JAIL_DIR, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_IPC "/." CONFIG_USCHED_FILE_IPC_JAIL_DIR, 128) < 0) {
 		errsv = errno;
@@ -255,6 +271,13 @@ int ipc_admin_show(void) {
 		return -1;
 	}
 
+	if (ipc_admin_msg_transport_show() < 0) {
+		errsv = errno;
+		log_crit("ipc_admin_show(): ipc_admin_msg_transport_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
 	if (ipc_admin_jail_dir_show() < 0) {
 		errsv = errno;
 		log_crit("ipc_admin_show(): ipc_admin_jail_dir_show(): %s\n", strerror(errno));
@@ -450,6 +473,46 @@ int ipc_admin_msg_size_change(const char *msg_size) {
 	return 0;
 }
 
+int ipc_admin_msg_transport_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_IPC, USCHED_CATEGORY_IPC_STR, CONFIG_USCHED_FILE_IPC_MSG_TRANSPORT) < 0) {
+		errsv = errno;
+		log_crit("ipc_admin_msg_transport_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int ipc_admin_msg_transport_change(const char *msg_transport) {
+	int errsv = 0;
+
+	if (strcmp(msg_transport, CONFIG_USCHED_IPC_TRANSPORT_PIPC) && strcmp(msg_transport, CONFIG_USCHED_IPC_TRANSPORT_SHM)) {
+		log_crit("ipc_admin_msg_transport_change(): Invalid transport: %s (expected '" CONFIG_USCHED_IPC_TRANSPORT_PIPC "' or '" CONFIG_USCHED_IPC_TRANSPORT_SHM "')\n", msg_transport);
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (admin_property_change(CONFIG_USCHED_DIR_IPC, CONFIG_USCHED_FILE_IPC_MSG_TRANSPORT, msg_transport) < 0) {
+		errsv = errno;
+		log_crit("ipc_admin_msg_transport_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (ipc_admin_msg_transport_show() < 0) {
+		errsv = errno;
+		log_crit("ipc_admin_msg_transport_change(): ipc_admin_msg_transport_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
 int ipc_admin_jail_dir_show(void) {
 	int errsv = 0;
 
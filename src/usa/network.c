@@ -81,6 +81,14 @@ int network_admin_commit(void) {
 		return -1;
 	}
 
+	/* accept.workers */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_NETWORK "/." CONFIG_USCHED_FILE_NETWORK_ACCEPT_WORKERS, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_NETWORK "/" CONFIG_USCHED_FILE_NETWORK_ACCEPT_WORKERS, 128) < 0) {
+		errsv = errno;
+		log_crit("network_admin_commit(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
 	/* All good */
 	return 0;
 }
@@ -128,6 +136,14 @@ int network_admin_rollback(void) {
 		return -1;
 	}
 
+	/* accept.workers */
+	if (fsop_cp(CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_NETWORK "/" CONFIG_USCHED_FILE_NETWORK_ACCEPT_WORKERS, CONFIG_USCHED_DIR_BASE "/" CONFIG_USCHED_DIR_NETWORK "/." CONFIG_USCHED_FILE_NETWORK_ACCEPT_WORKERS, 128) < 0) {
+		errsv = errno;
+		log_crit("network_admin_rollback(): fsop_cp(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
 	/* All good */
 	return 0;
 }
@@ -170,6 +186,13 @@ int network_admin_show(void) {
 		return -1;
 	}
 
+	if (network_admin_accept_workers_show() < 0) {
+		errsv = errno;
+		log_crit("network_admin_show(): network_admin_accept_workers_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
 	return 0;
 }
 
@@ -563,3 +586,37 @@ int network_admin_sock_name_change(const char *sock_name) {
 	return 0;
 }
 
+int network_admin_accept_workers_show(void) {
+	int errsv = 0;
+
+	if (admin_property_show(CONFIG_USCHED_DIR_NETWORK, USCHED_CATEGORY_NETWORK_STR, CONFIG_USCHED_FILE_NETWORK_ACCEPT_WORKERS) < 0) {
+		errsv = errno;
+		log_crit("network_admin_accept_workers_show(): admin_property_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+int network_admin_accept_workers_change(const char *accept_workers) {
+	int errsv = 0;
+
+	if (admin_property_change(CONFIG_USCHED_DIR_NETWORK, CONFIG_USCHED_FILE_NETWORK_ACCEPT_WORKERS, accept_workers) < 0) {
+		errsv = errno;
+		log_crit("network_admin_accept_workers_change(): admin_property_change(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (network_admin_accept_workers_show() < 0) {
+		errsv = errno;
+		log_crit("network_admin_accept_workers_change(): network_admin_accept_workers_show(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
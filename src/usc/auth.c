@@ -146,3 +146,17 @@ int auth_client_remote_session_process(
 	return 0;
 }
 
+uint32_t auth_client_remote_session_ticket_ttl(const unsigned char *session) {
+	uint32_t ttl = 0;
+
+	/* Session contents:
+	 *
+	 * | pubkey (32 bytes) | encrypted server token (32 bytes) | ticket ttl (4 bytes) |
+	 *
+	 * Daemons without session tickets leave the ticket ttl zeroed.
+	 */
+	memcpy(&ttl, session + KE_SERVER_SESSION_SIZE_CHREKE, sizeof(ttl));
+
+	return ntohl(ttl);
+}
+
@@ -33,6 +33,7 @@
 
 #ifndef COMPILE_WIN32
 #include <unistd.h>
+#include <sys/socket.h>
 #endif
 
 #include <panet/panet.h>
@@ -48,9 +49,55 @@
 #include "process.h"
 
 
+/* A request sent to the daemon: either a single entry or a batch carrying 'nmemb' entries */
+struct conn_client_unit {
+	struct usched_entry *req;
+	struct usched_entry **ops;
+	uint32_t nmemb;
+};
+
+static int _conn_client_reusable(void) {
+#ifndef COMPILE_WIN32
+	int errsv = 0;
+	char c = 0;
+	ssize_t ret = 0;
+#endif
+
+	/* Check if there's an open connection from a previous request */
+	if (!runc.fd_open)
+		return 0;
+
+	/* Check if the connection destination is still the same */
+	if (strcmp(runc.fd_hostname, runc.opt.remote_hostname) || strcmp(runc.fd_port, runc.opt.remote_port))
+		return 0;
+
+#ifndef COMPILE_WIN32
+	/* An idle connection has nothing to be read. Pending data or EOF means that the daemon
+	 * dropped the connection (for instance, due to network.conn.timeout).
+	 */
+	errsv = errno;
+	ret = recv(runc.fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+
+	if ((ret < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+		errno = errsv;
+		return 1;
+	}
+
+	errno = errsv;
+#endif
+
+	return 0;
+}
+
 int conn_client_init(void) {
 	int errsv = 0;
 
+	/* Library requests reuse the connection of the previous request, if still valid */
+	if (_conn_client_reusable())
+		return 0;
+
+	conn_client_destroy();
+
 	if (runc.opt.remote_hostname[0]) {
 		if ((runc.fd = panet_client_ipv4(runc.opt.remote_hostname, runc.opt.remote_port, PANET_PROTO_TCP, 5)) == (sock_t) -1) {
 			errsv = errno;
@@ -73,189 +120,458 @@ int conn_client_init(void) {
 	}
 #endif
 
+	/* Keep track of the connection destination */
+	strcpy(runc.fd_hostname, runc.opt.remote_hostname);
+	strcpy(runc.fd_port, runc.opt.remote_port);
+
+	runc.fd_open = 1;
+
 	return 0;
 }
 
-int conn_client_process(void) {
-	int errsv = 0, ret = 0;
-	struct usched_entry *cur = NULL;
-	char *aaa_payload_data = NULL;
-
-	while ((cur = runc.epool->pop(runc.epool))) {
-		/* If this is a remote connection, the payload will be encrypted, so we need to
-		 * inform the remote party of size of the encrypted payload and not the current
-		 * (plain) size.
+static void _conn_client_hdr_hton(struct usched_entry *cur) {
+	/* If this is a remote connection, the payload will be encrypted, so we need to
+	 * inform the remote party of size of the encrypted payload and not the current
+	 * (plain) size.
+	 */
+	if (conn_is_remote(runc.fd)) {
+		/* TODO or FIXME: If we're going to encrypt this entry, why not do it right
+		 * here instead of doing lots of calculations on entry->psize along this
+		 * rountine?
 		 */
-		if (conn_is_remote(runc.fd)) {
-			/* TODO or FIXME: If we're going to encrypt this entry, why not do it right
-			 * here instead of doing lots of calculations on entry->psize along this
-			 * rountine?
-			 */
-			cur->psize += CRYPT_EXTRA_SIZE_CHACHA20POLY1305;
-		}
+		cur->psize += CRYPT_EXTRA_SIZE_CHACHA20POLY1305;
+	}
+
+	/* Convert endianness to network byte order */
+	cur->id = htonll(cur->id);
+	cur->flags = htonl(cur->flags);
+
+	if (conn_is_remote(runc.fd)) {
+		/* For remote connections, UID and GID must be set to 0xff */
+		cur->uid = htonl(0xff);
+		cur->gid = htonl(0xff);
+	} else {
+		cur->uid = htonl(cur->uid);
+		cur->gid = htonl(cur->gid);
+	}
+
+	cur->trigger = htonl(cur->trigger);
+	cur->step = htonl(cur->step);
+	cur->expire = htonl(cur->expire);
+	cur->version = htonl(cur->version);
+	cur->overlap = htonl(cur->overlap);
+	cur->concurrency = htonl(cur->concurrency);
+	cur->priority = htonl(cur->priority);
+	/* We can ignore pid, status, exec_time, latency, outdata_len and outdata here */
+	cur->psize = htonl(cur->psize);
+}
+
+static void _conn_client_hdr_ntoh(struct usched_entry *cur) {
+	/* Convert endianness to host byte order */
+	cur->id = ntohll(cur->id);
+	cur->flags = ntohl(cur->flags);
+	cur->uid = ntohl(cur->uid);
+	cur->gid = ntohl(cur->gid);
+	cur->trigger = ntohl(cur->trigger);
+	cur->step = ntohl(cur->step);
+	cur->expire = ntohl(cur->expire);
+	cur->version = ntohl(cur->version);
+	cur->overlap = ntohl(cur->overlap);
+	cur->concurrency = ntohl(cur->concurrency);
+	cur->priority = ntohl(cur->priority);
+	cur->psize = ntohl(cur->psize) - (conn_is_remote(runc.fd) ? CRYPT_EXTRA_SIZE_CHACHA20POLY1305 : 0); /* Set the original payload size if the connection is remote. */
+}
 
-		/* Convert endianness to network byte order */
-		cur->id = htonll(cur->id);
-		cur->flags = htonl(cur->flags);
-
-		if (conn_is_remote(runc.fd)) {
-			/* For remote connections, UID and GID must be set to 0xff */
-			cur->uid = htonl(0xff);
-			cur->gid = htonl(0xff);
-		} else {
-			cur->uid = htonl(cur->uid);
-			cur->gid = htonl(cur->gid);
+static int _conn_client_ticket_usable(void) {
+	/* Check if a session ticket is held for the current destination and username */
+	if (!runc.ticket.expire || (runc.ticket.expire <= time(NULL)))
+		return 0;
+
+	if (strcmp(runc.ticket.hostname, runc.opt.remote_hostname) || strcmp(runc.ticket.port, runc.opt.remote_port) || strcmp(runc.ticket.username, runc.opt.remote_username))
+		return 0;
+
+	return 1;
+}
+
+static void _conn_client_ticket_discard(void) {
+	memset(&runc.ticket, 0, sizeof(runc.ticket));
+}
+
+static int _conn_client_send_hdr(struct usched_entry *cur) {
+	int errsv = 0;
+
+	/* Set username and session data if this is a remote connection */
+	if (conn_is_remote(runc.fd)) {
+		/* Set username */
+		if (strlen(runc.opt.remote_username) >= sizeof(cur->username)) {
+			log_crit("_conn_client_send_hdr(): The requested username is too long to be processed: %s\n", runc.opt.remote_username);
+			errno = EINVAL;
+			return -1;
 		}
 
-		cur->trigger = htonl(cur->trigger);
-		cur->step = htonl(cur->step);
-		cur->expire = htonl(cur->expire);
-		/* We can ignore pid, status, exec_time, latency, outdata_len and outdata here */
-		cur->psize = htonl(cur->psize);
-
-		/* Set username and session data if this is a remote connection */
-		if (conn_is_remote(runc.fd)) {
-			/* Set username */
-			if (strlen(runc.opt.remote_username) >= sizeof(cur->username)) {
-				log_crit("conn_client_process(): The requested username is too long to be processed: %s\n", runc.opt.remote_username);
-				/* The payload size is in network byte order. We need to revert it
-				 * before calling entry_destroy().
-				 */
-				cur->psize = ntohl(cur->psize) - CRYPT_EXTRA_SIZE_CHACHA20POLY1305;
-				entry_destroy(cur);
-				errno = EINVAL;
-				return -1;
-			}
+		strcpy(cur->username, runc.opt.remote_username);
 
-			strcpy(cur->username, runc.opt.remote_username);
+		entry_unset_flag(cur, USCHED_ENTRY_FLAG_RESUME);
 
-			/* Set the session data */
-			if (entry_client_remote_session_create(cur, runc.opt.remote_password) < 0) {
+		/* Resume the session from the ticket of a previous authentication, if possible */
+		if (_conn_client_ticket_usable()) {
+			if (entry_client_remote_session_resume(cur, &runc.ticket) < 0) {
 				errsv = errno;
-				log_crit("conn_client_process(): entry_client_remote_session_create(): %s\n", strerror(errno));
-				/* The payload size is in network byte order. We need to revert it
-				 * before calling entry_destroy().
-				 */
-				cur->psize = ntohl(cur->psize) - CRYPT_EXTRA_SIZE_CHACHA20POLY1305;
-				entry_destroy(cur);
+				log_crit("_conn_client_send_hdr(): entry_client_remote_session_resume(): %s\n", strerror(errno));
 				errno = errsv;
 				return -1;
 			}
-		}
-
-		/* Send the first entry block */
-		if (conn_write_blocking(runc.fd, cur, usched_entry_hdr_size()) != (ssize_t) usched_entry_hdr_size()) {
+		} else if (entry_client_remote_session_create(cur, runc.opt.remote_password) < 0) {
 			errsv = errno;
-			log_crit("conn_client_process(): conn_write_blocking() != %d: %s\n", usched_entry_hdr_size(), strerror(errno));
-			/* The payload size is in network byte order. We need to revert it before
-			 * calling entry_destroy().
-			 */
-			cur->psize = ntohl(cur->psize) - (conn_is_remote(runc.fd) ? CRYPT_EXTRA_SIZE_CHACHA20POLY1305 : 0);
-			entry_destroy(cur);
+			log_crit("_conn_client_send_hdr(): entry_client_remote_session_create(): %s\n", strerror(errno));
 			errno = errsv;
 			return -1;
 		}
+	}
+
+	_conn_client_hdr_hton(cur);
+
+	/* Send the first entry block */
+	if (conn_write_blocking(runc.fd, cur, usched_entry_hdr_size()) != (ssize_t) usched_entry_hdr_size()) {
+		errsv = errno;
+		log_crit("_conn_client_send_hdr(): conn_write_blocking() != %d: %s\n", usched_entry_hdr_size(), strerror(errno));
+		_conn_client_hdr_ntoh(cur);
+		errno = errsv;
+		return -1;
+	}
+
+	_conn_client_hdr_ntoh(cur);
+
+	return 0;
+}
+
+static int _conn_client_recv_session(struct usched_entry *cur) {
+	int errsv = 0;
+	usched_entry_reject_t reason = USCHED_ENTRY_REJECT_NONE;
+
+	/* Read the session token into the session field for further processing */
+	if (conn_read_blocking(runc.fd, cur->session, sizeof(cur->session)) != (ssize_t) sizeof(cur->session)) {
+		errsv = errno;
+		log_crit("_conn_client_recv_session(): conn_read_blocking() != sizeof(cur->session): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* The daemon may reject the request before processing it */
+	if ((reason = entry_reject_get(cur->session)) == USCHED_ENTRY_REJECT_RATE) {
+		log_crit("_conn_client_recv_session(): Request rejected by the daemon: Request rate limit exceeded.\n");
+		errno = EBUSY;
+		return -1;
+	} else if (reason == USCHED_ENTRY_REJECT_QUOTA) {
+		log_crit("_conn_client_recv_session(): Request rejected by the daemon: Active entries quota reached.\n");
+		errno = EDQUOT;
+		return -1;
+	} else if (reason != USCHED_ENTRY_REJECT_NONE) {
+		log_crit("_conn_client_recv_session(): Request rejected by the daemon (reason: %u).\n", (unsigned int) reason);
+		errno = EPERM;
+		return -1;
+	}
 
-		/* Convert endianness to host byte order */
-		cur->id = ntohll(cur->id);
-		cur->flags = ntohl(cur->flags);
-		cur->uid = ntohl(cur->uid);
-		cur->gid = ntohl(cur->gid);
-		cur->trigger = ntohl(cur->trigger);
-		cur->step = ntohl(cur->step);
-		cur->expire = ntohl(cur->expire);
-		cur->psize = ntohl(cur->psize) - (conn_is_remote(runc.fd) ? CRYPT_EXTRA_SIZE_CHACHA20POLY1305 : 0); /* Set the original payload size if the connection is remote. */
-
-		/* Read the session token into the session field for further processing */
-		if (conn_read_blocking(runc.fd, cur->session, sizeof(cur->session)) != (ssize_t) sizeof(cur->session)) {
+	return 0;
+}
+
+static int _conn_client_send_payload(struct usched_entry *cur) {
+	int errsv = 0;
+	uint32_t ticket_ttl = 0;
+
+	/* If this a remote connection, read the session field, which contains session data,
+	 * and rewrite it with authentication information.
+	 */
+	if (conn_is_remote(runc.fd)) {
+		/* The daemon advertises the session ticket lifetime on full key exchanges */
+		if (!entry_has_flag(cur, USCHED_ENTRY_FLAG_RESUME))
+			ticket_ttl = auth_client_remote_session_ticket_ttl(cur->session);
+
+		/* Process remote session data */
+		if (entry_client_remote_session_process(cur, runc.opt.remote_password) < 0) {
 			errsv = errno;
-			log_crit("conn_client_process(): conn_read_blocking() != sizeof(cur->session): %s\n", strerror(errno));
-			entry_destroy(cur);
+			log_crit("_conn_client_send_payload(): entry_client_remote_session_process(): %s\n", strerror(errno));
 			errno = errsv;
 			return -1;
 		}
 
-		/* If this a remote connection, read the session field, which contains session data,
-		 * and rewrite it with authentication information.
-		 */
-		if (conn_is_remote(runc.fd)) {
-			/* Process remote session data */
-			if (entry_client_remote_session_process(cur, runc.opt.remote_password) < 0) {
-				errsv = errno;
-				log_crit("conn_client_process(): entry_client_remote_session_process(): %s\n", strerror(errno));
-				entry_destroy(cur);
-				errno = errsv;
-				return -1;
-			}
-
-			/* Encrypt payload */
-			if (entry_payload_encrypt(cur, 0) < 0) {
-				errsv = errno;	
-				log_crit("conn_client_process(): entry_payload_encrypt(): %s\n", strerror(errno));
-				entry_destroy(cur);
-				errno = errsv;
-				return -1;
-			}
+		/* Keep a session ticket, so further requests can skip the key exchange */
+		if (ticket_ttl && (entry_client_remote_ticket_create(cur, ticket_ttl, &runc.ticket) == 0)) {
+			strcpy(runc.ticket.hostname, runc.opt.remote_hostname);
+			strcpy(runc.ticket.port, runc.opt.remote_port);
 		}
 
-		/* Craft the token and payload together */
-		if (!(aaa_payload_data = mm_alloc(sizeof(cur->session) + cur->psize))) {
-			errsv = errno;
-			log_crit("conn_client_process(): mm_alloc(): %s\n", strerror(errno));
-			entry_destroy(cur);
+		/* Encrypt payload */
+		if (entry_payload_encrypt(cur, 0) < 0) {
+			errsv = errno;	
+			log_crit("_conn_client_send_payload(): entry_payload_encrypt(): %s\n", strerror(errno));
 			errno = errsv;
 			return -1;
 		}
+	}
 
-		/* Craft the session/authentication information along with the payload */
-		memcpy(aaa_payload_data, cur->session, sizeof(cur->session));
-		memcpy(aaa_payload_data + sizeof(cur->session), cur->payload, cur->psize);
+	/* Send the authentication and authorization data along entry payload. Both are sent
+	 * from where they live, without being crafted into a single buffer first.
+	 */
+	if (conn_writev_blocking(runc.fd, (struct iovec [2]) { { cur->session, sizeof(cur->session) }, { cur->payload, cur->psize } }, 2) != (ssize_t) (sizeof(cur->session) + cur->psize)) {
+		errsv = errno;
+		log_crit("_conn_client_send_payload(): conn_writev_blocking() != (sizeof(cur->session) + cur->psize): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+static int _conn_client_recv(struct conn_client_unit *unit) {
+	int errsv = 0, ret = 0;
+	struct usched_entry *cur = unit->req;
+
+	/* Process the response */
+	if (unit->nmemb > 1) {
+		ret = process_client_recv_batch(cur, unit->ops, unit->nmemb);
+	} else if (entry_has_flag(cur, USCHED_ENTRY_FLAG_NEW)) {
+		ret = process_client_recv_run(cur);
+	} else if (entry_has_flag(cur, USCHED_ENTRY_FLAG_DEL)) {
+		ret = process_client_recv_stop(cur);
+	} else if (entry_has_flag(cur, USCHED_ENTRY_FLAG_GET)) {
+		ret = process_client_recv_show(cur);
+	} else if (entry_has_flag(cur, USCHED_ENTRY_FLAG_PAUSE)) {
+		ret = process_client_recv_hold(cur);
+	} else if (entry_has_flag(cur, USCHED_ENTRY_FLAG_SUBSCRIBE)) {
+		ret = process_client_recv_subscribe(cur);
+
+		/* The daemon keeps pushing records to a subscription connection, so it can't be
+		 * reused by further requests.
+		 */
+		conn_client_destroy();
+	} else {
+		log_warn("_conn_client_recv(): Unexpected value found in entry->flags\n");
+		errno = EINVAL;
+		ret = -1;
+	}
+
+	/* Check if a valid response was received */
+	if (ret < 0) {
+		errsv = errno;
+		log_crit("_conn_client_recv(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+static int _conn_client_batchable(const struct usched_entry *first, const struct usched_entry *cur) {
+	/* Only NEW, DEL and GET requests can be carried by a batch request */
+	if (!entry_has_flag(cur, USCHED_ENTRY_FLAG_NEW) && !entry_has_flag(cur, USCHED_ENTRY_FLAG_DEL) && !entry_has_flag(cur, USCHED_ENTRY_FLAG_GET))
+		return 0;
+
+	/* Projected GET responses are streamed and can't be carried by a batch response */
+	if (entry_has_flag(cur, USCHED_ENTRY_FLAG_PROJECT))
+		return 0;
+
+	/* All the operations of a batch belong to the same requester */
+	if (first && ((first->uid != cur->uid) || (first->gid != cur->gid)))
+		return 0;
+
+	return 1;
+}
+
+static struct usched_entry *_conn_client_batch_create(struct usched_entry **ops, uint32_t nmemb) {
+	int errsv = 0;
+	uint32_t i = 0;
+	size_t len = 8, offset = 0;
+	char *frame = NULL;
+	struct usched_entry *batch = NULL;
+
+	for (i = 0; i < nmemb; i ++)
+		len += sizeof(struct usched_entry_batch_op) + ops[i]->psize;
+
+	/* Craft the batch frame */
+	if (!(frame = mm_alloc(len))) {
+		errsv = errno;
+		log_crit("_conn_client_batch_create(): mm_alloc(): %s\n", strerror(errno));
+		errno = errsv;
+		return NULL;
+	}
+
+	memcpy(frame, (uint32_t [1]) { htonl(CONFIG_USCHED_BATCH_VERSION) }, 4);
+	memcpy(frame + 4, (uint32_t [1]) { htonl(nmemb) }, 4);
+
+	for (i = 0, offset = 8; i < nmemb; i ++) {
+		memcpy(frame + offset, (struct usched_entry_batch_op [1]) { {
+			htonl(ops[i]->flags),
+			htonl(ops[i]->trigger),
+			htonl(ops[i]->step),
+			htonl(ops[i]->expire),
+			htonl(ops[i]->overlap),
+			htonl(ops[i]->concurrency),
+			htonl(ops[i]->priority),
+			htonl(ops[i]->psize)
+		} }, sizeof(struct usched_entry_batch_op));
+		offset += sizeof(struct usched_entry_batch_op);
+
+		memcpy(frame + offset, ops[i]->payload, ops[i]->psize);
+		offset += ops[i]->psize;
+	}
+
+	/* All the operations belong to the same requester */
+	if (!(batch = entry_client_init(ops[0]->uid, ops[0]->gid, 0, frame, len))) {
+		errsv = errno;
+		log_crit("_conn_client_batch_create(): entry_client_init(): %s\n", strerror(errno));
+		memset(frame, 0, len);
+		mm_free(frame);
+		errno = errsv;
+		return NULL;
+	}
+
+	memset(frame, 0, len);
+	mm_free(frame);
+
+	entry_set_flag(batch, USCHED_ENTRY_FLAG_BATCH);
+
+	return batch;
+}
+
+static int _conn_client_pipeline(struct conn_client_unit *units, size_t units_nmemb, unsigned int *retry) {
+	size_t i = 0;
+
+	*retry = 0;
+
+	/* Requests are pipelined: the header of the next request is sent before waiting for the
+	 * response of the current one. The daemon processes the requests of a connection in order,
+	 * so responses are received in the same order the requests were sent.
+	 */
+	if (units_nmemb && (_conn_client_send_hdr(units[0].req) < 0))
+		return -1;
+
+	for (i = 0; i < units_nmemb; i ++) {
+		if (_conn_client_recv_session(units[i].req) < 0) {
+			/* The daemon drops the connection when a session ticket is rejected. Nothing was
+			 * processed yet if this happens on the first request, so it can be retried. Requests
+			 * rejected by the admission control would be rejected again.
+			 */
+			*retry = !i && entry_has_flag(units[i].req, USCHED_ENTRY_FLAG_RESUME) && (errno != EBUSY) && (errno != EDQUOT) && (errno != EPERM);
 
-		/* Send the authentication and authorization data along entry payload */
-		if (conn_write_blocking(runc.fd, aaa_payload_data, sizeof(cur->session) + cur->psize) != (ssize_t) (sizeof(cur->session) + cur->psize)) {
-			errsv = errno;
-			log_crit("conn_client_process(): conn_write_blocking() != (sizeof(cur->session) + cur->psize): %s\n", strerror(errno));
-			entry_destroy(cur);
-			mm_free(aaa_payload_data);
-			errno = errsv;
 			return -1;
 		}
 
-		/* Reset and free aaa_payload_data */
-		memset(aaa_payload_data, 0, sizeof(cur->session) + cur->psize);
-		mm_free(aaa_payload_data);
-
-		/* Process the response */
-		if (entry_has_flag(cur, USCHED_ENTRY_FLAG_NEW)) {
-			ret = process_client_recv_run(cur);
-		} else if (entry_has_flag(cur, USCHED_ENTRY_FLAG_DEL)) {
-			ret = process_client_recv_stop(cur);
-		} else if (entry_has_flag(cur, USCHED_ENTRY_FLAG_GET)) {
-			ret = process_client_recv_show(cur);
-		} else if (entry_has_flag(cur, USCHED_ENTRY_FLAG_PAUSE)) {
-			ret = process_client_recv_hold(cur);
-		} else {
-			log_warn("conn_client_process(): Unexpected value found in entry->flags\n");
-			errno = EINVAL;
-			ret = -1;
-		}
+		if (_conn_client_send_payload(units[i].req) < 0)
+			return -1;
 
-		/* Check if a valid response was received */
-		if (ret < 0) {
-			errsv = errno;
-			log_crit("conn_client_process(): %s\n", strerror(errno));
-			entry_destroy(cur);
-			errno = errsv;
+		/* The daemon doesn't read any further requests from a subscription connection */
+		if (((i + 1) < units_nmemb) && !entry_has_flag(units[i].req, USCHED_ENTRY_FLAG_SUBSCRIBE) && (_conn_client_send_hdr(units[i + 1].req) < 0))
 			return -1;
-		}
 
-		entry_destroy(cur);
+		if (_conn_client_recv(&units[i]) < 0)
+			return -1;
 	}
 
 	return 0;
 }
 
+int conn_client_process(void) {
+	int errsv = 0, ret = -1;
+	unsigned int retry = 0;
+	size_t i = 0, count = 0, units_nmemb = 0;
+	uint32_t n = 0;
+	struct usched_entry **entries = NULL;
+	struct conn_client_unit *units = NULL;
+
+	if (!(count = runc.epool->count(runc.epool)))
+		return 0;
+
+	if (!(entries = mm_alloc(count * sizeof(struct usched_entry *)))) {
+		errsv = errno;
+		log_crit("conn_client_process(): mm_alloc(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (!(units = mm_alloc(count * sizeof(struct conn_client_unit)))) {
+		errsv = errno;
+		log_crit("conn_client_process(): mm_alloc(): %s\n", strerror(errno));
+		mm_free(entries);
+		errno = errsv;
+		return -1;
+	}
+
+	memset(units, 0, count * sizeof(struct conn_client_unit));
+
+	for (i = 0; i < count; i ++) {
+		if (!(entries[i] = runc.epool->pop(runc.epool)))
+			break;
+	}
+
+	count = i;
+
+	/* Consecutive compatible entries are carried by a single batch request. Any other entry is
+	 * sent on its own, preserving the original order.
+	 */
+	for (i = 0; i < count; i += n, units_nmemb ++) {
+		for (n = 1; _conn_client_batchable(NULL, entries[i]) && ((i + n) < count) && (n < CONFIG_USCHED_BATCH_NMEMB_MAX) && _conn_client_batchable(entries[i], entries[i + n]); n ++);
+
+		units[units_nmemb].ops = &entries[i];
+		units[units_nmemb].nmemb = n;
+
+		if (n == 1) {
+			units[units_nmemb].req = entries[i];
+		} else if (!(units[units_nmemb].req = _conn_client_batch_create(&entries[i], n))) {
+			errsv = errno;
+			goto _process_finish;
+		}
+	}
+
+	/* Process all the requests. A rejected session ticket is discarded and the requests are
+	 * retried once with a full key exchange, on a new connection.
+	 */
+	if ((ret = _conn_client_pipeline(units, units_nmemb, &retry)) < 0) {
+		errsv = errno;
+
+		if (retry) {
+			_conn_client_ticket_discard();
+			conn_client_destroy();
+
+			if (conn_client_init() < 0) {
+				errsv = errno;
+				goto _process_finish;
+			}
+
+			if ((ret = _conn_client_pipeline(units, units_nmemb, &retry)) < 0)
+				errsv = errno;
+		}
+	}
+
+_process_finish:
+	for (i = 0; i < units_nmemb; i ++) {
+		if ((units[i].nmemb > 1) && units[i].req)
+			entry_destroy(units[i].req);
+	}
+
+	for (i = 0; i < count; i ++)
+		entry_destroy(entries[i]);
+
+	mm_free(units);
+	mm_free(entries);
+
+	/* The state of the connection is unknown after a failure, so it can't be reused. The
+	 * session ticket may have been rejected, so it's also discarded.
+	 */
+	if (ret < 0) {
+		_conn_client_ticket_discard();
+		conn_client_destroy();
+		errno = errsv;
+	}
+
+	return ret;
+}
+
 void conn_client_destroy(void) {
+	if (!runc.fd_open)
+		return;
+
 	panet_safe_close(runc.fd);
-}
 
+	runc.fd_open = 0;
+}
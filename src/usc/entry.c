@@ -45,6 +45,10 @@
 #include "log.h"
 #include "auth.h"
 
+#if KE_CONTEXT_SIZE_CHREKE < CONFIG_USCHED_AUTH_TICKET_SIZE
+ #error "KE_CONTEXT_SIZE_CHREKE is too small to hold the client nonce of resumed sessions."
+#endif
+
 struct usched_entry *entry_client_init(uid_t uid, gid_t gid, time_t trigger, void *payload, size_t psize) {
 	int errsv = 0;
 	struct usched_entry *entry = NULL;
@@ -58,6 +62,8 @@ struct usched_entry *entry_client_init(uid_t uid, gid_t gid, time_t trigger, voi
 
 	memset(entry, 0, sizeof(struct usched_entry));
 
+	entry->version = CONFIG_USCHED_ENTRY_HDR_VERSION;
+
 	entry_set_uid(entry, uid);
 	entry_set_gid(entry, gid);
 	entry_set_trigger(entry, trigger);
@@ -87,8 +93,88 @@ int entry_client_remote_session_create(struct usched_entry *entry, const char *p
 	return 0;
 }
 
+int entry_client_remote_session_resume(struct usched_entry *entry, const struct usched_auth_client_ticket *ticket) {
+	int errsv = 0;
+	unsigned char client_nonce[CONFIG_USCHED_AUTH_TICKET_SIZE];
+
+	if (!generate_bytes_random(client_nonce, sizeof(client_nonce))) {
+		errsv = errno;
+		log_warn("entry_client_remote_session_resume(): generate_bytes_random(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Session data contents:
+	 *
+	 * | ticket id (32 bytes) | client nonce (32 bytes) |
+	 *
+	 */
+	memset(entry->session, 0, sizeof(entry->session));
+	memcpy(entry->session, ticket->id, sizeof(ticket->id));
+	memcpy(entry->session + sizeof(ticket->id), client_nonce, sizeof(client_nonce));
+
+	/* Keep the ticket key and the client nonce until the server nonce is received. The key
+	 * exchange context isn't used by resumed sessions.
+	 */
+	memset(&entry->crypto, 0, sizeof(entry->crypto));
+	memcpy(entry->crypto.agreed_key, ticket->key, sizeof(ticket->key));
+	memcpy(entry->crypto.context, client_nonce, sizeof(client_nonce));
+
+	entry_set_flag(entry, USCHED_ENTRY_FLAG_RESUME);
+
+	return 0;
+}
+
+int entry_client_remote_ticket_create(const struct usched_entry *entry, uint32_t ttl, struct usched_auth_client_ticket *ticket) {
+	/* The daemon doesn't issue session tickets */
+	if (!ttl) {
+		errno = ENOSYS;
+		return -1;
+	}
+
+	memset(ticket, 0, sizeof(struct usched_auth_client_ticket));
+
+	entry_ticket_derive(entry, ticket->id, ticket->key);
+
+	strncpy(ticket->username, entry->username, sizeof(ticket->username) - 1);
+
+	/* Expire the ticket slightly before the daemon does */
+	ticket->expire = time(NULL) + ttl - 1;
+
+	return 0;
+}
+
 int entry_client_remote_session_process(struct usched_entry *entry, const char *password) {
 	int errsv = 0;
+	unsigned char ticket_key[CONFIG_USCHED_AUTH_TICKET_SIZE];
+	unsigned char server_nonce[CONFIG_USCHED_AUTH_TICKET_SIZE];
+
+	/* Resumed sessions: derive the request key and prove its knowledge */
+	if (entry_has_flag(entry, USCHED_ENTRY_FLAG_RESUME)) {
+		/* Session data contents:
+		 *
+		 * | server nonce (32 bytes) |
+		 *
+		 */
+		memcpy(server_nonce, entry->session, sizeof(server_nonce));
+		memcpy(ticket_key, entry->crypto.agreed_key, sizeof(ticket_key));
+
+		entry_ticket_session_key(entry, ticket_key, entry->crypto.context, server_nonce);
+
+		memset(ticket_key, 0, sizeof(ticket_key));
+		memset(entry->crypto.context, 0, sizeof(entry->crypto.context));
+
+		/* Session data contents:
+		 *
+		 * | proof (32 bytes) |
+		 *
+		 */
+		memset(entry->session, 0, sizeof(entry->session));
+		entry_ticket_session_proof(entry, entry->session);
+
+		/* All good */
+		return 0;
+	}
 
 	/* Process remote session data */
 	if (auth_client_remote_session_process(entry->session, entry->username, password, entry->crypto.context, entry->crypto.agreed_key) < 0) {
@@ -147,6 +147,62 @@ int usched_opt_set_remote_password(char *password) {
 	return 0;
 }
 
+#ifdef COMPILE_WIN32
+DLLIMPORT
+#endif
+int usched_opt_set_exec_overlap(char *overlap) {
+	int ret = 0;
+
+	if ((ret = opt_client_exec_overlap_parse(overlap)) < 0)
+		return -1;
+
+	runc.opt.exec_overlap = (unsigned int) ret;
+
+	return 0;
+}
+
+#ifdef COMPILE_WIN32
+DLLIMPORT
+#endif
+int usched_opt_set_exec_concurrency(char *concurrency) {
+	int ret = 0;
+
+	if ((ret = opt_client_exec_concurrency_parse(concurrency)) < 0)
+		return -1;
+
+	runc.opt.exec_concurrency = (unsigned int) ret;
+
+	return 0;
+}
+
+#ifdef COMPILE_WIN32
+DLLIMPORT
+#endif
+int usched_opt_set_exec_priority(char *priority) {
+	int ret = 0;
+
+	if ((ret = opt_client_exec_priority_parse(priority)) < 0)
+		return -1;
+
+	runc.opt.exec_priority = (unsigned int) ret;
+
+	return 0;
+}
+
+#ifdef COMPILE_WIN32
+DLLIMPORT
+#endif
+int usched_opt_set_show_fields(char *fields) {
+	return opt_client_show_fields_parse(fields, &runc.opt.show_fields);
+}
+
+#ifdef COMPILE_WIN32
+DLLIMPORT
+#endif
+void usched_opt_set_subscribe_handler(int (*handler) (const struct usched_entry *record)) {
+	runc.subscribe_handler = handler;
+}
+
 #ifdef COMPILE_WIN32
 DLLIMPORT
 #endif
@@ -144,6 +144,20 @@ int logic_client_process_run(void) {
 		/* This is a new entry */
 		entry_set_flag(entry, USCHED_ENTRY_FLAG_NEW);
 
+		/* Set the execution overlap policy and concurrency limit */
+		entry_set_overlap(entry, (usched_entry_overlap_t) runc.opt.exec_overlap);
+		entry_set_concurrency(entry, runc.opt.exec_concurrency);
+
+		/* Set the execution priority class */
+		entry_set_priority(entry, (usched_entry_priority_t) runc.opt.exec_priority);
+
+		/* Set the execution mode, if one was requested. Otherwise the daemon decides it. */
+		if (bit_test(&runc.req->flags, USCHED_REQ_FLAG_EXEC_SHELL)) {
+			entry_set_flag(entry, USCHED_ENTRY_FLAG_EXEC_SHELL);
+		} else if (bit_test(&runc.req->flags, USCHED_REQ_FLAG_EXEC_DIRECT)) {
+			entry_set_flag(entry, USCHED_ENTRY_FLAG_EXEC_DIRECT);
+		}
+
 		/* Check if the initial trigger is relative to the current time
 		 * This is only possible on IN prepositions
 		 */
@@ -314,7 +328,7 @@ int logic_client_process_show(void) {
 	char *ptr = NULL, *saveptr = NULL, *endptr = NULL;
 	struct usched_client_request *cur = NULL;
 	struct usched_entry *entry = NULL;
-	uint64_t *entry_list = NULL;
+	uint64_t *entry_list = NULL, *entry_list_fields = NULL;
 	uint64_t entry_id = 0;
 	size_t entry_list_nmemb = 0;
 
@@ -362,8 +376,21 @@ int logic_client_process_show(void) {
 		return -1;
 	}
 
+	/* Prepend the requested fields to the entry list (see USCHED_ENTRY_FLAG_PROJECT) */
+	if (!(entry_list_fields = mm_realloc(entry_list, (entry_list_nmemb + 1) * sizeof(uint64_t)))) {
+		errsv = errno;
+		mm_free(entry_list);
+		errno = errsv;
+		return -1;
+	}
+
+	entry_list = entry_list_fields;
+
+	memmove(&entry_list[1], &entry_list[0], entry_list_nmemb * sizeof(uint64_t));
+	memcpy(&entry_list[0], (uint32_t [2]) { htonl(runc.opt.show_fields), 0 }, sizeof(uint64_t));
+
 	/* Initialize the entry to be transmitted */
-	if (!(entry = entry_client_init(cur->uid, cur->gid, 0, entry_list, entry_list_nmemb * sizeof(uint64_t)))) {
+	if (!(entry = entry_client_init(cur->uid, cur->gid, 0, entry_list, (entry_list_nmemb + 1) * sizeof(uint64_t)))) {
 		errsv = errno;
 		mm_free(entry_list);
 		errno = errsv;
@@ -373,8 +400,9 @@ int logic_client_process_show(void) {
 	/* Free entry_list */
 	mm_free(entry_list);
 
-	/* Set this entry to be deleted */
+	/* Set this entry to be fetched, streamed with the requested fields only */
 	entry_set_flag(entry, USCHED_ENTRY_FLAG_GET);
+	entry_set_flag(entry, USCHED_ENTRY_FLAG_PROJECT);
 
 	/* Push the entry into the entries pool */
 	if (runc.epool->push(runc.epool, entry) < 0) {
@@ -389,4 +417,83 @@ int logic_client_process_show(void) {
 	return 0;
 }
 
+int logic_client_process_subscribe(void) {
+	int errsv = 0;
+	char *ptr = NULL, *saveptr = NULL, *endptr = NULL;
+	struct usched_client_request *cur = NULL;
+	struct usched_entry *entry = NULL;
+	uint64_t *entry_list = NULL;
+	uint64_t entry_id = 0;
+	size_t entry_list_nmemb = 0;
+
+	/* Validate the if the current request list has at least one valid entry */
+	if (!(cur = runc.req)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Validate if this request refers to all entries beloging to this user */
+	if (!strcasecmp(cur->subj, USCHED_SUBJ_ALL_STR)) {
+		entry_list_nmemb = 1;
+
+		if (!(entry_list = mm_alloc(sizeof(uint64_t))))
+			return -1;
+
+		entry_list[0] = USCHED_SUBJ_ALL; /* means all entries belonging to this user */
+	} else {
+		/* Iterate the current request list in order to craft an entry payload */
+		for (ptr = cur->subj, entry_list_nmemb = 0; (ptr = strtok_r(ptr, ",", &saveptr)); ptr = NULL) {
+			entry_list_nmemb ++;
+
+			/* Realloc the entry_list size */
+			if (!(entry_list = mm_realloc(entry_list, entry_list_nmemb * sizeof(uint64_t))))
+				return -1;
+
+			/* If the requested entry id to be subscribed is 0 or invalid, fail to accept logic */
+			if (!(entry_id = strtoull(ptr, &endptr, 16)) || (*endptr) || (endptr == ptr)) {
+				mm_free(entry_list);
+				errno = EINVAL;
+				return -1;
+			}
+
+			debug_printf(DEBUG_INFO, "OP == SUBSCRIBE: entry_id == 0x%llX\n", entry_id);
+
+			/* Append the extracted entry id to the current entry list */
+			entry_list[entry_list_nmemb - 1] = htonll(entry_id);
+		}
+	}
+
+	/* No conjunctions are accepted in a SUBSCRIBE operation */
+	if (cur->conj) {
+		mm_free(entry_list);
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Initialize the entry to be transmitted */
+	if (!(entry = entry_client_init(cur->uid, cur->gid, 0, entry_list, entry_list_nmemb * sizeof(uint64_t)))) {
+		errsv = errno;
+		mm_free(entry_list);
+		errno = errsv;
+		return -1;
+	}
+
+	/* Free entry_list */
+	mm_free(entry_list);
+
+	/* Subscribe the execution results of the requested entries */
+	entry_set_flag(entry, USCHED_ENTRY_FLAG_SUBSCRIBE);
+
+	/* Push the entry into the entries pool */
+	if (runc.epool->push(runc.epool, entry) < 0) {
+		errsv = errno;
+		entry_destroy(entry);
+		errno = errsv;
+		return -1;
+	}
+
+	/* Logic accepted */
+	return 0;
+}
+
 
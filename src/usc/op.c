@@ -79,6 +79,15 @@ int op_client_process(void) {
 				log_warn("op_client_process(): logic_client_process_show(): %s\n", strerror(errno));
 			}
 
+			break;
+		case USCHED_OP_SUBSCRIBE:
+			ret = logic_client_process_subscribe();
+
+			if (ret < 0) {
+				errsv = errno;
+				log_warn("op_client_process(): logic_client_process_subscribe(): %s\n", strerror(errno));
+			}
+
 			break;
 		default: errsv = EINVAL;
 	}
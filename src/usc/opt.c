@@ -26,6 +26,8 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <strings.h>
+#include <stdlib.h>
 #include <errno.h>
 
 #include "config.h"
@@ -37,6 +39,7 @@
 #include "usage.h"
 #include "opt.h"
 #include "input.h"
+#include "usched.h"
 
 extern char *optarg;
 extern int optind, optopt;
@@ -127,12 +130,194 @@ static int _opt_client_remote_password(const char *password, struct usched_opt_c
 	return 0;
 }
 
+static int _opt_client_exec_overlap(const char *overlap, struct usched_opt_client *dest) {
+	int ret = 0;
+
+	if (!overlap || !overlap[0]) {
+		puts("Overlap policy is empty.");
+		errno = EINVAL;
+		return -1;
+	}
+
+	if ((ret = opt_client_exec_overlap_parse(overlap)) < 0) {
+		puts("Invalid overlap policy. Expecting: allow, skip, queue or kill.");
+		errno = EINVAL;
+		return -1;
+	}
+
+	dest->exec_overlap = (unsigned int) ret;
+
+	return 0;
+}
+
+static int _opt_client_exec_concurrency(const char *concurrency, struct usched_opt_client *dest) {
+	int ret = 0;
+
+	if (!concurrency || !concurrency[0]) {
+		puts("Concurrency limit is empty.");
+		errno = EINVAL;
+		return -1;
+	}
+
+	if ((ret = opt_client_exec_concurrency_parse(concurrency)) < 0) {
+		printf("Invalid concurrency limit. Expecting a value between 0 and %u.\n", CONFIG_USCHED_EXEC_CONCURRENCY_MAX);
+		errno = EINVAL;
+		return -1;
+	}
+
+	dest->exec_concurrency = (unsigned int) ret;
+
+	return 0;
+}
+
+static int _opt_client_exec_priority(const char *priority, struct usched_opt_client *dest) {
+	int ret = 0;
+
+	if (!priority || !priority[0]) {
+		puts("Priority class is empty.");
+		errno = EINVAL;
+		return -1;
+	}
+
+	if ((ret = opt_client_exec_priority_parse(priority)) < 0) {
+		puts("Invalid priority class. Expecting: low, normal or high.");
+		errno = EINVAL;
+		return -1;
+	}
+
+	dest->exec_priority = (unsigned int) ret;
+
+	return 0;
+}
+
+static int _opt_client_show_fields(const char *fields, struct usched_opt_client *dest) {
+	if (!fields || !fields[0]) {
+		puts("Field list is empty.");
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (opt_client_show_fields_parse(fields, &dest->show_fields) < 0) {
+		puts("Invalid field list. Expecting a comma separated list of: all, id, flags, uid, gid, trigger, step, expire, overlap, concurrency, priority, pid, status, exectime, latency, output, username or command.");
+		errno = EINVAL;
+		return -1;
+	}
+
+	return 0;
+}
+
+int opt_client_exec_overlap_parse(const char *overlap) {
+	if (!strcasecmp(overlap, USCHED_OVERLAP_ALLOW_STR))
+		return USCHED_ENTRY_OVERLAP_ALLOW;
+
+	if (!strcasecmp(overlap, USCHED_OVERLAP_SKIP_STR))
+		return USCHED_ENTRY_OVERLAP_SKIP;
+
+	if (!strcasecmp(overlap, USCHED_OVERLAP_QUEUE_STR))
+		return USCHED_ENTRY_OVERLAP_QUEUE;
+
+	if (!strcasecmp(overlap, USCHED_OVERLAP_KILL_STR))
+		return USCHED_ENTRY_OVERLAP_KILL;
+
+	errno = EINVAL;
+
+	return -1;
+}
+
+int opt_client_exec_concurrency_parse(const char *concurrency) {
+	char *endptr = NULL;
+	unsigned long val = 0;
+
+	val = strtoul(concurrency, &endptr, 10);
+
+	if ((*endptr) || (endptr == concurrency) || (val > CONFIG_USCHED_EXEC_CONCURRENCY_MAX)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	return (int) val;
+}
+
+int opt_client_exec_priority_parse(const char *priority) {
+	if (!strcasecmp(priority, USCHED_PRIORITY_NORMAL_STR))
+		return USCHED_ENTRY_PRIORITY_NORMAL;
+
+	if (!strcasecmp(priority, USCHED_PRIORITY_HIGH_STR))
+		return USCHED_ENTRY_PRIORITY_HIGH;
+
+	if (!strcasecmp(priority, USCHED_PRIORITY_LOW_STR))
+		return USCHED_ENTRY_PRIORITY_LOW;
+
+	errno = EINVAL;
+
+	return -1;
+}
+
+int opt_client_show_fields_parse(const char *fields, uint32_t *mask) {
+	unsigned int i = 0;
+	uint32_t val = 0;
+	char buf[256], *ptr = NULL, *saveptr = NULL;
+	static const struct {
+		const char *name;
+		int field;	/* -1: Always present */
+	} field_map[] = {
+		{ USCHED_FIELD_ID_STR, -1 },
+		{ USCHED_FIELD_FLAGS_STR, USCHED_ENTRY_FIELD_FLAGS },
+		{ USCHED_FIELD_UID_STR, USCHED_ENTRY_FIELD_UID },
+		{ USCHED_FIELD_GID_STR, USCHED_ENTRY_FIELD_GID },
+		{ USCHED_FIELD_TRIGGER_STR, USCHED_ENTRY_FIELD_TRIGGER },
+		{ USCHED_FIELD_STEP_STR, USCHED_ENTRY_FIELD_STEP },
+		{ USCHED_FIELD_EXPIRE_STR, USCHED_ENTRY_FIELD_EXPIRE },
+		{ USCHED_FIELD_OVERLAP_STR, USCHED_ENTRY_FIELD_OVERLAP },
+		{ USCHED_FIELD_CONCURRENCY_STR, USCHED_ENTRY_FIELD_CONCURRENCY },
+		{ USCHED_FIELD_PRIORITY_STR, USCHED_ENTRY_FIELD_PRIORITY },
+		{ USCHED_FIELD_PID_STR, USCHED_ENTRY_FIELD_PID },
+		{ USCHED_FIELD_STATUS_STR, USCHED_ENTRY_FIELD_STATUS },
+		{ USCHED_FIELD_EXEC_TIME_STR, USCHED_ENTRY_FIELD_EXEC_TIME },
+		{ USCHED_FIELD_LATENCY_STR, USCHED_ENTRY_FIELD_LATENCY },
+		{ USCHED_FIELD_OUTDATA_STR, USCHED_ENTRY_FIELD_OUTDATA },
+		{ USCHED_FIELD_USERNAME_STR, USCHED_ENTRY_FIELD_USERNAME },
+		{ USCHED_FIELD_SUBJ_STR, USCHED_ENTRY_FIELD_SUBJ }
+	};
+
+	if (strlen(fields) >= sizeof(buf)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	strcpy(buf, fields);
+
+	for (ptr = buf; (ptr = strtok_r(ptr, ",", &saveptr)); ptr = NULL) {
+		if (!strcasecmp(ptr, USCHED_FIELD_ALL_STR)) {
+			val = USCHED_ENTRY_FIELDS_ALL;
+			continue;
+		}
+
+		for (i = 0; i < (sizeof(field_map) / sizeof(field_map[0])); i ++) {
+			if (!strcasecmp(ptr, field_map[i].name))
+				break;
+		}
+
+		if (i == (sizeof(field_map) / sizeof(field_map[0]))) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		if (field_map[i].field >= 0)
+			val |= 1 << field_map[i].field;
+	}
+
+	*mask = val;
+
+	return 0;
+}
+
 int opt_client_process(int argc, char **argv, struct usched_opt_client *opt_client) {
 	int opt = 0;
 	char password[CONFIG_USCHED_AUTH_PASSWORD_MAX + 1];
 
 	/* Parse command line options */
-	while ((opt = getopt(argc, argv, "hH:p:U:P:")) != -1) {
+	while ((opt = getopt(argc, argv, "hH:p:U:P:o:c:r:f:")) != -1) {
 		if (opt == 'h') {
 			usage_client_show();
 			return 0;
@@ -156,6 +341,26 @@ int opt_client_process(int argc, char **argv, struct usched_opt_client *opt_clie
 				usage_client_show();
 				return -1;
 			}
+		} else if (opt == 'o') {
+			if (_opt_client_exec_overlap(optarg, opt_client) < 0) {
+				usage_client_show();
+				return -1;
+			}
+		} else if (opt == 'c') {
+			if (_opt_client_exec_concurrency(optarg, opt_client) < 0) {
+				usage_client_show();
+				return -1;
+			}
+		} else if (opt == 'r') {
+			if (_opt_client_exec_priority(optarg, opt_client) < 0) {
+				usage_client_show();
+				return -1;
+			}
+		} else if (opt == 'f') {
+			if (_opt_client_show_fields(optarg, opt_client) < 0) {
+				usage_client_show();
+				return -1;
+			}
 		} else {
 			usage_client_show();
 			return -1;
@@ -179,8 +384,8 @@ int opt_client_process(int argc, char **argv, struct usched_opt_client *opt_clie
 		}
 	}
 
-	/* If there are arguments, we must grant that they make sense */
-	if ((optind != 1) && (!opt_client->remote_hostname[0] || !opt_client->remote_username[0] || !opt_client->remote_password[0])) {
+	/* If remote options were set, we must grant that they make sense */
+	if ((opt_client->remote_hostname[0] || opt_client->remote_port[0] || opt_client->remote_username[0] || opt_client->remote_password[0]) && (!opt_client->remote_hostname[0] || !opt_client->remote_username[0] || !opt_client->remote_password[0])) {
 		usage_client_show();
 		return -1;
 	}
@@ -210,6 +210,9 @@ static usched_op_t _parse_get_op(const char *op) {
 	if (!strcasecmp(op, USCHED_OP_SHOW_STR))
 		return USCHED_OP_SHOW;
 
+	if (!strcasecmp(op, USCHED_OP_SUBSCRIBE_STR))
+		return USCHED_OP_SUBSCRIBE;
+
 	return -1;
 }
 
@@ -232,6 +235,16 @@ static usched_prep_t _parse_get_prep(const char *prep) {
 	return -1;
 }
 
+static usched_request_flag_t _parse_get_mode(const char *mode) {
+	if (!strcasecmp(mode, USCHED_MODE_SHELL_STR))
+		return USCHED_REQ_FLAG_EXEC_SHELL;
+
+	if (!strcasecmp(mode, USCHED_MODE_DIRECT_STR))
+		return USCHED_REQ_FLAG_EXEC_DIRECT;
+
+	return -1;
+}
+
 static usched_adverb_t _parse_get_adverb(const char *adverb) {
 	if (!strcasecmp(adverb, USCHED_ADVERB_SECOND_STR) || !strcasecmp(adverb, USCHED_ADVERB_SECONDS_STR))
 		return USCHED_ADVERB_SECONDS;
@@ -469,6 +482,10 @@ static struct usched_client_request *_parse_subj_compound(struct usched_client_r
 			if (!(argc - 1)) return req;
 		} break;
 
+		case USCHED_OP_SUBSCRIBE: {
+			if (!(argc - 1)) return req;
+		} break;
+
 		default: break; /* Invalid operation */
 	}
 
@@ -503,6 +520,18 @@ static struct usched_client_request *_parse_op_compound(struct usched_client_req
 		} break;
 
 		case USCHED_OP_RUN: {
+			/* An execution mode may precede the subject. A subject named after a mode is
+			 * still accepted, as it is followed by a preposition.
+			 */
+			if ((argc > 3) && ((ret = _parse_get_mode(argv[1])) > 0) && (_parse_get_prep(argv[2]) < 0)) {
+				bit_set(&req->flags, ret);
+
+				debug_printf(DEBUG_INFO, "MODE: %d\n", ret);
+
+				argc --;
+				argv ++;
+			}
+
 			if (argc < 3) {
 				usage_client_error_set(USCHED_USAGE_CLIENT_ERR_INSUFF_ARGS, NULL);
 				goto _op_error;
@@ -523,6 +552,13 @@ static struct usched_client_request *_parse_op_compound(struct usched_client_req
 			}
 		} break;
 
+		case USCHED_OP_SUBSCRIBE: {
+			if (argc != 2) {
+				usage_client_error_set(USCHED_USAGE_CLIENT_ERR_TOOMANY_ARGS, NULL);
+				goto _op_error;
+			}
+		} break;
+
 		default: {
 			usage_client_error_set(USCHED_USAGE_CLIENT_ERR_INVALID_OP, argv[0]);
 			goto _op_error;
@@ -75,9 +75,17 @@ static void _print_client_result_single_show(const struct usched_entry *entry_li
 	printf("Trigger:   %u\n", (unsigned int) entry->trigger);
 	printf("Step:      %u\n", (unsigned int) entry->step);
 	printf("Expire:    %u\n", (unsigned int) entry->expire);
+	printf("Overlap:   %s\n",
+		(entry->overlap == USCHED_ENTRY_OVERLAP_SKIP) ? USCHED_OVERLAP_SKIP_STR :
+		(entry->overlap == USCHED_ENTRY_OVERLAP_QUEUE) ? USCHED_OVERLAP_QUEUE_STR :
+		(entry->overlap == USCHED_ENTRY_OVERLAP_KILL) ? USCHED_OVERLAP_KILL_STR : USCHED_OVERLAP_ALLOW_STR);
+	printf("Max Conc.: %u\n", (unsigned int) entry->concurrency);
+	printf("Priority:  %s\n",
+		(entry->priority == USCHED_ENTRY_PRIORITY_HIGH) ? USCHED_PRIORITY_HIGH_STR :
+		(entry->priority == USCHED_ENTRY_PRIORITY_LOW) ? USCHED_PRIORITY_LOW_STR : USCHED_PRIORITY_NORMAL_STR);
 	printf("UID:       %u\n", (unsigned int) entry->uid);
 	printf("GID:       %u\n", (unsigned int) entry->gid);
-	printf("Command:   %s\n", entry->subj);
+	printf("Command:   %s\n", entry->subj ? entry->subj : "-");
 	printf("Status:    %u\n", entry->status);
 	printf("Exec Time: %.3fus\n", entry->exec_time / 1000.0);
 	printf("Latency:   %.3fus\n", entry->latency / 1000.0);
@@ -113,7 +121,7 @@ static void _print_client_result_multi_show(const struct usched_entry *entry_lis
 			(unsigned int) entry_list[i].trigger,
 			(unsigned int) entry_list[i].step,
 			(unsigned int) entry_list[i].expire,
-			entry_list[i].subj);
+			entry_list[i].subj ? entry_list[i].subj : "-");
 	}
 }
 
@@ -125,3 +133,16 @@ void print_client_result_show(const struct usched_entry *entry_list, size_t coun
 	}
 }
 
+void print_client_result_subscribe(const struct usched_entry *entry) {
+	printf("Completed Entry ID: 0x%016llX | Status: %u | PID: %u | Exec Time: %.3fus | Latency: %.3fus | Output: %s\n",
+		(unsigned long long) entry->id,
+		entry->status,
+		entry->pid,
+		entry->exec_time / 1000.0,
+		entry->latency / 1000.0,
+		entry->outdata);
+
+	/* Records are printed as they arrive */
+	fflush(stdout);
+}
+
@@ -183,55 +183,8 @@ int process_client_recv_hold(struct usched_entry *entry) {
 	return 0;
 }
 
-int process_client_recv_run(struct usched_entry *entry) {
-	int errsv = 0;
+static int _process_client_result_run(struct usched_entry *entry) {
 	uint64_t entry_id = 0;
-	uint32_t data_len = 0;
-	ssize_t ret = 0;
-
-	/* Free payload memory */
-	if (entry->payload) {
-		mm_free(entry->payload);
-		entry->payload = NULL;
-		entry->psize = 0;
-	}
-
-	/* Read the payload size */
-	if (conn_read_blocking(runc.fd, &data_len, 4) != 4) {
-		errsv = errno;
-		log_crit("process_client_recv_run(): conn_read_blocking(..., &data_len, 4) != 4: %s\n", strerror(errno));
-		errno = errsv;
-		return -1;
-	}
-
-	/* Set entry payload size */
-	entry->psize = ntohl(data_len) - 4;
-
-	/* Allocate payload memory */
-	if (!(entry->payload = mm_alloc(entry->psize))) {
-		errsv = errno;
-		log_crit("process_client_recv_run(): mm_alloc(): %s\n", strerror(errno));
-		errno = errsv;
-		return -1;
-	}
-
-	/* Read the payload data */
-	if ((ret = conn_read_blocking(runc.fd, entry->payload, entry->psize)) != (ssize_t) entry->psize) {
-		errsv = errno;
-		log_crit("process_client_recv_run(): conn_read_blocking(..., entry->payload, entry->psize) != entry->psize: %s. (conn_read_blocking(): %zd bytes, entry->psize: %zd bytes)\n", strerror(errno), ret, entry->psize);
-		entry_unset_payload(entry);
-		errno = errsv;
-		return -1;
-	}
-
-	/* Decrypt payload */
-	if (entry_payload_decrypt(entry) < 0) {
-		errsv = errno;
-		log_crit("process_client_recv_run(): entry_payload_decrypt(): %s\n", strerror(errno));
-		entry_unset_payload(entry);
-		errno = errsv;
-		return -1;
-	}
 
 	/* Set the entry id */
 	memcpy(&entry_id, entry->payload, 8);
@@ -253,56 +206,64 @@ int process_client_recv_run(struct usched_entry *entry) {
 	return 0;
 }
 
-int process_client_recv_stop(struct usched_entry *entry) {
+int process_client_recv_run(struct usched_entry *entry) {
 	int errsv = 0;
-	uint32_t i = 0, entry_list_nmemb = 0, data_len = 0;
-	uint64_t *entry_list = NULL;
-	size_t p_offset = 0;
+	uint32_t data_len = 0;
+	ssize_t ret = 0;
 
-	/* Cleanup entry payload if required */
+	/* Free payload memory */
 	if (entry->payload) {
 		mm_free(entry->payload);
 		entry->payload = NULL;
 		entry->psize = 0;
 	}
 
-	/* Read data size */
+	/* Read the payload size */
 	if (conn_read_blocking(runc.fd, &data_len, 4) != 4) {
 		errsv = errno;
-		log_crit("process_client_recv_stop(): conn_read_blocking(, &data_len, 4) != 4: %s\n", strerror(errno));
+		log_crit("process_client_recv_run(): conn_read_blocking(..., &data_len, 4) != 4: %s\n", strerror(errno));
 		errno = errsv;
 		return -1;
 	}
 
-	/* Set the entry payload size */
+	/* Set entry payload size */
 	entry->psize = ntohl(data_len) - 4;
 
-	/* Allocate enough memory to receive the payload */
+	/* Allocate payload memory */
 	if (!(entry->payload = mm_alloc(entry->psize))) {
 		errsv = errno;
-		log_crit("process_client_recv_stop(): mm_alloc(): %s\n", strerror(errno));
+		log_crit("process_client_recv_run(): mm_alloc(): %s\n", strerror(errno));
 		errno = errsv;
 		return -1;
 	}
 
-	/* Receive the payload */
-	if (conn_read_blocking(runc.fd, entry->payload, entry->psize) != (ssize_t) entry->psize) {
+	/* Read the payload data */
+	if ((ret = conn_read_blocking(runc.fd, entry->payload, entry->psize)) != (ssize_t) entry->psize) {
 		errsv = errno;
-		log_crit("process_client_recv_stop(): conn_read_blocking(..., entry->payload, entry->psize) != entry->psize: %s\n", strerror(errno));
+		log_crit("process_client_recv_run(): conn_read_blocking(..., entry->payload, entry->psize) != entry->psize: %s. (conn_read_blocking(): %zd bytes, entry->psize: %zd bytes)\n", strerror(errno), ret, entry->psize);
 		entry_unset_payload(entry);
 		errno = errsv;
 		return -1;
 	}
 
-	/* Decrypt the payload */
+	/* Decrypt payload */
 	if (entry_payload_decrypt(entry) < 0) {
 		errsv = errno;
-		log_crit("process_client_recv_stop(): entry_payload_decrypt(): %s\n", strerror(errno));
+		log_crit("process_client_recv_run(): entry_payload_decrypt(): %s\n", strerror(errno));
 		entry_unset_payload(entry);
 		errno = errsv;
 		return -1;
 	}
 
+	return _process_client_result_run(entry);
+}
+
+static int _process_client_result_stop(struct usched_entry *entry) {
+	int errsv = 0;
+	uint32_t i = 0, entry_list_nmemb = 0;
+	uint64_t *entry_list = NULL;
+	size_t p_offset = 0;
+
 	/* Read te number of elements to process */
 	memcpy(&entry_list_nmemb, entry->payload, sizeof(entry_list_nmemb));
 	p_offset += sizeof(entry_list_nmemb);
@@ -355,12 +316,9 @@ int process_client_recv_stop(struct usched_entry *entry) {
 	return 0;
 }
 
-int process_client_recv_show(struct usched_entry *entry) {
-	int i = 0, errsv = 0, ret = -1;
-	uint32_t entry_list_nmemb = 0, data_len = 0;
-	struct usched_entry *entry_list = NULL;
-	size_t p_offset = 0;
-	ssize_t pret = 0;
+int process_client_recv_stop(struct usched_entry *entry) {
+	int errsv = 0;
+	uint32_t data_len = 0;
 
 	/* Cleanup entry payload if required */
 	if (entry->payload) {
@@ -372,7 +330,7 @@ int process_client_recv_show(struct usched_entry *entry) {
 	/* Read data size */
 	if (conn_read_blocking(runc.fd, &data_len, 4) != 4) {
 		errsv = errno;
-		log_crit("process_client_recv_show(): conn_read_blocking(..., &data_len, 4) != 4: %s\n", strerror(errno));
+		log_crit("process_client_recv_stop(): conn_read_blocking(, &data_len, 4) != 4: %s\n", strerror(errno));
 		errno = errsv;
 		return -1;
 	}
@@ -383,15 +341,15 @@ int process_client_recv_show(struct usched_entry *entry) {
 	/* Allocate enough memory to receive the payload */
 	if (!(entry->payload = mm_alloc(entry->psize))) {
 		errsv = errno;
-		log_crit("process_client_recv_show(): mm_alloc(): %s\n", strerror(errno));
+		log_crit("process_client_recv_stop(): mm_alloc(): %s\n", strerror(errno));
 		errno = errsv;
 		return -1;
 	}
 
 	/* Receive the payload */
-	if ((pret = conn_read_blocking(runc.fd, entry->payload, entry->psize)) != (ssize_t) entry->psize) {
+	if (conn_read_blocking(runc.fd, entry->payload, entry->psize) != (ssize_t) entry->psize) {
 		errsv = errno;
-		log_crit("process_client_recv_show(): conn_read_blocking(..., entry->payload, entry->psize) != entry->psize: %s. (conn_read_blocking(): %zd bytes, entry->psize: %zd bytes)\n", strerror(errno), pret, entry->psize);
+		log_crit("process_client_recv_stop(): conn_read_blocking(..., entry->payload, entry->psize) != entry->psize: %s\n", strerror(errno));
 		entry_unset_payload(entry);
 		errno = errsv;
 		return -1;
@@ -400,12 +358,21 @@ int process_client_recv_show(struct usched_entry *entry) {
 	/* Decrypt the payload */
 	if (entry_payload_decrypt(entry) < 0) {
 		errsv = errno;
-		log_crit("process_client_recv_show(): entry_payload_decrypt(): %s\n", strerror(errno));
+		log_crit("process_client_recv_stop(): entry_payload_decrypt(): %s\n", strerror(errno));
 		entry_unset_payload(entry);
 		errno = errsv;
 		return -1;
 	}
 
+	return _process_client_result_stop(entry);
+}
+
+static int _process_client_result_show(struct usched_entry *entry) {
+	int i = 0, errsv = 0, ret = -1;
+	uint32_t entry_list_nmemb = 0;
+	struct usched_entry *entry_list = NULL;
+	size_t p_offset = 0;
+
 	/* Set the entry_list_size */
 	memcpy(&entry_list_nmemb, entry->payload, sizeof(entry_list_nmemb));
 
@@ -448,6 +415,10 @@ int process_client_recv_show(struct usched_entry *entry) {
 		entry_list[i].trigger = ntohl(entry_list[i].trigger);
 		entry_list[i].step = ntohl(entry_list[i].step);
 		entry_list[i].expire = ntohl(entry_list[i].expire);
+		entry_list[i].version = ntohl(entry_list[i].version);
+		entry_list[i].overlap = ntohl(entry_list[i].overlap);
+		entry_list[i].concurrency = ntohl(entry_list[i].concurrency);
+		entry_list[i].priority = ntohl(entry_list[i].priority);
 		entry_list[i].pid = ntohl(entry_list[i].pid);
 		entry_list[i].status = ntohl(entry_list[i].status);
 		entry_list[i].exec_time = ntohll(entry_list[i].exec_time);
@@ -502,3 +473,562 @@ _recv_show_finish:
 	return ret;
 }
 
+static int _process_client_recv_show_chunk(struct usched_entry *entry) {
+	int errsv = 0;
+	uint32_t data_len = 0;
+	ssize_t pret = 0;
+
+	entry_unset_payload(entry);
+
+	/* Read data size */
+	if (conn_read_blocking(runc.fd, &data_len, 4) != 4) {
+		errsv = errno;
+		log_crit("_process_client_recv_show_chunk(): conn_read_blocking(..., &data_len, 4) != 4: %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Grant that the chunk carries, at least, the encryption overhead */
+	if (ntohl(data_len) < (4 + CRYPT_EXTRA_SIZE_CHACHA20POLY1305)) {
+		log_crit("_process_client_recv_show_chunk(): Invalid chunk size: %u\n", ntohl(data_len));
+		errno = EPROTO;
+		return -1;
+	}
+
+	/* Set the entry payload size */
+	entry->psize = ntohl(data_len) - 4;
+
+	/* Allocate enough memory to receive the payload */
+	if (!(entry->payload = mm_alloc(entry->psize))) {
+		errsv = errno;
+		log_crit("_process_client_recv_show_chunk(): mm_alloc(): %s\n", strerror(errno));
+		entry->psize = 0;
+		errno = errsv;
+		return -1;
+	}
+
+	/* Receive the payload */
+	if ((pret = conn_read_blocking(runc.fd, entry->payload, entry->psize)) != (ssize_t) entry->psize) {
+		errsv = errno;
+		log_crit("_process_client_recv_show_chunk(): conn_read_blocking(..., entry->payload, entry->psize) != entry->psize: %s. (conn_read_blocking(): %zd bytes, entry->psize: %zd bytes)\n", strerror(errno), pret, entry->psize);
+		entry_unset_payload(entry);
+		errno = errsv;
+		return -1;
+	}
+
+	/* Decrypt the payload */
+	if (entry_payload_decrypt(entry) < 0) {
+		errsv = errno;
+		log_crit("_process_client_recv_show_chunk(): entry_payload_decrypt(): %s\n", strerror(errno));
+		entry_unset_payload(entry);
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+static int _process_client_show_get32(const struct usched_entry *entry, size_t *p_offset, uint32_t *val) {
+	if ((entry->psize - *p_offset) < sizeof(uint32_t)) {
+		errno = EPROTO;
+		return -1;
+	}
+
+	memcpy(val, entry->payload + *p_offset, sizeof(uint32_t));
+	*val = ntohl(*val);
+	*p_offset += sizeof(uint32_t);
+
+	return 0;
+}
+
+static int _process_client_show_get64(const struct usched_entry *entry, size_t *p_offset, uint64_t *val) {
+	if ((entry->psize - *p_offset) < sizeof(uint64_t)) {
+		errno = EPROTO;
+		return -1;
+	}
+
+	memcpy(val, entry->payload + *p_offset, sizeof(uint64_t));
+	*val = ntohll(*val);
+	*p_offset += sizeof(uint64_t);
+
+	return 0;
+}
+
+static int _process_client_show_getvar(const struct usched_entry *entry, size_t *p_offset, const char **data, uint32_t *len, size_t max) {
+	if (_process_client_show_get32(entry, p_offset, len) < 0)
+		return -1;
+
+	if ((*len > max) || ((entry->psize - *p_offset) < *len)) {
+		errno = EPROTO;
+		return -1;
+	}
+
+	*data = entry->payload + *p_offset;
+	*p_offset += *len;
+
+	return 0;
+}
+
+static int _process_client_show_record(const struct usched_entry *entry, size_t *p_offset, uint32_t fields, struct usched_entry *rec) {
+	int errsv = 0;
+	uint32_t len = 0;
+	const char *data = NULL;
+
+	/* Fixed size fields, in usched_entry_field_t order */
+	if (_process_client_show_get64(entry, p_offset, &rec->id) < 0)
+		return -1;
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_FLAGS) && (_process_client_show_get32(entry, p_offset, &rec->flags) < 0))
+		return -1;
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_UID) && (_process_client_show_get32(entry, p_offset, &rec->uid) < 0))
+		return -1;
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_GID) && (_process_client_show_get32(entry, p_offset, &rec->gid) < 0))
+		return -1;
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_TRIGGER) && (_process_client_show_get32(entry, p_offset, &rec->trigger) < 0))
+		return -1;
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_STEP) && (_process_client_show_get32(entry, p_offset, &rec->step) < 0))
+		return -1;
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_EXPIRE) && (_process_client_show_get32(entry, p_offset, &rec->expire) < 0))
+		return -1;
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_OVERLAP) && (_process_client_show_get32(entry, p_offset, &rec->overlap) < 0))
+		return -1;
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_CONCURRENCY) && (_process_client_show_get32(entry, p_offset, &rec->concurrency) < 0))
+		return -1;
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_PRIORITY) && (_process_client_show_get32(entry, p_offset, &rec->priority) < 0))
+		return -1;
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_PID) && (_process_client_show_get32(entry, p_offset, &rec->pid) < 0))
+		return -1;
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_STATUS) && (_process_client_show_get32(entry, p_offset, &rec->status) < 0))
+		return -1;
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_EXEC_TIME) && (_process_client_show_get64(entry, p_offset, &rec->exec_time) < 0))
+		return -1;
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_LATENCY) && (_process_client_show_get64(entry, p_offset, &rec->latency) < 0))
+		return -1;
+
+	/* Variable size fields */
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_OUTDATA)) {
+		if (_process_client_show_getvar(entry, p_offset, &data, &len, sizeof(rec->outdata) - 1) < 0)
+			return -1;
+
+		memcpy(rec->outdata, data, len);
+		rec->outdata_len = len;
+	}
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_USERNAME)) {
+		if (_process_client_show_getvar(entry, p_offset, &data, &len, sizeof(rec->username) - 1) < 0)
+			return -1;
+
+		memcpy(rec->username, data, len);
+	}
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_SUBJ)) {
+		if (_process_client_show_getvar(entry, p_offset, &data, &len, entry->psize) < 0)
+			return -1;
+
+		if (len && (entry_set_subj(rec, data, len) < 0)) {
+			errsv = errno;
+			log_crit("_process_client_show_record(): entry_set_subj(): %s\n", strerror(errno));
+			errno = errsv;
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static int _process_client_recv_show_stream(struct usched_entry *entry) {
+	int errsv = 0;
+	uint32_t more = 0, nmemb = 0, i = 0, fields = runc.opt.show_fields;
+	size_t entry_list_nmemb = 0, p_offset = 0;
+	struct usched_entry *entry_list = NULL, *entry_list_new = NULL;
+
+	do {
+		/* Receive the next chunk */
+		if (_process_client_recv_show_chunk(entry) < 0) {
+			errsv = errno;
+			log_crit("_process_client_recv_show_stream(): _process_client_recv_show_chunk(): %s\n", strerror(errno));
+			goto _show_stream_failure;
+		}
+
+		p_offset = 0;
+
+		if ((_process_client_show_get32(entry, &p_offset, &more) < 0) || (_process_client_show_get32(entry, &p_offset, &nmemb) < 0) || (nmemb > (entry->psize / sizeof(uint64_t)))) {
+			log_crit("_process_client_recv_show_stream(): Invalid chunk header.\n");
+			errsv = EPROTO;
+			goto _show_stream_failure;
+		}
+
+		if (!nmemb)
+			continue;
+
+		/* Extend the entries array */
+		if (!(entry_list_new = mm_realloc(entry_list, (entry_list_nmemb + nmemb) * sizeof(struct usched_entry)))) {
+			errsv = errno;
+			log_crit("_process_client_recv_show_stream(): mm_realloc(): %s\n", strerror(errno));
+			goto _show_stream_failure;
+		}
+
+		entry_list = entry_list_new;
+
+		memset(&entry_list[entry_list_nmemb], 0, nmemb * sizeof(struct usched_entry));
+
+		/* Read the records of this chunk */
+		for (i = 0; i < nmemb; i ++) {
+			if (_process_client_show_record(entry, &p_offset, fields, &entry_list[entry_list_nmemb]) < 0) {
+				errsv = errno;
+				log_crit("_process_client_recv_show_stream(): _process_client_show_record(): %s\n", strerror(errno));
+				entry_unset_subj(&entry_list[entry_list_nmemb]);
+				goto _show_stream_failure;
+			}
+
+			entry_list_nmemb ++;
+		}
+
+		if (p_offset != entry->psize) {
+			log_crit("_process_client_recv_show_stream(): Trailing data found after the last record.\n");
+			errsv = EPROTO;
+			goto _show_stream_failure;
+		}
+	} while (more);
+
+	entry_unset_payload(entry);
+
+	if (!entry_list_nmemb) {
+		log_info("process_client_recv_show(): No entries were found.\n");
+		print_client_result_empty();
+		return 0;
+	}
+
+	/* Check if this is a library call */
+	if (bit_test(&runc.flags, USCHED_RUNTIME_FLAG_LIB))
+		return _process_lib_result_set_show(entry_list, entry_list_nmemb);
+
+	/* Otherwise print the received entries */
+	print_client_result_show(entry_list, entry_list_nmemb);
+
+	errsv = 0;
+
+_show_stream_failure:
+	while (entry_list_nmemb)
+		entry_unset_subj(&entry_list[-- entry_list_nmemb]);
+
+	if (entry_list)
+		mm_free(entry_list);
+
+	entry_unset_payload(entry);
+
+	errno = errsv;
+
+	return errsv ? -1 : 0;
+}
+
+int process_client_recv_show(struct usched_entry *entry) {
+	int errsv = 0;
+	uint32_t data_len = 0;
+	ssize_t pret = 0;
+
+	/* Projected requests are streamed in chunks */
+	if (entry_has_flag(entry, USCHED_ENTRY_FLAG_PROJECT))
+		return _process_client_recv_show_stream(entry);
+
+	/* Cleanup entry payload if required */
+	if (entry->payload) {
+		mm_free(entry->payload);
+		entry->payload = NULL;
+		entry->psize = 0;
+	}
+
+	/* Read data size */
+	if (conn_read_blocking(runc.fd, &data_len, 4) != 4) {
+		errsv = errno;
+		log_crit("process_client_recv_show(): conn_read_blocking(..., &data_len, 4) != 4: %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Set the entry payload size */
+	entry->psize = ntohl(data_len) - 4;
+
+	/* Allocate enough memory to receive the payload */
+	if (!(entry->payload = mm_alloc(entry->psize))) {
+		errsv = errno;
+		log_crit("process_client_recv_show(): mm_alloc(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Receive the payload */
+	if ((pret = conn_read_blocking(runc.fd, entry->payload, entry->psize)) != (ssize_t) entry->psize) {
+		errsv = errno;
+		log_crit("process_client_recv_show(): conn_read_blocking(..., entry->payload, entry->psize) != entry->psize: %s. (conn_read_blocking(): %zd bytes, entry->psize: %zd bytes)\n", strerror(errno), pret, entry->psize);
+		entry_unset_payload(entry);
+		errno = errsv;
+		return -1;
+	}
+
+	/* Decrypt the payload */
+	if (entry_payload_decrypt(entry) < 0) {
+		errsv = errno;
+		log_crit("process_client_recv_show(): entry_payload_decrypt(): %s\n", strerror(errno));
+		entry_unset_payload(entry);
+		errno = errsv;
+		return -1;
+	}
+
+	return _process_client_result_show(entry);
+}
+
+static int _process_client_subscribe_record(const struct usched_entry *entry, size_t *p_offset, struct usched_entry *rec) {
+	uint32_t outdata_len = 0;
+	const char *outdata = NULL;
+
+	memset(rec, 0, sizeof(struct usched_entry));
+
+	if (_process_client_show_get64(entry, p_offset, &rec->id) < 0)
+		return -1;
+
+	if (_process_client_show_get32(entry, p_offset, &rec->status) < 0)
+		return -1;
+
+	if (_process_client_show_get32(entry, p_offset, &rec->pid) < 0)
+		return -1;
+
+	if (_process_client_show_get64(entry, p_offset, &rec->exec_time) < 0)
+		return -1;
+
+	if (_process_client_show_get64(entry, p_offset, &rec->latency) < 0)
+		return -1;
+
+	if (_process_client_show_getvar(entry, p_offset, &outdata, &outdata_len, CONFIG_USCHED_SUBSCRIBE_OUTDATA_MAX) < 0)
+		return -1;
+
+	memcpy(rec->outdata, outdata, outdata_len);
+	rec->outdata[outdata_len] = 0;
+	rec->outdata_len = outdata_len;
+
+	return 0;
+}
+
+int process_client_recv_subscribe(struct usched_entry *entry) {
+	int errsv = 0;
+	uint32_t i = 0, nmemb = 0;
+	size_t p_offset = 0;
+	struct usched_entry rec;
+
+	/* Receive the number of subscribed entries */
+	if (_process_client_recv_show_chunk(entry) < 0) {
+		errsv = errno;
+		log_crit("process_client_recv_subscribe(): _process_client_recv_show_chunk(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (_process_client_show_get32(entry, &p_offset, &nmemb) < 0) {
+		log_crit("process_client_recv_subscribe(): Invalid subscription reply.\n");
+		entry_unset_payload(entry);
+		errno = EPROTO;
+		return -1;
+	}
+
+	log_info("process_client_recv_subscribe(): Subscribed %u entries (0: all).\n", nmemb);
+
+	/* Completion records are pushed by the daemon until the connection is closed */
+	for (;;) {
+		if (_process_client_recv_show_chunk(entry) < 0) {
+			errsv = errno;
+			log_crit("process_client_recv_subscribe(): _process_client_recv_show_chunk(): %s\n", strerror(errno));
+			goto _subscribe_failure;
+		}
+
+		p_offset = 0;
+
+		if (_process_client_show_get32(entry, &p_offset, &nmemb) < 0) {
+			log_crit("process_client_recv_subscribe(): Invalid records header.\n");
+			errsv = EPROTO;
+			goto _subscribe_failure;
+		}
+
+		for (i = 0; i < nmemb; i ++) {
+			if (_process_client_subscribe_record(entry, &p_offset, &rec) < 0) {
+				errsv = errno;
+				log_crit("process_client_recv_subscribe(): _process_client_subscribe_record(): %s\n", strerror(errno));
+				goto _subscribe_failure;
+			}
+
+			/* Check if this is a library call */
+			if (!bit_test(&runc.flags, USCHED_RUNTIME_FLAG_LIB)) {
+				print_client_result_subscribe(&rec);
+			} else if (runc.subscribe_handler && (runc.subscribe_handler(&rec) < 0)) {
+				/* The handler requested the subscription to be terminated */
+				entry_unset_payload(entry);
+				return 0;
+			}
+		}
+
+		if (p_offset != entry->psize) {
+			log_crit("process_client_recv_subscribe(): Trailing data found after the last record.\n");
+			errsv = EPROTO;
+			goto _subscribe_failure;
+		}
+	}
+
+_subscribe_failure:
+	entry_unset_payload(entry);
+
+	errno = errsv;
+
+	return -1;
+}
+
+int process_client_recv_batch(struct usched_entry *entry, struct usched_entry **ops, uint32_t nmemb) {
+	int errsv = 0, ret = 0;
+	uint32_t i = 0, data_len = 0, version = 0, status = 0, rsize = 0;
+	size_t p_offset = 0;
+	ssize_t pret = 0;
+
+	/* Cleanup entry payload if required */
+	if (entry->payload) {
+		mm_free(entry->payload);
+		entry->payload = NULL;
+		entry->psize = 0;
+	}
+
+	/* Read data size */
+	if (conn_read_blocking(runc.fd, &data_len, 4) != 4) {
+		errsv = errno;
+		log_crit("process_client_recv_batch(): conn_read_blocking(..., &data_len, 4) != 4: %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Set the entry payload size */
+	entry->psize = ntohl(data_len) - 4;
+
+	/* Allocate enough memory to receive the payload */
+	if (!(entry->payload = mm_alloc(entry->psize))) {
+		errsv = errno;
+		log_crit("process_client_recv_batch(): mm_alloc(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Receive the payload */
+	if ((pret = conn_read_blocking(runc.fd, entry->payload, entry->psize)) != (ssize_t) entry->psize) {
+		errsv = errno;
+		log_crit("process_client_recv_batch(): conn_read_blocking(..., entry->payload, entry->psize) != entry->psize: %s. (conn_read_blocking(): %zd bytes, entry->psize: %zd bytes)\n", strerror(errno), pret, entry->psize);
+		entry_unset_payload(entry);
+		errno = errsv;
+		return -1;
+	}
+
+	/* Decrypt the payload */
+	if (entry_payload_decrypt(entry) < 0) {
+		errsv = errno;
+		log_crit("process_client_recv_batch(): entry_payload_decrypt(): %s\n", strerror(errno));
+		entry_unset_payload(entry);
+		errno = errsv;
+		return -1;
+	}
+
+	/* Validate the batch response header */
+	if (entry->psize < 8) {
+		log_crit("process_client_recv_batch(): Batch response is too short.\n");
+		entry_unset_payload(entry);
+		errno = EPROTO;
+		return -1;
+	}
+
+	memcpy(&version, entry->payload, 4);
+	memcpy(&data_len, entry->payload + 4, 4);
+	p_offset = 8;
+
+	if ((ntohl(version) != CONFIG_USCHED_BATCH_VERSION) || (ntohl(data_len) != nmemb)) {
+		log_crit("process_client_recv_batch(): Unexpected batch response header (version: %u, nmemb: %u).\n", ntohl(version), ntohl(data_len));
+		entry_unset_payload(entry);
+		errno = EPROTO;
+		return -1;
+	}
+
+	/* Process the result of each operation, in the same order they were requested */
+	for (i = 0; i < nmemb; i ++) {
+		if ((entry->psize - p_offset) < 8) {
+			log_crit("process_client_recv_batch(): Batch response is truncated at operation #%u.\n", i);
+			errno = EPROTO;
+			ret = -1;
+			break;
+		}
+
+		memcpy(&status, entry->payload + p_offset, 4);
+		memcpy(&rsize, entry->payload + p_offset + 4, 4);
+		p_offset += 8;
+
+		status = ntohl(status);
+		rsize = ntohl(rsize);
+
+		if (rsize > (entry->psize - p_offset)) {
+			log_crit("process_client_recv_batch(): Batch response is truncated at operation #%u.\n", i);
+			errno = EPROTO;
+			ret = -1;
+			break;
+		}
+
+		/* Failed operations do not invalidate the remaining results */
+		if (status) {
+			log_crit("process_client_recv_batch(): Operation #%u failed: %s\n", i, strerror(status));
+			errsv = status;
+			ret = -1;
+			p_offset += rsize;
+			continue;
+		}
+
+		/* Replace the operation request payload with its result */
+		entry_unset_payload(ops[i]);
+
+		if (entry_set_payload(ops[i], entry->payload + p_offset, rsize) < 0) {
+			errsv = errno;
+			log_crit("process_client_recv_batch(): entry_set_payload(): %s\n", strerror(errno));
+			ret = -1;
+			p_offset += rsize;
+			continue;
+		}
+
+		p_offset += rsize;
+
+		if (entry_has_flag(ops[i], USCHED_ENTRY_FLAG_NEW)) {
+			pret = _process_client_result_run(ops[i]);
+		} else if (entry_has_flag(ops[i], USCHED_ENTRY_FLAG_DEL)) {
+			pret = _process_client_result_stop(ops[i]);
+		} else if (entry_has_flag(ops[i], USCHED_ENTRY_FLAG_GET)) {
+			pret = _process_client_result_show(ops[i]);
+		} else {
+			entry_unset_payload(ops[i]);
+			errno = EINVAL;
+			pret = -1;
+		}
+
+		if (pret < 0) {
+			errsv = errno;
+			ret = -1;
+		}
+	}
+
+	entry_unset_payload(entry);
+
+	if (ret < 0 && errsv)
+		errno = errsv;
+
+	return ret;
+}
+
@@ -53,6 +53,7 @@ int runtime_client_init(int argc, char **argv) {
 	runc.argc = argc;
 	runc.argv = argv;
 	runc.t = time(NULL);
+	runc.opt.show_fields = USCHED_ENTRY_FIELDS_ALL;
 
 	/* Initialize logging interface */
 	if (log_client_init() < 0) {
@@ -139,6 +140,7 @@ int runtime_client_lib_init(void) {
 	memset(&runc, 0, sizeof(struct usched_runtime_client));
 
 	runc.t = time(NULL);
+	runc.opt.show_fields = USCHED_ENTRY_FIELDS_ALL;
 
 	/* Initialize logging interface */
 	if (log_client_init() < 0) {
@@ -174,8 +176,9 @@ int runtime_client_lib_init(void) {
 }
 
 int runtime_client_lib_reset(void) {
-	/* Destroy connection interface */
-	conn_client_destroy();
+	/* The connection interface is kept open so it can be reused by the next request. See
+	 * conn_client_init().
+	 */
 
 	/* Clear data from previous request, if any */
 	pool_client_destroy();
@@ -206,6 +209,9 @@ void runtime_client_destroy(void) {
 	/* Destroy connection interface */
 	conn_client_destroy();
 
+	/* Discard the session ticket, if any */
+	memset(&runc.ticket, 0, sizeof(runc.ticket));
+
 	/* Destroy pools */
 	pool_client_destroy();
 
@@ -235,6 +241,9 @@ void runtime_client_lib_destroy(void) {
 	/* Destroy connection interface */
 	conn_client_destroy();
 
+	/* Discard the session ticket, if any */
+	memset(&runc.ticket, 0, sizeof(runc.ticket));
+
 	/* Destroy pools */
 	pool_client_destroy();
 
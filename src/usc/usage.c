@@ -90,7 +90,7 @@ static void _usage_client_error_print(void) {
 void usage_client_show(void) {
 	_usage_client_error_print();
 		
-	fprintf(stderr, "Usage: %s [ OPTIONS ] OP SUBJ { PREP [ ADVERB ARG | ARG ADVERB ] [ CONJ ... ] }\n", runc.argv[0]);
+	fprintf(stderr, "Usage: %s [ OPTIONS ] OP [ MODE ] SUBJ { PREP [ ADVERB ARG | ARG ADVERB ] [ CONJ ... ] }\n", runc.argv[0]);
 	fprintf(stderr, "\n");
 	fprintf(stderr, "\tOPTIONS\n");
 	fprintf(stderr, "\t\t-h\tShow this help.\n");
@@ -98,8 +98,15 @@ void usage_client_show(void) {
 	fprintf(stderr, "\t\t-p\tTCP port of the remote server.\n");
 	fprintf(stderr, "\t\t-U\tUsername for remote authentication.\n");
 	fprintf(stderr, "\t\t-P\tPassword for remote authentication.\n");
+	fprintf(stderr, "\t\t-o\tOverlap policy of new entries (allow | skip | queue | kill).\n");
+	fprintf(stderr, "\t\t-c\tMax concurrent executions of new entries (0: policy default).\n");
+	fprintf(stderr, "\t\t-r\tPriority class of new entries (low | normal | high).\n");
+	fprintf(stderr, "\t\t-f\tComma separated fields fetched by show (all | id | flags | uid | gid |\n");
+	fprintf(stderr, "\t\t\ttrigger | step | expire | overlap | concurrency | priority | pid |\n");
+	fprintf(stderr, "\t\t\tstatus | exectime | latency | output | username | command).\n");
 	fprintf(stderr, "\n");
-	fprintf(stderr,     "\tOP\t\thold    | run      | stop  | show\n");
+	fprintf(stderr,     "\tOP\t\thold    | run      | stop  | show  | subscribe\n");
+	fprintf(stderr,   "\tMODE\t\tshell   | direct   (run only)\n");
 	fprintf(stderr,   "\tPREP\t\tevery   | in       | now   | on    | to\n");
 	fprintf(stderr, "\tADVERB\t\tseconds | minutes  | hours | days  | weeks    | months\n");
 	fprintf(stderr,       "\t\t\tyears   | weekdays | time  | date  | datetime | timestamp\n");
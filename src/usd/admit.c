@@ -0,0 +1,346 @@
+/**
+ * @file admit.c
+ * @brief uSched
+ *        Request admission control interface - Daemon
+ *
+ * Date: 18-10-2026
+ *
+ * Copyright 2014-2015 Pedro A. Hortas (pah@ucodev.org)
+ *
+ * This file is part of usched.
+ *
+ * usched is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * usched is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with usched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+
+#include <sys/types.h>
+
+#include <pall/cll.h>
+
+#include <rtsaio/rtsaio.h>
+
+#include "config.h"
+#include "bitops.h"
+#include "runtime.h"
+#include "mm.h"
+#include "log.h"
+#include "entry.h"
+#include "conn.h"
+#include "local.h"
+#include "auth.h"
+#include "admit.h"
+
+static int _admit_daemon_compare(const void *a1, const void *a2) {
+	const struct usched_admit_entry *pa1 = a1, *pa2 = a2;
+
+	if (pa1->uid > pa2->uid)
+		return 1;
+
+	if (pa1->uid < pa2->uid)
+		return -1;
+
+	return strcmp(pa1->username, pa2->username);
+}
+
+static void _admit_daemon_destroy(void *elem) {
+	mm_free(elem);
+}
+
+static struct usched_admit_entry *_admit_daemon_get(uid_t uid, const char *username) {
+	int errsv = 0;
+	struct usched_admit_entry *a = NULL, key;
+
+	memset(&key, 0, sizeof(struct usched_admit_entry));
+
+	key.uid = uid;
+	strncpy(key.username, username, sizeof(key.username) - 1);
+
+	if ((a = rund.admit->search(rund.admit, &key)))
+		return a;
+
+	/* First request from this requester. Start with a full bucket. */
+	if (!(a = mm_alloc(sizeof(struct usched_admit_entry)))) {
+		errsv = errno;
+		log_warn("_admit_daemon_get(): mm_alloc(): %s\n", strerror(errno));
+		errno = errsv;
+		return NULL;
+	}
+
+	memcpy(a, &key, sizeof(struct usched_admit_entry));
+
+	a->tokens = (uint64_t) rund.config.auth.rate_burst * 1000;
+
+	clock_gettime(CLOCK_MONOTONIC, &a->t_refill);
+
+	if (rund.admit->insert(rund.admit, a) < 0) {
+		errsv = errno;
+		log_warn("_admit_daemon_get(): rund.admit->insert(): %s\n", strerror(errno));
+		mm_free(a);
+		errno = errsv;
+		return NULL;
+	}
+
+	return a;
+}
+
+static void _admit_daemon_refill(struct usched_admit_entry *a) {
+	uint64_t elapsed = 0, capacity = (uint64_t) rund.config.auth.rate_burst * 1000;
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	/* A bucket idle for 'burst' seconds or more is always full, even at the lowest rate */
+	if ((now.tv_sec - a->t_refill.tv_sec) >= (time_t) rund.config.auth.rate_burst) {
+		a->tokens = capacity;
+	} else {
+		elapsed = (uint64_t) (now.tv_sec - a->t_refill.tv_sec) * 1000000000 + now.tv_nsec - a->t_refill.tv_nsec;
+
+		/* rate_limit requests per second are rate_limit thousandths of a request per ms */
+		a->tokens += (elapsed * rund.config.auth.rate_limit) / 1000000;
+
+		if (a->tokens > capacity)
+			a->tokens = capacity;
+	}
+
+	a->t_refill = now;
+}
+
+static int _admit_daemon_rate_take(uid_t uid, const char *username, unsigned int count) {
+	int errsv = 0;
+	struct usched_admit_entry *a = NULL;
+
+	/* NOTE: rund.mutex_admit must be held by the caller */
+
+	if (!(a = _admit_daemon_get(uid, username))) {
+		errsv = errno;
+		log_warn("_admit_daemon_rate_take(): _admit_daemon_get(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	_admit_daemon_refill(a);
+
+	/* All or nothing: a batch is never partially admitted */
+	if (a->tokens < ((uint64_t) count * 1000)) {
+		rund.admit_rate_rejected ++;
+
+		log_warn("_admit_daemon_rate_take(): Requester (UID: %u, Username: %s) exceeded the request rate limit (%u/s). (Rate rejections: %llu, Quota rejections: %llu)\n", uid, username[0] ? username : "-", rund.config.auth.rate_limit, rund.admit_rate_rejected, rund.admit_quota_rejected);
+
+		errno = EBUSY;
+
+		return -1;
+	}
+
+	a->tokens -= (uint64_t) count * 1000;
+
+	return 0;
+}
+
+static int _admit_daemon_entry_hold(uid_t uid, int enforce) {
+	int errsv = 0;
+	struct usched_admit_entry *a = NULL;
+
+	pthread_mutex_lock(&rund.mutex_admit);
+
+	if (!(a = _admit_daemon_get(uid, ""))) {
+		errsv = errno;
+		pthread_mutex_unlock(&rund.mutex_admit);
+		log_warn("_admit_daemon_entry_hold(): _admit_daemon_get(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (enforce && rund.config.auth.quota_entries && (a->active >= rund.config.auth.quota_entries)) {
+		rund.admit_quota_rejected ++;
+
+		log_warn("_admit_daemon_entry_hold(): UID %u reached the active entries quota (%u). (Rate rejections: %llu, Quota rejections: %llu)\n", uid, rund.config.auth.quota_entries, rund.admit_rate_rejected, rund.admit_quota_rejected);
+
+		pthread_mutex_unlock(&rund.mutex_admit);
+
+		errno = EDQUOT;
+
+		return -1;
+	}
+
+	a->active ++;
+
+	pthread_mutex_unlock(&rund.mutex_admit);
+
+	return 0;
+}
+
+int admit_daemon_init(void) {
+	int errsv = 0;
+
+	rund.admit_rate_rejected = 0;
+	rund.admit_quota_rejected = 0;
+
+	if (!(rund.admit = pall_cll_init(&_admit_daemon_compare, &_admit_daemon_destroy, NULL, NULL))) {
+		errsv = errno;
+		log_crit("admit_daemon_init(): rund.admit = pall_cll_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Setup CLL: No auto search, head insert, search forward */
+	(void) rund.admit->set_config(rund.admit, (ui32_t) (CONFIG_SEARCH_FORWARD | CONFIG_INSERT_HEAD));
+
+	/* All good */
+	return 0;
+}
+
+void admit_daemon_destroy(void) {
+	pthread_mutex_lock(&rund.mutex_admit);
+
+	if (rund.admit) {
+		pall_cll_destroy(rund.admit);
+		rund.admit = NULL;
+	}
+
+	pthread_mutex_unlock(&rund.mutex_admit);
+
+	log_info("admit_daemon_destroy(): Rejected requests due to rate limit: %llu, Due to active entries quota: %llu.\n", rund.admit_rate_rejected, rund.admit_quota_rejected);
+}
+
+int admit_daemon_request(const struct async_op *aop) {
+	int errsv = 0;
+	uint32_t flags = 0;
+	uid_t uid = 0;
+	gid_t gid = 0;
+	char username[CONFIG_USCHED_AUTH_USERNAME_MAX];
+	const struct usched_entry *hdr = (const struct usched_entry *) aop->data;
+	struct usched_auth_user user;
+	struct usched_admit_entry *a = NULL;
+
+	/* Only NEW requests are subject to admission control */
+	flags = ntohl(hdr->flags);
+
+	if (!bit_test(&flags, USCHED_ENTRY_FLAG_NEW))
+		return 0;
+
+	/* Nothing to do if both limits are disabled */
+	if (!rund.config.auth.rate_limit && !rund.config.auth.quota_entries)
+		return 0;
+
+	memset(username, 0, sizeof(username));
+
+	/* Identify the requester. No allocation nor cryptographic work is performed here. */
+	if (conn_is_local(aop->fd) == 1) {
+		if (local_fd_peer_cred(aop->fd, &uid, &gid) < 0) {
+			errsv = errno;
+			log_warn("admit_daemon_request(): local_fd_peer_cred(): %s\n", strerror(errno));
+			errno = errsv;
+			return -1;
+		}
+	} else {
+		/* The username isn't authenticated yet. It's only used to select the rate bucket and
+		 * the UID quota of the configured user. Unknown users are rejected later on.
+		 */
+		memcpy(username, hdr->username, sizeof(username) - 1);
+
+		if (auth_daemon_users_get(username, &user) < 0)
+			return 0;
+
+		uid = user.uid;
+
+		memset(&user, 0, sizeof(struct usched_auth_user));
+	}
+
+	pthread_mutex_lock(&rund.mutex_admit);
+
+	/* Check the active entries quota of the UID */
+	if (rund.config.auth.quota_entries) {
+		if (!(a = _admit_daemon_get(uid, ""))) {
+			errsv = errno;
+			pthread_mutex_unlock(&rund.mutex_admit);
+			log_warn("admit_daemon_request(): _admit_daemon_get(): %s\n", strerror(errno));
+			errno = errsv;
+			return -1;
+		}
+
+		if (a->active >= rund.config.auth.quota_entries) {
+			rund.admit_quota_rejected ++;
+
+			log_warn("admit_daemon_request(): UID %u reached the active entries quota (%u). (Rate rejections: %llu, Quota rejections: %llu)\n", uid, rund.config.auth.quota_entries, rund.admit_rate_rejected, rund.admit_quota_rejected);
+
+			pthread_mutex_unlock(&rund.mutex_admit);
+
+			errno = EDQUOT;
+
+			return -1;
+		}
+	}
+
+	/* Check the request rate of the requester */
+	if (rund.config.auth.rate_limit && (_admit_daemon_rate_take(uid, username, 1) < 0)) {
+		errsv = errno;
+		pthread_mutex_unlock(&rund.mutex_admit);
+		errno = errsv;
+		return -1;
+	}
+
+	pthread_mutex_unlock(&rund.mutex_admit);
+
+	return 0;
+}
+
+int admit_daemon_request_batch(uid_t uid, const char *username, unsigned int count) {
+	int errsv = 0;
+
+	/* Batches are rate limited as one NEW request per NEW operation */
+	if (!rund.config.auth.rate_limit || !count)
+		return 0;
+
+	pthread_mutex_lock(&rund.mutex_admit);
+
+	if (_admit_daemon_rate_take(uid, username, count) < 0) {
+		errsv = errno;
+		pthread_mutex_unlock(&rund.mutex_admit);
+		errno = errsv;
+		return -1;
+	}
+
+	pthread_mutex_unlock(&rund.mutex_admit);
+
+	return 0;
+}
+
+int admit_daemon_entry_hold(uid_t uid) {
+	return _admit_daemon_entry_hold(uid, 1);
+}
+
+void admit_daemon_entry_restore(uid_t uid) {
+	/* Entries loaded from the serialization file are always accounted, even above quota */
+	if (_admit_daemon_entry_hold(uid, 0) < 0)
+		log_warn("admit_daemon_entry_restore(): _admit_daemon_entry_hold(): %s\n", strerror(errno));
+}
+
+void admit_daemon_entry_release(uid_t uid) {
+	struct usched_admit_entry *a = NULL;
+
+	pthread_mutex_lock(&rund.mutex_admit);
+
+	if (rund.admit && (a = rund.admit->search(rund.admit, (struct usched_admit_entry [1]) { { uid, "", 0, { 0, 0 }, 0 } })) && a->active)
+		a->active --;
+
+	pthread_mutex_unlock(&rund.mutex_admit);
+}
+
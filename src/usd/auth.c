@@ -26,9 +26,14 @@
 
 
 #include <stdio.h>
+#include <stdint.h>
 #include <string.h>
 #include <errno.h>
+#include <time.h>
 #include <unistd.h>
+#include <pthread.h>
+
+#include <pall/cll.h>
 
 #include <psec/crypt.h>
 #include <psec/decode.h>
@@ -41,8 +46,290 @@
 #include "debug.h"
 #include "config.h"
 #include "runtime.h"
+#include "mm.h"
 #include "log.h"
 #include "local.h"
+#include "auth.h"
+#include "hash.h"
+
+static int _auth_daemon_ticket_compare(const void *a1, const void *a2) {
+	const struct usched_auth_ticket *pa1 = a1, *pa2 = a2;
+
+	return memcmp(pa1->id, pa2->id, sizeof(pa1->id));
+}
+
+static void _auth_daemon_ticket_destroy(void *elem) {
+	memset(elem, 0, sizeof(struct usched_auth_ticket));
+
+	mm_free(elem);
+}
+
+static time_t _auth_daemon_ticket_now(void) {
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return now.tv_sec;
+}
+
+static int _auth_daemon_ticket_pwhash(unsigned char *digest, const struct usched_config_userinfo *userinfo) {
+	int errsv = 0;
+
+	/* Tickets are bound to the password hash they were issued for */
+	if (!hash_buffer_blake2s(digest, (unsigned char *) userinfo->password, strlen(userinfo->password))) {
+		errsv = errno;
+		log_warn("_auth_daemon_ticket_pwhash(): hash_buffer_blake2s(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+static void _auth_daemon_ticket_purge(time_t now) {
+	size_t i = 0, nmemb = 0;
+	struct usched_auth_ticket *ticket = NULL, **expired = NULL;
+
+	/* NOTE: rund.mutex_ticket must be held by the caller */
+
+	if (!(expired = mm_alloc(rund.tickets->count(rund.tickets) * sizeof(struct usched_auth_ticket *)))) {
+		log_warn("_auth_daemon_ticket_purge(): mm_alloc(): %s\n", strerror(errno));
+		return;
+	}
+
+	for (rund.tickets->rewind(rund.tickets, 0); (ticket = rund.tickets->iterate(rund.tickets)); ) {
+		if (ticket->expire <= now)
+			expired[nmemb ++] = ticket;
+	}
+
+	for (i = 0; i < nmemb; i ++)
+		rund.tickets->del(rund.tickets, expired[i]);
+
+	mm_free(expired);
+}
+
+static void _auth_daemon_users_destroy(struct usched_auth_users *users) {
+	if (!users)
+		return;
+
+	if (users->user) {
+		memset(users->user, 0, users->nmemb * sizeof(struct usched_auth_user));
+		mm_free(users->user);
+	}
+
+	if (users->bucket)
+		mm_free(users->bucket);
+
+	memset(users, 0, sizeof(struct usched_auth_users));
+
+	mm_free(users);
+}
+
+static int _auth_daemon_users_add(struct usched_auth_users *users, const struct usched_config_userinfo *userinfo) {
+	int errsv = 0;
+	size_t out_len = 0, b = 0;
+	unsigned char salt_raw[CONFIG_USCHED_AUTH_USERNAME_MAX];
+	struct usched_auth_user *user = &users->user[users->nmemb];
+
+	/* Check if username doesn't exceed the expected size */
+	if (strlen(userinfo->username) > sizeof(salt_raw)) {
+		log_warn("_auth_daemon_users_add(): strlen(username) > sizeof(salt_raw) (Username: %s)\n", userinfo->username);
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Grant that userinfo->password doesn't exceed the expected length */
+	if (decode_size_base64(strlen(userinfo->password)) > sizeof(user->pwhash)) {
+		log_warn("_auth_daemon_users_add(): pwhash buffer is too small to receive the decoded user password (Username: %s).\n", userinfo->username);
+		errno = EINVAL;
+		return -1;
+	}
+
+	memset(user, 0, sizeof(struct usched_auth_user));
+
+	strcpy(user->username, userinfo->username);
+	user->uid = userinfo->uid;
+	user->gid = userinfo->gid;
+
+	/* Decode the base64 encoded password hash */
+	if (!decode_buffer_base64(user->pwhash, &out_len, (unsigned char *) userinfo->password, strlen(userinfo->password))) {
+		errsv = errno;
+		log_warn("_auth_daemon_users_add(): decode_buffer_base64(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Craft and hash the raw salt */
+	memset(salt_raw, 'x', sizeof(salt_raw));
+	memcpy(salt_raw, userinfo->username, strlen(userinfo->username));
+
+	if (!hash_buffer_blake2s(user->salt, salt_raw, sizeof(salt_raw))) {
+		errsv = errno;
+		log_warn("_auth_daemon_users_add(): hash_buffer_blake2s(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if (_auth_daemon_ticket_pwhash(user->pwdigest, userinfo) < 0) {
+		errsv = errno;
+		log_warn("_auth_daemon_users_add(): _auth_daemon_ticket_pwhash(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Link the user to its bucket */
+	user->hash = hash_string_create(user->username);
+
+	b = user->hash & users->bucket_mask;
+
+	user->next = users->bucket[b];
+	users->bucket[b] = users->nmemb ++;
+
+	return 0;
+}
+
+static struct usched_auth_users *_auth_daemon_users_create(void) {
+	int errsv = 0;
+	size_t i = 0, count = 0, bucket_nmemb = 16;
+	struct usched_config_userinfo *userinfo = NULL;
+	struct usched_auth_users *users = NULL;
+
+	count = rund.config.users.list->count(rund.config.users.list);
+
+	/* Keep the load factor below 0.5 */
+	while (bucket_nmemb < (count * 2))
+		bucket_nmemb <<= 1;
+
+	if (!(users = mm_alloc(sizeof(struct usched_auth_users)))) {
+		errsv = errno;
+		log_warn("_auth_daemon_users_create(): mm_alloc(): %s\n", strerror(errno));
+		errno = errsv;
+		return NULL;
+	}
+
+	memset(users, 0, sizeof(struct usched_auth_users));
+
+	users->bucket_mask = bucket_nmemb - 1;
+
+	if (!(users->user = mm_alloc((count ? count : 1) * sizeof(struct usched_auth_user)))) {
+		errsv = errno;
+		log_warn("_auth_daemon_users_create(): mm_alloc(): %s\n", strerror(errno));
+		_auth_daemon_users_destroy(users);
+		errno = errsv;
+		return NULL;
+	}
+
+	if (!(users->bucket = mm_alloc(bucket_nmemb * sizeof(size_t)))) {
+		errsv = errno;
+		log_warn("_auth_daemon_users_create(): mm_alloc(): %s\n", strerror(errno));
+		_auth_daemon_users_destroy(users);
+		errno = errsv;
+		return NULL;
+	}
+
+	/* All buckets are empty (any index >= nmemb terminates a chain) */
+	for (i = 0; i < bucket_nmemb; i ++)
+		users->bucket[i] = count;
+
+	for (rund.config.users.list->rewind(rund.config.users.list, 0); (userinfo = rund.config.users.list->iterate(rund.config.users.list)); ) {
+		/* Users that can't be loaded are unable to authenticate, as before */
+		if (_auth_daemon_users_add(users, userinfo) < 0)
+			log_warn("_auth_daemon_users_create(): _auth_daemon_users_add(): %s\n", strerror(errno));
+	}
+
+	return users;
+}
+
+int auth_daemon_users_reload(void) {
+	int errsv = 0;
+	struct usched_auth_users *users = NULL, *users_old = NULL;
+
+	/* Build the new table without blocking the authentication path */
+	if (!(users = _auth_daemon_users_create())) {
+		errsv = errno;
+		log_warn("auth_daemon_users_reload(): _auth_daemon_users_create(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Publish it */
+	pthread_mutex_lock(&rund.mutex_users);
+	users_old = rund.users;
+	rund.users = users;
+	pthread_mutex_unlock(&rund.mutex_users);
+
+	_auth_daemon_users_destroy(users_old);
+
+	return 0;
+}
+
+int auth_daemon_users_get(const char *username, struct usched_auth_user *user) {
+	size_t i = 0;
+	uint64_t hash = hash_string_create(username);
+
+	pthread_mutex_lock(&rund.mutex_users);
+
+	if (rund.users) {
+		for (i = rund.users->bucket[hash & rund.users->bucket_mask]; i < rund.users->nmemb; i = rund.users->user[i].next) {
+			if ((rund.users->user[i].hash == hash) && !strcmp(rund.users->user[i].username, username)) {
+				memcpy(user, &rund.users->user[i], sizeof(struct usched_auth_user));
+
+				pthread_mutex_unlock(&rund.mutex_users);
+
+				return 0;
+			}
+		}
+	}
+
+	pthread_mutex_unlock(&rund.mutex_users);
+
+	errno = ENOENT;
+
+	return -1;
+}
+
+int auth_daemon_init(void) {
+	int errsv = 0;
+
+	if (!(rund.tickets = pall_cll_init(&_auth_daemon_ticket_compare, &_auth_daemon_ticket_destroy, NULL, NULL))) {
+		errsv = errno;
+		log_crit("auth_daemon_init(): rund.tickets = pall_cll_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Setup CLL: No auto search, head insert, search forward */
+	(void) rund.tickets->set_config(rund.tickets, (ui32_t) (CONFIG_SEARCH_FORWARD | CONFIG_INSERT_HEAD));
+
+	/* Load the remote users table */
+	if (auth_daemon_users_reload() < 0) {
+		errsv = errno;
+		log_crit("auth_daemon_init(): auth_daemon_users_reload(): %s\n", strerror(errno));
+		pall_cll_destroy(rund.tickets);
+		rund.tickets = NULL;
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+void auth_daemon_destroy(void) {
+	pthread_mutex_lock(&rund.mutex_ticket);
+
+	if (rund.tickets) {
+		pall_cll_destroy(rund.tickets);
+		rund.tickets = NULL;
+	}
+
+	pthread_mutex_unlock(&rund.mutex_ticket);
+
+	pthread_mutex_lock(&rund.mutex_users);
+	_auth_daemon_users_destroy(rund.users);
+	rund.users = NULL;
+	pthread_mutex_unlock(&rund.mutex_users);
+}
 
 int auth_daemon_local(sock_t fd, uid_t *uid, gid_t *gid) {
 	int errsv = 0;
@@ -77,11 +364,7 @@ int auth_daemon_remote_session_verify(
 	gid_t *gid)
 {
 	int errsv = 0;
-	struct usched_config_userinfo *userinfo = NULL;
-	unsigned char salt[HASH_DIGEST_SIZE_BLAKE2S];
-	unsigned char salt_raw[CONFIG_USCHED_AUTH_USERNAME_MAX];
-	unsigned char pwhash_s[HASH_DIGEST_SIZE_SHA512 + 3];
-	size_t out_len = 0;
+	struct usched_auth_user user;
 
 	/* Session data contents:
 	 *
@@ -101,59 +384,27 @@ int auth_daemon_remote_session_verify(
 		return -1;
 	}
 
-	/* Check if username doesn't exceed the expected size */
-	if (strlen(username) > sizeof(salt_raw)) {
-		log_warn("auth_daemon_remote_session_verify(): strlen(username) > sizeof(salt_raw)\n");
-		errno = EINVAL;
-		return -1;
-	}
-
-	/* Craft raw salt */
-	memset(salt_raw, 'x', sizeof(salt_raw));
-	memcpy(salt_raw, username, strlen(username));
-
-	/* Hash raw salt */
-	if (!hash_buffer_blake2s(salt, salt_raw, sizeof(salt_raw))) {
-		errsv = errno;
-		log_warn("auth_daemon_remote_session_verify(): hash_buffer_blake2s(): %s\n", strerror(errno));
-		errno = errsv;
-		return -1;
-	}
-
-	/* Get userinfo data from current configuration */
-	if (!(userinfo = rund.config.users.list->search(rund.config.users.list, (struct usched_config_userinfo [1]) { { (char *) username, NULL, NULL, 0, 0} }))) {
-		errsv = errno;
+	/* Get the user credentials from the current users table */
+	if (auth_daemon_users_get(username, &user) < 0) {
 		log_warn("auth_daemon_remote_session_verify(): No such username: %s\n", username);
-		errno = errsv;
-		return -1;
-	}
-
-	/* Grant that userinfo->password doesn't exceed the expected length */
-	if (decode_size_base64(strlen(userinfo->password)) > sizeof(pwhash_s)) {
-		log_warn("auth_daemon_remote_session_verify(): pwhash_s buffer is too small to receive the decoded user password.\n");
 		errno = EINVAL;
 		return -1;
 	}
 
-	/* Decode the base64 encoded password hash from current configuration */
-	if (!decode_buffer_base64(pwhash_s, &out_len, (unsigned char *) userinfo->password, strlen(userinfo->password))) {
-		errsv = errno;
-		log_warn("auth_daemon_remote_session_verify(): decode_buffer_base64(): %s\n", strerror(errno));
-		errno = errsv;
-		return -1;
-	}
-
 	/* Authorize */
-	if (ke_chreke_server_authorize(context, agreed_key, session, salt, sizeof(salt)) < 0) {
+	if (ke_chreke_server_authorize(context, agreed_key, session, user.salt, sizeof(user.salt)) < 0) {
 		errsv = errno;
 		log_warn("auth_daemon_remote_session_verify(): ke_chreke_server_authorize(): %s\n", strerror(errno));
+		memset(&user, 0, sizeof(struct usched_auth_user));
 		errno = errsv;
 		return -1;
 	}
 
 	/* Set effective UID and GID */
-	*uid = userinfo->uid;
-	*gid = userinfo->gid;
+	*uid = user.uid;
+	*gid = user.gid;
+
+	memset(&user, 0, sizeof(struct usched_auth_user));
 	
 	/* All good */
 	return 0;
@@ -165,10 +416,8 @@ int auth_daemon_remote_session_create(
 	unsigned char *context)
 {
 	int errsv = 0;
-	struct usched_config_userinfo *userinfo = NULL;
-	unsigned char pwhash[HASH_DIGEST_SIZE_SHA512 + 3];
+	struct usched_auth_user user;
 	unsigned char server_session[KE_SERVER_SESSION_SIZE_CHREKE];
-	size_t out_len = 0;
 
 	/* Session data contents
 	 *
@@ -187,46 +436,208 @@ int auth_daemon_remote_session_create(
 		return -1;
 	}
 
-	/* Get userinfo data from current configuration */
-	if (!(userinfo = rund.config.users.list->search(rund.config.users.list, (struct usched_config_userinfo [1]) { { (char *) username, NULL, NULL, 0, 0 } }))) {
+	/* Get the user credentials from the current users table */
+	if (auth_daemon_users_get(username, &user) < 0) {
 		log_warn("auth_daemon_remote_session_create(): No such username: %s\n", username);
 		errno = EINVAL;
 		return -1;
 	}
 
-	/* Grant that userinfo->password doesn't exceed the expected length */
-	if (decode_size_base64(strlen(userinfo->password)) > sizeof(pwhash)) {
-		log_warn("auth_daemon_remote_session_verify(): pwhash buffer is too small to receive the decoded user password.\n");
+	/* Initialize chreke server authentication */
+	if (!ke_chreke_server_init(server_session, context, session, user.pwhash)) {
+		errsv = errno;
+		log_warn("auth_daemon_remote_session_create(): ke_chreke_server_init(): %s\n", strerror(errno));
+		memset(&user, 0, sizeof(struct usched_auth_user));
+		errno = errsv;
+		return -1;
+	}
+
+	memset(&user, 0, sizeof(struct usched_auth_user));
+
+	/* Set session data */
+	memcpy(session, server_session, sizeof(server_session));
+
+	/* Advertise the lifetime of the session ticket issued on a successful authentication */
+	memcpy(session + sizeof(server_session), (uint32_t [1]) { htonl(CONFIG_USCHED_AUTH_TICKET_TTL) }, sizeof(uint32_t));
+
+	/* Session contents:
+	 *
+	 * | pubkey (32 bytes) | encrypted server token (32 bytes) |
+	 *
+	 * Total size of session field: 64 bytes
+	 */
+
+	/* All good */
+	return 0;
+}
+
+int auth_daemon_remote_ticket_issue(
+	const char *username,
+	const unsigned char *ticket_id,
+	const unsigned char *ticket_key)
+{
+	int errsv = 0;
+	time_t now = _auth_daemon_ticket_now();
+	struct usched_auth_user user;
+	struct usched_auth_ticket *ticket = NULL;
+
+	if (!CONFIG_USCHED_AUTH_TICKET_TTL)
+		return 0;
+
+	/* Get the user credentials from the current users table */
+	if (auth_daemon_users_get(username, &user) < 0) {
+		log_warn("auth_daemon_remote_ticket_issue(): No such username: %s\n", username);
 		errno = EINVAL;
 		return -1;
 	}
 
-	/* Decode user password hash from base64 */
-	if (!decode_buffer_base64(pwhash, &out_len, (unsigned char *) userinfo->password, strlen(userinfo->password))) {
+	if (!(ticket = mm_alloc(sizeof(struct usched_auth_ticket)))) {
 		errsv = errno;
-		log_warn("auth_daemon_remote_session_create(): decode_buffer_base64(): %s\n", strerror(errno));
+		log_warn("auth_daemon_remote_ticket_issue(): mm_alloc(): %s\n", strerror(errno));
 		errno = errsv;
 		return -1;
 	}
 
-	/* Initialize chreke server authentication */
-	if (!ke_chreke_server_init(server_session, context, session, pwhash)) {
+	memset(ticket, 0, sizeof(struct usched_auth_ticket));
+
+	memcpy(ticket->id, ticket_id, sizeof(ticket->id));
+	memcpy(ticket->key, ticket_key, sizeof(ticket->key));
+	strncpy(ticket->username, username, sizeof(ticket->username) - 1);
+	ticket->expire = now + CONFIG_USCHED_AUTH_TICKET_TTL;
+	memcpy(ticket->pwhash, user.pwdigest, sizeof(ticket->pwhash));
+
+	memset(&user, 0, sizeof(struct usched_auth_user));
+
+	pthread_mutex_lock(&rund.mutex_ticket);
+
+	/* Make room for the new ticket */
+	if (rund.tickets->count(rund.tickets) >= CONFIG_USCHED_AUTH_TICKET_MAX)
+		_auth_daemon_ticket_purge(now);
+
+	if (rund.tickets->count(rund.tickets) >= CONFIG_USCHED_AUTH_TICKET_MAX) {
+		pthread_mutex_unlock(&rund.mutex_ticket);
+		log_warn("auth_daemon_remote_ticket_issue(): Session tickets limit reached (%u).\n", CONFIG_USCHED_AUTH_TICKET_MAX);
+		_auth_daemon_ticket_destroy(ticket);
+		errno = ENOSPC;
+		return -1;
+	}
+
+	if (rund.tickets->insert(rund.tickets, ticket) < 0) {
 		errsv = errno;
-		log_warn("auth_daemon_remote_session_create(): ke_chreke_server_init(): %s\n", strerror(errno));
+		pthread_mutex_unlock(&rund.mutex_ticket);
+		log_warn("auth_daemon_remote_ticket_issue(): rund.tickets->insert(): %s\n", strerror(errno));
+		_auth_daemon_ticket_destroy(ticket);
 		errno = errsv;
 		return -1;
 	}
 
-	/* Set session data */
-	memcpy(session, server_session, sizeof(server_session));
+	pthread_mutex_unlock(&rund.mutex_ticket);
 
-	/* Session contents:
+	return 0;
+}
+
+int auth_daemon_remote_ticket_lookup(
+	const char *username,
+	const unsigned char *ticket_id,
+	unsigned char *ticket_key)
+{
+	time_t now = _auth_daemon_ticket_now();
+	unsigned char pwhash[CONFIG_USCHED_AUTH_TICKET_SIZE];
+	struct usched_auth_user user;
+	struct usched_auth_ticket *ticket = NULL, key;
+
+	/* The user must still exist and keep the same password the ticket was issued for */
+	if (auth_daemon_users_get(username, &user) < 0) {
+		log_warn("auth_daemon_remote_ticket_lookup(): No such username: %s\n", username);
+		errno = EINVAL;
+		return -1;
+	}
+
+	memcpy(pwhash, user.pwdigest, sizeof(pwhash));
+	memset(&user, 0, sizeof(struct usched_auth_user));
+
+	memset(&key, 0, sizeof(struct usched_auth_ticket));
+	memcpy(key.id, ticket_id, sizeof(key.id));
+
+	pthread_mutex_lock(&rund.mutex_ticket);
+
+	if (!(ticket = rund.tickets->search(rund.tickets, &key))) {
+		pthread_mutex_unlock(&rund.mutex_ticket);
+		log_warn("auth_daemon_remote_ticket_lookup(): No such session ticket (Username: %s).\n", username);
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (ticket->expire <= now) {
+		rund.tickets->del(rund.tickets, ticket);
+		pthread_mutex_unlock(&rund.mutex_ticket);
+		log_warn("auth_daemon_remote_ticket_lookup(): Session ticket expired (Username: %s).\n", username);
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (strcmp(ticket->username, username) || memcmp(ticket->pwhash, pwhash, sizeof(pwhash))) {
+		rund.tickets->del(rund.tickets, ticket);
+		pthread_mutex_unlock(&rund.mutex_ticket);
+		log_warn("auth_daemon_remote_ticket_lookup(): Session ticket doesn't match the current credentials of user %s.\n", username);
+		errno = EINVAL;
+		return -1;
+	}
+
+	memcpy(ticket_key, ticket->key, sizeof(ticket->key));
+
+	pthread_mutex_unlock(&rund.mutex_ticket);
+
+	return 0;
+}
+
+int auth_daemon_remote_ticket_verify(
+	const char *username,
+	const unsigned char *session,
+	const unsigned char *proof,
+	uid_t *uid,
+	gid_t *gid)
+{
+	size_t i = 0;
+	unsigned char diff = 0;
+	struct usched_auth_user user;
+
+	/* Session data contents:
 	 *
-	 * | pubkey (32 bytes) | encrypted server token (32 bytes) |
+	 * | proof (32 bytes) |
 	 *
-	 * Total size of session field: 64 bytes
 	 */
 
+	/* Same requirements as auth_daemon_remote_session_verify() */
+	if ((*uid != 0xff) || (*gid != 0xff)) {
+		log_warn("auth_daemon_remote_ticket_verify(): The received user or group identification doesn't match the specification for remote requests. (Remote UID: %u, Remote GID: %u)\n", *uid, *gid);
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Compare in constant time */
+	for (i = 0; i < CONFIG_USCHED_AUTH_TICKET_SIZE; i ++)
+		diff |= session[i] ^ proof[i];
+
+	if (diff) {
+		log_warn("auth_daemon_remote_ticket_verify(): Invalid session ticket proof (Username: %s).\n", username);
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Get the user credentials from the current users table */
+	if (auth_daemon_users_get(username, &user) < 0) {
+		log_warn("auth_daemon_remote_ticket_verify(): No such username: %s\n", username);
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Set effective UID and GID */
+	*uid = user.uid;
+	*gid = user.gid;
+
+	memset(&user, 0, sizeof(struct usched_auth_user));
+
 	/* All good */
 	return 0;
 }
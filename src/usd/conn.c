@@ -27,6 +27,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
 #include <errno.h>
 #include <pthread.h>
 
@@ -51,6 +52,14 @@
 #include "conn.h"
 #include "log.h"
 #include "gc.h"
+#include "pool.h"
+#include "process.h"
+#include "subscribe.h"
+
+#if CONFIG_USE_EPOLL == 1
+ #include <sys/epoll.h>
+ #include <netdb.h>
+#endif
 
 static int _conn_daemon_unix_init(void) {
 	int errsv = 0;
@@ -89,6 +98,98 @@ static int _conn_daemon_unix_init(void) {
 	return 0;
 }
 
+#if CONFIG_USE_EPOLL == 1
+static sock_t _conn_daemon_remote_listen_reuseport(void) {
+	int errsv = 0, ret = 0;
+	sock_t fd = (sock_t) -1;
+	struct addrinfo hints, *res = NULL;
+
+	memset(&hints, 0, sizeof(struct addrinfo));
+
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_flags = AI_PASSIVE;
+
+	if ((ret = getaddrinfo(rund.config.network.bind_addr, rund.config.network.bind_port, &hints, &res))) {
+		log_crit("_conn_daemon_remote_listen_reuseport(): getaddrinfo(\"%s\", \"%s\", ...): %s\n", rund.config.network.bind_addr, rund.config.network.bind_port, gai_strerror(ret));
+		errno = EINVAL;
+		return (sock_t) -1;
+	}
+
+	if ((fd = socket(res->ai_family, res->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, res->ai_protocol)) == (sock_t) -1) {
+		errsv = errno;
+		log_crit("_conn_daemon_remote_listen_reuseport(): socket(): %s\n", strerror(errno));
+		goto _listen_failure;
+	}
+
+	if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, (int [1]) { 1 }, sizeof(int)) < 0) {
+		errsv = errno;
+		log_crit("_conn_daemon_remote_listen_reuseport(): setsockopt(SO_REUSEADDR): %s\n", strerror(errno));
+		goto _listen_failure;
+	}
+
+	if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, (int [1]) { 1 }, sizeof(int)) < 0) {
+		errsv = errno;
+		log_crit("_conn_daemon_remote_listen_reuseport(): setsockopt(SO_REUSEPORT): %s\n", strerror(errno));
+		goto _listen_failure;
+	}
+
+	if (bind(fd, res->ai_addr, res->ai_addrlen) < 0) {
+		errsv = errno;
+		log_crit("_conn_daemon_remote_listen_reuseport(): bind(): %s\n", strerror(errno));
+		goto _listen_failure;
+	}
+
+	if (listen(fd, (int) rund.config.network.conn_limit) < 0) {
+		errsv = errno;
+		log_crit("_conn_daemon_remote_listen_reuseport(): listen(): %s\n", strerror(errno));
+		goto _listen_failure;
+	}
+
+	freeaddrinfo(res);
+
+	/* All good */
+	return fd;
+
+_listen_failure:
+	if (fd != (sock_t) -1)
+		close(fd);
+
+	freeaddrinfo(res);
+
+	errno = errsv;
+
+	return (sock_t) -1;
+}
+
+static int _conn_daemon_remote_init_reuseport(void) {
+	int errsv = 0;
+	unsigned int i = 0;
+
+	/* Each acceptor owns a listener bound to the same address. The kernel balances the incoming
+	 * connections between them.
+	 */
+	for (i = 0; i < rund.config.network.accept_workers; i ++) {
+		if ((rund.fd_accept[i] = _conn_daemon_remote_listen_reuseport()) == (sock_t) -1) {
+			errsv = errno;
+			log_crit("_conn_daemon_remote_init_reuseport(): _conn_daemon_remote_listen_reuseport(): %s\n", strerror(errno));
+
+			while (i --)
+				panet_safe_close(rund.fd_accept[i]);
+
+			errno = errsv;
+			return -1;
+		}
+	}
+
+	rund.fd_remote = rund.fd_accept[0];
+	rund.accept_nmemb = rund.config.network.accept_workers;
+
+	/* All good */
+	return 0;
+}
+#endif
+
 static int _conn_daemon_remote_init(void) {
 	int errsv = 0;
 
@@ -98,6 +199,12 @@ static int _conn_daemon_remote_init(void) {
 		return 0;
 	}
 
+#if CONFIG_USE_EPOLL == 1
+	/* Multiple acceptors require one SO_REUSEPORT listener per acceptor */
+	if (rund.config.network.accept_workers > 1)
+		return _conn_daemon_remote_init_reuseport();
+#endif
+
 	/* Initialize remote connections manager */
 	if ((rund.fd_remote = panet_server_ipv4(rund.config.network.bind_addr, rund.config.network.bind_port, PANET_PROTO_TCP, (int) rund.config.network.conn_limit)) == (sock_t) -1) {
 		errsv = errno;
@@ -114,6 +221,8 @@ static int _conn_daemon_remote_init(void) {
 		return -1;
 	}
 
+	rund.fd_accept[0] = rund.fd_remote;
+
 	/* All good */
 	return 0;
 }
@@ -121,6 +230,9 @@ static int _conn_daemon_remote_init(void) {
 int conn_daemon_init(void) {
 	int errsv = 0;
 
+	/* A single acceptor handles both listeners unless multiple remote acceptors are set */
+	rund.accept_nmemb = 1;
+
 	/* Initialize RTSAIO */
 	if (rtsaio_init(-(int) rund.config.core.thread_workers, SCHED_OTHER, rund.config.core.thread_priority, &notify_write, &notify_read) < 0) {
 		errsv = errno;
@@ -153,6 +265,15 @@ static int _conn_daemon_process_fd(sock_t fd) {
 	int errsv = 0;
 	struct async_op *aop = NULL;
 
+	/* Start a fresh receiving table slot for this connection */
+	if (pool_daemon_conn_open(fd) < 0) {
+		errsv = errno;
+		log_warn("conn_daemon_process(): pool_daemon_conn_open(): %s\n", strerror(errno));
+		conn_daemon_client_close(fd);
+		errno = errsv;
+		return -1;
+	}
+
 	/* Alloate enough memory for aop */
 	if (!(aop = mm_alloc(sizeof(struct async_op)))) {
 		errsv = errno;
@@ -167,24 +288,19 @@ static int _conn_daemon_process_fd(sock_t fd) {
 
 	/* Setup aop */
 	aop->fd = fd;
-	/* id(8), flags(4), uid(4), gid(4), trigger(4), step(4), expire(4), psize(4) */
-	aop->count = usched_entry_hdr_size();
 	aop->priority = 0;
 	aop->timeout.tv_sec = rund.config.network.conn_timeout;
 
 	/* Allocate enough memory to received the entry header */
-	if (!(aop->data = mm_alloc(aop->count))) {
+	if (process_daemon_recv_prepare(aop) < 0) {
 		errsv = errno;
-		log_warn("conn_daemon_process(): mm_alloc(): %s\n", strerror(errno));
+		log_warn("conn_daemon_process(): process_daemon_recv_prepare(): %s\n", strerror(errno));
 		mm_free(aop);
 		conn_daemon_client_close(fd);
 		errno = errsv;
 		return -1;
 	}
 
-	/* Cleanup aop->data for a fresh start */
-	memset((void *) aop->data, 0, aop->count);
-
 	/* Request a read operation of one entry header */
 	if (rtsaio_read(aop) < 0) {
 		errsv = errno;
@@ -200,6 +316,137 @@ static int _conn_daemon_process_fd(sock_t fd) {
 	return 0;
 }
 
+static int _conn_daemon_remote_account(void) {
+	int ret = 0;
+
+	pthread_mutex_lock(&rund.mutex_conn);
+
+	/* Increment the number of active connections and check it against the configuration limit */
+	ret = (++ rund.conn_cur <= rund.config.network.conn_limit);
+
+	pthread_mutex_unlock(&rund.mutex_conn);
+
+	return ret;
+}
+
+#if CONFIG_USE_EPOLL == 1
+static void _conn_daemon_accept_drain(sock_t fd_listen) {
+	unsigned int n = 0;
+	sock_t fd = 0;
+
+	/* Accept all the pending connections on this listener, up to a batch limit so the other
+	 * listener isn't starved. Any remaining connections will trigger the next wakeup.
+	 */
+	for (n = 0; n < CONFIG_USCHED_NET_ACCEPT_BATCH; n ++) {
+		/* Client descriptors remain blocking as expected by the rtsaio workers */
+		if ((fd = (sock_t) accept4(fd_listen, NULL, NULL, SOCK_CLOEXEC)) == (sock_t) -1) {
+			/* The client may have given up while waiting on the backlog */
+			if ((errno == EINTR) || (errno == ECONNABORTED) || (errno == EPROTO))
+				continue;
+
+			if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+				log_warn("_conn_daemon_accept_drain(): accept4(): %s\n", strerror(errno));
+
+			break;
+		}
+
+		/* Only remote connections are subject to the connections limit */
+		if ((fd_listen != rund.fd_unix) && !_conn_daemon_remote_account()) {
+			log_warn("_conn_daemon_accept_drain(): Maximum number of active connections exceedeed (current: %lu, maximum: %lu).\n", rund.conn_cur, rund.config.network.conn_limit);
+			conn_daemon_client_close(fd);
+			continue;
+		}
+
+		/* Process connection */
+		if (_conn_daemon_process_fd(fd) < 0)
+			log_warn("_conn_daemon_accept_drain(): _conn_daemon_process_fd(): %s\n", strerror(errno));
+	}
+}
+
+static void _conn_daemon_accept_cleanup(void *arg) {
+	close(*(int *) arg);
+}
+
+static void *_conn_daemon_process_accept(void *arg) {
+	unsigned int id = (unsigned int) (uintptr_t) arg;
+	int i = 0, nfds = 0, epfd = -1;
+	sigset_t si_cur, si_prev;
+	struct epoll_event ev, events[CONFIG_USCHED_NET_ACCEPT_EVENTS];
+
+	/* Initialize signal sets */
+	sigfillset(&si_cur);
+	sigemptyset(&si_prev);
+
+	if ((epfd = epoll_create1(EPOLL_CLOEXEC)) < 0) {
+		log_crit("_conn_daemon_process_accept(): epoll_create1(): %s\n", strerror(errno));
+		runtime_daemon_fatal();
+		pthread_exit(NULL);
+	}
+
+	pthread_cleanup_push(&_conn_daemon_accept_cleanup, &epfd);
+
+	memset(&ev, 0, sizeof(struct epoll_event));
+
+	ev.events = EPOLLIN;
+
+	/* The first acceptor also handles local connections */
+	if (!id && rund.config.auth.local_use) {
+		ev.data.fd = rund.fd_unix;
+
+		if (epoll_ctl(epfd, EPOLL_CTL_ADD, rund.fd_unix, &ev) < 0) {
+			log_crit("_conn_daemon_process_accept(): epoll_ctl(): %s\n", strerror(errno));
+			runtime_daemon_fatal();
+		}
+	}
+
+	if (rund.config.auth.remote_users) {
+		ev.data.fd = rund.fd_accept[id];
+
+		if (epoll_ctl(epfd, EPOLL_CTL_ADD, rund.fd_accept[id], &ev) < 0) {
+			log_crit("_conn_daemon_process_accept(): epoll_ctl(): %s\n", strerror(errno));
+			runtime_daemon_fatal();
+		}
+	}
+
+	for (;;) {
+		/* Block all signals */
+		pthread_sigmask(SIG_SETMASK, &si_cur, &si_prev);
+
+		/* Check for runtime interruptions */
+		if (runtime_daemon_interrupted()) {
+			log_info("_conn_daemon_process_accept(): Runtime interruption detected...\n");
+			pthread_sigmask(SIG_SETMASK, &si_prev, NULL);
+			break;
+		}
+
+		/* Wait for activity on the listeners, but resume execution when a signal is caught */
+		if ((nfds = epoll_pwait(epfd, events, CONFIG_USCHED_NET_ACCEPT_EVENTS, -1, &si_prev)) < 0) {
+			if (errno != EINTR)
+				log_warn("_conn_daemon_process_accept(): epoll_pwait(): %s\n", strerror(errno));
+
+			pthread_sigmask(SIG_SETMASK, &si_prev, NULL);
+			continue;
+		}
+
+		/* Signals can now be caught */
+		pthread_sigmask(SIG_SETMASK, &si_prev, NULL);
+
+		for (i = 0; i < nfds; i ++)
+			_conn_daemon_accept_drain(events[i].data.fd);
+
+		/* Empty garbage collector once per wakeup */
+		gc_cleanup();
+	}
+
+	log_info("_conn_daemon_process_accept(): Thread exiting...\n");
+
+	pthread_cleanup_pop(1);
+
+	pthread_exit(NULL);
+
+	return NULL;
+}
+#else
 static void *_conn_daemon_process_accept_unix(void *arg) {
 	sock_t fd = 0;
 	sigset_t si_cur, si_prev;
@@ -354,11 +601,8 @@ static void *_conn_daemon_process_accept_remote(void *arg) {
 			continue;
 		}
 
-		/* Increment the number of active connections */
-		rund.conn_cur ++;
-
 		/* Check if the current active connections exceeds the configuration limit */
-		if (rund.conn_cur > rund.config.network.conn_limit) {
+		if (!_conn_daemon_remote_account()) {
 			log_warn("conn_daemon_process_accept_remote(): Maximum number of active connections exceedeed (current: %lu, maximum: %lu).\n", rund.conn_cur, rund.config.network.conn_limit);
 			conn_daemon_client_close(fd);
 			continue;
@@ -378,9 +622,32 @@ static void *_conn_daemon_process_accept_remote(void *arg) {
 	return NULL;
 }
 
+#endif
+
 int conn_daemon_process_all(void) {
 	int errsv = 0;
+#if CONFIG_USE_EPOLL == 1
+	unsigned int i = 0;
+
+	for (i = 0; i < rund.accept_nmemb; i ++) {
+		if ((errno = pthread_create(&rund.t_accept[i], NULL, _conn_daemon_process_accept, (void *) (uintptr_t) i))) {
+			errsv = errno;
+			log_crit("conn_daemon_process_all(): pthread_create(): %s\n", strerror(errno));
+
+			/* Stop the acceptors already running */
+			while (i --) {
+				pthread_cancel(rund.t_accept[i]);
+				pthread_join(rund.t_accept[i], NULL);
+			}
+
+			errno = errsv;
+			return -1;
+		}
+	}
 
+	for (i = 0; i < rund.accept_nmemb; i ++)
+		pthread_join(rund.t_accept[i], NULL);
+#else
 	if ((errno = pthread_create(&rund.t_unix, NULL, _conn_daemon_process_accept_unix, NULL))) {
 		errsv = errno;
 		log_crit("conn_daemon_process_all(): pthread_create(): %s\n", strerror(errno));
@@ -397,18 +664,47 @@ int conn_daemon_process_all(void) {
 
 	pthread_join(rund.t_unix, NULL);
 	pthread_join(rund.t_remote, NULL);
+#endif
 
 	return 0;
 }
 
+void conn_daemon_process_cancel(void) {
+#if CONFIG_USE_EPOLL == 1
+	unsigned int i = 0;
+
+	for (i = 0; i < rund.accept_nmemb; i ++)
+		pthread_cancel(rund.t_accept[i]);
+#else
+	pthread_cancel(rund.t_unix);
+	pthread_cancel(rund.t_remote);
+#endif
+}
+
 void conn_daemon_client_close(sock_t fd) {
-	if (conn_is_remote(fd))
+	/* Release any entry still in progress on this connection before the descriptor is reused */
+	pool_daemon_conn_close(fd);
+
+	/* Release the subscription of this connection, if any */
+	subscribe_daemon_close(fd);
+
+	if (conn_is_remote(fd)) {
+		pthread_mutex_lock(&rund.mutex_conn);
 		rund.conn_cur --;
+		pthread_mutex_unlock(&rund.mutex_conn);
+	}
 
 	panet_safe_close(fd);
 }
 
 void conn_daemon_destroy(void) {
+#if CONFIG_USE_EPOLL == 1
+	unsigned int i = 0;
+
+	/* The first remote listener is rund.fd_remote */
+	for (i = 1; i < rund.accept_nmemb; i ++)
+		panet_safe_close(rund.fd_accept[i]);
+#endif
 	panet_safe_close(rund.fd_unix);
 	panet_safe_close(rund.fd_remote);
 	rtsaio_destroy();
@@ -0,0 +1,262 @@
+/**
+ * @file credit.c
+ * @brief uSched
+ *        Executer flow control interface - Daemon
+ *
+ * Date: 18-10-2026
+ *
+ * Copyright 2014-2015 Pedro A. Hortas (pah@ucodev.org)
+ *
+ * This file is part of usched.
+ *
+ * usched is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * usched is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with usched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+
+#include "config.h"
+#include "runtime.h"
+#include "log.h"
+#include "ipc.h"
+#include "retry.h"
+#include "credit.h"
+#include "stat.h"
+
+/*
+ * The executer (use) advertises its free capacity (child slots plus run queue positions) and
+ * the number of execution requests it has received so far. Requests sent by usd but not yet
+ * received by use are accounted here, so the available credits are:
+ *
+ *   free - (sent - received)
+ *
+ * Executions are only delivered while credits are available. Otherwise they are held in the
+ * deferred executions queue (see retry.c) until use advertises free capacity again.
+ */
+
+/* NOTE: Must be called with rund.mutex_credit held */
+static unsigned int _credit_daemon_available(void) {
+	uint64_t inflight = rund.credit_sent - rund.credit_recv;
+
+	if (inflight >= (uint64_t) rund.credit_free)
+		return 0;
+
+	return rund.credit_free - (unsigned int) inflight;
+}
+
+static void _credit_daemon_advert(const struct ipc_credit_hdr *hdr) {
+	unsigned int available = 0;
+	int resumed = 0;
+
+	pthread_mutex_lock(&rund.mutex_credit);
+
+	if (hdr->epoch != rund.credit_epoch) {
+		/* A new executer instance. Whatever was in flight to the previous one is unknown. */
+		if (rund.credit_epoch)
+			log_info("_credit_daemon_advert(): Executer was restarted. Resetting credits (Free: %u).\n", hdr->free);
+
+		rund.credit_epoch = hdr->epoch;
+		rund.credit_sent = hdr->received;
+	} else if (hdr->received < rund.credit_recv) {
+		/* Outdated advertisement */
+		pthread_mutex_unlock(&rund.mutex_credit);
+		return;
+	}
+
+	/* Requests sent by a previous instance of this daemon are also accounted by use */
+	if (hdr->received > rund.credit_sent)
+		rund.credit_sent = hdr->received;
+
+	rund.credit_recv = hdr->received;
+	rund.credit_free = hdr->free;
+	rund.credit_adverts ++;
+
+	if ((available = _credit_daemon_available()) && rund.credit_exhausted) {
+		rund.credit_exhausted = 0;
+		resumed = 1;
+	}
+
+	pthread_mutex_unlock(&rund.mutex_credit);
+
+	/* Advertisements are periodic, so they also pace the daemon counters sent to uss */
+	stat_daemon_counters_send();
+
+	if (!resumed)
+		return;
+
+	log_info("_credit_daemon_advert(): Executer regained capacity (Credits: %u, Queued executions: %zu, Stalls: %llu).\n", available, retry_daemon_pending(), rund.credit_stalls);
+
+	/* Held executions can now be delivered */
+	retry_daemon_wake();
+}
+
+static void *_credit_daemon_worker(void *arg) {
+	int errsv = 0;
+	ssize_t ret = 0;
+	char *msg = NULL;
+
+	arg = NULL; /* Unused */
+
+	for (;;) {
+		/* Check for runtime interruptions */
+		if (runtime_daemon_interrupted())
+			break;
+
+		/* Acquire the message buffer of this thread */
+		if (!(msg = ipc_buf_get((size_t) rund.config.ipc.msg_size))) {
+			log_warn("_credit_daemon_worker(): ipc_buf_get(): %s\n", strerror(errno));
+			continue;
+		}
+
+		/* Wait for a capacity advertisement */
+		if ((ret = ipc_recv(rund.pipcd, (long [1]) { IPC_USE_ID }, (long [1]) { IPC_USD_ID }, msg, (size_t) rund.config.ipc.msg_size)) < 0) {
+			errsv = errno;
+			log_warn("_credit_daemon_worker(): ipc_recv(): %s\n", strerror(errno));
+			errno = errsv;
+
+			/* Any of the following errno are a fatal condition and this module needs to
+			 * be restarted by its monitor.
+			 */
+			if (errno == EACCES || errno == EFAULT || errno == EINVAL || errno == EIDRM || errno == ENOMEM)
+				runtime_daemon_fatal();
+
+			errno = errsv;
+
+			continue;
+		}
+
+		/* Track the bytes written by the receive operation */
+		ipc_buf_dirty((size_t) ret);
+
+		credit_daemon_recv(msg, (size_t) ret);
+	}
+
+	/* Release the message buffer of this thread */
+	ipc_buf_destroy();
+
+	pthread_exit(NULL);
+
+	return NULL;
+}
+
+void credit_daemon_recv(const char *msg, size_t len) {
+	if (len != sizeof(struct ipc_credit_hdr)) {
+		log_warn("credit_daemon_recv(): Invalid capacity advertisement (%zu bytes).\n", len);
+		return;
+	}
+
+	_credit_daemon_advert((const struct ipc_credit_hdr *) msg);
+}
+
+int credit_daemon_acquire(void) {
+	int exhausted = 0;
+
+	pthread_mutex_lock(&rund.mutex_credit);
+
+	if (!_credit_daemon_available()) {
+		rund.credit_stalls ++;
+
+		if (!rund.credit_exhausted) {
+			exhausted = rund.credit_exhausted = 1;
+			rund.credit_exhaustions ++;
+		}
+
+		pthread_mutex_unlock(&rund.mutex_credit);
+
+		if (exhausted)
+			log_info("credit_daemon_acquire(): Executer has no free capacity (In flight: %llu, Free: %u). Executions will be queued.\n", rund.credit_sent - rund.credit_recv, rund.credit_free);
+
+		errno = EAGAIN;
+
+		return -1;
+	}
+
+	rund.credit_sent ++;
+
+	pthread_mutex_unlock(&rund.mutex_credit);
+
+	return 0;
+}
+
+void credit_daemon_counters(struct ipc_counters_hdr *hdr) {
+	pthread_mutex_lock(&rund.mutex_credit);
+
+	hdr->credit_inflight = rund.credit_sent - rund.credit_recv;
+	hdr->credit_exhaustions = rund.credit_exhaustions;
+	hdr->credit_stalls = rund.credit_stalls;
+	hdr->credit_free = rund.credit_free;
+	hdr->credit_available = _credit_daemon_available();
+
+	pthread_mutex_unlock(&rund.mutex_credit);
+
+	hdr->retry_pending = retry_daemon_pending();
+}
+
+void credit_daemon_restore(void) {
+	int errsv = errno;
+
+	/* The request wasn't sent after all */
+	pthread_mutex_lock(&rund.mutex_credit);
+	rund.credit_sent --;
+	pthread_mutex_unlock(&rund.mutex_credit);
+
+	errno = errsv;
+}
+
+int credit_daemon_init(void) {
+	int errsv = 0;
+
+	/* Until use advertises its capacity, assume it is idle */
+	rund.credit_epoch = 0;
+	rund.credit_sent = 0;
+	rund.credit_recv = 0;
+	rund.credit_free = rund.config.exec.children_max + rund.config.exec.queue_depth;
+	rund.credit_exhausted = 0;
+	rund.credit_adverts = 0;
+	rund.credit_stalls = 0;
+	rund.credit_exhaustions = 0;
+
+	/* With pipc, advertisements share the daemon queue and are received by the stat worker */
+	if (!rund.config.ipc.transport_shm)
+		return 0;
+
+	/* Initialize capacity advertisements worker */
+	if ((errno = pthread_create(&rund.t_credit, NULL, &_credit_daemon_worker, NULL))) {
+		errsv = errno;
+		log_warn("credit_daemon_init(): pthread_create(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+void credit_daemon_destroy(void) {
+	/* The worker blocks waiting for advertisements, so it must be cancelled */
+	if (rund.config.ipc.transport_shm) {
+		pthread_cancel(rund.t_credit);
+		pthread_join(rund.t_credit, NULL);
+	}
+
+	pthread_mutex_lock(&rund.mutex_credit);
+
+	log_info("credit_daemon_destroy(): Credits: %u, In flight: %llu, Advertisements: %llu, Exhaustions: %llu, Stalls: %llu.\n", _credit_daemon_available(), rund.credit_sent - rund.credit_recv, rund.credit_adverts, rund.credit_exhaustions, rund.credit_stalls);
+
+	pthread_mutex_unlock(&rund.mutex_credit);
+}
+
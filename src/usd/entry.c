@@ -36,6 +36,7 @@
 #include <sys/types.h>
 
 #include <psec/crypt.h>
+#include <psec/generate.h>
 
 #include <pall/cll.h>
 
@@ -51,6 +52,35 @@
 #include "schedule.h"
 #include "vars.h"
 #include "ipc.h"
+#include "retry.h"
+#include "credit.h"
+#include "admit.h"
+#include "subscribe.h"
+
+/* Characters interpreted by the shell and the blanks separating the arguments of a subject */
+#define ENTRY_SUBJ_SHELL_META	"|&;<>()$`\\\"'*?[]#~{}!\n"
+#define ENTRY_SUBJ_BLANKS	" \t"
+
+static size_t _entry_daemon_exec_argv(char *dest, const char *cmd, uint32_t *argc) {
+	size_t len = 0, n = 0;
+
+	/* Copy the arguments of cmd to dest, NULL separated. The result is never longer than cmd. */
+	for (*argc = 0, cmd += strspn(cmd, ENTRY_SUBJ_BLANKS); *cmd; cmd += strspn(cmd, ENTRY_SUBJ_BLANKS)) {
+		if (*argc)
+			dest[len ++] = 0;
+
+		n = strcspn(cmd, ENTRY_SUBJ_BLANKS);
+
+		memcpy(dest + len, cmd, n);
+
+		len += n;
+		cmd += n;
+
+		(*argc) ++;
+	}
+
+	return len;
+}
 
 static int _entry_daemon_authorize_local(struct usched_entry *entry, sock_t fd) {
 	int errsv = 0;
@@ -161,9 +191,57 @@ int entry_daemon_authorize(struct usched_entry *entry, sock_t fd) {
 	return ret;
 }
 
+static int _entry_daemon_remote_session_resume(struct usched_entry *entry) {
+	int errsv = 0;
+	unsigned char ticket_key[CONFIG_USCHED_AUTH_TICKET_SIZE];
+	unsigned char client_nonce[CONFIG_USCHED_AUTH_TICKET_SIZE];
+	unsigned char server_nonce[CONFIG_USCHED_AUTH_TICKET_SIZE];
+
+	/* Session data contents:
+	 *
+	 * | ticket id (32 bytes) | client nonce (32 bytes) |
+	 *
+	 */
+	if (auth_daemon_remote_ticket_lookup(entry->username, entry->session, ticket_key) < 0) {
+		errsv = errno;
+		log_warn("_entry_daemon_remote_session_resume(): auth_daemon_remote_ticket_lookup(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	memcpy(client_nonce, entry->session + CONFIG_USCHED_AUTH_TICKET_SIZE, sizeof(client_nonce));
+
+	if (!generate_bytes_random(server_nonce, sizeof(server_nonce))) {
+		errsv = errno;
+		log_warn("_entry_daemon_remote_session_resume(): generate_bytes_random(): %s\n", strerror(errno));
+		memset(ticket_key, 0, sizeof(ticket_key));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Derive the key of this request */
+	entry_ticket_session_key(entry, ticket_key, client_nonce, server_nonce);
+
+	memset(ticket_key, 0, sizeof(ticket_key));
+
+	/* Session data contents:
+	 *
+	 * | server nonce (32 bytes) |
+	 *
+	 */
+	memset(entry->session, 0, sizeof(entry->session));
+	memcpy(entry->session, server_nonce, sizeof(server_nonce));
+
+	return 0;
+}
+
 int entry_daemon_remote_session_create(struct usched_entry *entry) {
 	int errsv = 0;
 
+	/* Resume the session from a previously issued session ticket, if requested */
+	if (entry_has_flag(entry, USCHED_ENTRY_FLAG_RESUME))
+		return _entry_daemon_remote_session_resume(entry);
+
 	/* Initialize a new entry->session field to be sent to the client */
 	if (auth_daemon_remote_session_create(entry->username, entry->session, entry->crypto.context) < 0) {
 		errsv = errno;
@@ -177,6 +255,26 @@ int entry_daemon_remote_session_create(struct usched_entry *entry) {
 
 int entry_daemon_remote_session_process(struct usched_entry *entry) {
 	int errsv = 0;
+	unsigned char ticket_id[CONFIG_USCHED_AUTH_TICKET_SIZE];
+	unsigned char ticket_key[CONFIG_USCHED_AUTH_TICKET_SIZE];
+
+	/* Resumed sessions only need to prove the knowledge of the request key */
+	if (entry_has_flag(entry, USCHED_ENTRY_FLAG_RESUME)) {
+		entry_ticket_session_proof(entry, ticket_key);
+
+		if (auth_daemon_remote_ticket_verify(entry->username, entry->session, ticket_key, &entry->uid, &entry->gid) < 0) {
+			errsv = errno;
+			log_warn("entry_daemon_remote_session_process(): auth_daemon_remote_ticket_verify(): %s\n", strerror(errno));
+			memset(ticket_key, 0, sizeof(ticket_key));
+			errno = errsv;
+			return -1;
+		}
+
+		memset(ticket_key, 0, sizeof(ticket_key));
+
+		/* All good */
+		return 0;
+	}
 
 	/* Verify remote client authentication */
 	if (auth_daemon_remote_session_verify(entry->username, entry->session, entry->crypto.context, entry->crypto.agreed_key, &entry->uid, &entry->gid) < 0) {
@@ -189,12 +287,53 @@ int entry_daemon_remote_session_process(struct usched_entry *entry) {
 	/* Set nonce to 0 */
 	entry->crypto.nonce = 0;
 
+	/* Issue a session ticket, so further requests can skip the key exchange. A failure here
+	 * only means that the client will need to authenticate again.
+	 */
+	entry_ticket_derive(entry, ticket_id, ticket_key);
+
+	if (auth_daemon_remote_ticket_issue(entry->username, ticket_id, ticket_key) < 0)
+		log_warn("entry_daemon_remote_session_process(): auth_daemon_remote_ticket_issue(): %s\n", strerror(errno));
+
+	memset(ticket_key, 0, sizeof(ticket_key));
+
 	/* All good */
 	return 0;
 }
 
+int entry_daemon_exec_mode_set(struct usched_entry *entry) {
+	const char *subj = entry->subj + strspn(entry->subj, ENTRY_SUBJ_BLANKS);
+
+	if (entry_has_flag(entry, USCHED_ENTRY_FLAG_EXEC_SHELL)) {
+		/* Both modes can't be requested */
+		if (entry_has_flag(entry, USCHED_ENTRY_FLAG_EXEC_DIRECT)) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		return 0;
+	}
+
+	/* No PATH lookup is performed without a shell, so the program must be an absolute path */
+	if (subj[0] != '/') {
+		if (entry_has_flag(entry, USCHED_ENTRY_FLAG_EXEC_DIRECT)) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		return 0;
+	}
+
+	/* Subjects with no shell metacharacters mean the same with or without a shell */
+	if (!subj[strcspn(subj, ENTRY_SUBJ_SHELL_META)])
+		entry_set_flag(entry, USCHED_ENTRY_FLAG_EXEC_DIRECT);
+
+	return 0;
+}
+
 void entry_daemon_exec_dispatch(void *arg) {
-	int ret = 0, errsv = 0;
+	int ret = 0, errsv = 0, credited = 0;
+	size_t cmd_len = 0;
 	char *buf = NULL, *cmd = NULL;
 	struct usched_entry *entry = arg;
 	struct ipc_use_hdr *hdr = NULL;
@@ -215,9 +354,9 @@ void entry_daemon_exec_dispatch(void *arg) {
 		goto _process;
 	}
 
-	/* Allocate message memory */
-	if (!(buf = mm_alloc((size_t) rund.config.ipc.msg_size))) {
-		log_warn("entry_daemon_exec_dispatch(): mm_alloc(): %s\n", strerror(errno));
+	/* Acquire the message buffer of this thread */
+	if (!(buf = ipc_buf_get((size_t) rund.config.ipc.msg_size))) {
+		log_warn("entry_daemon_exec_dispatch(): ipc_buf_get(): %s\n", strerror(errno));
 
 		/* Force daemon to be restarted and reload a clean state */
 		runtime_daemon_fatal();
@@ -225,8 +364,6 @@ void entry_daemon_exec_dispatch(void *arg) {
 		goto _finish;
 	}
 
-	memset(buf, 0, (size_t) rund.config.ipc.msg_size);
-
 	/* Check if this entry is authorized */
 	if (!entry_has_flag(entry, USCHED_ENTRY_FLAG_AUTHORIZED)) {
 		log_warn("entry_daemon_exec_dispatch(): Unauthorized entry found. Discarding...\n");
@@ -259,19 +396,13 @@ void entry_daemon_exec_dispatch(void *arg) {
 	if (!(cmd = vars_replace_all(entry->subj, (struct usched_vars [1]) { { entry->id, entry->username, entry->uid, entry->gid, entry->trigger, entry->step, entry->expire } })))
 		cmd = entry->subj;
 
-	/* Craft IPC message header */
-	hdr          = (struct ipc_use_hdr *) buf;
-	hdr->id      = entry->id;
-	hdr->uid     = entry->uid;
-	hdr->gid     = entry->gid;
-	hdr->trigger = entry->trigger;
-	hdr->cmd_len = strlen(cmd);
+	cmd_len = strlen(cmd);
 
 	/* Check if the message fits in the configured message size.
 	 * Although this check was already performed when receiving the entry from the user,
 	 * this one is required since now the variables are expanded.
 	 */
-	if ((hdr->cmd_len + sizeof(struct ipc_use_hdr) + 1) > (size_t) rund.config.ipc.msg_size) {
+	if ((cmd_len + sizeof(struct ipc_use_hdr) + 1) > (size_t) rund.config.ipc.msg_size) {
 		log_warn("entry_daemon_exec_dispatch(): msg_size > sizeof(buf) (Entry ID: 0x%016llX)\n", entry->id);
 
 		/* Mark this entry as invalid. */
@@ -280,11 +411,36 @@ void entry_daemon_exec_dispatch(void *arg) {
 		/* Serializated data is now invalid. TODO: Serialize this entry... */
 		entry_unset_flag(entry, USCHED_ENTRY_FLAG_SERIALIZED);
 
+		/* Free cmd memory if allocated by vars_replace_all() */
+		if (cmd != entry->subj)
+			mm_free(cmd);
+
 		goto _finish;
 	}
 
-	/* Append command to IPC message */
-	memcpy(buf + sizeof(struct ipc_use_hdr), cmd, hdr->cmd_len);
+	/* Clear only the bytes that will be used by this message */
+	ipc_buf_reset(sizeof(struct ipc_use_hdr) + cmd_len);
+
+	/* Craft IPC message header */
+	hdr              = (struct ipc_use_hdr *) buf;
+	hdr->id          = entry->id;
+	hdr->uid         = entry->uid;
+	hdr->gid         = entry->gid;
+	hdr->trigger     = entry->trigger;
+	hdr->overlap     = entry->overlap;
+	hdr->concurrency = entry->concurrency;
+	hdr->priority    = entry->priority;
+	hdr->argc        = 0;
+	hdr->cmd_len     = cmd_len;
+
+	/* Append command to IPC message. Direct executions carry it already split into arguments,
+	 * so the executer doesn't need a shell to run it.
+	 */
+	if (entry_has_flag(entry, USCHED_ENTRY_FLAG_EXEC_DIRECT)) {
+		hdr->cmd_len = _entry_daemon_exec_argv(buf + sizeof(struct ipc_use_hdr), cmd, &hdr->argc);
+	} else {
+		memcpy(buf + sizeof(struct ipc_use_hdr), cmd, hdr->cmd_len);
+	}
 
 	/* Free cmd memory if allocated by vars_replace_all() */
 	if (cmd != entry->subj)
@@ -292,14 +448,55 @@ void entry_daemon_exec_dispatch(void *arg) {
 
 	debug_printf(DEBUG_INFO, "Requesting execution of entry->id: 0x%016llX\n", entry->id);
 
+	/* Keep the delivery order: while there are deferred executions pending, this one must be
+	 * queued behind them.
+	 */
+	if (retry_daemon_pending()) {
+		if (retry_daemon_defer(buf, IPC_USE_FRAME_LEN(hdr)) < 0)
+			log_crit("entry_daemon_exec_dispatch(): The Entry ID 0x%016llX was NOT executed at timestamp %u: retry_daemon_defer(): %s\n", entry->id, entry->trigger, strerror(errno));
+
+		goto _process;
+	}
+
+	/* Only deliver while the executer has advertised free capacity for it. Otherwise, hold the
+	 * execution until it does. Without a deferred executions queue there's nowhere to hold it,
+	 * so it's delivered anyway and the executer queue decides, as the credits are only an
+	 * estimate of its free capacity.
+	 */
+	if (rund.config.exec.retry_depth) {
+		if (credit_daemon_acquire() < 0) {
+			if (!retry_daemon_defer(buf, IPC_USE_FRAME_LEN(hdr))) {
+				debug_printf(DEBUG_INFO, "entry_daemon_exec_dispatch(): The Entry ID 0x%016llX was queued (Pending: %zu).\n", entry->id, retry_daemon_pending());
+			} else {
+				log_crit("entry_daemon_exec_dispatch(): The Entry ID 0x%016llX was NOT executed at timestamp %u: retry_daemon_defer(): %s\n", entry->id, entry->trigger, strerror(errno));
+			}
+
+			goto _process;
+		}
+
+		credited = 1;
+	}
+
 	/* Deliver message to uSched executer (use). Give up on block to avoid this notifier to
 	 * stall in the case of a full message queue or unresponsive executer.
 	 */
-	if (ipc_send_nowait(rund.pipcd, IPC_USD_ID, IPC_USE_ID, buf, (size_t) rund.config.ipc.msg_size) < 0) {
+	if (ipc_send_nowait(rund.pipcd, IPC_USD_ID, IPC_USE_ID, buf, IPC_USE_FRAME_LEN(hdr)) < 0) {
 		errsv = errno;
 
+		if (credited)
+			credit_daemon_restore();
+
 		log_warn("entry_daemon_exec_dispatch(): ipc_send_nowait(): %s\n", strerror(errno));
 
+		/* A full executer queue is a transient condition. Defer the execution so it can be
+		 * redelivered as soon as the executer regains capacity.
+		 */
+		if ((errsv == EAGAIN) && !retry_daemon_defer(buf, IPC_USE_FRAME_LEN(hdr))) {
+			log_info("entry_daemon_exec_dispatch(): The Entry ID 0x%016llX was deferred (Pending: %zu).\n", entry->id, retry_daemon_pending());
+
+			goto _process;
+		}
+
 		/* NOTE:
 		 *
 		 * We should not delete this entry from active pool if we're unable to write to
@@ -375,18 +572,20 @@ _process:
 _remove:
 	/* Remove the entry from active pool */
 	pthread_mutex_lock(&rund.mutex_apool);
+	admit_daemon_entry_release(entry->uid);
+	subscribe_daemon_forget(entry->id);
 	rund.apool->del(rund.apool, entry);
 	pthread_mutex_unlock(&rund.mutex_apool);
 
 _finish:
-	if (buf)
-		mm_free(buf);
+	/* The message buffer is owned by this thread and will be reused on the next dispatch */
+	return;
 }
 
 int entry_daemon_serialize(pall_fd_t fd, void *data) {
 	int errsv = 0;
 	struct usched_entry *entry = data;
-	char buf[sizeof(entry->id) + sizeof(entry->flags) + sizeof(entry->uid) + sizeof(entry->gid) + sizeof(entry->trigger) + sizeof(entry->step) + sizeof(entry->expire) + sizeof(entry->pid) + sizeof(entry->status) + sizeof(entry->exec_time) + sizeof(entry->latency) + sizeof(entry->outdata_len) + sizeof(entry->outdata) + sizeof(entry->username) + sizeof(entry->subj_size) + sizeof(entry->create_time) + sizeof(entry->signature)];
+	char buf[sizeof(entry->id) + sizeof(entry->flags) + sizeof(entry->uid) + sizeof(entry->gid) + sizeof(entry->trigger) + sizeof(entry->step) + sizeof(entry->expire) + sizeof(entry->overlap) + sizeof(entry->concurrency) + sizeof(entry->priority) + sizeof(entry->pid) + sizeof(entry->status) + sizeof(entry->exec_time) + sizeof(entry->latency) + sizeof(entry->outdata_len) + sizeof(entry->outdata) + sizeof(entry->username) + sizeof(entry->subj_size) + sizeof(entry->create_time) + sizeof(entry->signature)];
 	size_t offset = 0;
 
 	/* If this entry is set to be REMOVED, do not serialize it */
@@ -419,6 +618,15 @@ int entry_daemon_serialize(pall_fd_t fd, void *data) {
 	memcpy(buf + offset, &entry->expire, sizeof(entry->expire));
 	offset += sizeof(entry->expire);
 
+	memcpy(buf + offset, &entry->overlap, sizeof(entry->overlap));
+	offset += sizeof(entry->overlap);
+
+	memcpy(buf + offset, &entry->concurrency, sizeof(entry->concurrency));
+	offset += sizeof(entry->concurrency);
+
+	memcpy(buf + offset, &entry->priority, sizeof(entry->priority));
+	offset += sizeof(entry->priority);
+
 	memcpy(buf + offset, &entry->pid, sizeof(entry->pid));
 	offset += sizeof(entry->pid);
 
@@ -474,8 +682,15 @@ int entry_daemon_serialize(pall_fd_t fd, void *data) {
 void *entry_daemon_unserialize(pall_fd_t fd) {
 	int errsv = 0;
 	struct usched_entry *entry = NULL;
-	char buf[sizeof(entry->id) + sizeof(entry->flags) + sizeof(entry->uid) + sizeof(entry->gid) + sizeof(entry->trigger) + sizeof(entry->step) + sizeof(entry->expire) + sizeof(entry->pid) + sizeof(entry->status) + sizeof(entry->exec_time) + sizeof(entry->latency) + sizeof(entry->outdata_len) + sizeof(entry->outdata) + sizeof(entry->username) + sizeof(entry->subj_size) + sizeof(entry->create_time) + sizeof(entry->signature)];
-	size_t offset = 0;
+	char buf[sizeof(entry->id) + sizeof(entry->flags) + sizeof(entry->uid) + sizeof(entry->gid) + sizeof(entry->trigger) + sizeof(entry->step) + sizeof(entry->expire) + sizeof(entry->overlap) + sizeof(entry->concurrency) + sizeof(entry->priority) + sizeof(entry->pid) + sizeof(entry->status) + sizeof(entry->exec_time) + sizeof(entry->latency) + sizeof(entry->outdata_len) + sizeof(entry->outdata) + sizeof(entry->username) + sizeof(entry->subj_size) + sizeof(entry->create_time) + sizeof(entry->signature)];
+	size_t offset = 0, len = sizeof(buf);
+
+	/* Records written by older versions lack the fields added since then */
+	if (rund.ser_version < USCHED_ENTRY_SERIALIZE_VERSION_PRIORITY)
+		len -= sizeof(entry->priority);
+
+	if (rund.ser_version < USCHED_ENTRY_SERIALIZE_VERSION_OVERLAP)
+		len -= sizeof(entry->overlap) + sizeof(entry->concurrency);
 
 	/* Allocate enough memory for the entry */
 	if (!(entry = mm_alloc(sizeof(struct usched_entry)))) {
@@ -488,7 +703,7 @@ void *entry_daemon_unserialize(pall_fd_t fd) {
 	memset(entry, 0, sizeof(struct usched_entry));
 
 	/* Read serialized buffer */
-	if (read(fd, buf, sizeof(buf)) != (ssize_t) sizeof(buf)) {
+	if (read(fd, buf, len) != (ssize_t) len) {
 		errsv = errno;
 		log_crit("entry_daemon_unserialize(): read(): %s\n", strerror(errno));
 		entry_destroy(entry);
@@ -518,6 +733,19 @@ void *entry_daemon_unserialize(pall_fd_t fd) {
 	memcpy(&entry->expire, buf + offset, sizeof(entry->expire));
 	offset += sizeof(entry->expire);
 
+	if (rund.ser_version >= USCHED_ENTRY_SERIALIZE_VERSION_OVERLAP) {
+		memcpy(&entry->overlap, buf + offset, sizeof(entry->overlap));
+		offset += sizeof(entry->overlap);
+
+		memcpy(&entry->concurrency, buf + offset, sizeof(entry->concurrency));
+		offset += sizeof(entry->concurrency);
+	}
+
+	if (rund.ser_version >= USCHED_ENTRY_SERIALIZE_VERSION_PRIORITY) {
+		memcpy(&entry->priority, buf + offset, sizeof(entry->priority));
+		offset += sizeof(entry->priority);
+	}
+
 	memcpy(&entry->pid, buf + offset, sizeof(entry->pid));
 	offset += sizeof(entry->pid);
 
@@ -41,6 +41,18 @@
 int ipc_daemon_init(void) {
 	int errsv = 0;
 
+	/* Attach to the shared memory rings, if selected as the message transport */
+	if (rund.config.ipc.transport_shm) {
+		if (ipc_shm_attach(&rund.config.ipc, IPC_USD_ID) < 0) {
+			errsv = errno;
+			log_warn("ipc_daemon_init(): ipc_shm_attach(): %s\n", strerror(errno));
+			errno = errsv;
+			return -1;
+		}
+
+		return 0;
+	}
+
 	/* Create key */
 	rund.pipck = (pipck_t) rund.config.ipc.id_key;
 
@@ -57,6 +69,11 @@ int ipc_daemon_init(void) {
 }
 
 void ipc_daemon_destroy(void) {
+	if (rund.config.ipc.transport_shm) {
+		ipc_shm_detach();
+		return;
+	}
+
 	if (pipc_slave_unregister(rund.pipcd) < 0)
 		log_warn("ipc_daemon_destroy(): pipc_slave_unregister(): %s\n", strerror(errno));
 }
@@ -48,6 +48,7 @@
 #include "log.h"
 #include "entry.h"
 #include "schedule.h"
+#include "admit.h"
 
 #if CONFIG_USCHED_SERIALIZE_ON_REQ == 1
 static void *_marshal_monitor(void *arg) {
@@ -172,6 +173,7 @@ int marshal_daemon_serialize_pools(void) {
 	int errsv = 0;
 	int ret = -1;
 	struct usched_entry *entry = NULL;
+	struct marshal_header hdr;
 
 	pthread_mutex_lock(&rund.mutex_apool);
 
@@ -238,6 +240,18 @@ int marshal_daemon_serialize_pools(void) {
 #endif
 	}
 
+	/* Write the file header, so the record layout can be identified when loaded */
+	hdr.magic = MARSHAL_HEADER_MAGIC;
+	hdr.version = USCHED_ENTRY_SERIALIZE_VERSION;
+
+	if (write(rund.ser_fd, &hdr, sizeof(struct marshal_header)) != (ssize_t) sizeof(struct marshal_header)) {
+		errsv = errno;
+		log_warn("marshal_daemon_serialize_pools(): write(): %s\n", strerror(errno));
+		pthread_mutex_unlock(&rund.mutex_apool);
+		errno = errsv;
+		return -1;
+	}
+
 	/* Serialize the active pool */
 	if ((ret = rund.apool->serialize(rund.apool, rund.ser_fd)) < 0) {
 		errsv = errno;
@@ -255,8 +269,10 @@ int marshal_daemon_unserialize_pools(void) {
 	int ret = -1, errsv = errno;
 	struct stat st;
 	struct usched_entry *entry = NULL;
+	struct marshal_header hdr;
 
 	memset(&st, 0, sizeof(struct stat));
+	memset(&hdr, 0, sizeof(struct marshal_header));
 
 	pthread_mutex_lock(&rund.mutex_apool);
 
@@ -281,6 +297,27 @@ int marshal_daemon_unserialize_pools(void) {
 		goto _unserialize_finish;
 	}
 
+	/* Read the file header. Files without one were written before it was introduced. */
+	if ((st.st_size >= (off_t) sizeof(struct marshal_header)) && (read(rund.ser_fd, &hdr, sizeof(struct marshal_header)) == (ssize_t) sizeof(struct marshal_header)) && (hdr.magic == MARSHAL_HEADER_MAGIC)) {
+		if (hdr.version > USCHED_ENTRY_SERIALIZE_VERSION) {
+			errsv = EINVAL;
+			log_warn("marshal_daemon_unserialize_pools(): Serialization file version %u is newer than the supported version %u.\n", hdr.version, USCHED_ENTRY_SERIALIZE_VERSION);
+			goto _unserialize_finish;
+		}
+
+		rund.ser_version = hdr.version;
+	} else {
+		log_info("marshal_daemon_unserialize_pools(): Serialization file has no header. Loading legacy entry records.\n");
+
+		if (lseek(rund.ser_fd, 0, SEEK_SET) == (off_t) -1) {
+			errsv = errno;
+			log_warn("marshal_daemon_unserialize_pools(): lseek(%d, 0, SEEK_SET): %s\n", rund.ser_fd, strerror(errsv));
+			goto _unserialize_finish;
+		}
+
+		rund.ser_version = USCHED_ENTRY_SERIALIZE_VERSION_LEGACY;
+	}
+
 	/* Unserialize active pool */
 	if ((ret = rund.apool->unserialize(rund.apool, rund.ser_fd)) < 0) {
 		errsv = errno;
@@ -363,6 +400,9 @@ int marshal_daemon_unserialize_pools(void) {
 
 			continue; /* Unreachable for now (abort() preceeds this) */
 		}
+
+		/* Account the restored entry in the owner's active entries quota */
+		admit_daemon_entry_restore(entry->uid);
 	}
 
 _unserialize_finish:
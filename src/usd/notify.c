@@ -45,17 +45,100 @@
 #include "process.h"
 #include "gc.h"
 #include "marshal.h"
+#include "pool.h"
+#include "subscribe.h"
+
+static void _notify_partial_reset(struct async_op *aop, struct usched_conn_partial *partial) {
+	/* Point the aop back to the whole buffer of the operation */
+	if (partial->base) {
+		aop->data = partial->base;
+		aop->count = partial->count;
+	}
+
+	memset(partial, 0, sizeof(struct usched_conn_partial));
+}
+
+static int _notify_partial(struct async_op *aop, int (*resume) (struct async_op *)) {
+	int errsv = 0;
+	int cur_fd = aop->fd;
+	ssize_t count = rtsaio_count(aop);
+	struct usched_conn_partial *partial = NULL;
+
+	if (!(partial = pool_daemon_conn_partial(aop->fd)))
+		return -1;
+
+	/* The operation, or what remained of it, is now complete */
+	if ((rtsaio_status(aop) == ASYNCOP_STATUS_COMPLETE) && (count == (ssize_t) aop->count)) {
+		_notify_partial_reset(aop, partial);
+
+		return 0;
+	}
+
+	/* Only operations that made some progress are resumed. Otherwise the peer is gone or
+	 * stalled for a whole timeout period.
+	 */
+	if ((rtsaio_status(aop) != ASYNCOP_STATUS_INCOMPLETE) || (count <= 0) || (count >= (ssize_t) aop->count)) {
+		_notify_partial_reset(aop, partial);
+		errno = rtsaio_error(aop) ? rtsaio_error(aop) : EIO;
+		return -1;
+	}
+
+	/* Grant that a client trickling data can't hold the connection forever */
+	if (partial->resumes >= CONFIG_USCHED_NET_PARTIAL_RESUMES_MAX) {
+		log_warn("_notify_partial(): Too many partial operations on file descriptor %d (transferred: %zu, expected: %zu).\n", aop->fd, partial->offset + count, partial->base ? partial->count : aop->count);
+		_notify_partial_reset(aop, partial);
+		errno = ETIMEDOUT;
+		return -1;
+	}
+
+	/* Keep track of the whole operation on the first partial transfer */
+	if (!partial->base) {
+		partial->base = (char *) aop->data;
+		partial->count = aop->count;
+	}
+
+	partial->offset += count;
+	partial->resumes ++;
+
+	debug_printf(DEBUG_INFO, "_notify_partial(): Resuming operation on file descriptor %d (transferred: %zu, expected: %zu).\n", cur_fd, partial->offset, partial->count);
+
+	/* Continue where the operation stopped */
+	memset(aop, 0, sizeof(struct async_op));
+
+	aop->fd = cur_fd;
+	aop->count = partial->count - partial->offset;
+	aop->priority = 0;
+	aop->timeout.tv_sec = rund.config.network.conn_timeout;
+	aop->data = partial->base + partial->offset;
+
+	if (resume(aop) < 0) {
+		errsv = errno;
+		log_warn("_notify_partial(): resume(): %s\n", strerror(errno));
+		_notify_partial_reset(aop, partial);
+		errno = errsv;
+		return -1;
+	}
+
+	return 1;
+}
 
 void notify_read(struct async_op *aop) {
+	int ret = 0;
 	struct usched_entry *entry = NULL;
 
-	if ((rtsaio_status(aop) == ASYNCOP_STATUS_COMPLETE) && (rtsaio_count(aop) == aop->count)) {
+	/* Reads armed on subscription connections are handled by the subscription */
+	if (subscribe_daemon_received(aop))
+		return;
+
+	/* Slow clients may deliver the data across several reads */
+	if ((ret = _notify_partial(aop, &rtsaio_read)) > 0)
+		return;
+
+	if (!ret) {
 		/* Successfully received possible valid data */
 
 		/* Search for an existing entry. If found, the received data belongs to the entry command */
-		pthread_mutex_lock(&rund.mutex_rpool);
-		entry = rund.rpool->pope(rund.rpool, usched_entry_id(aop->fd));
-		pthread_mutex_unlock(&rund.mutex_rpool);
+		entry = pool_daemon_conn_pop(aop->fd);
 
 		if (entry) {
 			if (process_daemon_recv_update(aop, entry) < 0) {
@@ -69,27 +152,53 @@ void notify_read(struct async_op *aop) {
 			 * state is PROGRESS).
 			 */
 		} else {
+			/* Requests rejected by the admission control are answered with the reason */
+			if ((ret = process_daemon_recv_admit(aop)) < 0) {
+				log_warn("notify_read(): process_daemon_recv_admit(): %s\n", strerror(errno));
+				goto _read_failure;
+			} else if (ret > 0) {
+				/* The connection is closed once the reply is written (see notify_write()) */
+				if (rtsaio_write(aop) < 0) {
+					log_warn("notify_read(): rtsaio_write(): %s\n", strerror(errno));
+					goto _read_failure;
+				}
+
+				return;
+			}
+
 			if (!(entry = process_daemon_recv_create(aop))) {
 				log_warn("notify_read(): process_daemon_recv_create(): %s\n", strerror(errno));
 				goto _read_failure;
 			}
 
-			/* Re-insert the entry into the rpool before any I/O */
-			pthread_mutex_lock(&rund.mutex_rpool);
-
-			if (rund.rpool->insert(rund.rpool, entry) < 0) {
-				pthread_mutex_unlock(&rund.mutex_rpool);
-				log_warn("notify_read(): rund.rpool->insert(): %s\n", strerror(errno));
+			/* Re-insert the entry into the receiving table before any I/O */
+			if (pool_daemon_conn_insert(aop->fd, entry) < 0) {
+				log_warn("notify_read(): pool_daemon_conn_insert(): %s\n", strerror(errno));
+				entry_destroy(entry);
 				goto _read_failure;
 			}
-
-			pthread_mutex_unlock(&rund.mutex_rpool);
 		}
 
 		/* If we've reached this point without errors and the 'entry' pointer is still valid,
 		 * then it either bolongs to apool (completed) or it's in progress.
 		 */
-		if (entry_has_flag(entry, USCHED_ENTRY_FLAG_FINISH)) {
+		if (entry_has_flag(entry, USCHED_ENTRY_FLAG_FINISH) && entry_has_flag(entry, USCHED_ENTRY_FLAG_SUBSCRIBE)) {
+			/* The entry now belongs to the subscription, which keeps its cryptographic
+			 * context to encrypt the completion records. The connection is handed over
+			 * to the subscription once the reply is written (see notify_write()).
+			 */
+			log_info("notify_read(): Subscription from file descriptor %d successfully registered.\n", aop->fd);
+		} else if (entry_has_flag(entry, USCHED_ENTRY_FLAG_FINISH) && process_daemon_send_pending(entry)) {
+			/* The response is streamed across several writes. Keep the entry (and its
+			 * cryptographic context) in the receiving table until notify_write() sends
+			 * the last chunk.
+			 */
+			if (pool_daemon_conn_insert(aop->fd, entry) < 0) {
+				log_warn("notify_read(): pool_daemon_conn_insert(): %s\n", strerror(errno));
+				entry_destroy(entry);
+				goto _read_failure;
+			}
+		} else if (entry_has_flag(entry, USCHED_ENTRY_FLAG_FINISH)) {
 			/* If the entry is in finishing state and we reached this point, it means
 			 * it is now in a completed state.
 			 */
@@ -116,10 +225,10 @@ void notify_read(struct async_op *aop) {
 			}
 #endif
 
-			/* If this is a GET or DEL request, we must destroy the entry after
+			/* If this is a GET, DEL or BATCH request, we must destroy the entry after
 			 * completion since it wasn't placed in the active pool.
 			 */
-			if (entry_has_flag(entry, USCHED_ENTRY_FLAG_GET) || entry_has_flag(entry, USCHED_ENTRY_FLAG_DEL))
+			if (entry_has_flag(entry, USCHED_ENTRY_FLAG_GET) || entry_has_flag(entry, USCHED_ENTRY_FLAG_DEL) || entry_has_flag(entry, USCHED_ENTRY_FLAG_BATCH))
 				entry_destroy(entry);
 		} else if (entry_has_flag(entry, USCHED_ENTRY_FLAG_PROGRESS) && !entry_has_flag(entry, USCHED_ENTRY_FLAG_AUTHORIZED)) {
 			/* This is another acceptable state. A new entry was received but is still
@@ -144,9 +253,6 @@ void notify_read(struct async_op *aop) {
 			goto _read_failure;
 		}
 
-		return;
-	} else if (rtsaio_status(aop) == ASYNCOP_STATUS_INCOMPLETE) {
-		/* TODO: Read the missing data? */
 		return;
 	}
 
@@ -157,27 +263,15 @@ _read_failure:
 	/* Discard connection */
 	log_info("notify_read(): Terminating connection from file descriptor %d\n", aop->fd);
 
-	/* Entries in the remote connections pool (rpool) are always identified by its file descriptor.
-	 * Although the entry's handling functions will remove invalid connections from this pool (rpool),
-	 * this last search will grant that no residual entries will be kept in the pool in the case of a
-	 * connection timeout occur.
-	 */
-	pthread_mutex_lock(&rund.mutex_rpool);
+	/* Release the data buffer before the connection buffer it may refer to is destroyed */
+	pool_daemon_conn_buf_release(aop->fd, (void *) aop->data);
+	aop->data = NULL;
 
-	/* If we find an entry by it's file descriptor, it's safe to delete it because it doesn't
-	 * reside in the active pool. The ID of the entries on the active pool are no longer the
-	 * file descriptor value, but a unique identifier.
+	/* Any entry still held in the receiving table slot of this file descriptor is released
+	 * when the connection is closed. Such entries never reached the active pool.
 	 */
-	if ((entry = rund.rpool->search(rund.rpool, usched_entry_id(aop->fd))))
-		rund.rpool->del(rund.rpool, entry);
-
-	pthread_mutex_unlock(&rund.mutex_rpool);
-
 	conn_daemon_client_close(aop->fd);
 
-	if (aop->data)
-		mm_free((void *) aop->data);
-
 	/* 'aop' pointer should not be free()'d inside the notification function to avoid issues
 	 * with early free()'d while calling rtsaio_cancel().
 	 * 
@@ -199,22 +293,37 @@ _read_failure:
 }
 
 void notify_write(struct async_op *aop) {
+	int ret = 0;
 	struct usched_entry *entry = NULL;
 	int cur_fd = aop->fd;
 
 	debug_printf(DEBUG_INFO, "notify_write(): rtsaio_status(aop): %d\n", rtsaio_status(aop));
 
-	if ((rtsaio_status(aop) == ASYNCOP_STATUS_COMPLETE) && (rtsaio_count(aop) == aop->count)) {
-		/* Free aop->data memory */
-		if (aop->data) {
-			mm_free((void *) aop->data);
-			aop->data = NULL;
+	/* Slow clients may accept the data across several writes */
+	if ((ret = _notify_partial(aop, &rtsaio_write)) > 0)
+		return;
+
+	if (!ret) {
+		/* Free aop->data memory, unless it's the connection receive buffer */
+		pool_daemon_conn_buf_release(aop->fd, (void *) aop->data);
+		aop->data = NULL;
+
+		/* Subscription connections are only written to, as completion records are published */
+		if ((ret = subscribe_daemon_sent(aop)) > 0) {
+			return;
+		} else if (ret < 0) {
+			log_warn("notify_write(): subscribe_daemon_sent(): %s\n", strerror(errno));
+			goto _write_failure;
+		}
+
+		/* The client was told why its request was rejected. Nothing else is read from it. */
+		if (pool_daemon_conn_rejected(aop->fd)) {
+			log_info("notify_write(): Request from file descriptor %d was rejected by the admission control.\n", aop->fd);
+			goto _write_failure;
 		}
 
 		/* Search for an existing entry. */
-		pthread_mutex_lock(&rund.mutex_rpool);
-		entry = rund.rpool->pope(rund.rpool, usched_entry_id(aop->fd));
-		pthread_mutex_unlock(&rund.mutex_rpool);
+		entry = pool_daemon_conn_pop(aop->fd);
 
 		/* Prepare the aop for another read */
 		memset(aop, 0, sizeof(struct async_op));
@@ -235,39 +344,66 @@ void notify_write(struct async_op *aop) {
 			/* Do another rtsaio_read() of usched_entry_hdr_size() bytes in order
 			 * to wait for another entry
 			 */
-			aop->count = usched_entry_hdr_size();
+			if (process_daemon_recv_prepare(aop) < 0) {
+				log_warn("notify_write(): process_daemon_recv_prepare(): %s\n", strerror(errno));
+
+				goto _write_failure;
+			}
 
 			debug_printf(DEBUG_INFO, "Performing another entry read (aop->count: %u)...\n", aop->count);
-		} else if (entry_has_flag(entry, USCHED_ENTRY_FLAG_PROGRESS)) {
-			/* Re-insert the entry into the rpool before any I/O */
-			pthread_mutex_lock(&rund.mutex_rpool);
+		} else if (entry_has_flag(entry, USCHED_ENTRY_FLAG_FINISH)) {
+			/* A streamed response has more chunks to be sent */
+			if (process_daemon_send_update(aop, entry) < 0) {
+				log_warn("notify_write(): process_daemon_send_update(): %s\n", strerror(errno));
+				entry_destroy(entry);
+				goto _write_failure;
+			}
+
+			if (process_daemon_send_pending(entry)) {
+				/* Re-insert the entry into the receiving table before any I/O */
+				if (pool_daemon_conn_insert(aop->fd, entry) < 0) {
+					log_warn("notify_write(): pool_daemon_conn_insert(): %s\n", strerror(errno));
+					entry_destroy(entry);
+					goto _write_failure;
+				}
+			} else {
+				/* Last chunk. The entry is now completed. */
+				log_info("notify_write(): Request from file descriptor %d successfully processed.\n", aop->fd);
+
+				entry_destroy(entry);
+			}
+
+			/* Perform the asynchronous write */
+			if (rtsaio_write(aop) < 0) {
+				log_warn("notify_write(): rtsaio_write(): %s\n", strerror(errno));
 
-			if (rund.rpool->insert(rund.rpool, entry) < 0) {
-				pthread_mutex_unlock(&rund.mutex_rpool);
-				log_warn("notify_write(): rund.rpool->insert(): %s\n", strerror(errno));
 				goto _write_failure;
 			}
 
-			pthread_mutex_unlock(&rund.mutex_rpool);
+			return;
+		} else if (entry_has_flag(entry, USCHED_ENTRY_FLAG_PROGRESS)) {
+			/* Re-insert the entry into the receiving table before any I/O */
+			if (pool_daemon_conn_insert(aop->fd, entry) < 0) {
+				log_warn("notify_write(): pool_daemon_conn_insert(): %s\n", strerror(errno));
+				entry_destroy(entry);
+				goto _write_failure;
+			}
 
 			/* Request the amount of data present on entry->psize (payload size) */
 			aop->count = sizeof(entry->session) + entry->psize;
+
+			/* Receive the entry command into the connection receive buffer */
+			if (!(aop->data = pool_daemon_conn_buf(aop->fd, aop->count))) {
+				log_warn("notify_write(): pool_daemon_conn_buf(): %s\n", strerror(errno));
+
+				goto _write_failure;
+			}
 		} else {
 			/* Unexpected entry state */
 			log_warn("notify_write(): Unexpected entry state.\n");
 			goto _write_failure;
 		}
 
-		/* Allocate enough memory on data buffer */
-		if (!(aop->data = mm_alloc(aop->count))) {
-			log_warn("notify_write(): aop->data = mm_alloc(): %s\n", strerror(errno));
-
-			goto _write_failure;
-		}
-
-		/* Reset the memory */
-		memset((void *) aop->data, 0, aop->count);
-
 		/* Perform the asynchronous read */
 		if (rtsaio_read(aop) < 0) {
 			log_warn("notify_write(): rtsaio_read(): %s\n", strerror(errno));
@@ -275,9 +411,6 @@ void notify_write(struct async_op *aop) {
 			goto _write_failure;
 		}
 
-		return;
-	} else if (rtsaio_status(aop) == ASYNCOP_STATUS_INCOMPLETE) {
-		/* TODO: Read the missing data? */
 		return;
 	}
 
@@ -288,27 +421,19 @@ _write_failure:
 	/* Discard connection */
 	log_info("notify_write(): Terminating connection from file descriptor %d\n", aop->fd);
 
-	/* Entries in the remote connections pool (rpool) are always identified by its file descriptor.
-	 * Although the entry's handling functions will remove invalid connections from this pool (rpool),
-	 * this last search will grant that no residual entries will be kept in the pool in the case of a
-	 * connection timeout occur.
-	 */
-	pthread_mutex_lock(&rund.mutex_rpool);
-
-	/* If we find an entry by it's file descriptor, it's safe to delete it because it doesn't
-	 * reside in the active pool. The ID of the entries on the active pool are no longer the
-	 * file descriptor value, but a unique identifier.
-	 */
-	if ((entry = rund.rpool->search(rund.rpool, usched_entry_id(aop->fd))))
-		rund.rpool->del(rund.rpool, entry);
+	/* Release the data buffer before the connection buffer it may refer to is destroyed */
+	pool_daemon_conn_buf_release(aop->fd, (void *) aop->data);
+	aop->data = NULL;
 
-	pthread_mutex_unlock(&rund.mutex_rpool);
+	/* A subscription connection with a pending read is closed once that read completes */
+	if (subscribe_daemon_failed(aop))
+		return;
 
+	/* Any entry still held in the receiving table slot of this file descriptor is released
+	 * when the connection is closed. Such entries never reached the active pool.
+	 */
 	conn_daemon_client_close(aop->fd);
 
-	if (aop->data)
-		mm_free((void *) aop->data);
-
 	/* 'aop' pointer should not be free()'d inside the notification function to avoid issues
 	 * with early free()'d while calling rtsaio_cancel().
 	 * 
@@ -29,6 +29,7 @@
 #include <string.h>
 #include <errno.h>
 #include <pthread.h>
+#include <sys/resource.h>
 
 #include <pall/cll.h>
 
@@ -36,6 +37,207 @@
 #include "pool.h"
 #include "entry.h"
 #include "log.h"
+#include "mm.h"
+
+static int _pool_daemon_conn_init(void) {
+	struct rlimit rlim;
+
+	/* One slot per possible file descriptor. Descriptors beyond the table are refused. */
+	if (getrlimit(RLIMIT_NOFILE, &rlim) < 0) {
+		log_warn("_pool_daemon_conn_init(): getrlimit(): %s\n", strerror(errno));
+		rlim.rlim_cur = CONFIG_USCHED_NET_RTABLE_MAX;
+	}
+
+	if ((rlim.rlim_cur == RLIM_INFINITY) || (rlim.rlim_cur > CONFIG_USCHED_NET_RTABLE_MAX))
+		rlim.rlim_cur = CONFIG_USCHED_NET_RTABLE_MAX;
+
+	rund.rtable_nmemb = (size_t) rlim.rlim_cur;
+
+	if (!(rund.rtable = mm_calloc(rund.rtable_nmemb, sizeof(struct usched_conn_slot))))
+		return -1;
+
+	return 0;
+}
+
+static void _pool_daemon_conn_slot_clear(struct usched_conn_slot *slot) {
+	if (slot->entry) {
+		entry_destroy(slot->entry);
+		slot->entry = NULL;
+	}
+
+	if (slot->buf) {
+		mm_free(slot->buf);
+		slot->buf = NULL;
+		slot->buf_size = 0;
+	}
+
+	memset(&slot->partial, 0, sizeof(slot->partial));
+
+	slot->rejected = 0;
+	slot->gen ++;
+}
+
+int pool_daemon_conn_open(sock_t fd) {
+	if ((fd < 0) || ((size_t) fd >= rund.rtable_nmemb)) {
+		errno = EMFILE;
+		return -1;
+	}
+
+	pthread_mutex_lock(&rund.mutex_rpool);
+
+	/* Start a new connection generation. Any residual entry belongs to a previous connection
+	 * that was using the same file descriptor.
+	 */
+	_pool_daemon_conn_slot_clear(&rund.rtable[fd]);
+
+	pthread_mutex_unlock(&rund.mutex_rpool);
+
+	return 0;
+}
+
+int pool_daemon_conn_insert(sock_t fd, struct usched_entry *entry) {
+	struct usched_conn_slot *slot = NULL;
+
+	if ((fd < 0) || ((size_t) fd >= rund.rtable_nmemb)) {
+		errno = EMFILE;
+		return -1;
+	}
+
+	slot = &rund.rtable[fd];
+
+	pthread_mutex_lock(&rund.mutex_rpool);
+
+	/* There's at most one entry in progress per connection */
+	if (slot->entry) {
+		pthread_mutex_unlock(&rund.mutex_rpool);
+		errno = EEXIST;
+		return -1;
+	}
+
+	slot->entry = entry;
+	slot->entry_gen = slot->gen;
+
+	pthread_mutex_unlock(&rund.mutex_rpool);
+
+	return 0;
+}
+
+struct usched_entry *pool_daemon_conn_pop(sock_t fd) {
+	struct usched_entry *entry = NULL;
+	struct usched_conn_slot *slot = NULL;
+
+	if ((fd < 0) || ((size_t) fd >= rund.rtable_nmemb))
+		return NULL;
+
+	slot = &rund.rtable[fd];
+
+	pthread_mutex_lock(&rund.mutex_rpool);
+
+	if ((entry = slot->entry)) {
+		slot->entry = NULL;
+
+		/* Entries left behind by a previous connection are discarded */
+		if (slot->entry_gen != slot->gen) {
+			log_warn("pool_daemon_conn_pop(): Discarding stale entry on file descriptor %d.\n", fd);
+			entry_destroy(entry);
+			entry = NULL;
+		}
+	}
+
+	pthread_mutex_unlock(&rund.mutex_rpool);
+
+	return entry;
+}
+
+void pool_daemon_conn_close(sock_t fd) {
+	if ((fd < 0) || ((size_t) fd >= rund.rtable_nmemb))
+		return;
+
+	pthread_mutex_lock(&rund.mutex_rpool);
+
+	/* The slot only holds entries that were never placed in the active pool */
+	_pool_daemon_conn_slot_clear(&rund.rtable[fd]);
+
+	pthread_mutex_unlock(&rund.mutex_rpool);
+}
+
+void *pool_daemon_conn_buf(sock_t fd, size_t size) {
+	int errsv = 0;
+	char *buf = NULL;
+	struct usched_conn_slot *slot = NULL;
+
+	if ((fd < 0) || ((size_t) fd >= rund.rtable_nmemb)) {
+		errno = EMFILE;
+		return NULL;
+	}
+
+	/* Oversized requests don't grow the connection buffer. The caller gets a transient buffer
+	 * that is free()'d by pool_daemon_conn_buf_release().
+	 */
+	if (size > CONFIG_USCHED_NET_RBUF_MAX)
+		return mm_alloc(size);
+
+	slot = &rund.rtable[fd];
+
+	pthread_mutex_lock(&rund.mutex_rpool);
+
+	/* The buffer only grows. Its contents are always fully overwritten by the next read, so
+	 * there's no need to reset it.
+	 */
+	if (slot->buf_size < size) {
+		if (!(buf = mm_realloc(slot->buf, size))) {
+			errsv = errno;
+			pthread_mutex_unlock(&rund.mutex_rpool);
+			log_warn("pool_daemon_conn_buf(): mm_realloc(): %s\n", strerror(errno));
+			errno = errsv;
+			return NULL;
+		}
+
+		slot->buf = buf;
+		slot->buf_size = size;
+	}
+
+	buf = slot->buf;
+
+	pthread_mutex_unlock(&rund.mutex_rpool);
+
+	return buf;
+}
+
+void pool_daemon_conn_buf_release(sock_t fd, void *data) {
+	if (!data)
+		return;
+
+	/* The connection buffer is kept until the connection is closed */
+	if ((fd >= 0) && ((size_t) fd < rund.rtable_nmemb) && (data == rund.rtable[fd].buf))
+		return;
+
+	mm_free(data);
+}
+
+struct usched_conn_partial *pool_daemon_conn_partial(sock_t fd) {
+	if ((fd < 0) || ((size_t) fd >= rund.rtable_nmemb)) {
+		errno = EMFILE;
+		return NULL;
+	}
+
+	/* Only the operations of this connection access this state, one at a time */
+	return &rund.rtable[fd].partial;
+}
+
+void pool_daemon_conn_reject(sock_t fd) {
+	if ((fd < 0) || ((size_t) fd >= rund.rtable_nmemb))
+		return;
+
+	rund.rtable[fd].rejected = 1;
+}
+
+int pool_daemon_conn_rejected(sock_t fd) {
+	if ((fd < 0) || ((size_t) fd >= rund.rtable_nmemb))
+		return 0;
+
+	return rund.rtable[fd].rejected;
+}
 
 int pool_daemon_init(void) {
 	int errsv = 0;
@@ -51,21 +253,20 @@ int pool_daemon_init(void) {
 	/* Setup CLL: No auto search, head insert, search forward */
 	(void) rund.apool->set_config(rund.apool, (ui32_t) (CONFIG_SEARCH_FORWARD | CONFIG_INSERT_HEAD));
 
-	/* Initialize connection pool */
-	if (!(rund.rpool = pall_cll_init(&entry_compare, &entry_destroy, &entry_daemon_serialize, &entry_daemon_unserialize))) {
+	/* Initialize receiving table */
+	if (_pool_daemon_conn_init() < 0) {
 		errsv = errno;
-		log_crit("pool_daemon_init(): rund.rpool = pall_cll_init(): %s\n", strerror(errno));
+		log_crit("pool_daemon_init(): _pool_daemon_conn_init(): %s\n", strerror(errno));
 		errno = errsv;
 		return -1;
 	}
 
-	/* Setup CLL: No auto search, head insert, search forward */
-	(void) rund.rpool->set_config(rund.rpool, (ui32_t) (CONFIG_SEARCH_FORWARD | CONFIG_INSERT_HEAD));
-
 	return 0;
 }
 
 void pool_daemon_destroy(void) {
+	size_t i = 0;
+
 	/* TODO: Grant that conn_daemon_destroy() and schedule_daemon_destroy() were already called
 	 * before stepping ahead this point.
 	 */
@@ -84,13 +285,21 @@ void pool_daemon_destroy(void) {
 	pthread_mutex_unlock(&rund.mutex_apool);
 
 	/* NOTE: conn_daemon_destroy() must have been called at this time in order to ensure that
-	 * the destruction of remote connections pool won't cause any invalid memory accesses.
+	 * the destruction of the receiving table won't cause any invalid memory accesses.
 	 */
 	pthread_mutex_lock(&rund.mutex_rpool);
-	if (rund.rpool) {
-		pall_cll_destroy(rund.rpool);
-		rund.rpool = NULL;
+	if (rund.rtable) {
+		for (i = 0; i < rund.rtable_nmemb; i ++) {
+			if (rund.rtable[i].entry)
+				entry_destroy(rund.rtable[i].entry);
+
+			if (rund.rtable[i].buf)
+				mm_free(rund.rtable[i].buf);
+		}
+
+		mm_free(rund.rtable);
+		rund.rtable = NULL;
+		rund.rtable_nmemb = 0;
 	}
 	pthread_mutex_unlock(&rund.mutex_rpool);
 }
-
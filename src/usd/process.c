@@ -43,37 +43,99 @@
 #include "schedule.h"
 #include "conn.h"
 #include "usched.h"
+#include "admit.h"
+#include "pool.h"
+#include "subscribe.h"
 
-static int _process_recv_update_op_new(struct async_op *aop, struct usched_entry *entry) {
+static int _process_recv_update_reply(struct async_op *aop, struct usched_entry *entry) {
 	int errsv = 0;
 	int cur_fd = aop->fd;
 
+	/* Encrypt the payload and reserve 4 bytes on top of it to prepend the payload size later */
+	if (entry_payload_encrypt(entry, 4) < 0) {
+		errsv = errno;
+		log_warn("_process_recv_update_reply(): entry_payload_encrypt(): %s\n", strerror(errno));
+		entry_unset_payload(entry);
+		errno = errsv;
+		return -1;
+	}
+
+	/* Prepend the payload size to the payload itself */
+	memcpy(entry->payload, (uint32_t [1]) { htonl(entry->psize) }, 4);
+
+	/* Reuse 'aop' to reply the operation result to the client */
+	pool_daemon_conn_buf_release(cur_fd, (void *) aop->data);
+
+	memset(aop, 0, sizeof(struct async_op));
+
+	aop->fd = cur_fd;
+	aop->count = entry->psize;
+	aop->priority = 0;
+	aop->timeout.tv_sec = rund.config.network.conn_timeout;
+	aop->data = entry->payload;
+
+	/* Unset the payload without free()ing it. The new reference to the region was set to aop->data */
+	entry->payload = NULL;
+	entry->psize = 0;
+
+	/* All good */
+	return 0;
+}
+
+static void _process_op_new_revert(struct usched_entry *entry) {
+	/* If we're unable to comunicate with the client, the scheduled entry should be disabled and pop'd from apool */
+	if (!schedule_entry_disable(entry)) {
+		/* This is critical and should never happen. This means that a race condition occured that allowed
+		 * the user to operate over a unfinished entry. We'll abort here in order to prevent further damage.
+		 */
+		runtime_daemon_fatal();
+	}
+}
+
+static int _process_op_new(struct usched_entry *entry) {
+	int errsv = 0;
+
 	debug_printf(DEBUG_INFO, "PAYLOAD: %s\n", entry->payload);
 
 	/* The payload of a NEW entry is the entry subject. */
 	if (entry_set_subj(entry, entry->payload, entry->psize)) {
 		errsv = errno;
-		log_warn("_process_recv_update_op_new(): entry_set_subj(): %s\n", strerror(errno));
-		goto _update_op_new_failure_1;
+		log_warn("_process_op_new(): entry_set_subj(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
 	}
 
 	/* Clear payload information */
 	entry_unset_payload(entry);
 
+	/* Decide whether the subject is executed by the shell or directly */
+	if (entry_daemon_exec_mode_set(entry) < 0) {
+		errsv = errno;
+		log_warn("_process_op_new(): entry_daemon_exec_mode_set(): Direct execution requires an absolute program path and can't be combined with shell execution.\n");
+		errno = errsv;
+		return -1;
+	}
+
+	/* Account the new entry in the owner's active entries quota. The UID is now trusted. */
+	if (admit_daemon_entry_hold(entry->uid) < 0) {
+		errsv = errno;
+		log_warn("_process_op_new(): admit_daemon_entry_hold(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
 	/* We're done. Now we need to install and set a global and unique id for this entry */
 	if (schedule_entry_create(entry) < 0) {
 		errsv = errno;
-		log_warn("_process_recv_update_op_new(): schedule_entry_create(): %s\n", strerror(errno));
+		log_warn("_process_op_new(): schedule_entry_create(): %s\n", strerror(errno));
 
-		/* Destroy the entry (see NOTE below) */
-		entry_destroy(entry);
+		admit_daemon_entry_release(entry->uid);
 
-		/* NOTE: This is a special case: The current entry is no longer in the rpool and wasn't inserted into
-		 * the active pool (apool) due to errors.
-		 * Since the entry was already pop'd, we don't need to do it here.
+		/* NOTE: The entry wasn't inserted into the active pool (apool) due to errors. It will be
+		 * destroyed by the caller.
 		 */
-
-		goto _update_op_new_failure_1;
+		errno = errsv;
+		return -1;
 	}
 
 	/* Inform runtime that serialization is required */
@@ -84,70 +146,47 @@ static int _process_recv_update_op_new(struct async_op *aop, struct usched_entry
 	/* Set payload */
 	if (entry_set_payload(entry, (const char *) (uint64_t [1]) { htonll(entry->id) }, 8) < 0) {
 		errsv = errno;
-		log_warn("_process_recv_update_op_new(): entry_set_payload(): %s\n", strerror(errno));
+		log_warn("_process_op_new(): entry_set_payload(): %s\n", strerror(errno));
+		_process_op_new_revert(entry);
 		errno = errsv;
-		goto _update_op_new_failure_2;
-	}
-
-	/* Encrypt the payload */
-	if (entry_payload_encrypt(entry, 4) < 0) {
-		errsv = errno;
-		log_warn("_process_recv_update_op_new(): entry_payload_encrypt(): %s\n", strerror(errno));
-		entry_unset_payload(entry);
-		errno = errsv;
-		goto _update_op_new_failure_2;
+		return -1;
 	}
 
-	/* Prepend the payload size */
-	memcpy(entry->payload, (uint32_t [1]) { htonl(entry->psize) }, 4);
-
-	/* Reuse 'aop' to reply the entry->id to the client */
-	mm_free((void *) aop->data);
-
-	memset(aop, 0, sizeof(struct async_op));
-
-	aop->fd = cur_fd;
-	aop->count = entry->psize;
-	aop->priority = 0;
-	aop->timeout.tv_sec = rund.config.network.conn_timeout;
-	aop->data = entry->payload;
-
-	/* Unset the payload without free()ing it */
-	entry->payload = NULL;
-	entry->psize = 0;
-
 	debug_printf(DEBUG_INFO, "Delivering entry id: %llu\n", entry->id);
 
 	return 0;
+}
 
-_update_op_new_failure_2:
-	/* If we're unable to comunicate with the client, the scheduled entry should be disabled and pop'd from apool */
-	if (!schedule_entry_disable(entry)) {
-		/* This is critical and should never happen. This means that a race condition occured that allowed
-		 * the user to operate over a unfinished entry. We'll abort here in order to prevent further damage.
-		 */
-		runtime_daemon_fatal();
-	}
+static int _process_recv_update_op_new(struct async_op *aop, struct usched_entry *entry) {
+	int errsv = 0;
 
-	/* Revert the entry id to its original file descriptor. This will allow the rpool cleanup
-	 * routines be aware that this entry wasn't successfully inserted into the active pool.
-	 */
-	entry->id = (uint64_t) aop->fd;
+	if (_process_op_new(entry) < 0) {
+		errsv = errno;
+		log_warn("_process_recv_update_op_new(): _process_op_new(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
 
-_update_op_new_failure_1:
-	errno = errsv;
+	/* Reply the entry->id to the client */
+	if (_process_recv_update_reply(aop, entry) < 0) {
+		errsv = errno;
+		log_warn("_process_recv_update_op_new(): _process_recv_update_reply(): %s\n", strerror(errno));
+		_process_op_new_revert(entry);
+		errno = errsv;
+		return -1;
+	}
 
-	return -1;
+	return 0;
 }
 
-static int _process_recv_update_op_del(struct async_op *aop, struct usched_entry *entry) {
-	int errsv = 0, cur_fd = aop->fd;
+static int _process_op_del(struct usched_entry *entry) {
+	int errsv = 0;
 	uint64_t *entry_list_req = NULL, *entry_list_res = NULL;
 	uint32_t i = 0, entry_list_req_nmemb = 0, entry_list_res_nmemb = 0;
 
 	/* Check if the payload size if aligned with the entry->id size */
 	if ((entry->psize % sizeof(entry->id))) {
-		log_warn("_process_recv_update_op_del(): entry->psize %% sizeof(entry->id) != 0\n");
+		log_warn("_process_op_del(): entry->psize %% sizeof(entry->id) != 0\n");
 		errno = EINVAL;
 		return -1;
 	}
@@ -162,7 +201,7 @@ static int _process_recv_update_op_del(struct async_op *aop, struct usched_entry
 	 */
 	if (!entry_list_req_nmemb) {
 		/* Someone is probably trying something nasty */
-		log_warn("_process_recv_update_op_del(): entry_list_req_nmemb == 0 (Possible exploit attempt)\n");
+		log_warn("_process_op_del(): entry_list_req_nmemb == 0 (Possible exploit attempt)\n");
 		errno = EINVAL;
 		return -1;
 	}
@@ -181,7 +220,7 @@ static int _process_recv_update_op_del(struct async_op *aop, struct usched_entry
 
 		if (schedule_entry_get_by_uid(entry->uid, &entry_list_req, &entry_list_req_nmemb) < 0) {
 			errsv = errno;
-			log_warn("_process_recv_update_op_del(): schedule_entry_get_by_uid(): %s\n", strerror(errno));
+			log_warn("_process_op_del(): schedule_entry_get_by_uid(): %s\n", strerror(errno));
 			errno = errsv;
 			return -1;
 		}
@@ -195,7 +234,7 @@ static int _process_recv_update_op_del(struct async_op *aop, struct usched_entry
 	 */
 	for (i = 0, entry_list_res_nmemb = 0; i < entry_list_req_nmemb; i ++) {
 		if (schedule_entry_ownership_delete_by_id(entry_list_req[i], entry->uid) < 0) {
-			log_warn("_process_recv_update_op_del(): schedule_entry_ownership_delete_by_id(): %s\n", strerror(errno));
+			log_warn("_process_op_del(): schedule_entry_ownership_delete_by_id(): %s\n", strerror(errno));
 			continue;
 		}
 
@@ -207,7 +246,7 @@ static int _process_recv_update_op_del(struct async_op *aop, struct usched_entry
 		/* Reallocate list memory to hold another deleted entry id */
 		if (!(entry_list_res = mm_realloc(entry_list_res, entry_list_res_nmemb * sizeof(entry->id)))) {
 			errsv = errno;
-			log_warn("_process_recv_update_op_del(): mm_realloc(): %s\n", strerror(errno));
+			log_warn("_process_op_del(): mm_realloc(): %s\n", strerror(errno));
 			errno = errsv;
 
 			return -1;
@@ -227,7 +266,7 @@ static int _process_recv_update_op_del(struct async_op *aop, struct usched_entry
 
 	if (!(entry->payload = mm_alloc(entry->psize))) {
 		errsv = errno;
-		log_warn("_process_recv_update_op_del(): mm_alloc(): %s\n", strerror(errno));
+		log_warn("_process_op_del(): mm_alloc(): %s\n", strerror(errno));
 		mm_free(entry_list_res);
 		errno = errsv;
 		return -1;
@@ -239,34 +278,6 @@ static int _process_recv_update_op_del(struct async_op *aop, struct usched_entry
 
 	memcpy(entry->payload, (uint32_t [1]) { htonl(entry_list_res_nmemb) }, 4);
 
-	/* Encrypt the payload */
-	if (entry_payload_encrypt(entry, 4) < 0) {
-		errsv = errno;
-		log_warn("_process_recv_update_op_del(): entry_payload_encrypt(): %s\n", strerror(errno));
-		entry_unset_payload(entry);
-		mm_free(entry_list_res);
-		errno = errsv;
-		return -1;
-	}
-
-	/* Prepend the payload size to the payload itself */
-	memcpy(entry->payload, (uint32_t [1]) { htonl(entry->psize) }, 4);
-
-	/* Reuse 'aop' to reply the deleted entries to the client */
-	mm_free((void *) aop->data);
-
-	memset(aop, 0, sizeof(struct async_op));
-
-	aop->fd = cur_fd;
-	aop->count = entry->psize;
-	aop->priority = 0;
-	aop->timeout.tv_sec = rund.config.network.conn_timeout;
-	aop->data = entry->payload;
-
-	/* Unset the payload without free()ing it */
-	entry->payload = NULL;
-	entry->psize = 0;
-
 	debug_printf(DEBUG_INFO, "Delivering %lu entry ID's that were successfully deleted.\n", entry_list_res_nmemb);
 
 	/* Free entry list */
@@ -276,8 +287,29 @@ static int _process_recv_update_op_del(struct async_op *aop, struct usched_entry
 	return 0;
 }
 
-static int _process_recv_update_op_get(struct async_op *aop, struct usched_entry *entry) {
-	int errsv = 0, cur_fd = aop->fd;
+static int _process_recv_update_op_del(struct async_op *aop, struct usched_entry *entry) {
+	int errsv = 0;
+
+	if (_process_op_del(entry) < 0) {
+		errsv = errno;
+		log_warn("_process_recv_update_op_del(): _process_op_del(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Reply the deleted entries to the client */
+	if (_process_recv_update_reply(aop, entry) < 0) {
+		errsv = errno;
+		log_warn("_process_recv_update_op_del(): _process_recv_update_reply(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+static int _process_op_get(struct usched_entry *entry) {
+	int errsv = 0;
 	uint64_t *entry_list_req = NULL;
 	uint32_t i = 0, entry_list_req_nmemb = 0, entry_list_res_nmemb = 0;
 	size_t buf_offset = 0, len = 0;
@@ -298,6 +330,10 @@ static int _process_recv_update_op_get(struct async_op *aop, struct usched_entry
 	 * | trigger     | 32 bits                         |     |
 	 * | step        | 32 bits                         |      > Serialized entry #1
 	 * | expire      | 32 bits                         |     |
+	 * | version     | 32 bits                         |     |
+	 * | overlap     | 32 bits                         |     |
+	 * | concurrency | 32 bits                         |     |
+	 * | priority    | 32 bits                         |     |
 	 * | pid         | 32 bits                         |     |
 	 * | status      | 32 bits                         |     |
 	 * | exec_time   | 64 bits                         |     |
@@ -319,7 +355,7 @@ static int _process_recv_update_op_get(struct async_op *aop, struct usched_entry
 
 	/* Check if the payload size is aligned with the entry->id size */
 	if ((entry->psize % sizeof(entry->id))) {
-		log_warn("_process_recv_update_op_get(): entry->psize %% sizeof(entry->id) != 0\n");
+		log_warn("_process_op_get(): entry->psize %% sizeof(entry->id) != 0\n");
 		errno = EINVAL;
 		return -1;
 	}
@@ -334,7 +370,7 @@ static int _process_recv_update_op_get(struct async_op *aop, struct usched_entry
 	 */
 	if (!entry_list_req_nmemb) {
 		/* Someone is probably trying something nasty */
-		log_warn("_process_recv_update_op_get(): entry_list_req_nmemb == 0 (Possible exploit attempt)\n");
+		log_warn("_process_op_get(): entry_list_req_nmemb == 0 (Possible exploit attempt)\n");
 		errno = EINVAL;
 		return -1;
 	}
@@ -353,7 +389,7 @@ static int _process_recv_update_op_get(struct async_op *aop, struct usched_entry
 
 		if (schedule_entry_get_by_uid(entry->uid, &entry_list_req, &entry_list_req_nmemb) < 0) {
 			errsv = errno;
-			log_warn("_process_recv_update_op_get(): schedule_entry_get_by_uid(): %s\n", strerror(errno));
+			log_warn("_process_op_get(): schedule_entry_get_by_uid(): %s\n", strerror(errno));
 			errno = errsv;
 			return -1;
 		}
@@ -367,7 +403,7 @@ static int _process_recv_update_op_get(struct async_op *aop, struct usched_entry
 
 	if (!(buf = mm_alloc(buf_offset))) {
 		errsv = errno;
-		log_warn("_process_recv_update_op_get(): mm_alloc(): %s\n", strerror(errno));
+		log_warn("_process_op_get(): mm_alloc(): %s\n", strerror(errno));
 		errno = errsv;
 		return -1;
 	}
@@ -378,13 +414,13 @@ static int _process_recv_update_op_get(struct async_op *aop, struct usched_entry
 	for (i = 0; i < entry_list_req_nmemb; i ++) {
 		/* Search for the entry id in the active pool and get a copy of it. */
 		if (!(entry_c = schedule_entry_get_copy(entry_list_req[i]))) {
-			log_warn("_process_recv_update_op_get(): schedule_entry_get_copy(): %s\n", strerror(errno));
+			log_warn("_process_op_get(): schedule_entry_get_copy(): %s\n", strerror(errno));
 			continue;
 		}
 
 		/* Grant that the found entry belongs to the requesting uid */
 		if (entry_c->uid != entry->uid) {
-			log_warn("_process_recv_update_op_get(): entry_c->uid != entry->uid. (UID of the request: %u\n", entry->uid);
+			log_warn("_process_op_get(): entry_c->uid != entry->uid. (UID of the request: %u\n", entry->uid);
 
 			entry_destroy(entry_c);
 
@@ -393,7 +429,7 @@ static int _process_recv_update_op_get(struct async_op *aop, struct usched_entry
 
 		/* Grant that outdata_len doesn't exceed the hardlimit */
 		if ((entry_c->outdata_len >= CONFIG_USCHED_EXEC_OUTPUT_MAX) || (entry_c->outdata_len != strlen(entry_c->outdata))) {
-			log_crit("_process_recv_update_op_get(): (entry_c->outdata_len >= CONFIG_USCHED_EXEC_OUTPUT_MAX) || (entry_c->outdata_len != strlen(entry_c->outdata))\n");
+			log_crit("_process_op_get(): (entry_c->outdata_len >= CONFIG_USCHED_EXEC_OUTPUT_MAX) || (entry_c->outdata_len != strlen(entry_c->outdata))\n");
 
 			entry_destroy(entry_c);
 
@@ -415,7 +451,7 @@ static int _process_recv_update_op_get(struct async_op *aop, struct usched_entry
 		/* Extend transmission buffer */
 		if (!(buf = mm_realloc(buf, len))) {
 			errsv = errno;
-			log_warn("_process_recv_update_op_get(): mm_realloc(): %s\n", strerror(errno));
+			log_warn("_process_op_get(): mm_realloc(): %s\n", strerror(errno));
 			entry_destroy(entry_c);
 			errno = errsv;
 			return -1;
@@ -432,6 +468,10 @@ static int _process_recv_update_op_get(struct async_op *aop, struct usched_entry
 		entry_c->trigger = htonl(entry_c->trigger);
 		entry_c->step = htonl(entry_c->step);
 		entry_c->expire = htonl(entry_c->expire);
+		entry_c->version = htonl(CONFIG_USCHED_ENTRY_HDR_VERSION);
+		entry_c->overlap = htonl(entry_c->overlap);
+		entry_c->concurrency = htonl(entry_c->concurrency);
+		entry_c->priority = htonl(entry_c->priority);
 		entry_c->pid = htonl(entry_c->pid);
 		entry_c->status = htonl(entry_c->status);
 		entry_c->exec_time = htonll(entry_c->exec_time);
@@ -466,126 +506,785 @@ static int _process_recv_update_op_get(struct async_op *aop, struct usched_entry
 	entry->payload = buf;
 	entry->psize = buf_offset;
 
-	/* Encrypt the payload and reserve 4 bytes on top of it to prepend the payload size later */
-	if (entry_payload_encrypt(entry, 4) < 0) {
+	/* All good */
+	return 0;
+}
+
+static int _process_op_get_stream_init(struct usched_entry *entry) {
+	int errsv = 0;
+	uint32_t i = 0, fields = 0, entry_list_nmemb = 0;
+	uint64_t *entry_list = NULL;
+
+	/* The request payload carries the requested fields followed by, at least, one entry id */
+	if ((entry->psize < 16) || (entry->psize % sizeof(entry->id))) {
+		log_warn("_process_op_get_stream_init(): Invalid payload size: %u\n", entry->psize);
+		errno = EINVAL;
+		return -1;
+	}
+
+	memcpy(&fields, entry->payload, sizeof(fields));
+	fields = ntohl(fields) & USCHED_ENTRY_FIELDS_ALL;
+
+	entry_list_nmemb = (entry->psize - 8) / sizeof(entry->id);
+
+	if (!(entry_list = mm_alloc(entry_list_nmemb * sizeof(uint64_t)))) {
 		errsv = errno;
-		log_warn("_process_recv_update_op_get(): entry_payload_encrypt(): %s\n", strerror(errno));
-		entry_unset_payload(entry);
+		log_warn("_process_op_get_stream_init(): mm_alloc(): %s\n", strerror(errno));
 		errno = errsv;
 		return -1;
 	}
 
-	/* Prepend the payload size to the payload itself */
-	memcpy(entry->payload, (uint32_t [1]) { htonl(entry->psize) }, 4);
+	/* Revert network to host byte order */
+	memcpy(entry_list, entry->payload + 8, entry_list_nmemb * sizeof(uint64_t));
 
-	/* Reuse 'aop' to reply the contents of the requested entries */
-	mm_free((void *) aop->data);
+	for (i = 0; i < entry_list_nmemb; i ++)
+		entry_list[i] = ntohll(entry_list[i]);
 
-	memset(aop, 0, sizeof(struct async_op));
+	/* Fetch all the entries that match the entry's uid */
+	if ((entry_list_nmemb == 1) && (entry_list[0] == USCHED_SUBJ_ALL)) {
+		mm_free(entry_list);
 
-	aop->fd = cur_fd;
-	aop->count = entry->psize;
-	aop->priority = 0;
-	aop->timeout.tv_sec = rund.config.network.conn_timeout;
-	aop->data = entry->payload;
+		entry_list = NULL;
 
-	/* Unset the payload without free()ing it. The new reference to the region was set to aop->data */
-	entry->payload = NULL;
-	entry->psize = 0;
+		if (schedule_entry_get_by_uid(entry->uid, &entry_list, &entry_list_nmemb) < 0) {
+			errsv = errno;
+			log_warn("_process_op_get_stream_init(): schedule_entry_get_by_uid(): %s\n", strerror(errno));
+			errno = errsv;
+			return -1;
+		}
+	}
+
+	/* The entry ids to be streamed are kept as the entry payload until the last chunk is sent */
+	entry_unset_payload(entry);
+
+	entry->payload = (char *) entry_list;
+	entry->psize = entry_list_nmemb * sizeof(uint64_t);
+
+	entry->reserved.stream.fields = fields;
+	entry->reserved.stream.cursor = 0;
 
-	/* All good */
 	return 0;
 }
 
-struct usched_entry *process_daemon_recv_create(struct async_op *aop) {
+static int _process_op_get_stream_next(struct usched_entry *entry, char **chunk, size_t *chunk_len) {
 	int errsv = 0;
-	struct usched_entry *entry = NULL;
+	uint32_t nmemb = 0, entry_list_nmemb = entry->psize / sizeof(uint64_t);
+	uint64_t *entry_list = (uint64_t *) entry->payload;
+	size_t buf_size = 8 + CONFIG_USCHED_GET_CHUNK_SIZE, buf_offset = 8, len = 0;
+	char *buf = NULL, *buf_new = NULL;
 
-	/* Process the received entry data */
-	if (!(entry = mm_alloc(sizeof(struct usched_entry)))) {
+	if (!(buf = mm_alloc(buf_size))) {
 		errsv = errno;
-		log_warn("process_recv_create(): entry = mm_alloc(): %s\n", strerror(errno));
+		log_warn("_process_op_get_stream_next(): mm_alloc(): %s\n", strerror(errno));
 		errno = errsv;
-		return NULL;
+		return -1;
 	}
 
-	memset(entry, 0, sizeof(struct usched_entry));
+	while (entry->reserved.stream.cursor < entry_list_nmemb) {
+		len = buf_size - buf_offset;
+
+		if (!schedule_entry_get_projection(entry_list[entry->reserved.stream.cursor], entry->uid, entry->reserved.stream.fields, buf + buf_offset, &len)) {
+			buf_offset += len;
+			nmemb ++;
+		} else if (errno != ENOBUFS) {
+			/* Entry no longer exists or doesn't belong to the requester. Skip it. */
+			debug_printf(DEBUG_INFO, "_process_op_get_stream_next(): schedule_entry_get_projection(): %s\n", strerror(errno));
+		} else if (nmemb) {
+			/* Chunk is full. The record will be the first of the next chunk. */
+			break;
+		} else {
+			/* A single record larger than the chunk size */
+			if (!(buf_new = mm_realloc(buf, buf_offset + len))) {
+				errsv = errno;
+				log_warn("_process_op_get_stream_next(): mm_realloc(): %s\n", strerror(errno));
+				mm_free(buf);
+				errno = errsv;
+				return -1;
+			}
+
+			buf = buf_new;
+			buf_size = buf_offset + len;
 
-	memcpy(entry, (void *) aop->data, aop->count);
+			continue;
+		}
 
-	/* Free aop data. We no longer need it */
-	mm_free((void *) aop->data);
-	aop->data = NULL;
+		entry->reserved.stream.cursor ++;
+	}
 
-	/* Setup received entry */
-	entry_set_id(entry, (uint64_t) aop->fd);
-	entry_set_flags(entry, ntohl(entry->flags));
-	entry_set_uid(entry, ntohl(entry->uid)); /* Untrusted. Will be used for comparison only */
-	entry_set_gid(entry, ntohl(entry->gid)); /* Untrusted. Will be used for comparison only */
-	entry_set_trigger(entry, ntohl(entry->trigger));
-	entry_set_step(entry, ntohl(entry->step));
-	entry_set_expire(entry, ntohl(entry->expire));
-	/* NOTE: pid, status, exec_time, latency, outdata_len and outdata are ignored here */
-	entry_set_psize(entry, ntohl(entry->psize));
+	/* Chunk header */
+	memcpy(buf, (uint32_t [1]) { htonl(entry->reserved.stream.cursor < entry_list_nmemb) }, 4);
+	memcpy(buf + 4, (uint32_t [1]) { htonl(nmemb) }, 4);
 
-	/* Set the last byte of username field to 0, so it will always be NULL terminated */
-	entry->username[sizeof(entry->username) - 1] = 0;
+	*chunk = buf;
+	*chunk_len = buf_offset;
 
-	/* Clear all local flags that the client have possibly set */
-	entry_unset_flags_local(entry);
+	return 0;
+}
 
-	/* Validate if this entry has at least one valid operation flag */
-	if (!entry_has_flag(entry, USCHED_ENTRY_FLAG_NEW) && !entry_has_flag(entry, USCHED_ENTRY_FLAG_DEL) && !entry_has_flag(entry, USCHED_ENTRY_FLAG_GET)) {
-		log_warn("process_daemon_recv_create(): The requested operation is invalid.\n");
-		entry_destroy(entry);
-		errno = EINVAL;
-		return NULL;
-	}
+static int _process_send_update_stream(struct async_op *aop, struct usched_entry *entry) {
+	int errsv = 0;
+	char *entry_list = entry->payload, *chunk = NULL;
+	uint32_t entry_list_size = entry->psize;
+	size_t chunk_len = 0;
 
-	/* Validate payload size */
-	if (!entry->psize) {
-		/* All entry requests expect a payload. If none is set, this entry request is invalid. */
-		log_warn("process_daemon_recv_create(): entry->psize == 0.\n");
-		entry_destroy(entry);
-		errno = EINVAL;
-		return NULL;
+	if (_process_op_get_stream_next(entry, &chunk, &chunk_len) < 0) {
+		errsv = errno;
+		log_warn("_process_send_update_stream(): _process_op_get_stream_next(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
 	}
 
-	/* If this is a new entry request, grant that subject fits in the mqueue message size */
-	if (entry_has_flag(entry, USCHED_ENTRY_FLAG_NEW) && ((entry->psize + 21) > (size_t) rund.config.ipc.msg_size)) {
-		log_warn("process_daemon_recv_create(): (entry->psize + 21) > rund,config.core.ipc.msgsize. This means that the subject is too long to be processed on this system.\n");
-		entry_destroy(entry);
-		errno = EINVAL;
-		return NULL;
+	/* The chunk temporarily replaces the entry id list as the payload to be encrypted */
+	entry->payload = chunk;
+	entry->psize = chunk_len;
+
+	if (_process_recv_update_reply(aop, entry) < 0) {
+		errsv = errno;
+		log_warn("_process_send_update_stream(): _process_recv_update_reply(): %s\n", strerror(errno));
+		entry->payload = entry_list;
+		entry->psize = entry_list_size;
+		errno = errsv;
+		return -1;
 	}
 
-	debug_printf(DEBUG_INFO, "psize: %u\n", entry->psize);
-	debug_printf(DEBUG_INFO, "username: %s\n", entry->username);
+	entry->payload = entry_list;
+	entry->psize = entry_list_size;
 
-	/* Set this entry state as in progress */
-	entry_set_flag(entry, USCHED_ENTRY_FLAG_PROGRESS);
+	return 0;
+}
 
-	/*
-	 * If this is a remote connection:
-	 *
-	 *  - Send a ciphered session token in the session field which the encryption key is the
-	 * hash of the user password in the users configuration structure. Append the user hash salt
-	 * and encryption nonce value to the head of the ciphered result. All these steps are
-	 * accomplished by entry_daemon_remote_session_create() function.
-	 *
-	 *
-	 * If this is a local connection:
-	 *
-	 *  - Set the session field to all zeros.
-	 *
-	 */
-	if (conn_is_remote(aop->fd)) {
-		if (entry_daemon_remote_session_create(entry) < 0) {
+static int _process_recv_update_op_get(struct async_op *aop, struct usched_entry *entry) {
+	int errsv = 0;
+
+	/* Projected requests are streamed in chunks. Remaining chunks are sent by notify_write(). */
+	if (entry_has_flag(entry, USCHED_ENTRY_FLAG_PROJECT)) {
+		if (_process_op_get_stream_init(entry) < 0) {
 			errsv = errno;
-			log_warn("process_daemon_recv_create(): entry_daemon_remote_session_create(): %s\n", strerror(errno));
-			entry_destroy(entry);
+			log_warn("_process_recv_update_op_get(): _process_op_get_stream_init(): %s\n", strerror(errno));
 			errno = errsv;
-			return NULL;
+			return -1;
+		}
+
+		if (_process_send_update_stream(aop, entry) < 0) {
+			errsv = errno;
+			log_warn("_process_recv_update_op_get(): _process_send_update_stream(): %s\n", strerror(errno));
+			errno = errsv;
+			return -1;
+		}
+
+		return 0;
+	}
+
+	if (_process_op_get(entry) < 0) {
+		errsv = errno;
+		log_warn("_process_recv_update_op_get(): _process_op_get(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Reply the contents of the requested entries to the client */
+	if (_process_recv_update_reply(aop, entry) < 0) {
+		errsv = errno;
+		log_warn("_process_recv_update_op_get(): _process_recv_update_reply(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+static struct usched_entry *_process_op_batch_child(const struct usched_entry *entry, const struct usched_entry_batch_op *op, const char *payload) {
+	int errsv = 0;
+	struct usched_entry *child = NULL;
+
+	if (!(child = mm_alloc(sizeof(struct usched_entry)))) {
+		errsv = errno;
+		log_warn("_process_op_batch_child(): mm_alloc(): %s\n", strerror(errno));
+		errno = errsv;
+		return NULL;
+	}
+
+	memset(child, 0, sizeof(struct usched_entry));
+
+	/* The operation inherits the identity of the authorized batch request */
+	entry_set_id(child, entry->id);
+	entry_set_uid(child, entry->uid);
+	entry_set_gid(child, entry->gid);
+	memcpy(child->username, entry->username, sizeof(child->username));
+
+	/* Only remote flags are accepted from the client */
+	entry_set_flags(child, ntohl(op->flags) & (((1 << USCHED_ENTRY_FLAG_INIT) - 1) | (1 << USCHED_ENTRY_FLAG_EXEC_SHELL) | (1 << USCHED_ENTRY_FLAG_EXEC_DIRECT)));
+	entry_set_trigger(child, ntohl(op->trigger));
+	entry_set_step(child, ntohl(op->step));
+	entry_set_expire(child, ntohl(op->expire));
+	entry_set_overlap(child, ntohl(op->overlap));
+	entry_set_concurrency(child, ntohl(op->concurrency));
+	entry_set_priority(child, ntohl(op->priority));
+
+	/* Each operation must carry exactly one of the NEW, DEL or GET operation flags */
+	if ((!!entry_has_flag(child, USCHED_ENTRY_FLAG_NEW) + !!entry_has_flag(child, USCHED_ENTRY_FLAG_DEL) + !!entry_has_flag(child, USCHED_ENTRY_FLAG_GET)) != 1) {
+		log_warn("_process_op_batch_child(): The requested operation is invalid.\n");
+		entry_destroy(child);
+		errno = EINVAL;
+		return NULL;
+	}
+
+	/* Validate execution overlap policy, concurrency limit and priority class */
+	if ((child->overlap > USCHED_ENTRY_OVERLAP_KILL) || (child->concurrency > CONFIG_USCHED_EXEC_CONCURRENCY_MAX) || (child->priority > USCHED_ENTRY_PRIORITY_LOW)) {
+		log_warn("_process_op_batch_child(): Invalid overlap policy (%u), concurrency limit (%u) or priority class (%u).\n", child->overlap, child->concurrency, child->priority);
+		entry_destroy(child);
+		errno = EINVAL;
+		return NULL;
+	}
+
+	/* If this is a new entry request, grant that subject fits in the mqueue message size */
+	if (entry_has_flag(child, USCHED_ENTRY_FLAG_NEW) && ((ntohl(op->psize) + sizeof(struct ipc_use_hdr) + 1) > (size_t) rund.config.ipc.msg_size)) {
+		log_warn("_process_op_batch_child(): (psize + sizeof(struct ipc_use_hdr) + 1) > rund.config.ipc.msg_size. This means that the subject is too long to be processed on this system.\n");
+		entry_destroy(child);
+		errno = EINVAL;
+		return NULL;
+	}
+
+	if (entry_set_payload(child, payload, ntohl(op->psize)) < 0) {
+		errsv = errno;
+		log_warn("_process_op_batch_child(): entry_set_payload(): %s\n", strerror(errno));
+		entry_destroy(child);
+		errno = errsv;
+		return NULL;
+	}
+
+	/* The operation goes through the same states of a single authorized request */
+	entry_set_flag(child, USCHED_ENTRY_FLAG_PROGRESS);
+	entry_set_flag(child, USCHED_ENTRY_FLAG_INIT);
+	entry_set_flag(child, USCHED_ENTRY_FLAG_AUTHORIZED);
+	entry_set_flag(child, USCHED_ENTRY_FLAG_FINISH);
+
+	return child;
+}
+
+static int _process_op_batch(struct usched_entry *entry, uint64_t **created, uint32_t *created_nmemb) {
+	int errsv = 0, ret = 0, rejected = 0;
+	uint32_t i = 0, version = 0, nmemb = 0, nmemb_new = 0, status = 0, rsize = 0;
+	size_t offset = 0, res_offset = 0, len = 0;
+	struct usched_entry_batch_op op;
+	struct usched_entry *child = NULL;
+	uint64_t *created_new = NULL;
+	char *res = NULL, *res_new = NULL;
+
+	/* Check if the payload is large enough to hold the batch header */
+	if (entry->psize < 8) {
+		log_warn("_process_op_batch(): entry->psize < 8\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	memcpy(&version, entry->payload, 4);
+	memcpy(&nmemb, entry->payload + 4, 4);
+
+	version = ntohl(version);
+	nmemb = ntohl(nmemb);
+
+	if (version != CONFIG_USCHED_BATCH_VERSION) {
+		log_warn("_process_op_batch(): Unsupported batch version: %u\n", version);
+		errno = EPROTONOSUPPORT;
+		return -1;
+	}
+
+	if (!nmemb || (nmemb > CONFIG_USCHED_BATCH_NMEMB_MAX)) {
+		log_warn("_process_op_batch(): Invalid number of operations: %u\n", nmemb);
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Validate the framing of all operations before processing any of them */
+	for (i = 0, offset = 8; i < nmemb; i ++) {
+		if ((entry->psize - offset) < sizeof(struct usched_entry_batch_op)) {
+			log_warn("_process_op_batch(): Operation #%u header exceeds the payload size.\n", i);
+			errno = EINVAL;
+			return -1;
+		}
+
+		memcpy(&op, entry->payload + offset, sizeof(struct usched_entry_batch_op));
+		offset += sizeof(struct usched_entry_batch_op);
+
+		if (!ntohl(op.psize) || ((entry->psize - offset) < ntohl(op.psize))) {
+			log_warn("_process_op_batch(): Operation #%u payload size is invalid.\n", i);
+			errno = EINVAL;
+			return -1;
+		}
+
+		offset += ntohl(op.psize);
+
+		if (bit_test((uint32_t [1]) { ntohl(op.flags) }, USCHED_ENTRY_FLAG_NEW))
+			nmemb_new ++;
+	}
+
+	if (offset != entry->psize) {
+		log_warn("_process_op_batch(): Trailing data found after the last operation.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Each NEW operation is accounted as a NEW request by the admission control. If the batch
+	 * isn't admitted, none of its NEW operations are processed and each one reports why.
+	 */
+	if (admit_daemon_request_batch(entry->uid, entry->username, nmemb_new) < 0) {
+		if (errno != EBUSY) {
+			errsv = errno;
+			log_warn("_process_op_batch(): admit_daemon_request_batch(): %s\n", strerror(errno));
+			errno = errsv;
+			return -1;
+		}
+
+		rejected = 1;
+	}
+
+	/* Initialize the response buffer (version + nmemb) */
+	res_offset = 8;
+
+	if (!(res = mm_alloc(res_offset))) {
+		errsv = errno;
+		log_warn("_process_op_batch(): mm_alloc(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	memcpy(res, (uint32_t [1]) { htonl(CONFIG_USCHED_BATCH_VERSION) }, 4);
+	memcpy(res + 4, (uint32_t [1]) { htonl(nmemb) }, 4);
+
+	/* Process each operation. A failed operation doesn't prevent the remaining ones. */
+	for (i = 0, offset = 8; i < nmemb; i ++) {
+		memcpy(&op, entry->payload + offset, sizeof(struct usched_entry_batch_op));
+		offset += sizeof(struct usched_entry_batch_op);
+
+		ret = 0;
+
+		if (!(child = _process_op_batch_child(entry, &op, entry->payload + offset))) {
+			ret = -1;
+		} else if (entry_has_flag(child, USCHED_ENTRY_FLAG_NEW) && rejected) {
+			ret = -1;
+			errno = EBUSY;
+		} else if (entry_has_flag(child, USCHED_ENTRY_FLAG_NEW)) {
+			if ((ret = _process_op_new(child)) < 0) {
+				/* Nothing to record */
+			} else if (!(created_new = mm_realloc(*created, (*created_nmemb + 1) * sizeof(uint64_t)))) {
+				/* Without a record of it, the entry couldn't be reverted later */
+				ret = -1;
+				errsv = errno;
+				_process_op_new_revert(child);
+				errno = errsv;
+			} else {
+				*created = created_new;
+				(*created)[(*created_nmemb) ++] = child->id;
+			}
+		} else if (entry_has_flag(child, USCHED_ENTRY_FLAG_DEL)) {
+			ret = _process_op_del(child);
+		} else {
+			ret = _process_op_get(child);
+		}
+
+		status = (ret < 0) ? (errno ? errno : EINVAL) : 0;
+
+		offset += ntohl(op.psize);
+
+		if (status) {
+			log_warn("_process_op_batch(): Operation #%u failed: %s\n", i, strerror(status));
+
+			if (child)
+				entry_destroy(child);
+
+			child = NULL;
+
+			rsize = 0;
+		} else {
+			rsize = child->psize;
+		}
+
+		/* Extend the response buffer */
+		len = res_offset + 8 + rsize;
+
+		if (!(res_new = mm_realloc(res, len))) {
+			errsv = errno;
+			log_warn("_process_op_batch(): mm_realloc(): %s\n", strerror(errno));
+			goto _batch_failure;
+		}
+
+		res = res_new;
+
+		memcpy(res + res_offset, (uint32_t [1]) { htonl(status) }, 4);
+		memcpy(res + res_offset + 4, (uint32_t [1]) { htonl(rsize) }, 4);
+
+		if (rsize)
+			memcpy(res + res_offset + 8, child->payload, rsize);
+
+		res_offset = len;
+
+		if (!child)
+			continue;
+
+		if (entry_has_flag(child, USCHED_ENTRY_FLAG_NEW)) {
+			/* The entry now resides in the active pool. Complete it as notify_read() does for
+			 * single requests.
+			 */
+			entry_unset_payload(child);
+			entry_unset_flag(child, USCHED_ENTRY_FLAG_PROGRESS);
+			entry_set_flag(child, USCHED_ENTRY_FLAG_COMPLETE);
+			entry_cleanup_crypto(child);
+			entry_cleanup_session(child);
+		} else {
+			entry_destroy(child);
+		}
+
+		child = NULL;
+	}
+
+	/* Setup the response as the payload to be encrypted */
+	entry_unset_payload(entry);
+	entry->payload = res;
+	entry->psize = res_offset;
+
+	/* All good */
+	return 0;
+
+_batch_failure:
+	mm_free(res);
+
+	if (child) {
+		if (entry_has_flag(child, USCHED_ENTRY_FLAG_NEW)) {
+			entry_unset_payload(child);
+		} else {
+			entry_destroy(child);
+		}
+	}
+
+	errno = errsv;
+
+	return -1;
+}
+
+static void _process_op_batch_revert(uid_t uid, const uint64_t *created, uint32_t created_nmemb) {
+	uint32_t i = 0;
+
+	/* The client won't be aware of the created entries, so they must not remain scheduled */
+	for (i = 0; i < created_nmemb; i ++) {
+		if (schedule_entry_ownership_delete_by_id(created[i], uid) < 0)
+			log_warn("_process_op_batch_revert(): schedule_entry_ownership_delete_by_id(): %s\n", strerror(errno));
+	}
+}
+
+static int _process_recv_update_op_batch(struct async_op *aop, struct usched_entry *entry) {
+	int errsv = 0;
+	uint64_t *created = NULL;
+	uint32_t created_nmemb = 0;
+
+	if (_process_op_batch(entry, &created, &created_nmemb) < 0) {
+		errsv = errno;
+		log_warn("_process_recv_update_op_batch(): _process_op_batch(): %s\n", strerror(errno));
+		_process_op_batch_revert(entry->uid, created, created_nmemb);
+		mm_free(created);
+		errno = errsv;
+		return -1;
+	}
+
+	/* Reply all the operation results to the client in a single response */
+	if (_process_recv_update_reply(aop, entry) < 0) {
+		errsv = errno;
+		log_warn("_process_recv_update_op_batch(): _process_recv_update_reply(): %s\n", strerror(errno));
+		_process_op_batch_revert(entry->uid, created, created_nmemb);
+		mm_free(created);
+		errno = errsv;
+		return -1;
+	}
+
+	debug_printf(DEBUG_INFO, "Delivering batch results (%u entries created).\n", created_nmemb);
+
+	mm_free(created);
+
+	return 0;
+}
+
+static int _process_id_compare(const void *id1, const void *id2) {
+	const uint64_t *pid1 = id1, *pid2 = id2;
+
+	return (*pid1 > *pid2) - (*pid1 < *pid2);
+}
+
+static int _process_recv_update_op_subscribe(struct async_op *aop, struct usched_entry *entry) {
+	int errsv = 0;
+	uint64_t *ids = NULL;
+	size_t i = 0, n = 0, ids_nmemb = 0;
+
+	/* Check if the payload size is aligned with the entry->id size */
+	if ((entry->psize % sizeof(entry->id)) || !(ids_nmemb = entry->psize / sizeof(entry->id)) || (ids_nmemb > CONFIG_USCHED_SUBSCRIBE_IDS_MAX)) {
+		log_warn("_process_recv_update_op_subscribe(): Invalid entry list (psize: %u).\n", entry->psize);
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* The entry list is handed over to the subscription */
+	ids = (uint64_t *) entry->payload;
+
+	entry->payload = NULL;
+	entry->psize = 0;
+
+	/* Revert network to host byte order */
+	for (i = 0; i < ids_nmemb; i ++)
+		ids[i] = ntohll(ids[i]);
+
+	/* USCHED_SUBJ_ALL subscribes all the entries that match the entry's uid */
+	if ((ids_nmemb == 1) && (ids[0] == USCHED_SUBJ_ALL)) {
+		mm_free(ids);
+		ids = NULL;
+		ids_nmemb = 0;
+	} else {
+		/* Published IDs are looked up with a binary search */
+		qsort(ids, ids_nmemb, sizeof(uint64_t), &_process_id_compare);
+
+		/* Each ID is subscribed once */
+		for (i = 1, n = 1; i < ids_nmemb; i ++) {
+			if (ids[i] != ids[n - 1])
+				ids[n ++] = ids[i];
+		}
+
+		ids_nmemb = n;
+	}
+
+	/* Reply the number of subscribed entries to the client */
+	if (!(entry->payload = mm_alloc(4))) {
+		errsv = errno;
+		log_warn("_process_recv_update_op_subscribe(): mm_alloc(): %s\n", strerror(errno));
+		goto _subscribe_failure;
+	}
+
+	memcpy(entry->payload, (uint32_t [1]) { htonl((uint32_t) ids_nmemb) }, 4);
+	entry->psize = 4;
+
+	if (_process_recv_update_reply(aop, entry) < 0) {
+		errsv = errno;
+		log_warn("_process_recv_update_op_subscribe(): _process_recv_update_reply(): %s\n", strerror(errno));
+		goto _subscribe_failure;
+	}
+
+	/* Session authentication data is no longer required */
+	entry_cleanup_session(entry);
+
+	/* From now on, the entry belongs to the subscription */
+	if (subscribe_daemon_register(aop->fd, entry, ids, ids_nmemb) < 0) {
+		errsv = errno;
+		log_warn("_process_recv_update_op_subscribe(): subscribe_daemon_register(): %s\n", strerror(errno));
+		goto _subscribe_failure;
+	}
+
+	return 0;
+
+_subscribe_failure:
+	if (ids)
+		mm_free(ids);
+
+	errno = errsv;
+
+	return -1;
+}
+
+int process_daemon_recv_prepare(struct async_op *aop) {
+	int errsv = 0;
+
+	/* Receive one entry header */
+	aop->count = usched_entry_hdr_size();
+
+	/* The header is received straight into an entry sized buffer, which will be adopted as
+	 * the entry itself by process_daemon_recv_create(). Only the received bytes are used, so
+	 * there's no need to reset it.
+	 */
+	if (!(aop->data = mm_alloc(sizeof(struct usched_entry)))) {
+		errsv = errno;
+		log_warn("process_daemon_recv_prepare(): aop->data = mm_alloc(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+int process_daemon_recv_admit(struct async_op *aop) {
+	int errsv = 0;
+	int cur_fd = aop->fd;
+	usched_entry_reject_t reason = USCHED_ENTRY_REJECT_NONE;
+
+	/* Apply rate limits and quotas before any allocation or cryptographic work */
+	if (!admit_daemon_request(aop))
+		return 0;
+
+	if (errno == EBUSY) {
+		reason = USCHED_ENTRY_REJECT_RATE;
+	} else if (errno == EDQUOT) {
+		reason = USCHED_ENTRY_REJECT_QUOTA;
+	} else {
+		errsv = errno;
+		log_warn("process_daemon_recv_admit(): admit_daemon_request(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Reuse 'aop' to reply the rejection reason in place of the session */
+	pool_daemon_conn_buf_release(cur_fd, (void *) aop->data);
+
+	memset(aop, 0, sizeof(struct async_op));
+
+	aop->fd = cur_fd;
+	aop->count = CONFIG_USCHED_AUTH_SESSION_MAX;
+	aop->priority = 0;
+	aop->timeout.tv_sec = rund.config.network.conn_timeout;
+
+	if (!(aop->data = pool_daemon_conn_buf(aop->fd, aop->count))) {
+		errsv = errno;
+		log_warn("process_daemon_recv_admit(): pool_daemon_conn_buf(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	entry_reject_set((unsigned char *) aop->data, reason);
+
+	/* The connection is closed once the reply is written */
+	pool_daemon_conn_reject(aop->fd);
+
+	return 1;
+}
+
+struct usched_entry *process_daemon_recv_create(struct async_op *aop) {
+	int errsv = 0;
+	struct usched_entry *entry = NULL;
+
+	/* The entry header was received straight into an entry sized buffer (see
+	 * process_daemon_recv_prepare()). Adopt it as the entry and reset the fields that
+	 * weren't received.
+	 */
+	entry = (struct usched_entry *) aop->data;
+	aop->data = NULL;
+
+	memset((char *) entry + aop->count, 0, sizeof(struct usched_entry) - aop->count);
+
+	/* Setup received entry */
+	entry_set_id(entry, (uint64_t) aop->fd);
+	entry_set_flags(entry, ntohl(entry->flags));
+	entry_set_uid(entry, ntohl(entry->uid)); /* Untrusted. Will be used for comparison only */
+	entry_set_gid(entry, ntohl(entry->gid)); /* Untrusted. Will be used for comparison only */
+	entry_set_trigger(entry, ntohl(entry->trigger));
+	entry_set_step(entry, ntohl(entry->step));
+	entry_set_expire(entry, ntohl(entry->expire));
+	entry->version = ntohl(entry->version);
+	entry_set_overlap(entry, ntohl(entry->overlap));
+	entry_set_concurrency(entry, ntohl(entry->concurrency));
+	entry_set_priority(entry, ntohl(entry->priority));
+	/* NOTE: pid, status, exec_time, latency, outdata_len and outdata are ignored here */
+	entry_set_psize(entry, ntohl(entry->psize));
+
+	/* Set the last byte of username field to 0, so it will always be NULL terminated */
+	entry->username[sizeof(entry->username) - 1] = 0;
+
+	/* The header layout is only known for the current version */
+	if (entry->version != CONFIG_USCHED_ENTRY_HDR_VERSION) {
+		log_warn("process_daemon_recv_create(): Unsupported entry header version: %u\n", entry->version);
+		entry_destroy(entry);
+		errno = EPROTO;
+		return NULL;
+	}
+
+	/* Clear all local flags that the client have possibly set */
+	entry_unset_flags_local(entry);
+
+	/* Validate if this entry has at least one valid operation flag */
+	if (!entry_has_flag(entry, USCHED_ENTRY_FLAG_NEW) && !entry_has_flag(entry, USCHED_ENTRY_FLAG_DEL) && !entry_has_flag(entry, USCHED_ENTRY_FLAG_GET) && !entry_has_flag(entry, USCHED_ENTRY_FLAG_BATCH) && !entry_has_flag(entry, USCHED_ENTRY_FLAG_SUBSCRIBE)) {
+		log_warn("process_daemon_recv_create(): The requested operation is invalid.\n");
+		entry_destroy(entry);
+		errno = EINVAL;
+		return NULL;
+	}
+
+	/* A batch request carries its operations in the payload and can't be an operation itself */
+	if (entry_has_flag(entry, USCHED_ENTRY_FLAG_BATCH) && (entry_has_flag(entry, USCHED_ENTRY_FLAG_NEW) || entry_has_flag(entry, USCHED_ENTRY_FLAG_DEL) || entry_has_flag(entry, USCHED_ENTRY_FLAG_GET))) {
+		log_warn("process_daemon_recv_create(): Batch requests can't set operation flags.\n");
+		entry_destroy(entry);
+		errno = EINVAL;
+		return NULL;
+	}
+
+	/* A subscription can't be carried by, or combined with, any other operation */
+	if (entry_has_flag(entry, USCHED_ENTRY_FLAG_SUBSCRIBE) && (entry_has_flag(entry, USCHED_ENTRY_FLAG_NEW) || entry_has_flag(entry, USCHED_ENTRY_FLAG_DEL) || entry_has_flag(entry, USCHED_ENTRY_FLAG_GET) || entry_has_flag(entry, USCHED_ENTRY_FLAG_BATCH))) {
+		log_warn("process_daemon_recv_create(): Subscription requests can't set other operation flags.\n");
+		entry_destroy(entry);
+		errno = EINVAL;
+		return NULL;
+	}
+
+	/* Only GET requests can be projected */
+	if (entry_has_flag(entry, USCHED_ENTRY_FLAG_PROJECT) && !entry_has_flag(entry, USCHED_ENTRY_FLAG_GET)) {
+		log_warn("process_daemon_recv_create(): Only GET requests can be projected.\n");
+		entry_destroy(entry);
+		errno = EINVAL;
+		return NULL;
+	}
+
+	/* Session tickets are only issued to remote clients */
+	if (entry_has_flag(entry, USCHED_ENTRY_FLAG_RESUME) && (conn_is_remote(aop->fd) != 1)) {
+		log_warn("process_daemon_recv_create(): Session resumption is only available for remote connections.\n");
+		entry_destroy(entry);
+		errno = EINVAL;
+		return NULL;
+	}
+
+	/* Validate execution overlap policy, concurrency limit and priority class */
+	if ((entry->overlap > USCHED_ENTRY_OVERLAP_KILL) || (entry->concurrency > CONFIG_USCHED_EXEC_CONCURRENCY_MAX) || (entry->priority > USCHED_ENTRY_PRIORITY_LOW)) {
+		log_warn("process_daemon_recv_create(): Invalid overlap policy (%u), concurrency limit (%u) or priority class (%u).\n", entry->overlap, entry->concurrency, entry->priority);
+		entry_destroy(entry);
+		errno = EINVAL;
+		return NULL;
+	}
+
+	/* Validate payload size */
+	if (!entry->psize) {
+		/* All entry requests expect a payload. If none is set, this entry request is invalid. */
+		log_warn("process_daemon_recv_create(): entry->psize == 0.\n");
+		entry_destroy(entry);
+		errno = EINVAL;
+		return NULL;
+	}
+
+	/* If this is a new entry request, grant that subject fits in the mqueue message size */
+	if (entry_has_flag(entry, USCHED_ENTRY_FLAG_NEW) && ((entry->psize + sizeof(struct ipc_use_hdr) + 1) > (size_t) rund.config.ipc.msg_size)) {
+		log_warn("process_daemon_recv_create(): (entry->psize + sizeof(struct ipc_use_hdr) + 1) > rund.config.ipc.msg_size. This means that the subject is too long to be processed on this system.\n");
+		entry_destroy(entry);
+		errno = EINVAL;
+		return NULL;
+	}
+
+	debug_printf(DEBUG_INFO, "psize: %u\n", entry->psize);
+	debug_printf(DEBUG_INFO, "username: %s\n", entry->username);
+
+	/* Set this entry state as in progress */
+	entry_set_flag(entry, USCHED_ENTRY_FLAG_PROGRESS);
+
+	/*
+	 * If this is a remote connection:
+	 *
+	 *  - Send a ciphered session token in the session field which the encryption key is the
+	 * hash of the user password in the users configuration structure. Append the user hash salt
+	 * and encryption nonce value to the head of the ciphered result. All these steps are
+	 * accomplished by entry_daemon_remote_session_create() function.
+	 *
+	 *
+	 * If this is a local connection:
+	 *
+	 *  - Set the session field to all zeros.
+	 *
+	 */
+	if (conn_is_remote(aop->fd)) {
+		if (entry_daemon_remote_session_create(entry) < 0) {
+			errsv = errno;
+			log_warn("process_daemon_recv_create(): entry_daemon_remote_session_create(): %s\n", strerror(errno));
+			entry_destroy(entry);
+			errno = errsv;
+			return NULL;
 		}
 	} else if (conn_is_local(aop->fd)) {
 		memset(entry->session, 0, sizeof(entry->session));
@@ -604,9 +1303,12 @@ struct usched_entry *process_daemon_recv_create(struct async_op *aop) {
 	aop->priority = 0;
 	aop->timeout.tv_sec = rund.config.network.conn_timeout;
 
-	if (!(aop->data = mm_alloc(aop->count))) {
+	/* The session is sent from the connection receive buffer, which will be reused to
+	 * receive the entry command.
+	 */
+	if (!(aop->data = pool_daemon_conn_buf(aop->fd, aop->count))) {
 		errsv = errno;
-		log_warn("process_daemon_recv_create(): aop->data = mm_alloc(): %s\n", strerror(errno));
+		log_warn("process_daemon_recv_create(): pool_daemon_conn_buf(): %s\n", strerror(errno));
 		entry_destroy(entry);
 		errno = errsv;
 		return NULL;
@@ -683,25 +1385,22 @@ int process_daemon_recv_update(struct async_op *aop, struct usched_entry *entry)
 	}
 
 	/* Set the received entry payload which is sizeof(entry->session) offset bytes from
-	 * aop->data base pointer
+	 * aop->data base pointer. Remote payloads are decrypted straight from the receive buffer.
 	 */
-	if (entry_set_payload(entry, (char *) aop->data + sizeof(entry->session), entry->psize) < 0) {
-		errsv = errno;
-		log_warn("process_daemon_recv_update(): entry_set_payload(): %s\n", strerror(errno));
-		entry_destroy(entry);
-		errno = errsv;
-		return -1;
-	}
-
-	/* Decrypt payload if this is a remote connection */
 	if (conn_is_remote(aop->fd)) {
-		if (entry_payload_decrypt(entry) < 0) {
+		if (entry_set_payload_decrypt(entry, (char *) aop->data + sizeof(entry->session), entry->psize) < 0) {
 			errsv = errno;
-			log_warn("process_daemon_recv_update(): entry_payload_decrypt(): %s\n", strerror(errno));
+			log_warn("process_daemon_recv_update(): entry_set_payload_decrypt(): %s\n", strerror(errno));
 			entry_destroy(entry);
 			errno = errsv;
 			return -1;
 		}
+	} else if (entry_set_payload(entry, (char *) aop->data + sizeof(entry->session), entry->psize) < 0) {
+		errsv = errno;
+		log_warn("process_daemon_recv_update(): entry_set_payload(): %s\n", strerror(errno));
+		entry_destroy(entry);
+		errno = errsv;
+		return -1;
 	}
 
 	/* Process specific operation types */
@@ -727,6 +1426,22 @@ int process_daemon_recv_update(struct async_op *aop, struct usched_entry *entry)
 			errsv = errno;
 			log_warn("process_daemon_recv_update(): _process_recv_update_op_get(): %s\n", strerror(errno));
 
+			entry_destroy(entry);
+			errno = errsv;
+			return -1;
+		}
+	} else if (entry_has_flag(entry, USCHED_ENTRY_FLAG_BATCH)) {
+		if (_process_recv_update_op_batch(aop, entry) < 0) {
+			errsv = errno;
+			log_warn("process_daemon_recv_update(): _process_recv_update_op_batch(): %s\n", strerror(errno));
+			entry_destroy(entry);
+			errno = errsv;
+			return -1;
+		}
+	} else if (entry_has_flag(entry, USCHED_ENTRY_FLAG_SUBSCRIBE)) {
+		if (_process_recv_update_op_subscribe(aop, entry) < 0) {
+			errsv = errno;
+			log_warn("process_daemon_recv_update(): _process_recv_update_op_subscribe(): %s\n", strerror(errno));
 			entry_destroy(entry);
 			errno = errsv;
 			return -1;
@@ -741,3 +1456,34 @@ int process_daemon_recv_update(struct async_op *aop, struct usched_entry *entry)
 	return 0;
 }
 
+int process_daemon_send_reply(struct async_op *aop, struct usched_entry *entry) {
+	return _process_recv_update_reply(aop, entry);
+}
+
+int process_daemon_send_pending(const struct usched_entry *entry) {
+	/* Only projected GET requests have responses sent across several writes */
+	if (!entry_has_flag(entry, USCHED_ENTRY_FLAG_GET) || !entry_has_flag(entry, USCHED_ENTRY_FLAG_PROJECT))
+		return 0;
+
+	return entry->reserved.stream.cursor < (entry->psize / sizeof(uint64_t));
+}
+
+int process_daemon_send_update(struct async_op *aop, struct usched_entry *entry) {
+	int errsv = 0;
+
+	if (!process_daemon_send_pending(entry)) {
+		log_warn("process_daemon_send_update(): No pending data to be sent.\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (_process_send_update_stream(aop, entry) < 0) {
+		errsv = errno;
+		log_warn("process_daemon_send_update(): _process_send_update_stream(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
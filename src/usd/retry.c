@@ -0,0 +1,562 @@
+/**
+ * @file retry.c
+ * @brief uSched
+ *        Deferred execution retry interface - Daemon
+ *
+ * Date: 18-10-2026
+ *
+ * Copyright 2014-2015 Pedro A. Hortas (pah@ucodev.org)
+ *
+ * This file is part of usched.
+ *
+ * usched is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * usched is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with usched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <pall/fifo.h>
+
+#include "config.h"
+#include "runtime.h"
+#include "mm.h"
+#include "log.h"
+#include "ipc.h"
+#include "retry.h"
+#include "credit.h"
+
+/* The deferred execution currently being redelivered (already popped from the queue) */
+static struct usched_retry_msg *_retry_cur = NULL;
+
+static void _retry_daemon_msg_destroy(void *data) {
+	mm_free(data);
+}
+
+static size_t _retry_daemon_pending(void) {
+	return (_retry_cur ? 1 : 0) + rund.qpool->count(rund.qpool) + rund.spill_count;
+}
+
+static void _retry_daemon_drop(const char *msg, const char *reason) {
+	const struct ipc_use_hdr *hdr = (const struct ipc_use_hdr *) msg;
+
+	rund.retry_dropped ++;
+
+	log_crit("_retry_daemon_drop(): The Entry ID 0x%016llX was NOT executed at timestamp %u: %s (Deferred: %llu, Delivered: %llu, Dropped: %llu).\n", hdr->id, hdr->trigger, reason, rund.retry_deferred, rund.retry_delivered, rund.retry_dropped);
+}
+
+static void _retry_daemon_wait(unsigned int msec) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+
+	ts.tv_sec += msec / 1000;
+	ts.tv_nsec += (msec % 1000) * 1000000;
+
+	if (ts.tv_nsec >= 1000000000) {
+		ts.tv_sec ++;
+		ts.tv_nsec -= 1000000000;
+	}
+
+	pthread_cond_timedwait(&rund.cond_qpool, &rund.mutex_qpool, &ts);
+}
+
+static int _retry_daemon_spill_write(time_t deferred, const char *msg, size_t len) {
+	int errsv = 0;
+	off_t end = 0;
+	struct usched_retry_spill_hdr shdr;
+
+	memset(&shdr, 0, sizeof(struct usched_retry_spill_hdr));
+
+	shdr.deferred = (uint64_t) deferred;
+	shdr.len = (uint32_t) len;
+
+	/* Records are always appended */
+	if ((end = lseek(rund.spill_fd, 0, SEEK_END)) == (off_t) -1) {
+		errsv = errno;
+		log_warn("_retry_daemon_spill_write(): lseek(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if ((write(rund.spill_fd, &shdr, sizeof(struct usched_retry_spill_hdr)) != (ssize_t) sizeof(struct usched_retry_spill_hdr)) || (write(rund.spill_fd, msg, len) != (ssize_t) len)) {
+		errsv = errno;
+		log_warn("_retry_daemon_spill_write(): write(): %s\n", strerror(errno));
+
+		/* Discard any partially written record */
+		if (ftruncate(rund.spill_fd, end) < 0)
+			log_warn("_retry_daemon_spill_write(): ftruncate(): %s\n", strerror(errno));
+
+		errno = errsv;
+		return -1;
+	}
+
+	rund.spill_count ++;
+
+	/* All good */
+	return 0;
+}
+
+static struct usched_retry_msg *_retry_daemon_spill_read(off_t *offset) {
+	int errsv = 0;
+	struct usched_retry_spill_hdr shdr;
+	struct usched_retry_msg *r = NULL;
+
+	if (pread(rund.spill_fd, &shdr, sizeof(struct usched_retry_spill_hdr), *offset) != (ssize_t) sizeof(struct usched_retry_spill_hdr)) {
+		errno = EIO;
+		return NULL;
+	}
+
+	/* Validate record length */
+	if ((shdr.len < sizeof(struct ipc_use_hdr)) || (shdr.len >= (uint32_t) rund.config.ipc.msg_size)) {
+		errno = EINVAL;
+		return NULL;
+	}
+
+	if (!(r = mm_alloc(sizeof(struct usched_retry_msg) + shdr.len))) {
+		errsv = errno;
+		log_warn("_retry_daemon_spill_read(): mm_alloc(): %s\n", strerror(errno));
+		errno = errsv;
+		return NULL;
+	}
+
+	r->deferred = (time_t) shdr.deferred;
+	r->len = shdr.len;
+
+	if (pread(rund.spill_fd, r->msg, r->len, *offset + sizeof(struct usched_retry_spill_hdr)) != (ssize_t) r->len) {
+		mm_free(r);
+		errno = EIO;
+		return NULL;
+	}
+
+	/* Records are redelivered as stored, so each one must be a complete frame */
+	if (IPC_USE_FRAME_LEN((struct ipc_use_hdr *) r->msg) != r->len) {
+		mm_free(r);
+		errno = EINVAL;
+		return NULL;
+	}
+
+	*offset += sizeof(struct usched_retry_spill_hdr) + r->len;
+
+	return r;
+}
+
+static void _retry_daemon_spill_reset(void) {
+	if (ftruncate(rund.spill_fd, 0) < 0)
+		log_warn("_retry_daemon_spill_reset(): ftruncate(): %s\n", strerror(errno));
+
+	rund.spill_off = 0;
+	rund.spill_count = 0;
+}
+
+static void _retry_daemon_spill_load(void) {
+	struct usched_retry_msg *r = NULL;
+
+	/* Move spilled records back to the memory queue, in order, as capacity allows */
+	while (rund.spill_count && (rund.qpool->count(rund.qpool) < rund.config.exec.retry_depth)) {
+		if (!(r = _retry_daemon_spill_read(&rund.spill_off))) {
+			if (errno == ENOMEM)
+				return;
+
+			log_warn("_retry_daemon_spill_load(): Spill file is corrupted. Discarding %zu spilled executions.\n", rund.spill_count);
+
+			rund.retry_dropped += rund.spill_count;
+
+			_retry_daemon_spill_reset();
+
+			return;
+		}
+
+		if (rund.qpool->push(rund.qpool, r) < 0) {
+			log_warn("_retry_daemon_spill_load(): rund.qpool->push(): %s\n", strerror(errno));
+			_retry_daemon_drop(r->msg, "unable to queue spilled execution");
+			mm_free(r);
+		}
+
+		rund.spill_count --;
+	}
+
+	/* Reclaim spill file space once fully consumed */
+	if (!rund.spill_count)
+		_retry_daemon_spill_reset();
+}
+
+static int _retry_daemon_spill_scan(void) {
+	off_t offset = 0;
+	struct usched_retry_msg *r = NULL;
+
+	rund.spill_off = 0;
+	rund.spill_count = 0;
+
+	/* Count the records left by a previous run, discarding any trailing garbage */
+	for (;;) {
+		if (!(r = _retry_daemon_spill_read(&offset))) {
+			if (errno == ENOMEM)
+				return -1;
+
+			break;
+		}
+
+		mm_free(r);
+
+		rund.spill_count ++;
+	}
+
+	if (ftruncate(rund.spill_fd, offset) < 0)
+		log_warn("_retry_daemon_spill_scan(): ftruncate(): %s\n", strerror(errno));
+
+	if (rund.spill_count)
+		log_info("_retry_daemon_spill_scan(): Found %zu spilled executions pending redelivery.\n", rund.spill_count);
+
+	/* All good */
+	return 0;
+}
+
+static void _retry_daemon_spill_flush(void) {
+	off_t end = 0;
+	size_t tail_len = 0, tail_count = rund.spill_count;
+	char *tail = NULL;
+	struct usched_retry_msg *r = NULL;
+
+	/* Nothing held in memory */
+	if (!_retry_cur && !rund.qpool->count(rund.qpool))
+		return;
+
+	/* Deferred executions held in memory precede the ones in the spill file, so the unread
+	 * records must be preserved and written after them.
+	 */
+	if ((end = lseek(rund.spill_fd, 0, SEEK_END)) == (off_t) -1) {
+		log_warn("_retry_daemon_spill_flush(): lseek(): %s\n", strerror(errno));
+		return;
+	}
+
+	if ((tail_len = (size_t) (end - rund.spill_off))) {
+		if (!(tail = mm_alloc(tail_len))) {
+			log_warn("_retry_daemon_spill_flush(): mm_alloc(): %s\n", strerror(errno));
+			return;
+		}
+
+		if (pread(rund.spill_fd, tail, tail_len, rund.spill_off) != (ssize_t) tail_len) {
+			log_warn("_retry_daemon_spill_flush(): pread(): %s\n", strerror(errno));
+			mm_free(tail);
+			return;
+		}
+	}
+
+	_retry_daemon_spill_reset();
+
+	if (_retry_cur) {
+		if (_retry_daemon_spill_write(_retry_cur->deferred, _retry_cur->msg, _retry_cur->len) < 0)
+			_retry_daemon_drop(_retry_cur->msg, "unable to spill execution");
+
+		mm_free(_retry_cur);
+		_retry_cur = NULL;
+	}
+
+	while ((r = rund.qpool->pop(rund.qpool))) {
+		if (_retry_daemon_spill_write(r->deferred, r->msg, r->len) < 0)
+			_retry_daemon_drop(r->msg, "unable to spill execution");
+
+		mm_free(r);
+	}
+
+	if (tail) {
+		if (write(rund.spill_fd, tail, tail_len) != (ssize_t) tail_len) {
+			log_warn("_retry_daemon_spill_flush(): write(): %s\n", strerror(errno));
+			rund.retry_dropped += tail_count;
+		} else {
+			rund.spill_count += tail_count;
+		}
+
+		mm_free(tail);
+	}
+
+	log_info("_retry_daemon_spill_flush(): %zu deferred executions were spilled for redelivery.\n", rund.spill_count);
+}
+
+static void *_retry_daemon_worker(void *arg) {
+	struct ipc_use_hdr *hdr = NULL;
+
+	arg = NULL; /* Unused */
+
+	pthread_mutex_lock(&rund.mutex_qpool);
+
+	while (!runtime_daemon_terminated()) {
+		/* Fetch the next deferred execution, refilling the memory queue from the spill file
+		 * when required.
+		 */
+		if (!_retry_cur) {
+			if (!rund.qpool->count(rund.qpool) && rund.spill_count)
+				_retry_daemon_spill_load();
+
+			_retry_cur = rund.qpool->pop(rund.qpool);
+		}
+
+		/* Nothing to redeliver. Wait for new deferrals. */
+		if (!_retry_cur) {
+			pthread_cond_wait(&rund.cond_qpool, &rund.mutex_qpool);
+			continue;
+		}
+
+		hdr = (struct ipc_use_hdr *) _retry_cur->msg;
+
+		/* Discard executions that were deferred for too long */
+		if ((time(NULL) - _retry_cur->deferred) >= (time_t) rund.config.exec.retry_delay) {
+			_retry_daemon_drop(_retry_cur->msg, "maximum retry delay exceeded");
+			mm_free(_retry_cur);
+			_retry_cur = NULL;
+			continue;
+		}
+
+		/* Wait for the executer to advertise free capacity */
+		if (credit_daemon_acquire() < 0) {
+			_retry_daemon_wait(CONFIG_USCHED_EXEC_RETRY_INTERVAL);
+
+			continue;
+		}
+
+		/* Try to redeliver the message to uSched executer (use). Deferred messages keep their
+		 * exact frame length, so they are sent as stored.
+		 */
+		if (ipc_send_nowait(rund.pipcd, IPC_USD_ID, IPC_USE_ID, _retry_cur->msg, _retry_cur->len) < 0) {
+			credit_daemon_restore();
+
+			if (errno != EAGAIN) {
+				log_warn("_retry_daemon_worker(): ipc_send_nowait(): %s\n", strerror(errno));
+
+				/* Any of the following errno are a fatal condition and this module needs
+				 * to be restarted by its monitor.
+				 */
+				if (errno == EACCES || errno == EFAULT || errno == EINVAL || errno == EIDRM || errno == ENOMEM)
+					runtime_daemon_fatal();
+			}
+
+			/* Executer queue is still full. Wait for it to regain capacity. */
+			_retry_daemon_wait(CONFIG_USCHED_EXEC_RETRY_INTERVAL);
+
+			continue;
+		}
+
+		rund.retry_delivered ++;
+
+		log_info("_retry_daemon_worker(): Entry ID 0x%016llX was delivered after being deferred for %ld seconds.\n", hdr->id, (long) (time(NULL) - _retry_cur->deferred));
+
+		mm_free(_retry_cur);
+		_retry_cur = NULL;
+	}
+
+	pthread_mutex_unlock(&rund.mutex_qpool);
+
+	pthread_exit(NULL);
+
+	return NULL;
+}
+
+int retry_daemon_defer(const char *msg, size_t len) {
+	int errsv = 0;
+	struct usched_retry_msg *r = NULL;
+
+	/* Check if deferral is enabled */
+	if (!rund.config.exec.retry_depth) {
+		errno = ENOSYS;
+		return -1;
+	}
+
+	pthread_mutex_lock(&rund.mutex_qpool);
+
+	/* Keep delivery order: once executions are spilled, new ones must be spilled too */
+	if (!rund.spill_count && ((rund.qpool->count(rund.qpool) + (_retry_cur ? 1 : 0)) < rund.config.exec.retry_depth)) {
+		if (!(r = mm_alloc(sizeof(struct usched_retry_msg) + len))) {
+			errsv = errno;
+			log_warn("retry_daemon_defer(): mm_alloc(): %s\n", strerror(errno));
+			goto _drop;
+		}
+
+		r->deferred = time(NULL);
+		r->len = len;
+
+		memcpy(r->msg, msg, len);
+
+		if (rund.qpool->push(rund.qpool, r) < 0) {
+			errsv = errno;
+			log_warn("retry_daemon_defer(): rund.qpool->push(): %s\n", strerror(errno));
+			mm_free(r);
+			goto _drop;
+		}
+	} else if (rund.spill_fd >= 0) {
+		if (_retry_daemon_spill_write(time(NULL), msg, len) < 0) {
+			errsv = errno;
+			goto _drop;
+		}
+	} else {
+		errsv = ENOSPC;
+		goto _drop;
+	}
+
+	rund.retry_deferred ++;
+
+	/* Wake up the redelivery worker */
+	pthread_cond_signal(&rund.cond_qpool);
+
+	pthread_mutex_unlock(&rund.mutex_qpool);
+
+	/* All good */
+	return 0;
+
+_drop:
+	rund.retry_dropped ++;
+
+	pthread_mutex_unlock(&rund.mutex_qpool);
+
+	errno = errsv;
+
+	return -1;
+}
+
+void retry_daemon_wake(void) {
+	pthread_mutex_lock(&rund.mutex_qpool);
+	pthread_cond_signal(&rund.cond_qpool);
+	pthread_mutex_unlock(&rund.mutex_qpool);
+}
+
+size_t retry_daemon_pending(void) {
+	size_t count = 0;
+
+	if (!rund.config.exec.retry_depth)
+		return 0;
+
+	pthread_mutex_lock(&rund.mutex_qpool);
+	count = _retry_daemon_pending();
+	pthread_mutex_unlock(&rund.mutex_qpool);
+
+	return count;
+}
+
+int retry_daemon_init(void) {
+	int errsv = 0;
+
+	rund.spill_fd = -1;
+	rund.spill_off = 0;
+	rund.spill_count = 0;
+
+	rund.retry_deferred = 0;
+	rund.retry_delivered = 0;
+	rund.retry_dropped = 0;
+
+	/* Check if deferral is enabled */
+	if (!rund.config.exec.retry_depth)
+		return 0;
+
+	/* Initialize deferred executions pool */
+	if (!(rund.qpool = pall_fifo_init(&_retry_daemon_msg_destroy, NULL, NULL))) {
+		errsv = errno;
+		log_warn("retry_daemon_init(): rund.qpool = pall_fifo_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Open the spill file, if configured */
+	if (rund.config.exec.spill_use) {
+		if ((rund.spill_fd = open(rund.config.exec.spill_file, O_CREAT | O_RDWR, S_IRUSR | S_IWUSR)) < 0) {
+			errsv = errno;
+			log_warn("retry_daemon_init(): open(\"%s\", ...): %s\n", rund.config.exec.spill_file, strerror(errno));
+			goto _init_failure;
+		}
+
+		/* Test lock on spill file */
+		if (lockf(rund.spill_fd, F_TLOCK, 0) < 0) {
+			errsv = errno;
+			log_warn("retry_daemon_init(): lockf(): Spill file is locked by another process.\n");
+			goto _init_failure;
+		}
+
+		/* Account for any records spilled by a previous run */
+		if (_retry_daemon_spill_scan() < 0) {
+			errsv = errno;
+			log_warn("retry_daemon_init(): _retry_daemon_spill_scan(): %s\n", strerror(errno));
+			goto _init_failure;
+		}
+	}
+
+	/* Initialize redelivery worker */
+	if ((errno = pthread_create(&rund.t_retry, NULL, &_retry_daemon_worker, NULL))) {
+		errsv = errno;
+		log_warn("retry_daemon_init(): pthread_create(): %s\n", strerror(errno));
+		goto _init_failure;
+	}
+
+	/* All good */
+	return 0;
+
+_init_failure:
+	if (rund.spill_fd >= 0) {
+		close(rund.spill_fd);
+		rund.spill_fd = -1;
+	}
+
+	pall_fifo_destroy(rund.qpool);
+	rund.qpool = NULL;
+
+	errno = errsv;
+
+	return -1;
+}
+
+void retry_daemon_destroy(void) {
+	if (!rund.qpool)
+		return;
+
+	/* Wake up the redelivery worker so it can acknowledge the runtime termination */
+	pthread_mutex_lock(&rund.mutex_qpool);
+	pthread_cond_signal(&rund.cond_qpool);
+	pthread_mutex_unlock(&rund.mutex_qpool);
+
+	pthread_join(rund.t_retry, NULL);
+
+	pthread_mutex_lock(&rund.mutex_qpool);
+
+	/* Preserve pending deferred executions on the spill file, if configured */
+	if (rund.spill_fd >= 0) {
+		_retry_daemon_spill_flush();
+
+		close(rund.spill_fd);
+		rund.spill_fd = -1;
+	} else if (_retry_daemon_pending()) {
+		log_crit("retry_daemon_destroy(): %zu deferred executions were discarded.\n", _retry_daemon_pending());
+
+		rund.retry_dropped += _retry_daemon_pending();
+	}
+
+	if (_retry_cur) {
+		mm_free(_retry_cur);
+		_retry_cur = NULL;
+	}
+
+	pall_fifo_destroy(rund.qpool);
+	rund.qpool = NULL;
+
+	pthread_mutex_unlock(&rund.mutex_qpool);
+
+	log_info("retry_daemon_destroy(): Deferred executions: %llu, Delivered: %llu, Dropped: %llu.\n", rund.retry_deferred, rund.retry_delivered, rund.retry_dropped);
+}
+
@@ -50,6 +50,11 @@
 #include "gc.h"
 #include "delta.h"
 #include "stat.h"
+#include "retry.h"
+#include "credit.h"
+#include "admit.h"
+#include "auth.h"
+#include "subscribe.h"
 
 #if CONFIG_USCHED_JAIL == 1
 static int _runtime_daemon_jail(void) {
@@ -212,6 +217,42 @@ int runtime_daemon_init(int argc, char **argv) {
 
 	log_info("Pools initialized.\n");
 
+	/* Initialize admission control interface */
+	log_info("Initializing admission control interface...\n");
+
+	if (admit_daemon_init() < 0) {
+		errsv = errno;
+		log_crit("runtime_daemon_init(): admit_daemon_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	log_info("Admission control interface initialized.\n");
+
+	/* Initialize authentication interface */
+	log_info("Initializing authentication interface...\n");
+
+	if (auth_daemon_init() < 0) {
+		errsv = errno;
+		log_crit("runtime_daemon_init(): auth_daemon_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	log_info("Authentication interface initialized.\n");
+
+	/* Initialize execution results subscription interface */
+	log_info("Initializing execution results subscription interface...\n");
+
+	if (subscribe_daemon_init() < 0) {
+		errsv = errno;
+		log_crit("runtime_daemon_init(): subscribe_daemon_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	log_info("Execution results subscription interface initialized.\n");
+
 	/* Initialize status and statistics worker */
 	log_info("Initializing status and statistics worker...\n");
 
@@ -224,6 +265,30 @@ int runtime_daemon_init(int argc, char **argv) {
 
 	log_info("Status and statistics worker initialized.\n");
 
+	/* Initialize executer flow control interface */
+	log_info("Initializing executer flow control interface...\n");
+
+	if (credit_daemon_init() < 0) {
+		errsv = errno;
+		log_crit("runtime_daemon_init(): credit_daemon_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	log_info("Executer flow control interface initialized.\n");
+
+	/* Initialize deferred execution retry interface */
+	log_info("Initializing deferred execution retry interface...\n");
+
+	if (retry_daemon_init() < 0) {
+		errsv = errno;
+		log_crit("runtime_daemon_init(): retry_daemon_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	log_info("Deferred execution retry interface initialized.\n");
+
 	/* Initialize scheduling interface */
 	log_info("Initializing scheduling interface...\n");
 
@@ -391,8 +456,7 @@ void runtime_daemon_interrupt(void) {
 
 		pthread_mutex_unlock(&rund.mutex_interrupt);
 
-		pthread_cancel(rund.t_unix);
-		pthread_cancel(rund.t_remote);
+		conn_daemon_process_cancel();
 
 		return;
 	}
@@ -436,10 +500,25 @@ void runtime_daemon_destroy(void) {
 	schedule_daemon_destroy();
 	log_info("Scheduling interface destroyed.\n");
 
+	/* Destroy the executer flow control interface */
+	log_info("Destroying executer flow control interface...\n");
+	credit_daemon_destroy();
+	log_info("Executer flow control interface destroyed.\n");
+
+	/* Destroy the deferred execution retry interface */
+	log_info("Destroying deferred execution retry interface...\n");
+	retry_daemon_destroy();
+	log_info("Deferred execution retry interface destroyed.\n");
+
 	/* Destroy the status and statistics worker */
 	log_info("Destroying status and statistics worker...\n");
 	stat_daemon_destroy();
 	log_info("Status and statistics worker destroyed.\n");
+
+	/* Destroy the execution results subscription interface */
+	log_info("Destroying execution results subscription interface...\n");
+	subscribe_daemon_destroy();
+	log_info("Execution results subscription interface destroyed.\n");
 	
 #if CONFIG_USCHED_SERIALIZE_ON_REQ == 0
 	log_info("Serializing active pools...\n");
@@ -461,6 +540,16 @@ void runtime_daemon_destroy(void) {
 	pool_daemon_destroy();
 	log_info("Pools destroyed.\n");
 
+	/* Destroy admission control interface */
+	log_info("Destroying admission control interface...\n");
+	admit_daemon_destroy();
+	log_info("Admission control interface destroyed.\n");
+
+	/* Destroy authentication interface */
+	log_info("Destroying authentication interface...\n");
+	auth_daemon_destroy();
+	log_info("Authentication interface destroyed.\n");
+
 	/* Destroy thread components */
 	log_info("Destroying thread components...\n");
 	thread_daemon_components_destroy();
@@ -43,6 +43,10 @@
 #include "entry.h"
 #include "index.h"
 #include "schedule.h"
+#include "admit.h"
+#include "conn.h"
+#include "subscribe.h"
+#include "bitops.h"
 
 int schedule_daemon_init(void) {
 	int errsv = 0;
@@ -193,26 +197,172 @@ struct usched_entry *schedule_entry_get_copy(uint64_t entry_id) {
 	return entry_dest;
 }
 
+static size_t _schedule_entry_projection_size(const struct usched_entry *entry, uint32_t fields) {
+	unsigned int i = 0;
+	size_t len = sizeof(entry->id);
+
+	/* Fixed size fields (32 bits) */
+	for (i = USCHED_ENTRY_FIELD_FLAGS; i <= USCHED_ENTRY_FIELD_STATUS; i ++) {
+		if (bit_test(&fields, i))
+			len += sizeof(uint32_t);
+	}
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_EXEC_TIME))
+		len += sizeof(entry->exec_time);
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_LATENCY))
+		len += sizeof(entry->latency);
+
+	/* Variable size fields */
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_OUTDATA))
+		len += sizeof(uint32_t) + entry->outdata_len;
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_USERNAME))
+		len += sizeof(uint32_t) + strnlen(entry->username, sizeof(entry->username));
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_SUBJ))
+		len += sizeof(uint32_t) + entry->subj_size;
+
+	return len;
+}
+
+static size_t _schedule_entry_projection_put32(char *buf, uint32_t val) {
+	memcpy(buf, (uint32_t [1]) { htonl(val) }, sizeof(uint32_t));
+
+	return sizeof(uint32_t);
+}
+
+static size_t _schedule_entry_projection_put64(char *buf, uint64_t val) {
+	memcpy(buf, (uint64_t [1]) { htonll(val) }, sizeof(uint64_t));
+
+	return sizeof(uint64_t);
+}
+
+static size_t _schedule_entry_projection_putvar(char *buf, const char *data, uint32_t len) {
+	memcpy(buf, (uint32_t [1]) { htonl(len) }, sizeof(uint32_t));
+	memcpy(buf + sizeof(uint32_t), data, len);
+
+	return sizeof(uint32_t) + len;
+}
+
+int schedule_entry_get_projection(uint64_t entry_id, uid_t uid, uint32_t fields, char *buf, size_t *len) {
+	size_t offset = 0, rlen = 0;
+	struct usched_entry *entry = NULL;
+
+	/* Serialize the requested fields straight from the active pool, without copying the entry */
+	pthread_mutex_lock(&rund.mutex_apool);
+
+	if (!(entry = rund.apool->search(rund.apool, usched_entry_id(entry_id))) || !entry->reserved.psched_id) {
+		pthread_mutex_unlock(&rund.mutex_apool);
+		errno = ENOENT;
+		return -1;
+	}
+
+	/* Grant that the found entry belongs to the requesting uid */
+	if (entry->uid != uid) {
+		pthread_mutex_unlock(&rund.mutex_apool);
+		log_warn("schedule_entry_get_projection(): entry->uid != uid. (UID of the request: %u)\n", uid);
+		errno = EPERM;
+		return -1;
+	}
+
+	/* Grant that outdata_len doesn't exceed the hardlimit */
+	if (entry->outdata_len >= CONFIG_USCHED_EXEC_OUTPUT_MAX) {
+		pthread_mutex_unlock(&rund.mutex_apool);
+		log_crit("schedule_entry_get_projection(): entry->outdata_len >= CONFIG_USCHED_EXEC_OUTPUT_MAX\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Check if the record fits in the buffer */
+	if ((rlen = _schedule_entry_projection_size(entry, fields)) > *len) {
+		pthread_mutex_unlock(&rund.mutex_apool);
+		*len = rlen;
+		errno = ENOBUFS;
+		return -1;
+	}
+
+	offset += _schedule_entry_projection_put64(buf + offset, entry->id);
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_FLAGS))
+		offset += _schedule_entry_projection_put32(buf + offset, entry->flags);
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_UID))
+		offset += _schedule_entry_projection_put32(buf + offset, entry->uid);
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_GID))
+		offset += _schedule_entry_projection_put32(buf + offset, entry->gid);
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_TRIGGER))
+		offset += _schedule_entry_projection_put32(buf + offset, entry->trigger);
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_STEP))
+		offset += _schedule_entry_projection_put32(buf + offset, entry->step);
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_EXPIRE))
+		offset += _schedule_entry_projection_put32(buf + offset, entry->expire);
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_OVERLAP))
+		offset += _schedule_entry_projection_put32(buf + offset, entry->overlap);
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_CONCURRENCY))
+		offset += _schedule_entry_projection_put32(buf + offset, entry->concurrency);
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_PRIORITY))
+		offset += _schedule_entry_projection_put32(buf + offset, entry->priority);
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_PID))
+		offset += _schedule_entry_projection_put32(buf + offset, entry->pid);
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_STATUS))
+		offset += _schedule_entry_projection_put32(buf + offset, entry->status);
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_EXEC_TIME))
+		offset += _schedule_entry_projection_put64(buf + offset, entry->exec_time);
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_LATENCY))
+		offset += _schedule_entry_projection_put64(buf + offset, entry->latency);
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_OUTDATA))
+		offset += _schedule_entry_projection_putvar(buf + offset, entry->outdata, entry->outdata_len);
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_USERNAME))
+		offset += _schedule_entry_projection_putvar(buf + offset, entry->username, strnlen(entry->username, sizeof(entry->username)));
+
+	if (bit_test(&fields, USCHED_ENTRY_FIELD_SUBJ))
+		offset += _schedule_entry_projection_putvar(buf + offset, entry->subj, entry->subj_size);
+
+	pthread_mutex_unlock(&rund.mutex_apool);
+
+	*len = offset;
+
+	return 0;
+}
+
 int schedule_entry_get_by_uid(uid_t uid, uint64_t **entry_list, uint32_t *count) {
 	int errsv = 0;
+	uint64_t *entry_list_new = NULL;
 	struct usched_entry *entry = NULL;
 
 	pthread_mutex_lock(&rund.mutex_apool);
 
-	for (*count = 0, *entry_list = NULL, rund.apool->rewind(rund.apool, 0); (entry = rund.apool->iterate(rund.apool)); ++ *count) {
+	for (*count = 0, *entry_list = NULL, rund.apool->rewind(rund.apool, 0); (entry = rund.apool->iterate(rund.apool)); ) {
 		if (entry->uid != uid)
 			continue;
 
-		if (!(*entry_list = mm_realloc(*entry_list, (1 + *count) * sizeof(uint64_t)))) {
+		if (!(entry_list_new = mm_realloc(*entry_list, (1 + *count) * sizeof(uint64_t)))) {
 			errsv = errno;
 			log_warn("schedule_entry_get_by_uid(): mm_realloc(): %s\n", strerror(errno));
+			mm_free(*entry_list);
+			*entry_list = NULL;
 			*count = 0;
 			pthread_mutex_unlock(&rund.mutex_apool);
 			errno = errsv;
 			return -1;
 		}
 
-		(*entry_list)[*count] = entry->id;
+		*entry_list = entry_list_new;
+		(*entry_list)[(*count) ++] = entry->id;
 	}
 
 	pthread_mutex_unlock(&rund.mutex_apool);
@@ -261,6 +411,10 @@ struct usched_entry *schedule_entry_disable(struct usched_entry *entry) {
 	entry = rund.apool->pope(rund.apool, entry);
 	pthread_mutex_unlock(&rund.mutex_apool);
 
+	/* The entry no longer counts towards the owner's active entries quota */
+	if (entry)
+		admit_daemon_entry_release(entry->uid);
+
 	return entry;
 }
 
@@ -324,6 +478,10 @@ int schedule_entry_ownership_delete_by_id(uint64_t id, uid_t uid) {
 	}
 
 	/* Delete the entry */
+	admit_daemon_entry_release(entry->uid);
+
+	subscribe_daemon_forget(entry->id);
+
 	rund.apool->del(rund.apool, entry);
 
 	pthread_mutex_unlock(&rund.mutex_apool);
@@ -36,6 +36,7 @@
 #include "runtime.h"
 #include "bitops.h"
 #include "log.h"
+#include "conn.h"
 #include "sig.h"
 
 
@@ -43,24 +44,21 @@ static void _sig_term_daemon_handler(int n) {
 	bit_set(&rund.flags, USCHED_RUNTIME_FLAG_TERMINATE);
 
 	/* Cancel active threads */
-	pthread_cancel(rund.t_unix);
-	pthread_cancel(rund.t_remote);
+	conn_daemon_process_cancel();
 }
 
 static void _sig_hup_daemon_handler(int n) {
 	bit_set(&rund.flags, USCHED_RUNTIME_FLAG_RELOAD);
 
 	/* Cancel active threads */
-	pthread_cancel(rund.t_unix);
-	pthread_cancel(rund.t_remote);
+	conn_daemon_process_cancel();
 }
 
 static void _sig_usr1_daemon_handler(int n) {
 	bit_set(&rund.flags, USCHED_RUNTIME_FLAG_FLUSH);
 
 	/* Cancel active threads */
-	pthread_cancel(rund.t_unix);
-	pthread_cancel(rund.t_remote);
+	conn_daemon_process_cancel();
 }
 
 static void _sig_pipe_daemon_handler(int n) {
@@ -75,8 +73,7 @@ static void _sig_abrt_daemon_handler(int n) {
 		bit_set(&rund.flags, USCHED_RUNTIME_FLAG_RELOAD);
 
 		/* Cancel active threads */
-		pthread_cancel(rund.t_unix);
-		pthread_cancel(rund.t_remote);
+		conn_daemon_process_cancel();
 	}
 
 	/* Otherwise we don't know where this signal came from... better abort execution */
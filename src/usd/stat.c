@@ -26,6 +26,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <stddef.h>
 #include <errno.h>
 #include <pthread.h>
 
@@ -38,8 +39,11 @@
 #include "ipc.h"
 #include "stat.h"
 #include "entry.h"
+#include "subscribe.h"
+#include "credit.h"
 
-static int _stat_daemon_process(char *msg) {
+/* NOTE: Must be called with rund.mutex_apool held */
+static int _stat_daemon_update(char *msg, uid_t *uid) {
 	int errsv = 0;
 	struct ipc_usd_hdr *hdr = (struct ipc_usd_hdr *) msg;
 	char *outdata = msg + sizeof(struct ipc_usd_hdr);
@@ -48,7 +52,7 @@ static int _stat_daemon_process(char *msg) {
 	/* Validate outdata length */
 	if ((hdr->outdata_len + sizeof(struct ipc_usd_hdr)) >= rund.config.ipc.msg_size) {
 		errsv = errno = EINVAL;
-		log_warn("_stat_daemon_process(): hdr->outdata_len is too long: %s\n", strerror(errno));
+		log_warn("_stat_daemon_update(): hdr->outdata_len is too long: %s\n", strerror(errno));
 		errno = errsv;
 		return -1;
 	}
@@ -57,16 +61,12 @@ static int _stat_daemon_process(char *msg) {
 	outdata[hdr->outdata_len] = 0;
 
 	/* Print debug information */
-	debug_printf(DEBUG_INFO, "[STAT RECEIVED]: Entry ID: 0x%016llX, PID: %u, exec_time: %.3fus, latency: %.3fus, status: %u, outdata_len: %u\n", hdr->id, hdr->pid, (hdr->exec_time / 1000.0), (hdr->latency / 1000.0), hdr->status, hdr->outdata_len);
-
-	/* Acquire active pool mutex */
-	pthread_mutex_lock(&rund.mutex_apool);
+	debug_printf(DEBUG_INFO, "[STAT RECEIVED]: Entry ID: 0x%016llX, PID: %u, exec_time: %.3fus, latency: %.3fus, cpu_usec: %llu, mem_peak: %llu, status: %u, outdata_len: %u\n", hdr->id, hdr->pid, (hdr->exec_time / 1000.0), (hdr->latency / 1000.0), (unsigned long long) hdr->cpu_usec, (unsigned long long) hdr->mem_peak, hdr->status, hdr->outdata_len);
 
 	/* Search for an existing entry on active pool that matches the received ID */
 	if (!(entry = rund.apool->search(rund.apool, (struct usched_entry [1]) { { hdr->id, } }))) {
-		pthread_mutex_unlock(&rund.mutex_apool);
 		errsv = errno = EINVAL;
-		log_warn("_stat_daemon_process(): Cannot find Entry ID 0x%016llX on active pool: %s\n", hdr->id, strerror(errno));
+		log_warn("_stat_daemon_update(): Cannot find Entry ID 0x%016llX on active pool: %s\n", hdr->id, strerror(errno));
 		errno = errsv;
 		return -1;
 	}
@@ -84,18 +84,56 @@ static int _stat_daemon_process(char *msg) {
 	memcpy(entry->outdata, outdata, hdr->outdata_len);
 	entry->outdata[hdr->outdata_len] = 0;
 
-	/* Release active pool mutex */
-	pthread_mutex_unlock(&rund.mutex_apool);
+	*uid = entry->uid;
 
-	debug_printf(DEBUG_INFO, "_stat_daemon_process(): Entry ID 0x%016llX updated.\n", hdr->id);
+	debug_printf(DEBUG_INFO, "_stat_daemon_update(): Entry ID 0x%016llX updated.\n", hdr->id);
 
 	/* All good */
 	return 0;
 }
 
+static void _stat_daemon_process(char *msgs, size_t nmemb) {
+	size_t i = 0, stride = IPC_RECV_BATCH_STRIDE(rund.config.ipc.msg_size);
+	struct ipc_usd_hdr *hdr = NULL;
+	uid_t uid[CONFIG_USCHED_IPC_RECV_BATCH_MAX];
+	int updated[CONFIG_USCHED_IPC_RECV_BATCH_MAX];
+
+	/* Acquire active pool mutex, once for the whole batch */
+	pthread_mutex_lock(&rund.mutex_apool);
+
+	for (i = 0; i < nmemb; i ++) {
+		if (!(updated[i] = (_stat_daemon_update(msgs + (i * stride), &uid[i]) == 0)))
+			log_warn("_stat_daemon_process(): _stat_daemon_update(): %s\n", strerror(errno));
+	}
+
+	/* Release active pool mutex */
+	pthread_mutex_unlock(&rund.mutex_apool);
+
+	/* Push the completion records to the subscribers of each entry */
+	for (i = 0; i < nmemb; i ++) {
+		if (!updated[i])
+			continue;
+
+		hdr = (struct ipc_usd_hdr *) (msgs + (i * stride));
+
+		subscribe_daemon_publish(hdr->id, uid[i], hdr->pid, hdr->status, hdr->exec_time, hdr->latency, ((char *) hdr) + sizeof(struct ipc_usd_hdr), hdr->outdata_len);
+	}
+}
+
+/* Messages received from other modules by the stat worker (see ipc_recv_frames()) */
+static void _stat_daemon_other(long src_id, const char *msg, size_t len) {
+	if (src_id == IPC_USE_ID) {
+		credit_daemon_recv(msg, len);
+	} else {
+		log_warn("_stat_daemon_other(): Unexpected message from module %ld (%zu bytes).\n", src_id, len);
+	}
+}
+
 static void *_stat_daemon_worker(void *arg) {
 	int errsv = 0;
-	char *msg = NULL;
+	ssize_t nmemb = 0;
+	size_t stride = 0, lens[CONFIG_USCHED_IPC_RECV_BATCH_MAX];
+	char *msgs = NULL;
 	arg = NULL;
 
 	for (;;) {
@@ -103,20 +141,18 @@ static void *_stat_daemon_worker(void *arg) {
 		if (runtime_daemon_interrupted())
 			break;
 
-		/* Allocate message size */
-		if (!(msg = mm_alloc((size_t) rund.config.ipc.msg_size + 1))) {
-			log_warn("_stat_daemon_worker(): msg = mm_alloc(): %s\n", strerror(errno));
+		stride = IPC_RECV_BATCH_STRIDE(rund.config.ipc.msg_size);
+
+		/* Acquire the batch buffer of this thread (one stride per message) */
+		if (!(msgs = ipc_buf_get(stride * CONFIG_USCHED_IPC_RECV_BATCH_MAX))) {
+			log_warn("_stat_daemon_worker(): ipc_buf_get(): %s\n", strerror(errno));
 			continue;
 		}
 
-		/* Reset message memory */
-		memset(msg, 0, (size_t) rund.config.ipc.msg_size + 1);
-
-		/* Wait for IPC message */
-		if (ipc_recv(rund.pipcd, (long [1]) { IPC_USS_ID }, (long [1]) { IPC_USD_ID }, msg, (size_t) rund.config.ipc.msg_size) < 0) {
+		/* Wait for IPC messages */
+		if ((nmemb = ipc_recv_frames(rund.pipcd, IPC_USS_ID, IPC_USD_ID, msgs, (size_t) rund.config.ipc.msg_size, CONFIG_USCHED_IPC_RECV_BATCH_MAX, lens, sizeof(struct ipc_usd_hdr), offsetof(struct ipc_usd_hdr, outdata_len), &_stat_daemon_other)) < 0) {
 			errsv = errno;
-			log_warn("_stat_daemon_worker(): ipc_recv(): %s\n", strerror(errno));
-			mm_free(msg);
+			log_warn("_stat_daemon_worker(): ipc_recv_frames(): %s\n", strerror(errno));
 			errno = errsv;
 
 			/* Any of the following errno are a fatal condition and this module needs to
@@ -130,23 +166,41 @@ static void *_stat_daemon_worker(void *arg) {
 			continue;
 		}
 
-		/* Process incoming message */
-		if (_stat_daemon_process(msg) < 0) {
-			log_warn("_stat_daemon_worker(): _stat_daemon_process(): %s\n", strerror(errno));
-			mm_free(msg);
-			continue;
-		}
+		/* Track the bytes written by the receive operation */
+		ipc_buf_dirty(((size_t) nmemb - 1) * stride + lens[nmemb - 1] + 1);
 
-		/* Free msg memory */
-		mm_free(msg);
+		/* Process incoming messages */
+		_stat_daemon_process(msgs, (size_t) nmemb);
 	}
 
+	/* Release the message buffer of this thread */
+	ipc_buf_destroy();
+
 	/* All good */
 	pthread_exit(NULL);
 
 	return NULL;
 }
 
+void stat_daemon_counters_send(void) {
+	struct ipc_counters_hdr hdr;
+
+	memset(&hdr, 0, sizeof(struct ipc_counters_hdr));
+
+	pthread_mutex_lock(&rund.mutex_admit);
+	hdr.admit_rate_rejected = rund.admit_rate_rejected;
+	hdr.admit_quota_rejected = rund.admit_quota_rejected;
+	pthread_mutex_unlock(&rund.mutex_admit);
+
+	credit_daemon_counters(&hdr);
+
+	/* Counters are idempotent. If these can't be sent, the next ones will do. */
+	if (ipc_send_nowait(rund.pipcd, IPC_USD_ID, IPC_USS_ID, (char *) &hdr, sizeof(struct ipc_counters_hdr)) < 0) {
+		if (errno != EAGAIN)
+			log_warn("stat_daemon_counters_send(): ipc_send_nowait(): %s\n", strerror(errno));
+	}
+}
+
 int stat_daemon_init(void) {
 	int errsv = 0;
 
@@ -163,7 +217,7 @@ int stat_daemon_init(void) {
 }
 
 void stat_daemon_destroy(void) {
-	/* FIXME: Thread may contain alloc'd data and it's now being handled on cancel cleanups */
+	/* NOTE: The worker message buffer is thread-specific data and is released on cancellation */
 	pthread_cancel(rund.t_stat);
 	pthread_join(rund.t_stat, NULL);
 }
@@ -0,0 +1,612 @@
+/**
+ * @file subscribe.c
+ * @brief uSched
+ *        Execution results subscription interface - Daemon
+ *
+ * Date: 18-10-2026
+ *
+ * Copyright 2014-2015 Pedro A. Hortas (pah@ucodev.org)
+ *
+ * This file is part of usched.
+ *
+ * usched is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * usched is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with usched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <pthread.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+
+#include <pall/cll.h>
+
+#include <rtsaio/rtsaio.h>
+#include <panet/panet.h>
+
+#include "config.h"
+#include "debug.h"
+#include "runtime.h"
+#include "mm.h"
+#include "log.h"
+#include "entry.h"
+#include "conn.h"
+#include "gc.h"
+#include "pool.h"
+#include "process.h"
+#include "subscribe.h"
+
+static int _subscribe_daemon_compare(const void *s1, const void *s2) {
+	const struct usched_subscription *ps1 = s1, *ps2 = s2;
+
+	return (ps1->fd > ps2->fd) - (ps1->fd < ps2->fd);
+}
+
+static void _subscribe_daemon_destroy(void *elem) {
+	struct usched_subscription *sub = elem;
+
+	/* NOTE: The connection aop isn't owned by the subscription */
+
+	if (sub->entry)
+		entry_destroy(sub->entry);
+
+	if (sub->ids)
+		mm_free(sub->ids);
+
+	if (sub->queue)
+		mm_free(sub->queue);
+
+	mm_free(sub);
+}
+
+static int _subscribe_daemon_id_compare(const void *id1, const void *id2) {
+	const uint64_t *pid1 = id1, *pid2 = id2;
+
+	return (*pid1 > *pid2) - (*pid1 < *pid2);
+}
+
+static struct usched_subscription *_subscribe_daemon_get(sock_t fd) {
+	struct usched_subscription sub;
+
+	/* NOTE: rund.mutex_subs must be held by the caller */
+
+	memset(&sub, 0, sizeof(struct usched_subscription));
+
+	sub.fd = fd;
+
+	return rund.subs->search(rund.subs, &sub);
+}
+
+static int _subscribe_daemon_queue(struct usched_subscription *sub, uint64_t id, pid_t pid, uint32_t status, uint64_t exec_time, uint64_t latency, const char *outdata, size_t outdata_len) {
+	size_t len = 0;
+	char *queue = NULL;
+
+	/* NOTE: rund.mutex_subs must be held by the caller */
+
+	/* Completion record layout:
+	 *
+	 * +=============+=================================+
+	 * | Field       | Size                            |
+	 * +=============+=================================+
+	 * | id          | 64 bits                         |
+	 * | status      | 32 bits                         |
+	 * | pid         | 32 bits                         |
+	 * | exec_time   | 64 bits                         |
+	 * | latency     | 64 bits                         |
+	 * | outdata_len | 32 bits                         |
+	 * | outdata     | outdata_len (truncated)         |
+	 * +-------------+---------------------------------+
+	 *
+	 */
+
+	/* Records only carry the head of the output */
+	if (outdata_len > CONFIG_USCHED_SUBSCRIBE_OUTDATA_MAX)
+		outdata_len = CONFIG_USCHED_SUBSCRIBE_OUTDATA_MAX;
+
+	len = 8 + 4 + 4 + 8 + 8 + 4 + outdata_len;
+
+	/* The first 4 bytes of the queue are reserved for the records count */
+	if (!sub->queue_len)
+		sub->queue_len = 4;
+
+	if ((sub->queue_len + len) > CONFIG_USCHED_SUBSCRIBE_QUEUE_MAX) {
+		errno = ENOBUFS;
+		return -1;
+	}
+
+	if (!(queue = mm_realloc(sub->queue, sub->queue_len + len)))
+		return -1;
+
+	sub->queue = queue;
+	queue += sub->queue_len;
+
+	memcpy(queue, (uint64_t [1]) { htonll(id) }, 8);
+	memcpy(queue + 8, (uint32_t [1]) { htonl(status) }, 4);
+	memcpy(queue + 12, (uint32_t [1]) { htonl((uint32_t) pid) }, 4);
+	memcpy(queue + 16, (uint64_t [1]) { htonll(exec_time) }, 8);
+	memcpy(queue + 24, (uint64_t [1]) { htonll(latency) }, 8);
+	memcpy(queue + 32, (uint32_t [1]) { htonl((uint32_t) outdata_len) }, 4);
+	memcpy(queue + 36, outdata, outdata_len);
+
+	sub->queue_len += len;
+	sub->queue_nmemb ++;
+
+	return 0;
+}
+
+static int _subscribe_daemon_push(struct usched_subscription *sub) {
+	int errsv = 0;
+
+	/* NOTE: rund.mutex_subs must be held by the caller and the subscription must be idle */
+
+	/* Set the records count and hand the queue over to the subscription entry */
+	memcpy(sub->queue, (uint32_t [1]) { htonl(sub->queue_nmemb) }, 4);
+
+	sub->entry->payload = sub->queue;
+	sub->entry->psize = sub->queue_len;
+
+	sub->queue = NULL;
+	sub->queue_len = 0;
+	sub->queue_nmemb = 0;
+
+	/* Records are sent as a regular encrypted response */
+	if (process_daemon_send_reply(sub->aop, sub->entry) < 0) {
+		errsv = errno;
+		log_warn("_subscribe_daemon_push(): process_daemon_send_reply(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	sub->busy = 1;
+
+	if (rtsaio_write(sub->aop) < 0) {
+		errsv = errno;
+		log_warn("_subscribe_daemon_push(): rtsaio_write(): %s\n", strerror(errno));
+		sub->busy = 0;
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+static void _subscribe_daemon_drop(sock_t fd, struct async_op *aop) {
+	/* The aop of an idle subscription isn't being used by rtsaio, so the connection can be
+	 * safely terminated from here.
+	 */
+	log_info("_subscribe_daemon_drop(): Terminating subscription on file descriptor %d\n", fd);
+
+	pool_daemon_conn_buf_release(fd, (void *) aop->data);
+	aop->data = NULL;
+
+	conn_daemon_client_close(fd);
+
+	if (gc_insert(aop) < 0) {
+		log_warn("_subscribe_daemon_drop(): gc_insert(): %s\n", strerror(errno));
+
+		runtime_daemon_fatal();
+	}
+}
+
+static void _subscribe_daemon_terminate(struct usched_subscription *sub) {
+	/* NOTE: rund.mutex_subs must be held by the caller */
+
+	/* Nothing else is sent to this subscriber */
+	sub->closing = 1;
+
+	/* Wake up the pending I/O. The connection is closed by whichever operation completes last
+	 * (see subscribe_daemon_received() and subscribe_daemon_failed()).
+	 */
+	shutdown(sub->fd, SHUT_RDWR);
+}
+
+static int _subscribe_daemon_arm(struct usched_subscription *sub, struct async_op *raop, time_t timeout) {
+	int errsv = 0;
+
+	/* NOTE: rund.mutex_subs must be held by the caller */
+
+	memset(raop, 0, sizeof(struct async_op));
+
+	raop->fd = sub->fd;
+	raop->count = sizeof(sub->probe);
+	raop->priority = 0;
+	raop->timeout.tv_sec = timeout;
+	raop->data = &sub->probe;
+
+	if (rtsaio_read(raop) < 0) {
+		errsv = errno;
+		log_warn("_subscribe_daemon_arm(): rtsaio_read(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	sub->raop = raop;
+
+	return 0;
+}
+
+static int _subscribe_daemon_connected(sock_t fd) {
+	int errsv = errno;
+	unsigned char c = 0;
+	int ret = 0;
+
+	/* Nothing is pending and the peer didn't close its end of the connection */
+	ret = (recv(fd, &c, sizeof(c), MSG_PEEK | MSG_DONTWAIT) < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK));
+
+	errno = errsv;
+
+	return ret;
+}
+
+int subscribe_daemon_register(sock_t fd, struct usched_entry *entry, uint64_t *ids, size_t ids_nmemb) {
+	int errsv = 0;
+	size_t i = 0;
+	struct usched_entry *e = NULL;
+	struct usched_subscription *sub = NULL;
+
+	/* The active pool is held until the subscription is registered, so none of the subscribed
+	 * entries can be removed before subscribe_daemon_forget() is able to notice it.
+	 */
+	pthread_mutex_lock(&rund.mutex_apool);
+
+	/* Only existing entries owned by the subscriber can be subscribed */
+	for (i = 0; i < ids_nmemb; i ++) {
+		if (!(e = rund.apool->search(rund.apool, usched_entry_id(ids[i]))) || (e->uid != entry->uid)) {
+			pthread_mutex_unlock(&rund.mutex_apool);
+			log_warn("subscribe_daemon_register(): Entry ID 0x%016llX doesn't exist or isn't owned by UID %u.\n", ids[i], entry->uid);
+			errno = EACCES;
+			return -1;
+		}
+	}
+
+	pthread_mutex_lock(&rund.mutex_subs);
+
+	if (rund.subs->count(rund.subs) >= CONFIG_USCHED_SUBSCRIBE_MAX) {
+		pthread_mutex_unlock(&rund.mutex_subs);
+		pthread_mutex_unlock(&rund.mutex_apool);
+		log_warn("subscribe_daemon_register(): Maximum number of subscriptions reached (%u).\n", CONFIG_USCHED_SUBSCRIBE_MAX);
+		errno = EBUSY;
+		return -1;
+	}
+
+	if (_subscribe_daemon_get(fd)) {
+		pthread_mutex_unlock(&rund.mutex_subs);
+		pthread_mutex_unlock(&rund.mutex_apool);
+		errno = EEXIST;
+		return -1;
+	}
+
+	if (!(sub = mm_alloc(sizeof(struct usched_subscription)))) {
+		errsv = errno;
+		pthread_mutex_unlock(&rund.mutex_subs);
+		pthread_mutex_unlock(&rund.mutex_apool);
+		log_warn("subscribe_daemon_register(): mm_alloc(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	memset(sub, 0, sizeof(struct usched_subscription));
+
+	sub->fd = fd;
+	sub->uid = entry->uid;
+	sub->ids = ids;
+	sub->ids_nmemb = ids_nmemb;
+	sub->entry = entry;
+	sub->t_active = time(NULL);
+
+	/* The subscription reply is still to be written. Records are queued until then. */
+	sub->busy = 1;
+
+	if (rund.subs->insert(rund.subs, sub) < 0) {
+		errsv = errno;
+		pthread_mutex_unlock(&rund.mutex_subs);
+		pthread_mutex_unlock(&rund.mutex_apool);
+		log_warn("subscribe_daemon_register(): rund.subs->insert(): %s\n", strerror(errno));
+		mm_free(sub);
+		errno = errsv;
+		return -1;
+	}
+
+	pthread_mutex_unlock(&rund.mutex_subs);
+	pthread_mutex_unlock(&rund.mutex_apool);
+
+	return 0;
+}
+
+int subscribe_daemon_sent(struct async_op *aop) {
+	int errsv = 0;
+	struct usched_subscription *sub = NULL;
+	struct async_op *raop = NULL;
+
+	pthread_mutex_lock(&rund.mutex_subs);
+
+	/* Not a subscription */
+	if (!rund.subs->count(rund.subs) || !(sub = _subscribe_daemon_get(aop->fd))) {
+		pthread_mutex_unlock(&rund.mutex_subs);
+		return 0;
+	}
+
+	sub->aop = aop;
+	sub->busy = 0;
+
+	/* The subscription is being terminated */
+	if (sub->closing) {
+		pthread_mutex_unlock(&rund.mutex_subs);
+		errno = ECONNABORTED;
+		return -1;
+	}
+
+	/* Records were lost while this response was being written */
+	if (sub->overflow) {
+		sub->closing = 1;
+		pthread_mutex_unlock(&rund.mutex_subs);
+		log_warn("subscribe_daemon_sent(): Subscriber on file descriptor %d isn't keeping up with the completions.\n", aop->fd);
+		errno = ENOBUFS;
+		return -1;
+	}
+
+	/* Keep a read armed on the connection while the subscription is active, so it is closed as
+	 * soon as the subscriber goes away or the subscription is idle for too long.
+	 */
+	if (!sub->raop) {
+		if (!(raop = mm_alloc(sizeof(struct async_op)))) {
+			errsv = errno;
+			sub->closing = 1;
+			pthread_mutex_unlock(&rund.mutex_subs);
+			log_warn("subscribe_daemon_sent(): mm_alloc(): %s\n", strerror(errno));
+			errno = errsv;
+			return -1;
+		}
+
+		if (_subscribe_daemon_arm(sub, raop, CONFIG_USCHED_SUBSCRIBE_IDLE_TIMEOUT) < 0) {
+			errsv = errno;
+			sub->closing = 1;
+			pthread_mutex_unlock(&rund.mutex_subs);
+			log_warn("subscribe_daemon_sent(): _subscribe_daemon_arm(): %s\n", strerror(errno));
+			mm_free(raop);
+			errno = errsv;
+			return -1;
+		}
+	}
+
+	/* Send the records queued in the meanwhile, if any. Otherwise, the subscription is now
+	 * idle and the next record will be sent as soon as it's published.
+	 */
+	if (sub->queue_nmemb && (_subscribe_daemon_push(sub) < 0)) {
+		errsv = errno;
+		sub->closing = 1;
+		pthread_mutex_unlock(&rund.mutex_subs);
+		log_warn("subscribe_daemon_sent(): _subscribe_daemon_push(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	pthread_mutex_unlock(&rund.mutex_subs);
+
+	return 1;
+}
+
+int subscribe_daemon_received(struct async_op *aop) {
+	sock_t fd = aop->fd;
+	time_t idle = 0;
+	struct usched_subscription *sub = NULL;
+	struct async_op *waop = NULL;
+
+	pthread_mutex_lock(&rund.mutex_subs);
+
+	/* Not the read armed on a subscription connection */
+	if (!rund.subs || !rund.subs->count(rund.subs) || !(sub = _subscribe_daemon_get(fd)) || (sub->raop != aop)) {
+		pthread_mutex_unlock(&rund.mutex_subs);
+		return 0;
+	}
+
+	idle = time(NULL) - sub->t_active;
+
+	if (sub->closing) {
+		/* Woken up by _subscribe_daemon_terminate() */
+	} else if ((rtsaio_count(aop) > 0) || !_subscribe_daemon_connected(fd)) {
+		log_info("subscribe_daemon_received(): Subscriber on file descriptor %d closed the connection or sent unexpected data.\n", fd);
+	} else if (idle >= CONFIG_USCHED_SUBSCRIBE_IDLE_TIMEOUT) {
+		log_info("subscribe_daemon_received(): Subscription on file descriptor %d was idle for %ld seconds.\n", fd, (long) idle);
+	} else if (_subscribe_daemon_arm(sub, aop, CONFIG_USCHED_SUBSCRIBE_IDLE_TIMEOUT - idle) == 0) {
+		/* Records were published since the read was armed. Keep waiting. */
+		pthread_mutex_unlock(&rund.mutex_subs);
+		return 1;
+	}
+
+	/* The read is no longer pending */
+	sub->raop = NULL;
+
+	if (sub->busy) {
+		/* The connection is closed once the pending response is written */
+		_subscribe_daemon_terminate(sub);
+		pthread_mutex_unlock(&rund.mutex_subs);
+	} else {
+		/* Nothing else can use the idle connection aop */
+		sub->closing = 1;
+		waop = sub->aop;
+		pthread_mutex_unlock(&rund.mutex_subs);
+
+		_subscribe_daemon_drop(fd, waop);
+	}
+
+	/* See notify_read() on why 'aop' isn't free()'d here */
+	if (gc_insert(aop) < 0) {
+		log_warn("subscribe_daemon_received(): gc_insert(): %s\n", strerror(errno));
+
+		runtime_daemon_fatal();
+	}
+
+	return 1;
+}
+
+int subscribe_daemon_failed(struct async_op *aop) {
+	struct usched_subscription *sub = NULL;
+
+	pthread_mutex_lock(&rund.mutex_subs);
+
+	/* Connections without a pending read are closed by the caller */
+	if (!rund.subs || !rund.subs->count(rund.subs) || !(sub = _subscribe_daemon_get(aop->fd)) || !sub->raop) {
+		pthread_mutex_unlock(&rund.mutex_subs);
+		return 0;
+	}
+
+	/* The connection aop is released along with the connection, once the read completes */
+	sub->aop = aop;
+	sub->busy = 0;
+
+	_subscribe_daemon_terminate(sub);
+
+	pthread_mutex_unlock(&rund.mutex_subs);
+
+	return 1;
+}
+
+void subscribe_daemon_close(sock_t fd) {
+	struct usched_subscription *sub = NULL;
+
+	pthread_mutex_lock(&rund.mutex_subs);
+
+	if (rund.subs && rund.subs->count(rund.subs) && (sub = _subscribe_daemon_get(fd)))
+		rund.subs->del(rund.subs, sub);
+
+	pthread_mutex_unlock(&rund.mutex_subs);
+}
+
+void subscribe_daemon_forget(uint64_t id) {
+	uint64_t *pid = NULL;
+	struct usched_subscription *sub = NULL;
+
+	/* NOTE: rund.mutex_apool must be held by the caller */
+
+	pthread_mutex_lock(&rund.mutex_subs);
+
+	if (!rund.subs || !rund.subs->count(rund.subs)) {
+		pthread_mutex_unlock(&rund.mutex_subs);
+		return;
+	}
+
+	for (rund.subs->rewind(rund.subs, 0); (sub = rund.subs->iterate(rund.subs)); ) {
+		if (!sub->ids || sub->closing)
+			continue;
+
+		if (!(pid = bsearch(&id, sub->ids, sub->ids_nmemb, sizeof(uint64_t), &_subscribe_daemon_id_compare)))
+			continue;
+
+		/* Keep the remaining IDs sorted */
+		memmove(pid, pid + 1, (sub->ids_nmemb - (size_t) (pid - sub->ids) - 1) * sizeof(uint64_t));
+
+		if (-- sub->ids_nmemb)
+			continue;
+
+		log_info("subscribe_daemon_forget(): None of the entries subscribed on file descriptor %d remain.\n", sub->fd);
+
+		_subscribe_daemon_terminate(sub);
+	}
+
+	pthread_mutex_unlock(&rund.mutex_subs);
+}
+
+void subscribe_daemon_publish(uint64_t id, uid_t uid, pid_t pid, uint32_t status, uint64_t exec_time, uint64_t latency, const char *outdata, size_t outdata_len) {
+	struct usched_subscription *sub = NULL;
+
+	pthread_mutex_lock(&rund.mutex_subs);
+
+	if (!rund.subs->count(rund.subs)) {
+		pthread_mutex_unlock(&rund.mutex_subs);
+		return;
+	}
+
+	for (rund.subs->rewind(rund.subs, 0); (sub = rund.subs->iterate(rund.subs)); ) {
+		/* Subscribers are only notified about their own entries */
+		if ((sub->uid != uid) || sub->overflow || sub->closing)
+			continue;
+
+		if (sub->ids && !bsearch(&id, sub->ids, sub->ids_nmemb, sizeof(uint64_t), &_subscribe_daemon_id_compare))
+			continue;
+
+		if (_subscribe_daemon_queue(sub, id, pid, status, exec_time, latency, outdata, outdata_len) < 0) {
+			log_warn("subscribe_daemon_publish(): _subscribe_daemon_queue(): %s\n", strerror(errno));
+
+			/* The subscriber will be dropped when the current response is written */
+			sub->overflow = 1;
+
+			continue;
+		}
+
+		sub->t_active = time(NULL);
+
+		/* Busy subscribers will send the queued records when the current response is written */
+		if (sub->busy || (_subscribe_daemon_push(sub) == 0))
+			continue;
+
+		log_warn("subscribe_daemon_publish(): _subscribe_daemon_push(): %s\n", strerror(errno));
+
+		/* Failed connections are closed by the read armed on them */
+		sub->overflow = 1;
+
+		_subscribe_daemon_terminate(sub);
+	}
+
+	pthread_mutex_unlock(&rund.mutex_subs);
+}
+
+int subscribe_daemon_init(void) {
+	int errsv = 0;
+
+	if (!(rund.subs = pall_cll_init(&_subscribe_daemon_compare, &_subscribe_daemon_destroy, NULL, NULL))) {
+		errsv = errno;
+		log_crit("subscribe_daemon_init(): rund.subs = pall_cll_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Setup CLL: No auto search, head insert, search forward */
+	(void) rund.subs->set_config(rund.subs, (ui32_t) (CONFIG_SEARCH_FORWARD | CONFIG_INSERT_HEAD));
+
+	/* All good */
+	return 0;
+}
+
+void subscribe_daemon_destroy(void) {
+	struct usched_subscription *sub = NULL;
+
+	pthread_mutex_lock(&rund.mutex_subs);
+
+	if (rund.subs) {
+		/* Idle subscriptions hold their connection aop and the read armed on the connection,
+		 * which are no longer used by rtsaio at this point.
+		 */
+		for (rund.subs->rewind(rund.subs, 0); (sub = rund.subs->iterate(rund.subs)); ) {
+			if (sub->raop)
+				mm_free(sub->raop);
+
+			if (sub->busy || !sub->aop)
+				continue;
+
+			panet_safe_close(sub->fd);
+
+			mm_free(sub->aop);
+		}
+
+		pall_cll_destroy(rund.subs);
+		rund.subs = NULL;
+	}
+
+	pthread_mutex_unlock(&rund.mutex_subs);
+}
@@ -45,6 +45,13 @@ int thread_daemon_components_init(void) {
 		return -1;
 	}
 
+	if ((errno = pthread_mutex_init(&rund.mutex_conn, NULL))) {
+		errsv = errno;
+		log_crit("thread_daemon_components_init(): pthread_mutex_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
 	if ((errno = pthread_mutex_init(&rund.mutex_rpool, NULL))) {
 		errsv = errno;
 		log_crit("thread_daemon_components_init(): pthread_mutex_init(): %s\n", strerror(errno));
@@ -59,6 +66,55 @@ int thread_daemon_components_init(void) {
 		return -1;
 	}
 
+	if ((errno = pthread_mutex_init(&rund.mutex_qpool, NULL))) {
+		errsv = errno;
+		log_crit("thread_daemon_components_init(): pthread_mutex_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if ((errno = pthread_mutex_init(&rund.mutex_admit, NULL))) {
+		errsv = errno;
+		log_crit("thread_daemon_components_init(): pthread_mutex_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if ((errno = pthread_mutex_init(&rund.mutex_ticket, NULL))) {
+		errsv = errno;
+		log_crit("thread_daemon_components_init(): pthread_mutex_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if ((errno = pthread_mutex_init(&rund.mutex_users, NULL))) {
+		errsv = errno;
+		log_crit("thread_daemon_components_init(): pthread_mutex_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if ((errno = pthread_mutex_init(&rund.mutex_subs, NULL))) {
+		errsv = errno;
+		log_crit("thread_daemon_components_init(): pthread_mutex_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if ((errno = pthread_mutex_init(&rund.mutex_credit, NULL))) {
+		errsv = errno;
+		log_crit("thread_daemon_components_init(): pthread_mutex_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	if ((errno = pthread_cond_init(&rund.cond_qpool, NULL))) {
+		errsv = errno;
+		log_crit("thread_daemon_components_init(): pthread_cond_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
 #if CONFIG_USCHED_SERIALIZE_ON_REQ == 1
 	if ((errno = pthread_mutex_init(&rund.mutex_marshal, NULL))) {
 		errsv = errno;
@@ -82,7 +138,15 @@ void thread_daemon_components_destroy(void) {
 	pthread_mutex_destroy(&rund.mutex_marshal);
 	pthread_cond_destroy(&rund.cond_marshal);
 #endif
+	pthread_cond_destroy(&rund.cond_qpool);
+	pthread_mutex_destroy(&rund.mutex_credit);
+	pthread_mutex_destroy(&rund.mutex_subs);
+	pthread_mutex_destroy(&rund.mutex_users);
+	pthread_mutex_destroy(&rund.mutex_ticket);
+	pthread_mutex_destroy(&rund.mutex_admit);
+	pthread_mutex_destroy(&rund.mutex_qpool);
 	pthread_mutex_destroy(&rund.mutex_rpool);
+	pthread_mutex_destroy(&rund.mutex_conn);
 	pthread_mutex_destroy(&rund.mutex_apool);
 	pthread_mutex_destroy(&rund.mutex_interrupt);
 }
@@ -0,0 +1,336 @@
+/**
+ * @file cgroup.c
+ * @brief uSched
+ *        Execution cgroup placement interface - Exec
+ *
+ * Date: 18-10-2026
+ *
+ * Copyright 2014-2015 Pedro A. Hortas (pah@ucodev.org)
+ *
+ * This file is part of usched.
+ *
+ * usched is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * usched is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with usched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include "config.h"
+#include "runtime.h"
+#include "log.h"
+#include "usched.h"
+#include "entry.h"
+#include "ipc.h"
+#include "worker.h"
+#include "cgroup.h"
+
+#if CONFIG_USE_CGROUP == 1
+ #include <dirent.h>
+ #include <sys/vfs.h>
+ #include <linux/magic.h>
+
+/*
+ * Executions are placed in cgroups under exec.cgroup.dir, which must be a cgroup v2 directory
+ * delegated to the executer:
+ *
+ *   <exec.cgroup.dir>/<group>/<execution>
+ *
+ * The group cgroups (one per UID or one per priority class) hold the configured limits and are
+ * kept between executions. Each execution gets a leaf cgroup of its own, so its resource usage
+ * can be read when it exits. The leaf is then removed.
+ *
+ * If the hierarchy can't be used, executions run in the cgroup of the executer.
+ */
+static int _cgroup_basefd = -1;
+
+static int _cgroup_write(int dirfd, const char *file, const char *value) {
+	int fd = -1, errsv = 0;
+	size_t len = strlen(value);
+
+	if ((fd = openat(dirfd, file, O_WRONLY | O_CLOEXEC)) < 0)
+		return -1;
+
+	if (write(fd, value, len) != (ssize_t) len) {
+		errsv = errno;
+		close(fd);
+		errno = errsv;
+		return -1;
+	}
+
+	close(fd);
+
+	return 0;
+}
+
+static int _cgroup_read_u64(int dirfd, const char *file, const char *key, uint64_t *value) {
+	int fd = -1;
+	ssize_t len = 0;
+	size_t klen = key ? strlen(key) : 0;
+	char buf[1024], *ptr = buf;
+
+	if ((fd = openat(dirfd, file, O_RDONLY | O_CLOEXEC)) < 0)
+		return -1;
+
+	len = read(fd, buf, sizeof(buf) - 1);
+
+	close(fd);
+
+	if (len <= 0)
+		return -1;
+
+	buf[len] = 0;
+
+	/* Flat keyed files (such as cpu.stat) have one "key value" pair per line */
+	if (key) {
+		while (strncmp(ptr, key, klen) || (ptr[klen] != ' ')) {
+			if (!(ptr = strchr(ptr, '\n')))
+				return -1;
+
+			ptr ++;
+		}
+
+		ptr += klen + 1;
+	}
+
+	*value = strtoull(ptr, NULL, 10);
+
+	return 0;
+}
+
+static void _cgroup_limits_set(const char *group) {
+	int fd = -1;
+	char value[32];
+
+	if ((fd = openat(_cgroup_basefd, group, O_RDONLY | O_DIRECTORY | O_CLOEXEC)) < 0) {
+		log_warn("_cgroup_limits_set(): openat(\"%s\"): %s\n", group, strerror(errno));
+		return;
+	}
+
+	snprintf(value, sizeof(value), "%u", rune.config.exec.cgroup_cpu);
+
+	if (_cgroup_write(fd, "cpu.weight", value) < 0)
+		log_warn("_cgroup_limits_set(): %s/cpu.weight: %s\n", group, strerror(errno));
+
+	if (rune.config.exec.cgroup_memory) {
+		snprintf(value, sizeof(value), "%llu", (unsigned long long) rune.config.exec.cgroup_memory * 1048576);
+	} else {
+		strcpy(value, "max");
+	}
+
+	if (_cgroup_write(fd, "memory.max", value) < 0)
+		log_warn("_cgroup_limits_set(): %s/memory.max: %s\n", group, strerror(errno));
+
+	snprintf(value, sizeof(value), "default %u", rune.config.exec.cgroup_io);
+
+	if (_cgroup_write(fd, "io.weight", value) < 0)
+		log_warn("_cgroup_limits_set(): %s/io.weight: %s\n", group, strerror(errno));
+
+	/* The memory usage of each execution is accounted in its own leaf */
+	if (_cgroup_write(fd, "cgroup.subtree_control", "+memory") < 0)
+		log_warn("_cgroup_limits_set(): %s/cgroup.subtree_control: %s\n", group, strerror(errno));
+
+	close(fd);
+}
+
+static void _cgroup_limits_reload(void) {
+	int fd = -1;
+	DIR *dir = NULL;
+	struct dirent *ent = NULL;
+
+	if ((fd = dup(_cgroup_basefd)) < 0) {
+		log_warn("_cgroup_limits_reload(): dup(): %s\n", strerror(errno));
+		return;
+	}
+
+	if (!(dir = fdopendir(fd))) {
+		log_warn("_cgroup_limits_reload(): fdopendir(): %s\n", strerror(errno));
+		close(fd);
+		return;
+	}
+
+	/* Groups left by the previous instances get the current limits */
+	while ((ent = readdir(dir))) {
+		if ((ent->d_type != DT_DIR) || (ent->d_name[0] == '.'))
+			continue;
+
+		_cgroup_limits_set(ent->d_name);
+	}
+
+	closedir(dir);
+}
+
+static void _cgroup_group_name(const struct ipc_use_hdr *hdr, char *group, size_t size) {
+	if (!strcmp(rune.config.exec.cgroup_group, USCHED_CGROUP_GROUP_CLASS_STR)) {
+		snprintf(group, size, "class.%s",
+			(hdr->priority == USCHED_ENTRY_PRIORITY_HIGH) ? USCHED_PRIORITY_HIGH_STR :
+			(hdr->priority == USCHED_ENTRY_PRIORITY_LOW) ? USCHED_PRIORITY_LOW_STR : USCHED_PRIORITY_NORMAL_STR);
+	} else {
+		snprintf(group, size, "uid.%u", hdr->uid);
+	}
+}
+
+void cgroup_exec_init(void) {
+	int errsv = 0;
+	struct statfs sfs;
+	const char *dir = rune.config.exec.cgroup_dir;
+
+	_cgroup_basefd = -1;
+
+	if (!rune.config.exec.cgroup_use)
+		return;
+
+	if ((mkdir(dir, 0755) < 0) && (errno != EEXIST)) {
+		log_warn("cgroup_exec_init(): mkdir(\"%s\"): %s. (Executions won't be placed in cgroups)\n", dir, strerror(errno));
+		return;
+	}
+
+	if (statfs(dir, &sfs) < 0) {
+		log_warn("cgroup_exec_init(): statfs(\"%s\"): %s. (Executions won't be placed in cgroups)\n", dir, strerror(errno));
+		return;
+	}
+
+	if (sfs.f_type != CGROUP2_SUPER_MAGIC) {
+		log_warn("cgroup_exec_init(): %s isn't part of a cgroup v2 hierarchy. (Executions won't be placed in cgroups)\n", dir);
+		return;
+	}
+
+	if ((_cgroup_basefd = open(dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC)) < 0) {
+		log_warn("cgroup_exec_init(): open(\"%s\"): %s. (Executions won't be placed in cgroups)\n", dir, strerror(errno));
+		return;
+	}
+
+	/* Executions are only moved into the hierarchy if it was delegated to the executer */
+	if (faccessat(_cgroup_basefd, "cgroup.procs", W_OK, AT_EACCESS) < 0) {
+		errsv = errno;
+		log_warn("cgroup_exec_init(): %s/cgroup.procs: %s. (Executions won't be placed in cgroups)\n", dir, strerror(errsv));
+		close(_cgroup_basefd);
+		_cgroup_basefd = -1;
+		return;
+	}
+
+	/* Controllers of the group limits. Each one is enabled on its own, so the unavailable
+	 * ones don't prevent the others from being used.
+	 */
+	if (_cgroup_write(_cgroup_basefd, "cgroup.subtree_control", "+cpu") < 0)
+		log_warn("cgroup_exec_init(): Unable to enable the cpu controller: %s\n", strerror(errno));
+
+	if (_cgroup_write(_cgroup_basefd, "cgroup.subtree_control", "+memory") < 0)
+		log_warn("cgroup_exec_init(): Unable to enable the memory controller: %s\n", strerror(errno));
+
+	if (_cgroup_write(_cgroup_basefd, "cgroup.subtree_control", "+io") < 0)
+		log_warn("cgroup_exec_init(): Unable to enable the io controller: %s\n", strerror(errno));
+
+	_cgroup_limits_reload();
+
+	log_info("Executions are placed in cgroups under %s (grouped by %s).\n", dir, rune.config.exec.cgroup_group);
+}
+
+void cgroup_exec_destroy(void) {
+	if (_cgroup_basefd >= 0)
+		close(_cgroup_basefd);
+
+	_cgroup_basefd = -1;
+}
+
+int cgroup_exec_create(struct usched_exec_task *task) {
+	int fd = -1;
+	char group[32];
+	struct ipc_use_hdr *hdr = (struct ipc_use_hdr *) task->buf;
+
+	if (_cgroup_basefd < 0)
+		return -1;
+
+	_cgroup_group_name(hdr, group, sizeof(group));
+
+	/* Limits are set when the group is created, and again on each initialization */
+	if (!mkdirat(_cgroup_basefd, group, 0755)) {
+		_cgroup_limits_set(group);
+	} else if (errno != EEXIST) {
+		log_warn("Entry[0x%016llX]: cgroup_exec_create(): mkdirat(\"%s\"): %s\n", hdr->id, group, strerror(errno));
+		return -1;
+	}
+
+	snprintf(task->cgname, sizeof(task->cgname), "%s/%016llX.%lld.%09ld", group, (unsigned long long) hdr->id, (long long) task->t_start.tv_sec, (long) task->t_start.tv_nsec);
+
+	if (mkdirat(_cgroup_basefd, task->cgname, 0755) < 0) {
+		log_warn("Entry[0x%016llX]: cgroup_exec_create(): mkdirat(\"%s\"): %s\n", hdr->id, task->cgname, strerror(errno));
+		return -1;
+	}
+
+	if ((task->cgfd = openat(_cgroup_basefd, task->cgname, O_RDONLY | O_DIRECTORY | O_CLOEXEC)) < 0) {
+		log_warn("Entry[0x%016llX]: cgroup_exec_create(): openat(\"%s\"): %s\n", hdr->id, task->cgname, strerror(errno));
+		unlinkat(_cgroup_basefd, task->cgname, AT_REMOVEDIR);
+		return -1;
+	}
+
+	/* The child moves itself into the cgroup, before dropping its privileges */
+	if ((fd = openat(task->cgfd, "cgroup.procs", O_WRONLY | O_CLOEXEC)) < 0) {
+		log_warn("Entry[0x%016llX]: cgroup_exec_create(): openat(\"%s/cgroup.procs\"): %s\n", hdr->id, task->cgname, strerror(errno));
+		close(task->cgfd);
+		task->cgfd = -1;
+		unlinkat(_cgroup_basefd, task->cgname, AT_REMOVEDIR);
+		return -1;
+	}
+
+	return fd;
+}
+
+void cgroup_exec_collect(struct usched_exec_task *task) {
+	if (task->cgfd < 0)
+		return;
+
+	/* Usage of the execution and of the processes it left behind, if any */
+	if (_cgroup_read_u64(task->cgfd, "cpu.stat", "usage_usec", &task->cpu_usec) < 0)
+		task->cpu_usec = 0;
+
+	/* memory.peak is only available since Linux 5.19 */
+	if (_cgroup_read_u64(task->cgfd, "memory.peak", NULL, &task->mem_peak) < 0)
+		task->mem_peak = 0;
+
+	close(task->cgfd);
+	task->cgfd = -1;
+
+	/* Processes left running by the execution keep the cgroup populated */
+	if ((_cgroup_basefd >= 0) && (unlinkat(_cgroup_basefd, task->cgname, AT_REMOVEDIR) < 0))
+		log_warn("cgroup_exec_collect(): unlinkat(\"%s\"): %s\n", task->cgname, strerror(errno));
+}
+#else
+void cgroup_exec_init(void) {
+	if (rune.config.exec.cgroup_use)
+		log_warn("cgroup_exec_init(): cgroups aren't supported on this platform. (Executions won't be placed in cgroups)\n");
+}
+
+void cgroup_exec_destroy(void) {
+	return;
+}
+
+int cgroup_exec_create(struct usched_exec_task *task) {
+	return -1;
+}
+
+void cgroup_exec_collect(struct usched_exec_task *task) {
+	return;
+}
+#endif
+
@@ -0,0 +1,161 @@
+/**
+ * @file credit.c
+ * @brief uSched
+ *        Executer flow control interface - Executer
+ *
+ * Date: 18-10-2026
+ *
+ * Copyright 2014-2015 Pedro A. Hortas (pah@ucodev.org)
+ *
+ * This file is part of usched.
+ *
+ * usched is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * usched is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with usched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "config.h"
+#include "runtime.h"
+#include "log.h"
+#include "ipc.h"
+#include "runq.h"
+#include "credit.h"
+
+static void _credit_exec_advertise(void) {
+	struct ipc_credit_hdr hdr;
+
+	memset(&hdr, 0, sizeof(struct ipc_credit_hdr));
+
+	hdr.epoch = rune.credit_epoch;
+
+	/* Read the received requests before the free capacity. Requests are only accounted as
+	 * received after being admitted, so the advertised capacity is never overestimated.
+	 */
+	pthread_mutex_lock(&rune.mutex_credit);
+	hdr.received = rune.credit_received;
+	pthread_mutex_unlock(&rune.mutex_credit);
+
+	hdr.free = runq_exec_free();
+
+	/* Advertisements are idempotent. If this one can't be sent, the next one will do. */
+	if (ipc_send_nowait(rune.pipcd, IPC_USE_ID, IPC_USD_ID, (char *) &hdr, sizeof(struct ipc_credit_hdr)) < 0) {
+		if (errno != EAGAIN)
+			log_warn("_credit_exec_advertise(): ipc_send_nowait(): %s\n", strerror(errno));
+	}
+}
+
+static void *_credit_exec_worker(void *arg) {
+	struct timespec ts;
+
+	arg = NULL; /* Unused */
+
+	pthread_mutex_lock(&rune.mutex_credit);
+
+	while (!rune.credit_stop) {
+		/* Coalesce the capacity changes that happened since the last advertisement */
+		rune.credit_notify = 0;
+
+		pthread_mutex_unlock(&rune.mutex_credit);
+
+		_credit_exec_advertise();
+
+		pthread_mutex_lock(&rune.mutex_credit);
+
+		if (rune.credit_notify || rune.credit_stop)
+			continue;
+
+		/* Wait for capacity changes, but advertise periodically in case usd missed one */
+		clock_gettime(CLOCK_REALTIME, &ts);
+
+		ts.tv_sec += CONFIG_USCHED_EXEC_CREDIT_INTERVAL / 1000;
+		ts.tv_nsec += (CONFIG_USCHED_EXEC_CREDIT_INTERVAL % 1000) * 1000000;
+
+		if (ts.tv_nsec >= 1000000000) {
+			ts.tv_sec ++;
+			ts.tv_nsec -= 1000000000;
+		}
+
+		pthread_cond_timedwait(&rune.cond_credit, &rune.mutex_credit, &ts);
+	}
+
+	pthread_mutex_unlock(&rune.mutex_credit);
+
+	pthread_exit(NULL);
+
+	return NULL;
+}
+
+void credit_exec_received(size_t count) {
+	pthread_mutex_lock(&rune.mutex_credit);
+
+	rune.credit_received += count;
+	rune.credit_notify = 1;
+
+	pthread_cond_signal(&rune.cond_credit);
+
+	pthread_mutex_unlock(&rune.mutex_credit);
+}
+
+void credit_exec_notify(void) {
+	pthread_mutex_lock(&rune.mutex_credit);
+
+	rune.credit_notify = 1;
+
+	pthread_cond_signal(&rune.cond_credit);
+
+	pthread_mutex_unlock(&rune.mutex_credit);
+}
+
+int credit_exec_init(void) {
+	int errsv = 0;
+	struct timespec ts;
+
+	/* A new epoch tells usd that anything in flight to a previous instance is gone */
+	clock_gettime(CLOCK_REALTIME, &ts);
+
+	rune.credit_epoch = ((uint64_t) ts.tv_sec * 1000000000) + (uint64_t) ts.tv_nsec;
+	rune.credit_received = 0;
+	rune.credit_notify = 1;
+	rune.credit_stop = 0;
+
+	/* Initialize capacity advertisements worker */
+	if ((errno = pthread_create(&rune.t_credit, NULL, &_credit_exec_worker, NULL))) {
+		errsv = errno;
+		log_warn("credit_exec_init(): pthread_create(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* All good */
+	return 0;
+}
+
+void credit_exec_destroy(void) {
+	pthread_mutex_lock(&rune.mutex_credit);
+
+	rune.credit_stop = 1;
+
+	pthread_cond_signal(&rune.cond_credit);
+
+	pthread_mutex_unlock(&rune.mutex_credit);
+
+	pthread_join(rune.t_credit, NULL);
+}
+
@@ -27,14 +27,18 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <stddef.h>
 #include <errno.h>
 #include <stdlib.h>
 #include <pthread.h>
 #include <time.h>
+#include <limits.h>
 
 #include <sys/types.h>
 #include <sys/wait.h>
+#include <sys/stat.h>
 #include <unistd.h>
+#include <fcntl.h>
 
 #include "config.h"
 #include "debug.h"
@@ -43,6 +47,19 @@
 #include "log.h"
 #include "bitops.h"
 #include "ipc.h"
+#include "overlap.h"
+#include "runq.h"
+#include "credit.h"
+#include "worker.h"
+#include "reap.h"
+#include "cgroup.h"
+
+#if CONFIG_USE_SPAWN == 1
+ #include <stdint.h>
+ #include <signal.h>
+ #include <sched.h>
+ #include <sys/syscall.h>
+#endif
 
 extern char **environ;
 
@@ -53,24 +70,44 @@ static int _uss_dispatch(
 	uint32_t pid,
 	uint32_t status,
 	const struct timespec *t_trigger,
+	const struct timespec *t_recv,
 	const struct timespec *t_start,
 	const struct timespec *t_end,
+	uint64_t cpu_usec,
+	uint64_t mem_peak,
+	uint64_t outdata_dropped,
 	const char *outdata)
 {
 	int errsv = 0;
+	size_t outdata_len = 0;
 	char *buf = NULL;
 	struct ipc_uss_hdr *hdr = NULL;
 
-	/* Allocate IPC buffer */
-	if (!(buf = mm_alloc((size_t) rune.config.ipc.msg_size))) {
+	/* Acquire the IPC buffer of this thread */
+	if (!(buf = ipc_buf_get((size_t) rune.config.ipc.msg_size))) {
 		errsv = errno;
-		log_warn("_uss_dispatch(): mm_alloc(): %s\n", strerror(errno));
+		log_warn("_uss_dispatch(): ipc_buf_get(): %s\n", strerror(errno));
 		errno = errsv;
 		return -1;
 	}
 
-	/* Reset IPC buffer */
-	memset(buf, 0, (size_t) rune.config.ipc.msg_size);
+	/* Truncate output data to the available message space */
+	outdata_len = strlen(outdata);
+
+	if (outdata_len >= (rune.config.ipc.msg_size - sizeof(struct ipc_uss_hdr))) {
+		outdata_dropped += outdata_len - (rune.config.ipc.msg_size - sizeof(struct ipc_uss_hdr) - 1);
+		outdata_len = rune.config.ipc.msg_size - sizeof(struct ipc_uss_hdr) - 1;
+	}
+
+	/* Validate message size */
+	if ((outdata_len + sizeof(struct timespec) + 1) > (size_t) rune.config.ipc.msg_size) {
+		log_warn("_uss_dispatch(): IPC message size too long (Entry ID: 0x%016llX)\n", id);
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Clear only the bytes that will be used by this message */
+	ipc_buf_reset(sizeof(struct ipc_uss_hdr) + outdata_len);
 
 	/* Craft IPC message header */
 	hdr 		 = (struct ipc_uss_hdr *) buf;
@@ -79,28 +116,22 @@ static int _uss_dispatch(
 	hdr->gid	 = gid;
 	hdr->pid	 = pid;
 	hdr->status 	 = status;
-	hdr->outdata_len = strlen(outdata);
-	hdr->outdata_len = (hdr->outdata_len >= (rune.config.ipc.msg_size - sizeof(struct ipc_uss_hdr))) ? (rune.config.ipc.msg_size - sizeof(struct ipc_uss_hdr) - 1) : hdr->outdata_len;
+	hdr->cpu_usec	 = cpu_usec;
+	hdr->mem_peak	 = mem_peak;
+	hdr->outdata_dropped = outdata_dropped;
+	hdr->outdata_len = outdata_len;
 	memcpy(&hdr->t_trigger, t_trigger, sizeof(struct timespec));
+	memcpy(&hdr->t_recv, t_recv, sizeof(struct timespec));
 	memcpy(&hdr->t_start, t_start, sizeof(struct timespec));
 	memcpy(&hdr->t_end, t_end, sizeof(struct timespec));
 
-	/* Validate message size */
-	if ((hdr->outdata_len + sizeof(struct timespec) + 1) > (size_t) rune.config.ipc.msg_size) {
-		log_warn("_uss_dispatch(): IPC message size too long (Entry ID: 0x%016llX)\n", id);
-		mm_free(buf);
-		errno = EINVAL;
-		return -1;
-	}
-
 	/* Append output data to IPC message */
 	memcpy(buf + sizeof(struct ipc_uss_hdr), outdata, hdr->outdata_len);
 
 	/* Dispatch IPC message to uss module */
-	if (ipc_send_nowait(rune.pipcd, IPC_USE_ID, IPC_USS_ID, buf, (size_t) rune.config.ipc.msg_size) < 0) {
+	if (ipc_send_nowait(rune.pipcd, IPC_USE_ID, IPC_USS_ID, buf, IPC_USS_FRAME_LEN(hdr)) < 0) {
 		errsv = errno;
 		log_warn("_uss_dispatch(): ipc_send_nowait(): %s\n", strerror(errno));
-		mm_free(buf);
 		errno = errsv;
 
 		/* Any of the following errno are a fatal condition and this module needs to
@@ -115,49 +146,408 @@ static int _uss_dispatch(
 		return -1;
 	}
 
-	/* Free IPC message memory */
-	mm_free(buf);
-
 	/* All good */
 	return 0;
 }
 
-static void *_exec_cmd(void *arg) {
-	char *buf = arg;	/* | id (64 bits) | uid (32 bits) | gid (32 bits) | trigger (32 bits) | cmd (...) ... | */
-	char child_outdata[CONFIG_USCHED_EXEC_OUTPUT_MAX];
-	ssize_t child_outlen = 0;
+static void _exec_release(void);
+static void _exec_dispatch(char *tbuf);
+
+static int _exec_pipe(int *opipe) {
+	int errsv = 0;
+
+	/* Other children, launched concurrently, must not inherit this pipe, or its read end
+	 * won't see the end of the output. Both ends are created close-on-exec, so no child can
+	 * be forked while they aren't.
+	 */
+	if (pipe2(opipe, O_CLOEXEC) < 0)
+		return -1;
+
+	/* The read end is non-blocking, as the reaper reads it as the output arrives */
+	if (fcntl(opipe[0], F_SETFL, fcntl(opipe[0], F_GETFL) | O_NONBLOCK) < 0) {
+		errsv = errno;
+		close(opipe[0]);
+		close(opipe[1]);
+		opipe[0] = opipe[1] = -1;
+		errno = errsv;
+		return -1;
+	}
+
+	return 0;
+}
+
+static int _exec_spool_dir(const struct ipc_use_hdr *hdr) {
+	int errsv = 0, dfd = -1;
+	char path[PATH_MAX];
+	struct stat st;
+
+	if (snprintf(path, sizeof(path), "%s/%u", rune.config.exec.spool_dir, (unsigned int) hdr->uid) >= (int) sizeof(path)) {
+		errno = ENAMETOOLONG;
+		return -1;
+	}
+
+	/* Each UID spools to its own directory, which is only accessible by its owner */
+	if ((mkdir(path, 0700) < 0) && (errno != EEXIST))
+		return -1;
+
+	if ((dfd = open(path, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC)) < 0)
+		return -1;
+
+	if (fstat(dfd, &st) < 0)
+		goto _error;
+
+#if CONFIG_USCHED_MULTIUSER == 1
+	if ((st.st_uid != (uid_t) hdr->uid) || (st.st_gid != (gid_t) hdr->gid)) {
+		if (fchown(dfd, (uid_t) hdr->uid, (gid_t) hdr->gid) < 0)
+			goto _error;
+	}
+#endif
+
+	if (((st.st_mode & 07777) != 0700) && (fchmod(dfd, 0700) < 0))
+		goto _error;
+
+	return dfd;
+
+_error:
+	errsv = errno;
+	close(dfd);
+	errno = errsv;
+
+	return -1;
+}
+
+static void _exec_spool_open(struct usched_exec_task *task) {
+	int dfd = -1;
+	char name[64];
+	struct ipc_use_hdr *hdr = (struct ipc_use_hdr *) task->buf;
+
+	if ((dfd = _exec_spool_dir(hdr)) < 0) {
+		log_warn("Entry[0x%016llX]: PID[%u]: _exec_spool_open(): _exec_spool_dir(): %s\n", hdr->id, task->pid, strerror(errno));
+		return;
+	}
+
+	snprintf(name, sizeof(name), "%016llX.%lld.%u", (unsigned long long) hdr->id, (long long) task->t_start.tv_sec, (unsigned int) task->pid);
+
+	/* Never follow or reuse an existing file: the directory belongs to the entry owner, who
+	 * could have placed a link to any other file under the expected name. Children must not
+	 * inherit the spool files of other executions.
+	 */
+	if ((task->sfd = openat(dfd, name, O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, 0640)) < 0) {
+		log_warn("Entry[0x%016llX]: PID[%u]: _exec_spool_open(): openat(\"%s/%u/%s\"): %s\n", hdr->id, task->pid, rune.config.exec.spool_dir, hdr->uid, name, strerror(errno));
+		close(dfd);
+		return;
+	}
+
+	close(dfd);
+
+#if CONFIG_USCHED_MULTIUSER == 1
+	/* The owner of the entry may read and remove its output */
+	if (fchown(task->sfd, (uid_t) hdr->uid, (gid_t) hdr->gid) < 0)
+		log_warn("Entry[0x%016llX]: PID[%u]: _exec_spool_open(): fchown(): %s\n", hdr->id, task->pid, strerror(errno));
+#endif
+
+	task->spool_max = rune.config.exec.spool_max;
+
+	log_info("Entry[0x%016llX]: PID[%u]: Spooling output to %s/%u/%s\n", hdr->id, task->pid, rune.config.exec.spool_dir, hdr->uid, name);
+}
+
+#if CONFIG_USE_SPAWN == 1
+struct usched_exec_spawn {
+	const char *cmd;
+	char *const *argv;	/* Arguments of a direct execution, or NULL to execute cmd by the shell */
+	uid_t uid;
+	gid_t gid;
+	int ofd;		/* Write end of the output pipe */
+	int cgprocs;		/* cgroup.procs of the execution cgroup (-1 if none) */
+	long fd_max;		/* Upper bound of the descriptors to be closed */
+	sigset_t sigmask;	/* Signal mask to be set before executing the command */
+};
+
+/* The child shares the memory of the executer, which is suspended until the command is
+ * executed or the child exits. Only calls that map directly to system calls can be used
+ * here, nothing that takes libc locks or touches state of other threads, and nothing can be
+ * allocated, freed or written outside of this stack.
+ */
+static int _exec_spawn_child(void *arg) {
+	const struct usched_exec_spawn *sp = arg;
+	struct sigaction sa;
+	long fd = 0;
+
+	/* Handlers of the executer can't run on the child */
+	memset(&sa, 0, sizeof(struct sigaction));
+	sa.sa_handler = SIG_DFL;
+
+	sigaction(SIGTERM, &sa, NULL);
+	sigaction(SIGINT, &sa, NULL);
+	sigaction(SIGQUIT, &sa, NULL);
+	sigaction(SIGHUP, &sa, NULL);
+
+	sigprocmask(SIG_SETMASK, &sp->sigmask, NULL);
+
+	/* Duplicate standard output and standard error */
+	if (sp->ofd >= 0) {
+		dup2(sp->ofd, STDOUT_FILENO);
+		dup2(sp->ofd, STDERR_FILENO);
+	}
+
+	/* Create a new session */
+	if (setsid() == (pid_t) -1)
+		_exit(CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_SETSID);
+
+	/* Move into the execution cgroup while still privileged. If this fails, the command
+	 * runs in the cgroup of the executer.
+	 */
+	if (sp->cgprocs >= 0)
+		(void) write(sp->cgprocs, "0", 1);
+
+	/* Redirect standard input */
+	if ((fd = open(CONFIG_SYS_DEV_ZERO, O_RDONLY)) < 0)
+		_exit(CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_FREOPEN_STDIN);
+
+	if ((fd != STDIN_FILENO) && (dup2(fd, STDIN_FILENO) < 0))
+		_exit(CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_FREOPEN_STDIN);
+
+#if CONFIG_USCHED_MULTIUSER == 1
+	/* Drop privileges, if required. The libc wrappers of these calls synchronize the
+	 * credentials of all the threads of the process, taking locks and signaling threads
+	 * that are shared with the suspended executer, so the raw system calls are used, as
+	 * posix_spawn() itself does. Only this task is affected, as it doesn't share the
+	 * credentials of the executer.
+	 */
+	if (syscall(SYS_setgroups, 0, NULL) < 0)
+		_exit(CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_SETREGID);
+
+	if (syscall(SYS_setresgid, sp->gid, sp->gid, sp->gid) < 0)
+		_exit(CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_SETREGID);
+
+	if (syscall(SYS_setresuid, sp->uid, sp->uid, sp->uid) < 0)
+		_exit(CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_SETREUID);
+#endif
+
+	/* Paranoid mode */
+	if ((getuid() != sp->uid) || (geteuid() != sp->uid))
+		_exit(CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_UID);
+
+	if ((getgid() != sp->gid) || (getegid() != sp->gid))
+		_exit(CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_GID);
+
+	/* No descriptors of the executer are inherited by the command */
+#ifdef SYS_close_range
+	if (syscall(SYS_close_range, 3, ~0U, 0) < 0)
+#endif
+	{
+		for (fd = 3; fd < sp->fd_max; fd ++)
+			close((int) fd);
+	}
+
+	/* Execute command */
+	if (sp->argv) {
+		execv(sp->argv[0], sp->argv);
+	} else {
+		execl(CONFIG_USCHED_SHELL_BIN_PATH, CONFIG_USCHED_SHELL_BIN_PATH, "-c", sp->cmd, (char *) NULL);
+	}
+
+	/* If reached, exec have failed */
+	_exit(CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_EXECLP);
+}
+
+static pid_t _exec_spawn(const struct ipc_use_hdr *hdr, const char *cmd, char *const *argv, int ofd, int cgprocs) {
+	int errsv = 0;
 	pid_t pid = 0;
-	int status = 0, opipe[2] = { 0, 0 };
-	char *cmd = buf + sizeof(struct ipc_use_hdr);
+	sigset_t si_all, si_orig;
+	struct usched_exec_spawn sp;
+	char stack[CONFIG_USCHED_EXEC_SPAWN_STACK_SIZE];
+
+	/* Unlike fork(), the cost of clone(CLONE_VM | CLONE_VFORK) doesn't grow with the memory
+	 * of the executer, as its page tables aren't copied.
+	 */
+	sp.cmd = cmd;
+	sp.argv = argv;
+	sp.uid = (uid_t) hdr->uid;
+	sp.gid = (gid_t) hdr->gid;
+	sp.ofd = ofd;
+	sp.cgprocs = cgprocs;
+
+	if ((sp.fd_max = sysconf(_SC_OPEN_MAX)) < 0)
+		sp.fd_max = 1024;
+
+	/* Signals are blocked until the child resets the handlers of the executer */
+	sigfillset(&si_all);
+
+	if ((errno = pthread_sigmask(SIG_SETMASK, &si_all, &si_orig)))
+		return (pid_t) -1;
+
+	/* Children get a clean SIGCHLD, even if the reaper blocks it */
+	sp.sigmask = si_orig;
+	sigdelset(&sp.sigmask, SIGCHLD);
+
+	/* The stack grows downwards. Its top must be aligned. */
+	pid = clone(&_exec_spawn_child, (void *) (((uintptr_t) (stack + sizeof(stack))) & ~((uintptr_t) 15)), CLONE_VM | CLONE_VFORK | SIGCHLD, &sp);
+
+	errsv = errno;
+	pthread_sigmask(SIG_SETMASK, &si_orig, NULL);
+	errno = errsv;
+
+	return pid;
+}
+#endif
+
+static char **_exec_argv(const struct ipc_use_hdr *hdr, char *cmd) {
+	uint32_t i = 0;
+	size_t offset = 0;
+	char **argv = NULL;
+
+	/* Each argument is followed by a NULL byte, so there can't be more than cmd_len + 1 */
+	if (hdr->argc > (hdr->cmd_len + 1)) {
+		errno = EINVAL;
+		return NULL;
+	}
+
+	if (!(argv = mm_alloc((hdr->argc + 1) * sizeof(char *))))
+		return NULL;
+
+	for (i = 0; i < hdr->argc; i ++) {
+		if (offset > hdr->cmd_len) {
+			mm_free(argv);
+			errno = EINVAL;
+			return NULL;
+		}
+
+		argv[i] = cmd + offset;
+		offset += strlen(argv[i]) + 1;
+	}
+
+	argv[i] = NULL;
+
+	return argv;
+}
+
+static void _exec_complete(struct usched_exec_task *task) {
+	char *buf = task->buf;	/* | struct ipc_use_hdr | cmd (...) ... | */
+	char *next = NULL;
 	struct ipc_use_hdr *hdr = (struct ipc_use_hdr *) buf;
-	struct timespec t_start, t_end, t_trigger;
+	struct timespec t_trigger;
 
-	/* Validate cmd length */
-	if (hdr->cmd_len >= (rune.config.ipc.msg_size - sizeof(struct ipc_use_hdr))) {
-		log_crit("_exec_cmd(): hdr->cmd_len is too long (%u bytes). Entry ID: 0x%016llX\n", hdr->cmd_len, hdr->id);
-		goto _exec_finish;
+	/* Exit status, output and end time were collected by the reaper */
+	if (task->pid > 0) {
+		debug_printf(DEBUG_INFO, "Entry[0x%016llX]: Output: %s\n", hdr->id, task->outdata);
+
+		/* Log errors (if any) based on exit status */
+		switch (WEXITSTATUS(task->status)) {
+			case CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_SETSID: {
+				log_warn("Entry[0x%016llX]: PID[%u]: setsid() failed.\n", hdr->id, task->pid);
+			} break;
+			case CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_FREOPEN_STDIN: {
+				log_warn("Entry[0x%016llX]: PID[%u]: freopen(%s, \"r\", stdout) failed.\n", hdr->id, task->pid, CONFIG_SYS_DEV_ZERO);
+			} break;
+			case CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_SETREGID: {
+				log_warn("Entry[0x%016llX]: PID[%u]: setregid() failed.\n", hdr->id, task->pid);
+			} break;
+			case CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_SETREUID: {
+				log_warn("Entry[0x%016llX]: PID[%u]: setreuid() failed.\n", hdr->id, task->pid);
+			} break;
+			case CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_UID: {
+				log_warn("Entry[0x%016llX]: PID[%u]: Failed to drop process privileges (UID).", hdr->id, task->pid);
+			} break;
+			case CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_GID: {
+				log_warn("Entry[0x%016llX]: PID[%u]: Failed to drop process privileges (GID).", hdr->id, task->pid);
+			} break;
+			case CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_EXECLP: {
+				log_warn("Entry[0x%016llX]: PID[%u]: execlp() failed.", hdr->id, task->pid);
+			} break;
+			case EXIT_SUCCESS:
+			default: break;
+		}
+
+		log_info("Entry[0x%016llX]: PID[%u]: Child exited. Exit Status: %d\n", hdr->id, task->pid, WEXITSTATUS(task->status));
 	}
 
+	/* Convert trigger format */
+	t_trigger.tv_sec  = hdr->trigger;
+	t_trigger.tv_nsec = 0;
+
+	/* Read the resource usage of the execution cgroup, if any, and remove it */
+	cgroup_exec_collect(task);
+
+	/* Send status and statistical data to uSched Status and Statistics */
+	if (_uss_dispatch(hdr->id, hdr->uid, hdr->gid, task->pid, task->status, &t_trigger, &hdr->t_recv, &task->t_start, &task->t_end, task->cpu_usec, task->mem_peak, task->outdropped, task->outdata) < 0)
+		log_warn("_exec_complete(): _uss_dispatch(): %s\n", strerror(errno));
+
+	/* Release this execution and fetch the pending one of this entry, if any */
+	next = overlap_exec_finish(hdr->id, task->pid);
+
+	/* Free task resources */
+	mm_free(buf);
+	mm_free(task);
+
+	/* Hand over the child slot of this execution to the run queue */
+	_exec_release();
+
+	/* Dispatch the pending execution of this entry, if any */
+	if (next)
+		_exec_dispatch(next);
+}
+
+static void _exec_launch(struct usched_exec_task *task) {
+	char *buf = task->buf;	/* | struct ipc_use_hdr | cmd (...) ... | */
+	pid_t pid = 0;
+	int opipe[2] = { -1, -1 }, cgprocs = -1;
+	char *cmd = buf + sizeof(struct ipc_use_hdr);
+	char **argv = NULL;
+	struct ipc_use_hdr *hdr = (struct ipc_use_hdr *) buf;
+
 	/* Grant NULL termination */
 	cmd[hdr->cmd_len] = 0;
 
 	/* Get the start time of execution */
-	clock_gettime(CLOCK_REALTIME, &t_start);
+	clock_gettime(CLOCK_REALTIME, &task->t_start);
+
+	/* Output kept for the stats record: half from its start and half from its end */
+	task->head_max = rune.config.exec.output_max / 2;
+	task->tail_max = rune.config.exec.output_max - task->head_max;
 
 	/* Create a pipe to read child output */
-	if (pipe(opipe) < 0)
-		log_warn("Entry[0x%016llX]: _exec_cmd(): pipe(): %s\n", hdr->id, strerror(errno));
+	if (_exec_pipe(opipe) < 0)
+		log_warn("Entry[0x%016llX]: _exec_launch(): _exec_pipe(): %s\n", hdr->id, strerror(errno));
+
+	/* Create the cgroup of this execution, if enabled. Without it, the child runs in the
+	 * cgroup of the executer.
+	 */
+	cgprocs = cgroup_exec_create(task);
 
 	/* Check delta time before executing event (Absolute value is a safe check. Negative values
 	 * won't occur here... hopefully).
 	 */
 	if ((unsigned int) labs((long) (time(NULL) - hdr->trigger)) >= rune.config.exec.delta_noexec) {
-		log_warn("Entry[0x%016llX]: _exec_cmd(): Entry delta T (%u seconds) is >= than the configured delta T for noexec (%d seconds). Ignoring execution...\n", hdr->id, time(NULL) - hdr->trigger, rune.config.exec.delta_noexec);
+		log_warn("Entry[0x%016llX]: _exec_launch(): Entry delta T (%u seconds) is >= than the configured delta T for noexec (%d seconds). Ignoring execution...\n", hdr->id, time(NULL) - hdr->trigger, rune.config.exec.delta_noexec);
+
+		/* Close pipe */
+		close(opipe[0]);
+		close(opipe[1]);
+	} else if (hdr->argc && !(argv = _exec_argv(hdr, cmd))) {
+		/* Arguments of a direct execution are invalid */
+		log_warn("Entry[0x%016llX]: _exec_launch(): _exec_argv(): %s\n", hdr->id, strerror(errno));
+
+		/* Close pipe */
+		close(opipe[0]);
+		close(opipe[1]);
+#if CONFIG_USE_SPAWN == 1
+	} else if ((pid = _exec_spawn(hdr, cmd, argv, opipe[1], cgprocs)) == (pid_t) -1) {	/* Create a new process, drop
+										 * privileges to UID and GID and
+										 * execute CMD
+										 */
+		/* Failure */
+		log_warn("Entry[0x%016llX]: _exec_launch(): _exec_spawn(): %s\n", hdr->id, strerror(errno));
+
+		/* Close pipe */
+		close(opipe[0]);
+		close(opipe[1]);
+#else
 	} else if ((pid = fork()) == (pid_t) -1) {	/* Create a new process, drop privileges to
 							 * UID and GID and execute CMD
 							 */
 		/* Failure */
-		log_warn("Entry[0x%016llX]: _exec_cmd(): fork(): %s\n", hdr->id, strerror(errno));
+		log_warn("Entry[0x%016llX]: _exec_launch(): fork(): %s\n", hdr->id, strerror(errno));
 
 		/* Close pipe */
 		close(opipe[0]);
@@ -187,15 +577,19 @@ static void *_exec_cmd(void *arg) {
 		/* Create a new session */
 		if (setsid() == (pid_t) -1) {
 			/* Free argument resources */
-			mm_free(arg);
+			mm_free(buf);
 
 			exit(CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_SETSID);
 		}
 
+		/* Move into the execution cgroup while still privileged */
+		if ((cgprocs >= 0) && (write(cgprocs, "0", 1) != 1))
+			debug_printf(DEBUG_INFO, "Entry[0x%016llX]: PID[%u]: write(cgprocs): %s\n", hdr->id, pid, strerror(errno));
+
 		/* Redirect standard files */
 		if (!freopen(CONFIG_SYS_DEV_ZERO, "r", stdin)) {
 			/* Free argument resources */
-			mm_free(arg);
+			mm_free(buf);
 
 			exit(CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_FREOPEN_STDIN);
 		}
@@ -204,14 +598,14 @@ static void *_exec_cmd(void *arg) {
 		/* Drop privileges, if required */
 		if (setregid(hdr->gid, hdr->gid) < 0) {
 			/* Free argument resources */
-			mm_free(arg);
+			mm_free(buf);
 
 			exit(CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_SETREGID);
 		}
 
 		if (setreuid(hdr->uid, hdr->uid) < 0) {
 			/* Free argument resources */
-			mm_free(arg);
+			mm_free(buf);
 
 			exit(CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_SETREUID);
 		}
@@ -220,14 +614,14 @@ static void *_exec_cmd(void *arg) {
 		/* Paranoid mode */
 		if ((getuid() != (uid_t) hdr->uid) || (geteuid() != (uid_t) hdr->uid)) {
 			/* Free argument resources */
-			mm_free(arg);
+			mm_free(buf);
 
 			exit(CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_UID);
 		}
 
 		if ((getgid() != (gid_t) hdr->gid) || (getegid() != (gid_t) hdr->gid)) {
 			/* Free argument resources */
-			mm_free(arg);
+			mm_free(buf);
 
 			exit(CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_GID);
 		}
@@ -235,125 +629,216 @@ static void *_exec_cmd(void *arg) {
 		/* Cleanup child */
 		runtime_exec_quiet_destroy();
 
-		/* Execute command */
-		execlp(CONFIG_USCHED_SHELL_BIN_PATH, CONFIG_USCHED_SHELL_BIN_PATH, "-c", cmd, (char *) NULL);
+		/* Execute command. Direct executions don't need a shell. */
+		if (argv) {
+			execv(argv[0], argv);
+		} else {
+			execlp(CONFIG_USCHED_SHELL_BIN_PATH, CONFIG_USCHED_SHELL_BIN_PATH, "-c", cmd, (char *) NULL);
+		}
 
-		/* If execlp() returns, it's safe to assume that it has failed */
+		/* If exec returns, it's safe to assume that it has failed */
 
 		/* Free argument resources */
-		mm_free(arg);
+		mm_free(buf);
 
 		/* If reached, execlp() have failed */
 		exit(CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_EXECLP);
+#endif
 	} else {
 		/* Parent */
-		log_info("Entry[0x%016llX]: PID[%u]: Executing '%s' [uid: %u, gid: %u]. Waiting for child to exit...\n", hdr->id, pid, cmd, hdr->uid, hdr->gid);
+		log_info("Entry[0x%016llX]: PID[%u]: Executing '%s' [uid: %u, gid: %u, argc: %u]. Waiting for child to exit...\n", hdr->id, pid, cmd, hdr->uid, hdr->gid, hdr->argc);
+
+		/* The arguments were only needed until the child executed the command */
+		if (argv)
+			mm_free(argv);
+
+		if (cgprocs >= 0)
+			close(cgprocs);
 
 		/* Close the write end of the output pipe */
 		close(opipe[1]);
 
-		/* Wait for child to return */
-		if (waitpid(pid, &status, 0) < 0)
-			log_crit("Entry[0x%016llX]: _exec_cmd(): waitpid(): %s\n", hdr->id, strerror(errno));
+		task->pid = pid;
+		task->ofd = opipe[0];
 
-		/* Read the output from the child process */
-		memset(child_outdata, 0, sizeof(child_outdata));
-		child_outlen = read(opipe[0], child_outdata, sizeof(child_outdata) - 1);
+		/* Spool the full output, if enabled */
+		if (rune.config.exec.spool_use && (task->ofd >= 0))
+			_exec_spool_open(task);
 
-		/* Process the output buffer */
-		if (child_outlen < 0) {
-			/* Set the error as the output */
-			snprintf(child_outdata, sizeof(child_outdata) - 1, "Entry[0x%016llX]: read(): %s\n", (unsigned long long) hdr->id, strerror(errno));
-		} else {
-			/* Grant NULL terination on output data buffer */
-			child_outdata[child_outlen] = 0;
-		}
+		/* The reaper collects the output and the exit of the child, and hands the task
+		 * back to the pool to be completed, so this worker is free to launch other
+		 * executions. The task must not be touched after being tracked, unless the child
+		 * was already reaped.
+		 */
+		if (reap_exec_track(task))
+			_exec_complete(task);
 
-		/* Close the read end of the pipe */
-		close(opipe[0]);
+		return;
+	}
 
-		debug_printf(DEBUG_INFO, "Entry[0x%016llX]: Output: %s\n", hdr->id, child_outdata);
+	/* Nothing was executed */
+	if (argv)
+		mm_free(argv);
 
-		/* Log errors (if any) based on exit status */
-		switch (WEXITSTATUS(status)) {
-			case CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_SETSID: {
-				log_warn("Entry[0x%016llX]: PID[%u]: setsid() failed.\n", hdr->id, pid);
-			} break;
-			case CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_FREOPEN_STDIN: {
-				log_warn("Entry[0x%016llX]: PID[%u]: freopen(%s, \"r\", stdout) failed.\n", hdr->id, pid, CONFIG_SYS_DEV_ZERO);
-			} break;
-			case CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_SETREGID: {
-				log_warn("Entry[0x%016llX]: PID[%u]: setregid() failed.\n", hdr->id, pid);
-			} break;
-			case CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_SETREUID: {
-				log_warn("Entry[0x%016llX]: PID[%u]: setreuid() failed.\n", hdr->id, pid);
-			} break;
-			case CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_UID: {
-				log_warn("Entry[0x%016llX]: PID[%u]: Failed to drop process privileges (UID).", hdr->id, pid);
-			} break;
-			case CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_GID: {
-				log_warn("Entry[0x%016llX]: PID[%u]: Failed to drop process privileges (GID).", hdr->id, pid);
-			} break;
-			case CONFIG_SYS_EXIT_CODE_CUSTOM_BASE + CHILD_EXIT_STATUS_FAILED_EXECLP: {
-				log_warn("Entry[0x%016llX]: PID[%u]: execlp() failed.", hdr->id, pid);
-			} break;
-			case EXIT_SUCCESS:
-			default: break;
-		}
+	if (cgprocs >= 0)
+		close(cgprocs);
+
+	clock_gettime(CLOCK_REALTIME, &task->t_end);
+
+	task->pid = pid;
+	task->status = 0;
 
-		log_info("Entry[0x%016llX]: PID[%u]: Child exited. Exit Status: %d\n", hdr->id, pid, WEXITSTATUS(status));
+	_exec_complete(task);
+}
+
+static void _exec_task(struct usched_exec_task *task) {
+	switch (task->type) {
+		case WORKER_TASK_LAUNCH: _exec_launch(task); break;
+		case WORKER_TASK_COMPLETE: _exec_complete(task); break;
+		default: {
+			log_crit("_exec_task(): Unknown task type: %d\n", task->type);
+		}
 	}
+}
 
-	/* Get the end time of the execution */
-	clock_gettime(CLOCK_REALTIME, &t_end);
+static int _exec_start(char *tbuf) {
+	int errsv = 0;
+	struct usched_exec_task *task = NULL;
 
-	/* Convert trigger format */
-	t_trigger.tv_sec  = hdr->trigger;
-	t_trigger.tv_nsec = 0;
+	if (!(task = mm_alloc(sizeof(struct usched_exec_task)))) {
+		errsv = errno;
+		log_warn("_exec_start(): mm_alloc(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
 
-	/* Send status and statistical data to uSched Status and Statistics */
-	if (_uss_dispatch(hdr->id, hdr->uid, hdr->gid, pid, status, &t_trigger, &t_start, &t_end, child_outdata) < 0)
-		log_warn("_exec_cmd(): _uss_dispatch(): %s\n", strerror(errno));
+	memset(task, 0, sizeof(struct usched_exec_task));
 
-_exec_finish:
-	/* Free argument resources */
-	mm_free(arg);
+	task->type = WORKER_TASK_LAUNCH;
+	task->buf = tbuf;
+	task->ofd = -1;
+	task->pidfd = -1;
+	task->sfd = -1;
+	task->cgfd = -1;
 
-	/* Terminate this thread */
-	pthread_exit(NULL);
+	/* Queue the execution to the worker pool */
+	if (worker_exec_submit(task) < 0) {
+		errsv = errno;
+		log_warn("_exec_start(): worker_exec_submit(): %s\n", strerror(errno));
+		mm_free(task);
+		errno = errsv;
+		return -1;
+	}
 
 	/* All good */
-	return NULL;
+	return 0;
 }
 
-static void _exec_process(void) {
-	int errsv = 0;
-	pthread_t ptid;
+static void _exec_abort(char *tbuf) {
+	uint64_t id = ((struct ipc_use_hdr *) tbuf)->id;
+	char *next = NULL;
+
+	/* This execution won't run. Release it and dispatch the pending one of this entry, if any */
+	mm_free(tbuf);
+
+	if ((next = overlap_exec_finish(id, 0)))
+		_exec_dispatch(next);
+}
+
+static void _exec_release(void) {
+	char *next = NULL;
+
+	/* Release a child slot. If an execution is waiting in the run queue, the slot is handed
+	 * over to it instead.
+	 */
+	while ((next = runq_exec_release())) {
+		if (!_exec_start(next))
+			break;
+
+		_exec_abort(next);
+	}
+}
+
+static void _exec_dispatch_verdict(char *tbuf, int verdict) {
+	switch (verdict) {
+		case RUNQ_EXEC_START: {
+			/* A child slot is reserved for this execution */
+			if (_exec_start(tbuf) < 0) {
+				_exec_release();
+				_exec_abort(tbuf);
+			}
+		} break;
+		case RUNQ_EXEC_QUEUED: {
+			debug_printf(DEBUG_INFO, "Entry[0x%016llX]: Executer is at its children limit. Execution queued.\n", ((struct ipc_use_hdr *) tbuf)->id);
+		} break;
+		default: {
+			/* The reason was already logged by the run queue */
+			log_warn("Entry[0x%016llX]: Execution rejected by the run queue.\n", ((struct ipc_use_hdr *) tbuf)->id);
+			_exec_abort(tbuf);
+		}
+	}
+}
+
+static void _exec_dispatch(char *tbuf) {
+	_exec_dispatch_verdict(tbuf, runq_exec_submit(tbuf));
+}
+
+static char *_exec_request(char *msg, const struct timespec *t_recv) {
+	size_t tbuf_len = 0;
 	char *tbuf = NULL;
+	struct ipc_use_hdr *hdr = (struct ipc_use_hdr *) msg;
+
+	/* Time of reception, used to measure the time spent waiting to be executed */
+	memcpy(&hdr->t_recv, t_recv, sizeof(struct timespec));
+
+	/* Validate cmd length */
+	if (hdr->cmd_len >= (rune.config.ipc.msg_size - sizeof(struct ipc_use_hdr))) {
+		log_crit("_exec_request(): hdr->cmd_len is too long (%u bytes). Entry ID: 0x%016llX\n", hdr->cmd_len, hdr->id);
+		return NULL;
+	}
+
+	/* The execution task owns its request, so only the used bytes of the message
+	 * are copied to a buffer of its own, plus one byte for the subject NULL termination.
+	 */
+	tbuf_len = sizeof(struct ipc_use_hdr) + hdr->cmd_len;
+
+	if (!(tbuf = mm_alloc(tbuf_len + 1))) {
+		log_warn("_exec_request(): tbuf = mm_alloc(): %s\n", strerror(errno));
+		return NULL;
+	}
+
+	memcpy(tbuf, msg, tbuf_len);
+	tbuf[tbuf_len] = 0;
+
+	return tbuf;
+}
+
+static void _exec_process(void) {
+	int errsv = 0, verdicts[CONFIG_USCHED_IPC_RECV_BATCH_MAX];
+	ssize_t nmemb = 0;
+	size_t i = 0, count = 0, received = 0, stride = 0, lens[CONFIG_USCHED_IPC_RECV_BATCH_MAX];
+	char *msgs = NULL, *tbufs[CONFIG_USCHED_IPC_RECV_BATCH_MAX];
+	struct timespec t_recv;
 
 	for (;;) {
 		/* Check for rutime interruptions */
 		if (runtime_exec_interrupted())
 			break;
 
-		/* Allocate temporary buffer size, plus one byte that won't be written to safe guard
-		 * the subject NULL termination
+		stride = IPC_RECV_BATCH_STRIDE(rune.config.ipc.msg_size);
+
+		/* Acquire the IPC batch buffer of this thread. Each message has an extra byte that
+		 * is never written, safe guarding the subject NULL termination.
 		 */
-		if (!(tbuf = mm_alloc((size_t) rune.config.ipc.msg_size + 1))) {
-			log_warn("_exec_process(): tbuf = mm_alloc(): %s\n", strerror(errno));
+		if (!(msgs = ipc_buf_get(stride * CONFIG_USCHED_IPC_RECV_BATCH_MAX))) {
+			log_warn("_exec_process(): ipc_buf_get(): %s\n", strerror(errno));
 			continue;
 		}
 
-		/* Reset all the memory to 0, granting the extra byte to be 0, so subject will
-		 * will always be NULL terminated regardless of the data received from the queue
-		 */
-		memset(tbuf, 0, (size_t) rune.config.ipc.msg_size + 1);
-
-		/* Wait for IPC message */
-		if (ipc_recv(rune.pipcd, (long [1]) { IPC_USD_ID }, (long [1]) { IPC_USE_ID }, tbuf, (size_t) rune.config.ipc.msg_size) < 0) {
+		/* Wait for IPC messages */
+		if ((nmemb = ipc_recv_frames(rune.pipcd, IPC_USD_ID, IPC_USE_ID, msgs, (size_t) rune.config.ipc.msg_size, CONFIG_USCHED_IPC_RECV_BATCH_MAX, lens, sizeof(struct ipc_use_hdr), offsetof(struct ipc_use_hdr, cmd_len), NULL)) < 0) {
 			errsv = errno;
-			log_warn("_exec_process(): ipc_recv(): %s\n", strerror(errno));
-			mm_free(tbuf);
+			log_warn("_exec_process(): ipc_recv_frames(): %s\n", strerror(errno));
 			errno = errsv;
 
 			/* Any of the following errno are a fatal condition and this module needs to
@@ -367,18 +852,52 @@ static void _exec_process(void) {
 			continue;
 		}
 
-		/* Create a new thread for command execution */
-		if ((errno = pthread_create(&ptid, NULL, _exec_cmd, tbuf))) {
-			log_warn("_exec_process(): pthread_create(): %s\n", strerror(errno));
-			mm_free(tbuf);
-			continue;
+		/* Track the bytes written by the receive operation */
+		ipc_buf_dirty(((size_t) nmemb - 1) * stride + lens[nmemb - 1] + 1);
+
+		received = (size_t) nmemb;
+
+		/* All the messages of this batch were received at the same wakeup */
+		clock_gettime(CLOCK_REALTIME, &t_recv);
+
+		/* Copy each valid request to a buffer owned by its execution */
+		for (i = 0, count = 0; i < (size_t) nmemb; i ++) {
+			if ((tbufs[count] = _exec_request(msgs + (i * stride), &t_recv)))
+				count ++;
 		}
 
-		/* Detach the newly created thread as the resources should be automatically free'd
-		 * upon thread termination.
-		 */
-		if ((errno = pthread_detach(ptid)))
-			log_crit("_exec_process(): pthread_detach(): %s. (Possible memory leak)\n", strerror(errno));
+		/* Apply the overlap policy of each entry against its running executions */
+		overlap_exec_admit_batch(tbufs, verdicts, count);
+
+		for (i = 0, nmemb = 0; i < count; i ++) {
+			switch (verdicts[i]) {
+				case OVERLAP_EXEC_START: break;
+				case OVERLAP_EXEC_SKIP: {
+					log_info("Entry[0x%016llX]: Concurrency limit reached. Skipping execution...\n", ((struct ipc_use_hdr *) tbufs[i])->id);
+					mm_free(tbufs[i]);
+				} continue;
+				case OVERLAP_EXEC_QUEUED: {
+					log_info("Entry[0x%016llX]: Concurrency limit reached. Execution queued.\n", ((struct ipc_use_hdr *) tbufs[i])->id);
+				} continue;
+				default: {
+					/* Untracked executions are still allowed to run */
+					log_warn("_exec_process(): overlap_exec_admit_batch(): Entry[0x%016llX] not tracked.\n", ((struct ipc_use_hdr *) tbufs[i])->id);
+				}
+			}
+
+			/* Keep the admitted ones, in order */
+			tbufs[nmemb ++] = tbufs[i];
+		}
+
+		/* Reserve child slots, or run queue positions, for the whole batch */
+		runq_exec_submit_batch(tbufs, verdicts, (size_t) nmemb);
+
+		/* Start the executions, or leave them waiting in the run queue */
+		for (i = 0; i < (size_t) nmemb; i ++)
+			_exec_dispatch_verdict(tbufs[i], verdicts[i]);
+
+		/* The capacity used by these requests is now accounted. Let usd know. */
+		credit_exec_received(received);
 	}
 }
 
@@ -387,9 +906,49 @@ static void _init(int argc, char **argv) {
 		log_crit("_init(): runtime_exec_init(): %s\n", strerror(errno));
 		exit(EXIT_FAILURE);
 	}
+
+	/* Initialize the execution workers */
+	if (worker_exec_init(&_exec_task) < 0) {
+		log_crit("_init(): worker_exec_init(): %s\n", strerror(errno));
+		exit(EXIT_FAILURE);
+	}
+
+	/* Initialize the children reaper */
+	if (reap_exec_init() < 0) {
+		log_crit("_init(): reap_exec_init(): %s\n", strerror(errno));
+		exit(EXIT_FAILURE);
+	}
+
+	/* Place executions in cgroups, if enabled and available */
+	cgroup_exec_init();
+
+	/* Create the output spool directory, if required. It can be traversed, but not listed,
+	 * by other users, which reach their own output through the per-UID directories below it.
+	 */
+	if (rune.config.exec.spool_use) {
+		if ((mkdir(rune.config.exec.spool_dir, 0711) < 0) && (errno != EEXIST))
+			log_warn("_init(): mkdir(\"%s\"): %s\n", rune.config.exec.spool_dir, strerror(errno));
+		else if (chmod(rune.config.exec.spool_dir, 0711) < 0)
+			log_warn("_init(): chmod(\"%s\"): %s\n", rune.config.exec.spool_dir, strerror(errno));
+	}
+
+	log_info("Executer started with %u worker threads.\n", rune.workers_nmemb);
 }
 
 static void _destroy(void) {
+	/* Stop collecting children before the workers are gone. Children still running are
+	 * reaped after the next initialization.
+	 */
+	reap_exec_destroy();
+
+	/* Let the workers finish the queued tasks */
+	worker_exec_destroy();
+
+	cgroup_exec_destroy();
+
+	/* Release the IPC buffer of the main thread */
+	ipc_buf_destroy();
+
 	runtime_exec_destroy();
 }
 
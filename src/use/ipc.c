@@ -40,6 +40,18 @@
 int ipc_exec_init(void) {
 	int errsv = 0;
 
+	/* Attach to the shared memory rings, if selected as the message transport */
+	if (rune.config.ipc.transport_shm) {
+		if (ipc_shm_attach(&rune.config.ipc, IPC_USE_ID) < 0) {
+			errsv = errno;
+			log_warn("ipc_exec_init(): ipc_shm_attach(): %s\n", strerror(errno));
+			errno = errsv;
+			return -1;
+		}
+
+		return 0;
+	}
+
 	/* Create key */
 	rune.pipck = (pipck_t) rune.config.ipc.id_key;
 
@@ -56,6 +68,11 @@ int ipc_exec_init(void) {
 }
 
 void ipc_exec_destroy(void) {
+	if (rune.config.ipc.transport_shm) {
+		ipc_shm_detach();
+		return;
+	}
+
 	if (pipc_slave_unregister(rune.pipcd) < 0)
 		log_warn("ipc_exec_destroy(): pipc_slave_unregister(): %s\n", strerror(errno));
 }
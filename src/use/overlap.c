@@ -0,0 +1,336 @@
+/**
+ * @file overlap.c
+ * @brief uSched
+ *        Execution overlap control interface - Exec
+ *
+ * Date: 18-10-2026
+ *
+ * Copyright 2014-2015 Pedro A. Hortas (pah@ucodev.org)
+ *
+ * This file is part of usched.
+ *
+ * usched is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * usched is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with usched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include <sys/types.h>
+#include <sys/syscall.h>
+
+#include <pall/cll.h>
+
+#include "config.h"
+#include "runtime.h"
+#include "mm.h"
+#include "log.h"
+#include "ipc.h"
+#include "entry.h"
+#include "overlap.h"
+
+static int _overlap_exec_compare(const void *o1, const void *o2) {
+	const struct usched_overlap_entry *po1 = o1, *po2 = o2;
+
+	if (po1->id > po2->id)
+		return 1;
+
+	if (po1->id < po2->id)
+		return -1;
+
+	return 0;
+}
+
+static void _overlap_exec_destroy(void *elem) {
+	unsigned int i = 0;
+	struct usched_overlap_entry *o = elem;
+
+	for (i = 0; i < o->pids_nmemb; i ++) {
+		if (o->pids[i].pidfd >= 0)
+			close(o->pids[i].pidfd);
+	}
+
+	if (o->pids)
+		mm_free(o->pids);
+
+	if (o->queued)
+		mm_free(o->queued);
+
+	mm_free(o);
+}
+
+static unsigned int _overlap_exec_limit(const struct ipc_use_hdr *hdr) {
+	/* An explicit limit always applies */
+	if (hdr->concurrency)
+		return hdr->concurrency;
+
+	/* Otherwise, only the 'allow' policy permits unlimited (0) concurrent executions */
+	return (hdr->overlap == USCHED_ENTRY_OVERLAP_ALLOW) ? 0 : 1;
+}
+
+static int _overlap_exec_pidfd_signal(int pidfd, int sig) {
+#ifdef SYS_pidfd_send_signal
+	return (int) syscall(SYS_pidfd_send_signal, pidfd, sig, NULL, 0);
+#else
+	errno = ENOSYS;
+	return -1;
+#endif
+}
+
+static void _overlap_exec_kill(struct usched_overlap_entry *o) {
+	unsigned int i = 0;
+	pid_t pid = 0;
+
+	for (i = 0; i < o->pids_nmemb; i ++) {
+		pid = o->pids[i].pid;
+
+		log_info("Entry[0x%016llX]: PID[%u]: Overlap policy is 'kill'. Terminating previous execution...\n", o->id, pid);
+
+		/* PIDs are forgotten by the reaper before their exit is reported, but a child may
+		 * have just been reaped. The process descriptor always refers to the execution:
+		 * while it can be signaled, the child isn't reaped and its PID can't be reused.
+		 */
+		if ((o->pids[i].pidfd >= 0) && (_overlap_exec_pidfd_signal(o->pids[i].pidfd, SIGTERM) < 0)) {
+			if (errno != ESRCH)
+				log_warn("Entry[0x%016llX]: PID[%u]: _overlap_exec_kill(): pidfd_send_signal(): %s\n", o->id, pid, strerror(errno));
+
+			continue;
+		}
+
+		/* Children are session leaders, so signal the whole process group. Fallback to the
+		 * process itself if it didn't create its session yet.
+		 */
+		if ((kill(-pid, SIGTERM) < 0) && (kill(pid, SIGTERM) < 0) && (o->pids[i].pidfd < 0))
+			log_warn("Entry[0x%016llX]: PID[%u]: _overlap_exec_kill(): kill(): %s\n", o->id, pid, strerror(errno));
+	}
+}
+
+/* NOTE: Must be called with rune.mutex_opool held */
+static void _overlap_exec_pid_forget(struct usched_overlap_entry *o, pid_t pid) {
+	unsigned int i = 0;
+
+	for (i = 0; i < o->pids_nmemb; i ++) {
+		if (o->pids[i].pid != pid)
+			continue;
+
+		if (o->pids[i].pidfd >= 0)
+			close(o->pids[i].pidfd);
+
+		o->pids[i] = o->pids[-- o->pids_nmemb];
+
+		break;
+	}
+}
+
+int overlap_exec_init(void) {
+	int errsv = 0;
+
+	if (!(rune.opool = pall_cll_init(&_overlap_exec_compare, &_overlap_exec_destroy, NULL, NULL))) {
+		errsv = errno;
+		log_crit("overlap_exec_init(): rune.opool = pall_cll_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Setup CLL: No auto search, head insert, search forward */
+	(void) rune.opool->set_config(rune.opool, (ui32_t) (CONFIG_SEARCH_FORWARD | CONFIG_INSERT_HEAD));
+
+	/* All good */
+	return 0;
+}
+
+void overlap_exec_destroy(void) {
+	pthread_mutex_lock(&rune.mutex_opool);
+
+	if (rune.opool) {
+		pall_cll_destroy(rune.opool);
+		rune.opool = NULL;
+	}
+
+	pthread_mutex_unlock(&rune.mutex_opool);
+}
+
+/* NOTE: Must be called with rune.mutex_opool held */
+static int _overlap_exec_admit(char *buf) {
+	int errsv = 0, ret = OVERLAP_EXEC_START;
+	unsigned int limit = 0;
+	struct ipc_use_hdr *hdr = (struct ipc_use_hdr *) buf;
+	struct usched_overlap_entry *o = NULL;
+
+	limit = _overlap_exec_limit(hdr);
+
+	/* Search for the running executions of this entry, or start tracking them */
+	if (!(o = rune.opool->search(rune.opool, (struct usched_overlap_entry [1]) { { hdr->id, } }))) {
+		if (!(o = mm_alloc(sizeof(struct usched_overlap_entry)))) {
+			errsv = errno;
+			log_warn("_overlap_exec_admit(): mm_alloc(): %s\n", strerror(errno));
+			errno = errsv;
+			return -1;
+		}
+
+		memset(o, 0, sizeof(struct usched_overlap_entry));
+
+		o->id = hdr->id;
+
+		if (rune.opool->insert(rune.opool, o) < 0) {
+			errsv = errno;
+			log_warn("_overlap_exec_admit(): rune.opool->insert(): %s\n", strerror(errno));
+			mm_free(o);
+			errno = errsv;
+			return -1;
+		}
+	}
+
+	/* Start the execution if the concurrency limit wasn't reached yet */
+	if (!limit || (o->running < limit)) {
+		o->running ++;
+
+		return ret;
+	}
+
+	/* Otherwise, apply the overlap policy */
+	switch (hdr->overlap) {
+		case USCHED_ENTRY_OVERLAP_QUEUE: {
+			/* Only one execution is kept pending. A newer one replaces it. */
+			if (o->queued) {
+				log_info("Entry[0x%016llX]: Overlap policy is 'queue'. Replacing the pending execution.\n", hdr->id);
+				mm_free(o->queued);
+			}
+
+			o->queued = buf;
+
+			ret = OVERLAP_EXEC_QUEUED;
+		} break;
+		case USCHED_ENTRY_OVERLAP_KILL: {
+			_overlap_exec_kill(o);
+
+			o->running ++;
+		} break;
+		case USCHED_ENTRY_OVERLAP_SKIP:
+		case USCHED_ENTRY_OVERLAP_ALLOW:
+		default: {
+			ret = OVERLAP_EXEC_SKIP;
+		} break;
+	}
+
+	return ret;
+}
+
+int overlap_exec_admit(char *buf) {
+	int ret = 0;
+
+	pthread_mutex_lock(&rune.mutex_opool);
+
+	ret = _overlap_exec_admit(buf);
+
+	pthread_mutex_unlock(&rune.mutex_opool);
+
+	return ret;
+}
+
+void overlap_exec_admit_batch(char **bufs, int *verdicts, size_t nmemb) {
+	size_t i = 0;
+
+	pthread_mutex_lock(&rune.mutex_opool);
+
+	for (i = 0; i < nmemb; i ++)
+		verdicts[i] = _overlap_exec_admit(bufs[i]);
+
+	pthread_mutex_unlock(&rune.mutex_opool);
+}
+
+/* NOTE: Called by the reaper, with the child not reaped yet. The process descriptor, if any,
+ * is duplicated, as the reaper closes its own once the child is reaped.
+ */
+void overlap_exec_pid_set(uint64_t id, pid_t pid, int pidfd) {
+	struct usched_overlap_pid *pids = NULL;
+	struct usched_overlap_entry *o = NULL;
+
+	pthread_mutex_lock(&rune.mutex_opool);
+
+	if (!rune.opool || !(o = rune.opool->search(rune.opool, (struct usched_overlap_entry [1]) { { id, } })))
+		goto _finish;
+
+	if (!(pids = mm_realloc(o->pids, (o->pids_nmemb + 1) * sizeof(struct usched_overlap_pid)))) {
+		log_warn("Entry[0x%016llX]: PID[%u]: overlap_exec_pid_set(): mm_realloc(): %s\n", id, pid, strerror(errno));
+		goto _finish;
+	}
+
+	o->pids = pids;
+	o->pids[o->pids_nmemb].pid = pid;
+	o->pids[o->pids_nmemb].pidfd = -1;
+
+	if ((pidfd >= 0) && ((o->pids[o->pids_nmemb].pidfd = fcntl(pidfd, F_DUPFD_CLOEXEC, 0)) < 0))
+		log_warn("Entry[0x%016llX]: PID[%u]: overlap_exec_pid_set(): fcntl(): %s\n", id, pid, strerror(errno));
+
+	o->pids_nmemb ++;
+
+_finish:
+	pthread_mutex_unlock(&rune.mutex_opool);
+}
+
+/* NOTE: Called by the reaper as soon as the child is reaped, before its PID can be reused */
+void overlap_exec_pid_clear(uint64_t id, pid_t pid) {
+	struct usched_overlap_entry *o = NULL;
+
+	pthread_mutex_lock(&rune.mutex_opool);
+
+	if (rune.opool && (o = rune.opool->search(rune.opool, (struct usched_overlap_entry [1]) { { id, } })))
+		_overlap_exec_pid_forget(o, pid);
+
+	pthread_mutex_unlock(&rune.mutex_opool);
+}
+
+char *overlap_exec_finish(uint64_t id, pid_t pid) {
+	unsigned int limit = 0;
+	char *next = NULL;
+	struct usched_overlap_entry *o = NULL;
+
+	pthread_mutex_lock(&rune.mutex_opool);
+
+	if (!(o = rune.opool->search(rune.opool, (struct usched_overlap_entry [1]) { { id, } })))
+		goto _finish;
+
+	/* Forget the PID of the finished execution, if the reaper didn't already */
+	_overlap_exec_pid_forget(o, pid);
+
+	if (o->running)
+		o->running --;
+
+	/* Hand over the pending execution, if any, as soon as the limit allows it */
+	if (o->queued) {
+		limit = _overlap_exec_limit((struct ipc_use_hdr *) o->queued);
+
+		if (!limit || (o->running < limit)) {
+			next = o->queued;
+			o->queued = NULL;
+			o->running ++;
+		}
+	}
+
+	/* Stop tracking this entry if there's nothing left running or pending */
+	if (!o->running && !o->queued)
+		rune.opool->del(rune.opool, o);
+
+_finish:
+	pthread_mutex_unlock(&rune.mutex_opool);
+
+	return next;
+}
+
@@ -0,0 +1,818 @@
+/**
+ * @file reap.c
+ * @brief uSched
+ *        Execution children reaper interface - Exec
+ *
+ * Date: 18-10-2026
+ *
+ * Copyright 2014-2015 Pedro A. Hortas (pah@ucodev.org)
+ *
+ * This file is part of usched.
+ *
+ * usched is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * usched is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with usched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "config.h"
+#include "runtime.h"
+#include "mm.h"
+#include "log.h"
+#include "worker.h"
+#include "overlap.h"
+#include "reap.h"
+
+#if CONFIG_USE_EPOLL == 1
+ #include <sys/epoll.h>
+ #include <sys/signalfd.h>
+ #include <sys/syscall.h>
+#else
+ #include <poll.h>
+#endif
+
+/*
+ * Children table, indexed by pid. It's kept outside of the runtime structure so it survives a
+ * reload: children that are still running when the executer is reinitialized are reaped by the
+ * next reaper instance. Entries without a buffer are placeholders for children that exited
+ * before being tracked by their launcher.
+ */
+static struct usched_exec_task *_reap_children[CONFIG_USCHED_EXEC_CHILDREN_BUCKETS];
+static size_t _reap_children_nmemb = 0;		/* Tracked children (placeholders excluded) */
+static pthread_mutex_t _reap_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+#if CONFIG_USE_EPOLL == 1
+/* Event sources. Like the table, they outlive the reaper threads. */
+static int _reap_epfd = -1;
+static int _reap_sigfd = -1;
+static int _reap_pidfd = 0;			/* Process descriptors are supported */
+static size_t _reap_unwatched = 0;		/* Tracked children without a process descriptor */
+static struct usched_reap_event _reap_ev_signal = { NULL, REAP_EVENT_SIGNAL };
+#else
+static uint64_t _reap_generation = 0;		/* Bumped whenever a child is tracked */
+static pthread_cond_t _reap_cond = PTHREAD_COND_INITIALIZER;
+#endif
+
+/* NOTE: Must be called with _reap_mutex held */
+static void _reap_link(struct usched_exec_task *task) {
+	struct usched_exec_task **head = &_reap_children[(size_t) task->pid % CONFIG_USCHED_EXEC_CHILDREN_BUCKETS];
+
+	task->next = *head;
+	*head = task;
+
+	if (task->buf)
+		_reap_children_nmemb ++;
+}
+
+/* NOTE: Must be called with _reap_mutex held */
+static struct usched_exec_task *_reap_unlink(pid_t pid) {
+	struct usched_exec_task **prev = &_reap_children[(size_t) pid % CONFIG_USCHED_EXEC_CHILDREN_BUCKETS];
+	struct usched_exec_task *task = NULL;
+
+	for (; *prev; prev = &(*prev)->next) {
+		if ((*prev)->pid != pid)
+			continue;
+
+		task = *prev;
+		*prev = task->next;
+		task->next = NULL;
+
+		if (task->buf)
+			_reap_children_nmemb --;
+
+		return task;
+	}
+
+	return NULL;
+}
+
+/* NOTE: Must be called with _reap_mutex held */
+static void _reap_placeholder(pid_t pid, int status) {
+	struct usched_exec_task *task = NULL;
+
+	/* Not tracked yet. Leave the exit status to its launcher. */
+	if (!(task = mm_alloc(sizeof(struct usched_exec_task)))) {
+		log_crit("_reap_placeholder(): mm_alloc(): %s. (Exit status of PID %u lost)\n", strerror(errno), pid);
+		return;
+	}
+
+	memset(task, 0, sizeof(struct usched_exec_task));
+
+	task->pid = pid;
+	task->status = status;
+	task->ofd = -1;
+	task->pidfd = -1;
+	task->sfd = -1;
+	task->cgfd = -1;
+
+	_reap_link(task);
+}
+
+static void _reap_output_close(struct usched_exec_task *task) {
+#if CONFIG_USE_EPOLL == 1
+	/* Fails harmlessly if it was never registered */
+	epoll_ctl(_reap_epfd, EPOLL_CTL_DEL, task->ofd, NULL);
+#endif
+	close(task->ofd);
+
+	task->ofd = -1;
+}
+
+static int _reap_write(int fd, const char *data, size_t len) {
+	ssize_t ret = 0;
+
+	while (len) {
+		if ((ret = write(fd, data, len)) < 0) {
+			if (errno == EINTR)
+				continue;
+
+			return -1;
+		}
+
+		data += ret;
+		len -= (size_t) ret;
+	}
+
+	return 0;
+}
+
+static void _reap_output_store(struct usched_exec_task *task, const char *data, size_t len) {
+	size_t count = 0;
+
+	task->outtotal += len;
+
+	/* Spool the full output, up to its limit */
+	if (task->sfd >= 0) {
+		count = len;
+
+		if (task->spool_max && ((task->spooled + count) > task->spool_max))
+			count = (size_t) (task->spool_max - task->spooled);
+
+		if (count && (_reap_write(task->sfd, data, count) < 0)) {
+			log_warn("Entry[0x%016llX]: PID[%u]: _reap_write(): %s. (Output spooling stopped)\n", ((struct ipc_use_hdr *) task->buf)->id, task->pid, strerror(errno));
+			close(task->sfd);
+			task->sfd = -1;
+		} else {
+			task->spooled += count;
+		}
+	}
+
+	/* Fill the head first */
+	if (task->outlen < task->head_max) {
+		count = (len < (task->head_max - task->outlen)) ? len : (task->head_max - task->outlen);
+
+		memcpy(task->outdata + task->outlen, data, count);
+
+		task->outlen += count;
+		data += count;
+		len -= count;
+	}
+
+	if (!len || !task->tail_max)
+		return;
+
+	/* Then keep the last bytes in the tail ring */
+	if (len >= task->tail_max) {
+		memcpy(task->outtail, data + len - task->tail_max, task->tail_max);
+
+		task->tail_pos = 0;
+		task->tail_len = task->tail_max;
+
+		return;
+	}
+
+	while (len) {
+		count = (len < (task->tail_max - task->tail_pos)) ? len : (task->tail_max - task->tail_pos);
+
+		memcpy(task->outtail + task->tail_pos, data, count);
+
+		task->tail_pos = (task->tail_pos + count) % task->tail_max;
+		task->tail_len = ((task->tail_len + count) < task->tail_max) ? (task->tail_len + count) : task->tail_max;
+		data += count;
+		len -= count;
+	}
+}
+
+static void _reap_output_join(struct usched_exec_task *task) {
+	int ret = 0;
+	size_t room = 0, count = 0, start = 0, part = 0;
+
+	task->outdropped = task->outtotal - task->outlen - task->tail_len;
+
+	/* Mark the gap between the head and the tail */
+	if (task->outdropped && ((ret = snprintf(task->outdata + task->outlen, sizeof(task->outdata) - task->outlen, "\n[... %llu bytes dropped ...]\n", (unsigned long long) task->outdropped)) > 0))
+		task->outlen = ((task->outlen + (size_t) ret) < (sizeof(task->outdata) - 1)) ? (task->outlen + (size_t) ret) : (sizeof(task->outdata) - 1);
+
+	/* Append as much of the tail as fits, keeping its last bytes */
+	room = sizeof(task->outdata) - 1 - task->outlen;
+	count = (task->tail_len < room) ? task->tail_len : room;
+
+	task->outdropped += task->tail_len - count;
+
+	if (count) {
+		start = (task->tail_pos + task->tail_max - count) % task->tail_max;
+		part = ((task->tail_max - start) < count) ? (task->tail_max - start) : count;
+
+		memcpy(task->outdata + task->outlen, task->outtail + start, part);
+		memcpy(task->outdata + task->outlen + part, task->outtail, count - part);
+
+		task->outlen += count;
+	}
+
+	task->outdata[task->outlen] = 0;
+}
+
+/* NOTE: Must be called with _reap_mutex held */
+static void _reap_output(struct usched_exec_task *task) {
+	unsigned int reads = 0;
+	ssize_t ret = 0;
+	char chunk[CONFIG_USCHED_EXEC_OUTPUT_MAX];
+
+	/* Read a bounded amount per wakeup, so a single chatty child can't hold the reaper. The
+	 * pipe is watched (or polled) again, so whatever is left is read on the next wakeup.
+	 */
+	while (reads < CONFIG_USCHED_EXEC_REAP_OUTPUT_READS) {
+		if ((ret = read(task->ofd, chunk, sizeof(chunk))) > 0) {
+			_reap_output_store(task, chunk, (size_t) ret);
+			reads ++;
+			continue;
+		}
+
+		if (!ret) {
+			/* End of output */
+			_reap_output_close(task);
+			return;
+		}
+
+		if (errno == EINTR)
+			continue;
+
+		if (errno == EAGAIN)
+			return;
+
+		/* Set the error as the output, if there's none */
+		if (!task->outtotal) {
+			snprintf(task->outdata, sizeof(task->outdata) - 1, "Entry[0x%016llX]: read(): %s\n", (unsigned long long) ((struct ipc_use_hdr *) task->buf)->id, strerror(errno));
+			task->outlen = strlen(task->outdata);
+			task->outtotal = task->outlen;
+		}
+
+		_reap_output_close(task);
+
+		return;
+	}
+}
+
+/* NOTE: Must be called with _reap_mutex held, and the task removed from the table */
+static void _reap_finish(struct usched_exec_task *task, int status, struct usched_exec_task **done) {
+	clock_gettime(CLOCK_REALTIME, &task->t_end);
+
+	/* The PID may be reused from now on, so newer executions of the entry must not signal it */
+	overlap_exec_pid_clear(((struct ipc_use_hdr *) task->buf)->id, task->pid);
+
+	task->status = status;
+	task->exited = 1;
+	task->type = WORKER_TASK_COMPLETE;
+
+	/* Collect what's left of the output, up to the per wakeup bound. Descendants of the child
+	 * may keep the pipe open and writing, so don't wait for its end.
+	 */
+	if (task->ofd >= 0)
+		_reap_output(task);
+
+	if (task->ofd >= 0)
+		_reap_output_close(task);
+
+	_reap_output_join(task);
+
+	if (task->sfd >= 0) {
+		if (task->spooled < task->outtotal)
+			log_warn("Entry[0x%016llX]: PID[%u]: Spooled output truncated to %llu of %llu bytes.\n", ((struct ipc_use_hdr *) task->buf)->id, task->pid, (unsigned long long) task->spooled, (unsigned long long) task->outtotal);
+
+		close(task->sfd);
+		task->sfd = -1;
+	}
+
+#if CONFIG_USE_EPOLL == 1
+	if (task->pidfd >= 0) {
+		epoll_ctl(_reap_epfd, EPOLL_CTL_DEL, task->pidfd, NULL);
+		close(task->pidfd);
+		task->pidfd = -1;
+	}
+#endif
+
+	task->next = *done;
+	*done = task;
+}
+
+static void _reap_submit(struct usched_exec_task *done) {
+	struct usched_exec_task *task = NULL;
+
+	while ((task = done)) {
+		done = task->next;
+		task->next = NULL;
+
+		/* Completions are processed by the worker pool. If it can't take this one, process
+		 * it here rather than leaking the child slot of the execution.
+		 */
+		if (worker_exec_submit(task) < 0)
+			rune.workers_routine(task);
+	}
+}
+
+#if CONFIG_USE_EPOLL == 1
+static int _reap_pidfd_open(pid_t pid) {
+ #ifdef SYS_pidfd_open
+	return (int) syscall(SYS_pidfd_open, pid, 0);
+ #else
+	errno = ENOSYS;
+	return -1;
+ #endif
+}
+
+/* NOTE: Must be called with _reap_mutex held */
+static void _reap_sweep(struct usched_exec_task **done) {
+	int status = 0;
+	pid_t pid = 0;
+	struct usched_exec_task *task = NULL;
+
+	while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+		if (!(task = _reap_unlink(pid))) {
+			_reap_placeholder(pid, status);
+			continue;
+		}
+
+		if (task->pidfd < 0)
+			_reap_unwatched --;
+
+		_reap_finish(task, status, done);
+	}
+}
+
+/* NOTE: Must be called with _reap_mutex held */
+static void _reap_event(struct usched_reap_event *ev, struct usched_exec_task **done) {
+	int status = 0;
+	pid_t pid = 0;
+	struct usched_exec_task *task = ev->task;
+	struct signalfd_siginfo si;
+
+	switch (ev->type) {
+		case REAP_EVENT_SIGNAL: {
+			/* Pending signals are coalesced, so how many are read doesn't matter */
+			while (read(_reap_sigfd, &si, sizeof(si)) == sizeof(si));
+
+			/* Only children without a process descriptor rely on SIGCHLD */
+			if (_reap_unwatched)
+				_reap_sweep(done);
+		} break;
+		case REAP_EVENT_EXIT: {
+			/* Already collected by a sweep of this batch */
+			if (task->exited)
+				break;
+
+			if (!(pid = waitpid(task->pid, &status, WNOHANG)))
+				break;
+
+			if (pid < 0)
+				log_warn("_reap_event(): waitpid(): %s. (Exit status of PID %u unknown)\n", strerror(errno), task->pid);
+
+			_reap_unlink(task->pid);
+			_reap_finish(task, status, done);
+		} break;
+		case REAP_EVENT_OUTPUT: {
+			if (task->exited || (task->ofd < 0))
+				break;
+
+			_reap_output(task);
+		} break;
+	}
+}
+
+static void *_reap_exec_worker(void *arg) {
+	int errsv = 0, i = 0, nfds = 0, state = 0;
+	struct epoll_event events[CONFIG_USCHED_EXEC_REAP_EVENTS_MAX];
+	struct usched_exec_task *done = NULL;
+
+	arg = NULL; /* Unused */
+
+	/* A SIGCHLD may have been missed while there was no reaper */
+	pthread_mutex_lock(&_reap_mutex);
+
+	if (_reap_unwatched)
+		_reap_sweep(&done);
+
+	pthread_mutex_unlock(&_reap_mutex);
+
+	_reap_submit(done);
+
+	for (;;) {
+		done = NULL;
+
+		/* Wait for exits and output (cancellation point) */
+		if ((nfds = epoll_wait(_reap_epfd, events, CONFIG_USCHED_EXEC_REAP_EVENTS_MAX, -1)) < 0) {
+			if (errno == EINTR)
+				continue;
+
+			errsv = errno;
+			log_crit("_reap_exec_worker(): epoll_wait(): %s\n", strerror(errno));
+			errno = errsv;
+
+			/* Executions can't complete without the reaper */
+			runtime_exec_fatal();
+
+			break;
+		}
+
+		pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &state);
+
+		pthread_mutex_lock(&_reap_mutex);
+
+		for (i = 0; i < nfds; i ++)
+			_reap_event(events[i].data.ptr, &done);
+
+		pthread_mutex_unlock(&_reap_mutex);
+
+		/* Completed tasks are only handed over after the whole batch is processed, as later
+		 * events of the batch may still refer to them.
+		 */
+		_reap_submit(done);
+
+		pthread_setcancelstate(state, NULL);
+	}
+
+	return NULL;
+}
+
+int reap_exec_track(struct usched_exec_task *task) {
+	int status = 0;
+	struct usched_exec_task *exited = NULL, *done = NULL;
+	struct epoll_event ev;
+
+	memset(&ev, 0, sizeof(struct epoll_event));
+
+	task->ev_exit.task = task;
+	task->ev_exit.type = REAP_EVENT_EXIT;
+	task->ev_out.task = task;
+	task->ev_out.type = REAP_EVENT_OUTPUT;
+	task->pidfd = -1;
+
+	pthread_mutex_lock(&_reap_mutex);
+
+	/* Collected by a sweep before being tracked. The caller must complete this task. */
+	if ((exited = _reap_unlink(task->pid))) {
+		_reap_finish(task, exited->status, &done);
+		pthread_mutex_unlock(&_reap_mutex);
+		mm_free(exited);
+		return 1;
+	}
+
+	if (_reap_pidfd && ((task->pidfd = _reap_pidfd_open(task->pid)) < 0))
+		log_warn("reap_exec_track(): pidfd_open(): %s. (PID %u exit will be detected through SIGCHLD)\n", strerror(errno), task->pid);
+
+	if (task->pidfd >= 0) {
+		ev.events = EPOLLIN;
+		ev.data.ptr = &task->ev_exit;
+
+		if (epoll_ctl(_reap_epfd, EPOLL_CTL_ADD, task->pidfd, &ev) < 0) {
+			log_warn("reap_exec_track(): epoll_ctl(): %s. (PID %u exit will be detected through SIGCHLD)\n", strerror(errno), task->pid);
+			close(task->pidfd);
+			task->pidfd = -1;
+		}
+	}
+
+	if (task->pidfd < 0) {
+		/* The SIGCHLD of this child may have been consumed already */
+		if (waitpid(task->pid, &status, WNOHANG) == task->pid) {
+			_reap_finish(task, status, &done);
+			pthread_mutex_unlock(&_reap_mutex);
+			return 1;
+		}
+
+		_reap_unwatched ++;
+	}
+
+	if (task->ofd >= 0) {
+		ev.events = EPOLLIN;
+		ev.data.ptr = &task->ev_out;
+
+		if (epoll_ctl(_reap_epfd, EPOLL_CTL_ADD, task->ofd, &ev) < 0)
+			log_warn("reap_exec_track(): epoll_ctl(): %s. (PID %u output will only be read on exit)\n", strerror(errno), task->pid);
+	}
+
+	/* Newer executions of the entry may terminate this one while it isn't reaped */
+	overlap_exec_pid_set(((struct ipc_use_hdr *) task->buf)->id, task->pid, task->pidfd);
+
+	_reap_link(task);
+
+	pthread_mutex_unlock(&_reap_mutex);
+
+	return 0;
+}
+
+static int _reap_exec_sources_init(void) {
+	int errsv = 0, fd = -1;
+	sigset_t mask;
+	struct epoll_event ev;
+
+	memset(&ev, 0, sizeof(struct epoll_event));
+
+	if ((_reap_epfd = epoll_create1(EPOLL_CLOEXEC)) < 0) {
+		errsv = errno;
+		log_warn("_reap_exec_sources_init(): epoll_create1(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* SIGCHLD is blocked by the signals interface, so it's only consumed here */
+	sigemptyset(&mask);
+	sigaddset(&mask, SIGCHLD);
+
+	if ((_reap_sigfd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC)) < 0) {
+		errsv = errno;
+		log_warn("_reap_exec_sources_init(): signalfd(): %s\n", strerror(errno));
+		goto _failure;
+	}
+
+	ev.events = EPOLLIN;
+	ev.data.ptr = &_reap_ev_signal;
+
+	if (epoll_ctl(_reap_epfd, EPOLL_CTL_ADD, _reap_sigfd, &ev) < 0) {
+		errsv = errno;
+		log_warn("_reap_exec_sources_init(): epoll_ctl(): %s\n", strerror(errno));
+		goto _failure;
+	}
+
+	/* Process descriptors (Linux 5.3+) notify the exit of each child individually */
+	if ((fd = _reap_pidfd_open(getpid())) >= 0) {
+		close(fd);
+		_reap_pidfd = 1;
+	}
+
+	log_info("_reap_exec_sources_init(): Child exits are detected through %s.\n", _reap_pidfd ? "process descriptors" : "SIGCHLD");
+
+	return 0;
+
+_failure:
+	if (_reap_sigfd >= 0)
+		close(_reap_sigfd);
+
+	close(_reap_epfd);
+
+	_reap_sigfd = -1;
+	_reap_epfd = -1;
+
+	errno = errsv;
+
+	return -1;
+}
+#else
+static void _reap_exec_unlock(void *arg) {
+	arg = NULL; /* Unused */
+
+	pthread_mutex_unlock(&_reap_mutex);
+}
+
+/* NOTE: Must be called with _reap_mutex held */
+static struct usched_exec_task *_reap_lookup(pid_t pid) {
+	struct usched_exec_task *task = _reap_children[(size_t) pid % CONFIG_USCHED_EXEC_CHILDREN_BUCKETS];
+
+	for (; task; task = task->next) {
+		if (task->pid == pid)
+			return task;
+	}
+
+	return NULL;
+}
+
+/* The reaper blocks on waitpid(), so the output of running children is drained by a separate
+ * thread. Otherwise, a child writing more than the pipe capacity would block until killed.
+ */
+static void *_reap_exec_drainer(void *arg) {
+	int i = 0, nfds = 0, ret = 0, state = 0;
+	size_t bucket = 0, next = 0;
+	pid_t pids[CONFIG_USCHED_EXEC_REAP_EVENTS_MAX];
+	struct pollfd fds[CONFIG_USCHED_EXEC_REAP_EVENTS_MAX];
+	struct usched_exec_task *task = NULL;
+
+	arg = NULL; /* Unused */
+
+	for (;;) {
+		nfds = 0;
+
+		pthread_mutex_lock(&_reap_mutex);
+
+		/* Collect the output pipes of the running children. When there are more than fit in a
+		 * single poll, the next pass starts where this one stopped.
+		 */
+		for (i = 0; (i < CONFIG_USCHED_EXEC_CHILDREN_BUCKETS) && (nfds < CONFIG_USCHED_EXEC_REAP_EVENTS_MAX); i ++) {
+			bucket = (next + (size_t) i) % CONFIG_USCHED_EXEC_CHILDREN_BUCKETS;
+
+			for (task = _reap_children[bucket]; task && (nfds < CONFIG_USCHED_EXEC_REAP_EVENTS_MAX); task = task->next) {
+				if (!task->buf || (task->ofd < 0))
+					continue;
+
+				fds[nfds].fd = task->ofd;
+				fds[nfds].events = POLLIN;
+				fds[nfds].revents = 0;
+				pids[nfds ++] = task->pid;
+			}
+		}
+
+		next = (nfds < CONFIG_USCHED_EXEC_REAP_EVENTS_MAX) ? 0 : bucket;
+
+		pthread_mutex_unlock(&_reap_mutex);
+
+		/* Wait for output. New children are picked up on the next pass. (cancellation point) */
+		if ((ret = poll(fds, (nfds_t) nfds, CONFIG_USCHED_EXEC_REAP_DRAIN_INTERVAL)) <= 0) {
+			if ((ret < 0) && (errno != EINTR))
+				log_warn("_reap_exec_drainer(): poll(): %s\n", strerror(errno));
+
+			continue;
+		}
+
+		pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &state);
+
+		pthread_mutex_lock(&_reap_mutex);
+
+		for (i = 0; i < nfds; i ++) {
+			if (!fds[i].revents)
+				continue;
+
+			/* The child may have been completed in the meanwhile */
+			if (!(task = _reap_lookup(pids[i])) || !task->buf || (task->ofd != fds[i].fd))
+				continue;
+
+			_reap_output(task);
+		}
+
+		pthread_mutex_unlock(&_reap_mutex);
+
+		pthread_setcancelstate(state, NULL);
+	}
+
+	return NULL;
+}
+
+static void _reap_exec_exited(pid_t pid, int status) {
+	struct usched_exec_task *task = NULL, *done = NULL;
+
+	pthread_mutex_lock(&_reap_mutex);
+
+	if ((task = _reap_unlink(pid))) {
+		_reap_finish(task, status, &done);
+	} else {
+		_reap_placeholder(pid, status);
+	}
+
+	pthread_mutex_unlock(&_reap_mutex);
+
+	_reap_submit(done);
+}
+
+static void *_reap_exec_worker(void *arg) {
+	int errsv = 0, status = 0, state = 0;
+	pid_t pid = 0;
+	uint64_t generation = 0;
+
+	arg = NULL; /* Unused */
+
+	for (;;) {
+		pthread_mutex_lock(&_reap_mutex);
+		generation = _reap_generation;
+		pthread_mutex_unlock(&_reap_mutex);
+
+		/* Wait for any child to exit (cancellation point) */
+		if ((pid = waitpid(-1, &status, 0)) == (pid_t) -1) {
+			if (errno == EINTR)
+				continue;
+
+			if (errno != ECHILD) {
+				errsv = errno;
+				log_warn("_reap_exec_worker(): waitpid(): %s\n", strerror(errno));
+				errno = errsv;
+			}
+
+			/* Nothing to wait for. Sleep until a new child is tracked. */
+			pthread_mutex_lock(&_reap_mutex);
+			pthread_cleanup_push(&_reap_exec_unlock, NULL);
+
+			while (generation == _reap_generation)
+				pthread_cond_wait(&_reap_cond, &_reap_mutex);
+
+			pthread_cleanup_pop(1);
+
+			continue;
+		}
+
+		/* Don't lose an exit status once it's collected */
+		pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &state);
+
+		_reap_exec_exited(pid, status);
+
+		pthread_setcancelstate(state, NULL);
+	}
+
+	return NULL;
+}
+
+int reap_exec_track(struct usched_exec_task *task) {
+	struct usched_exec_task *exited = NULL, *done = NULL;
+
+	task->pidfd = -1;
+
+	pthread_mutex_lock(&_reap_mutex);
+
+	if ((exited = _reap_unlink(task->pid))) {
+		/* Already reaped. The caller must complete this task. */
+		_reap_finish(task, exited->status, &done);
+	} else {
+		/* Newer executions of the entry may terminate this one while it isn't reaped */
+		overlap_exec_pid_set(((struct ipc_use_hdr *) task->buf)->id, task->pid, -1);
+
+		_reap_link(task);
+		_reap_generation ++;
+
+		pthread_cond_signal(&_reap_cond);
+	}
+
+	pthread_mutex_unlock(&_reap_mutex);
+
+	if (exited) {
+		mm_free(exited);
+		return 1;
+	}
+
+	return 0;
+}
+#endif
+
+int reap_exec_init(void) {
+	int errsv = 0;
+
+#if CONFIG_USE_EPOLL == 1
+	if ((_reap_epfd < 0) && (_reap_exec_sources_init() < 0)) {
+		errsv = errno;
+		log_warn("reap_exec_init(): _reap_exec_sources_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+#endif
+
+	if ((errno = pthread_create(&rune.t_reap, NULL, &_reap_exec_worker, NULL))) {
+		errsv = errno;
+		log_warn("reap_exec_init(): pthread_create(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+#if CONFIG_USE_EPOLL == 0
+	if ((errno = pthread_create(&rune.t_drain, NULL, &_reap_exec_drainer, NULL))) {
+		errsv = errno;
+		log_warn("reap_exec_init(): pthread_create(): %s\n", strerror(errno));
+		pthread_cancel(rune.t_reap);
+		pthread_join(rune.t_reap, NULL);
+		errno = errsv;
+		return -1;
+	}
+#endif
+
+	/* All good */
+	return 0;
+}
+
+void reap_exec_destroy(void) {
+#if CONFIG_USE_EPOLL == 0
+	pthread_cancel(rune.t_drain);
+	pthread_join(rune.t_drain, NULL);
+#endif
+	pthread_cancel(rune.t_reap);
+	pthread_join(rune.t_reap, NULL);
+
+	pthread_mutex_lock(&_reap_mutex);
+
+	if (_reap_children_nmemb)
+		log_info("reap_exec_destroy(): %zu children still running.\n", _reap_children_nmemb);
+
+	pthread_mutex_unlock(&_reap_mutex);
+}
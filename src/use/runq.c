@@ -0,0 +1,192 @@
+/**
+ * @file runq.c
+ * @brief uSched
+ *        Executer run queue interface - Exec
+ *
+ * Date: 18-10-2026
+ *
+ * Copyright 2014-2015 Pedro A. Hortas (pah@ucodev.org)
+ *
+ * This file is part of usched.
+ *
+ * usched is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * usched is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with usched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+
+#include <pall/fifo.h>
+
+#include "config.h"
+#include "runtime.h"
+#include "mm.h"
+#include "log.h"
+#include "ipc.h"
+#include "entry.h"
+#include "runq.h"
+#include "credit.h"
+
+/* Order in which the priority classes are dispatched */
+static const usched_entry_priority_t _runq_exec_order[CONFIG_USCHED_EXEC_PRIORITY_CLASSES] = {
+	USCHED_ENTRY_PRIORITY_HIGH,
+	USCHED_ENTRY_PRIORITY_NORMAL,
+	USCHED_ENTRY_PRIORITY_LOW
+};
+
+static void _runq_exec_msg_destroy(void *data) {
+	mm_free(data);
+}
+
+int runq_exec_init(void) {
+	int errsv = 0, i = 0;
+
+	for (i = 0; i < CONFIG_USCHED_EXEC_PRIORITY_CLASSES; i ++) {
+		if (!(rune.runq[i] = pall_fifo_init(&_runq_exec_msg_destroy, NULL, NULL))) {
+			errsv = errno;
+			log_crit("runq_exec_init(): rune.runq[%d] = pall_fifo_init(): %s\n", i, strerror(errno));
+			runq_exec_destroy();
+			errno = errsv;
+			return -1;
+		}
+	}
+
+	rune.runq_children = 0;
+	rune.runq_waiting = 0;
+
+	/* All good */
+	return 0;
+}
+
+void runq_exec_destroy(void) {
+	int i = 0;
+
+	pthread_mutex_lock(&rune.mutex_runq);
+
+	for (i = 0; i < CONFIG_USCHED_EXEC_PRIORITY_CLASSES; i ++) {
+		if (!rune.runq[i])
+			continue;
+
+		pall_fifo_destroy(rune.runq[i]);
+		rune.runq[i] = NULL;
+	}
+
+	if (rune.runq_waiting)
+		log_info("runq_exec_destroy(): %zu waiting executions were discarded.\n", rune.runq_waiting);
+
+	rune.runq_waiting = 0;
+
+	pthread_mutex_unlock(&rune.mutex_runq);
+}
+
+/* NOTE: Must be called with rune.mutex_runq held */
+static int _runq_exec_submit(char *buf) {
+	int errsv = 0;
+	struct ipc_use_hdr *hdr = (struct ipc_use_hdr *) buf;
+	unsigned int prio = hdr->priority;
+
+	/* Unknown classes are handled as normal ones */
+	if (prio >= CONFIG_USCHED_EXEC_PRIORITY_CLASSES)
+		prio = USCHED_ENTRY_PRIORITY_NORMAL;
+
+	/* Reserve a child slot if the global limit wasn't reached yet */
+	if (rune.runq_children < rune.config.exec.children_max) {
+		rune.runq_children ++;
+
+		return RUNQ_EXEC_START;
+	}
+
+	/* Otherwise, wait in the run queue of its priority class, if there's room for it */
+	if (rune.runq_waiting >= rune.config.exec.queue_depth) {
+		log_warn("Entry[0x%016llX]: runq_exec_submit(): Run queue is full (%zu executions waiting).\n", hdr->id, rune.runq_waiting);
+		errno = EAGAIN;
+		return -1;
+	}
+
+	if (rune.runq[prio]->push(rune.runq[prio], buf) < 0) {
+		errsv = errno;
+		log_warn("Entry[0x%016llX]: runq_exec_submit(): rune.runq[%u]->push(): %s\n", hdr->id, prio, strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	rune.runq_waiting ++;
+
+	return RUNQ_EXEC_QUEUED;
+}
+
+int runq_exec_submit(char *buf) {
+	int ret = 0, errsv = 0;
+
+	pthread_mutex_lock(&rune.mutex_runq);
+
+	ret = _runq_exec_submit(buf);
+	errsv = errno;
+
+	pthread_mutex_unlock(&rune.mutex_runq);
+
+	errno = errsv;
+
+	return ret;
+}
+
+void runq_exec_submit_batch(char **bufs, int *verdicts, size_t nmemb) {
+	size_t i = 0;
+
+	pthread_mutex_lock(&rune.mutex_runq);
+
+	for (i = 0; i < nmemb; i ++)
+		verdicts[i] = _runq_exec_submit(bufs[i]);
+
+	pthread_mutex_unlock(&rune.mutex_runq);
+}
+
+char *runq_exec_release(void) {
+	int i = 0;
+	char *next = NULL;
+
+	pthread_mutex_lock(&rune.mutex_runq);
+
+	/* Hand over the child slot to the first waiting execution of the highest class */
+	for (i = 0; rune.runq_waiting && (i < CONFIG_USCHED_EXEC_PRIORITY_CLASSES); i ++) {
+		if ((next = rune.runq[_runq_exec_order[i]]->pop(rune.runq[_runq_exec_order[i]]))) {
+			rune.runq_waiting --;
+			break;
+		}
+	}
+
+	/* If no execution was waiting, release the slot */
+	if (!next && rune.runq_children)
+		rune.runq_children --;
+
+	pthread_mutex_unlock(&rune.mutex_runq);
+
+	/* Either a child slot or a run queue position is now free */
+	credit_exec_notify();
+
+	return next;
+}
+
+unsigned int runq_exec_free(void) {
+	size_t used = 0, capacity = (size_t) rune.config.exec.children_max + rune.config.exec.queue_depth;
+
+	pthread_mutex_lock(&rune.mutex_runq);
+	used = rune.runq_children + rune.runq_waiting;
+	pthread_mutex_unlock(&rune.mutex_runq);
+
+	return (used < capacity) ? (unsigned int) (capacity - used) : 0;
+}
+
@@ -38,6 +38,9 @@
 #include "sig.h"
 #include "bitops.h"
 #include "ipc.h"
+#include "overlap.h"
+#include "runq.h"
+#include "credit.h"
 #if CONFIG_USE_IPC_PMQ == 1
  #include "pmq.h"
 #endif
@@ -130,6 +133,30 @@ int runtime_exec_init(int argc, char **argv) {
 
 	log_info("Thread behaviour interface initialized.\n");
 
+	/* Initialize overlap control */
+	log_info("Initializing overlap control interface...\n");
+
+	if (overlap_exec_init() < 0) {
+		errsv = errno;
+		log_crit("runtime_exec_init(): overlap_exec_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	log_info("Overlap control interface initialized.\n");
+
+	/* Initialize run queue */
+	log_info("Initializing run queue interface...\n");
+
+	if (runq_exec_init() < 0) {
+		errsv = errno;
+		log_crit("runtime_exec_init(): runq_exec_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	log_info("Run queue interface initialized.\n");
+
 	/* Initialize IPC */
 	log_info("Initializing IPC interface...\n");
 
@@ -142,6 +169,18 @@ int runtime_exec_init(int argc, char **argv) {
 
 	log_info("IPC interface initialized.\n");
 
+	/* Initialize flow control interface */
+	log_info("Initializing flow control interface...\n");
+
+	if (credit_exec_init() < 0) {
+		errsv = errno;
+		log_crit("runtime_exec_init(): credit_exec_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	log_info("Flow control interface initialized.\n");
+
 #if CONFIG_USCHED_MULTIUSER == 0
 	/* If no multiuser support, drop privileges to the configured nopriv user and group */
 	log_info("Dropping process privileges (no multi-user support)...\n");
@@ -199,11 +238,26 @@ int runtime_exec_interrupted(void) {
 }
 
 void runtime_exec_destroy(void) {
+	/* Destroy flow control interface */
+	log_info("Destroying flow control interface...\n");
+	credit_exec_destroy();
+	log_info("Flow control interface destroyed.\n");
+
 	/* Destroy IPC interface */
 	log_info("Destroying IPC interface...\n");
 	ipc_exec_destroy();
 	log_info("IPC interface destroyed.\n");
 
+	/* Destroy run queue interface */
+	log_info("Destroying run queue interface...\n");
+	runq_exec_destroy();
+	log_info("Run queue interface destroyed.\n");
+
+	/* Destroy overlap control interface */
+	log_info("Destroying overlap control interface...\n");
+	overlap_exec_destroy();
+	log_info("Overlap control interface destroyed.\n");
+
 	/* Destroy thread behaviour interface */
 	log_info("Destroying thread behaviour interface...\n");
 	thread_exec_behaviour_destroy();
@@ -47,6 +47,9 @@ static void _sig_hup_exec_handler(int n) {
 int sig_exec_init(void) {
 	int errsv = 0;
 	struct sigaction sa;
+#if CONFIG_USE_EPOLL == 1
+	sigset_t si_chld;
+#endif
 
 	memset(&sa, 0, sizeof(struct sigaction));
 
@@ -80,6 +83,20 @@ int sig_exec_init(void) {
 		goto _failure;
 	}
 
+#if CONFIG_USE_EPOLL == 1
+	/* SIGCHLD is consumed by the children reaper through a signalfd. It must be blocked
+	 * before any thread is created, so all of them inherit the mask.
+	 */
+	sigemptyset(&si_chld);
+	sigaddset(&si_chld, SIGCHLD);
+
+	if ((errno = pthread_sigmask(SIG_BLOCK, &si_chld, NULL))) {
+		errsv = errno;
+		log_warn("sig_exec_init(): pthread_sigmask(): %s\n", strerror(errno));
+		goto _failure;
+	}
+#endif
+
 	return 0;
 
 _failure:
@@ -91,6 +108,15 @@ _failure:
 }
 
 void sig_exec_destroy(void) {
+#if CONFIG_USE_EPOLL == 1
+	sigset_t si_chld;
+
+	/* Executed children must not inherit the blocked SIGCHLD */
+	sigemptyset(&si_chld);
+	sigaddset(&si_chld, SIGCHLD);
+
+	pthread_sigmask(SIG_UNBLOCK, &si_chld, NULL);
+#endif
 	sigaction(SIGTERM, &rune.sa_save, NULL);
 	sigaction(SIGINT, &rune.sa_save, NULL);
 	sigaction(SIGQUIT, &rune.sa_save, NULL);
@@ -45,10 +45,79 @@ int thread_exec_components_init(void) {
 		return -1;
 	}
 
+	if ((errno = pthread_mutex_init(&rune.mutex_opool, NULL))) {
+		errsv = errno;
+		log_crit("thread_exec_components_init(): pthread_mutex_init(): %s\n", strerror(errno));
+		pthread_mutex_destroy(&rune.mutex_interrupt);
+		errno = errsv;
+		return -1;
+	}
+
+	if ((errno = pthread_mutex_init(&rune.mutex_runq, NULL))) {
+		errsv = errno;
+		log_crit("thread_exec_components_init(): pthread_mutex_init(): %s\n", strerror(errno));
+		pthread_mutex_destroy(&rune.mutex_opool);
+		pthread_mutex_destroy(&rune.mutex_interrupt);
+		errno = errsv;
+		return -1;
+	}
+
+	if ((errno = pthread_mutex_init(&rune.mutex_credit, NULL))) {
+		errsv = errno;
+		log_crit("thread_exec_components_init(): pthread_mutex_init(): %s\n", strerror(errno));
+		pthread_mutex_destroy(&rune.mutex_runq);
+		pthread_mutex_destroy(&rune.mutex_opool);
+		pthread_mutex_destroy(&rune.mutex_interrupt);
+		errno = errsv;
+		return -1;
+	}
+
+	if ((errno = pthread_cond_init(&rune.cond_credit, NULL))) {
+		errsv = errno;
+		log_crit("thread_exec_components_init(): pthread_cond_init(): %s\n", strerror(errno));
+		pthread_mutex_destroy(&rune.mutex_credit);
+		pthread_mutex_destroy(&rune.mutex_runq);
+		pthread_mutex_destroy(&rune.mutex_opool);
+		pthread_mutex_destroy(&rune.mutex_interrupt);
+		errno = errsv;
+		return -1;
+	}
+
+	if ((errno = pthread_mutex_init(&rune.mutex_workers, NULL))) {
+		errsv = errno;
+		log_crit("thread_exec_components_init(): pthread_mutex_init(): %s\n", strerror(errno));
+		pthread_cond_destroy(&rune.cond_credit);
+		pthread_mutex_destroy(&rune.mutex_credit);
+		pthread_mutex_destroy(&rune.mutex_runq);
+		pthread_mutex_destroy(&rune.mutex_opool);
+		pthread_mutex_destroy(&rune.mutex_interrupt);
+		errno = errsv;
+		return -1;
+	}
+
+	if ((errno = pthread_cond_init(&rune.cond_workers, NULL))) {
+		errsv = errno;
+		log_crit("thread_exec_components_init(): pthread_cond_init(): %s\n", strerror(errno));
+		pthread_mutex_destroy(&rune.mutex_workers);
+		pthread_cond_destroy(&rune.cond_credit);
+		pthread_mutex_destroy(&rune.mutex_credit);
+		pthread_mutex_destroy(&rune.mutex_runq);
+		pthread_mutex_destroy(&rune.mutex_opool);
+		pthread_mutex_destroy(&rune.mutex_interrupt);
+		errno = errsv;
+		return -1;
+	}
+
 	return 0;
 }
 
 void thread_exec_components_destroy(void) {
+	pthread_cond_destroy(&rune.cond_workers);
+	pthread_mutex_destroy(&rune.mutex_workers);
+	pthread_cond_destroy(&rune.cond_credit);
+	pthread_mutex_destroy(&rune.mutex_credit);
+	pthread_mutex_destroy(&rune.mutex_runq);
+	pthread_mutex_destroy(&rune.mutex_opool);
 	pthread_mutex_destroy(&rune.mutex_interrupt);
 }
 
@@ -0,0 +1,327 @@
+/**
+ * @file worker.c
+ * @brief uSched
+ *        Execution worker pool interface - Exec
+ *
+ * Date: 18-10-2026
+ *
+ * Copyright 2014-2015 Pedro A. Hortas (pah@ucodev.org)
+ *
+ * This file is part of usched.
+ *
+ * usched is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * usched is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with usched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <pthread.h>
+
+#include "config.h"
+#include "runtime.h"
+#include "mm.h"
+#include "log.h"
+#include "worker.h"
+
+static pthread_key_t _worker_key;
+static pthread_once_t _worker_once = PTHREAD_ONCE_INIT;
+static int _worker_key_errno = 0;
+
+static void _worker_key_create(void) {
+	_worker_key_errno = pthread_key_create(&_worker_key, NULL);
+}
+
+/* NOTE: Must be called with worker->mutex held */
+static int _worker_push(struct usched_worker *worker, struct usched_exec_task *task) {
+	size_t i = 0, count = worker->bottom - worker->top;
+	struct usched_exec_task **tasks = NULL;
+
+	/* Double the deque size when it's full */
+	if (count == worker->size) {
+		if (!(tasks = mm_alloc(worker->size * 2 * sizeof(struct usched_exec_task *))))
+			return -1;
+
+		for (i = 0; i < count; i ++)
+			tasks[i] = worker->tasks[(worker->top + i) & (worker->size - 1)];
+
+		mm_free(worker->tasks);
+
+		worker->tasks = tasks;
+		worker->size *= 2;
+		worker->top = 0;
+		worker->bottom = count;
+	}
+
+	worker->tasks[worker->bottom ++ & (worker->size - 1)] = task;
+
+	return 0;
+}
+
+/* NOTE: Must be called with worker->mutex held */
+static struct usched_exec_task *_worker_pop(struct usched_worker *worker) {
+	if (worker->bottom == worker->top)
+		return NULL;
+
+	return worker->tasks[-- worker->bottom & (worker->size - 1)];
+}
+
+/* NOTE: Must be called with worker->mutex held */
+static struct usched_exec_task *_worker_steal(struct usched_worker *worker) {
+	if (worker->bottom == worker->top)
+		return NULL;
+
+	return worker->tasks[worker->top ++ & (worker->size - 1)];
+}
+
+static struct usched_exec_task *_worker_take(struct usched_worker *self) {
+	unsigned int i = 0;
+	struct usched_worker *victim = NULL;
+	struct usched_exec_task *task = NULL;
+
+	/* Run our own work first */
+	pthread_mutex_lock(&self->mutex);
+	task = _worker_pop(self);
+	pthread_mutex_unlock(&self->mutex);
+
+	if (task)
+		return task;
+
+	/* Otherwise steal from the next workers */
+	for (i = 1; i < rune.workers_nmemb; i ++) {
+		victim = &rune.workers[(self->index + i) % rune.workers_nmemb];
+
+		pthread_mutex_lock(&victim->mutex);
+		task = _worker_steal(victim);
+		pthread_mutex_unlock(&victim->mutex);
+
+		if (task) {
+			self->stolen ++;
+			return task;
+		}
+	}
+
+	return NULL;
+}
+
+static void *_worker_exec_thread(void *arg) {
+	struct usched_worker *self = arg;
+	struct usched_exec_task *task = NULL;
+
+	/* Submissions from this thread go to its own deque */
+	pthread_setspecific(_worker_key, self);
+
+	for (;;) {
+		if ((task = _worker_take(self))) {
+			pthread_mutex_lock(&rune.mutex_workers);
+			rune.workers_pending --;
+			pthread_mutex_unlock(&rune.mutex_workers);
+
+			self->executed ++;
+
+			rune.workers_routine(task);
+
+			continue;
+		}
+
+		/* Pending tasks that we weren't able to take were already taken by another worker
+		 * that didn't account for them yet. Retry instead of sleeping.
+		 */
+		pthread_mutex_lock(&rune.mutex_workers);
+
+		while (!rune.workers_pending && !rune.workers_stop)
+			pthread_cond_wait(&rune.cond_workers, &rune.mutex_workers);
+
+		/* Only terminate when all the pending work is done */
+		if (!rune.workers_pending) {
+			pthread_mutex_unlock(&rune.mutex_workers);
+			break;
+		}
+
+		pthread_mutex_unlock(&rune.mutex_workers);
+	}
+
+	pthread_exit(NULL);
+
+	return NULL;
+}
+
+static void _worker_exec_stop(unsigned int started) {
+	unsigned int i = 0;
+
+	pthread_mutex_lock(&rune.mutex_workers);
+
+	rune.workers_stop = 1;
+
+	pthread_cond_broadcast(&rune.cond_workers);
+
+	pthread_mutex_unlock(&rune.mutex_workers);
+
+	for (i = 0; i < started; i ++)
+		pthread_join(rune.workers[i].tid, NULL);
+}
+
+static void _worker_exec_free(unsigned int allocated) {
+	unsigned int i = 0;
+
+	pthread_mutex_lock(&rune.mutex_workers);
+
+	for (i = 0; i < allocated; i ++) {
+		pthread_mutex_destroy(&rune.workers[i].mutex);
+		mm_free(rune.workers[i].tasks);
+	}
+
+	mm_free(rune.workers);
+
+	rune.workers = NULL;
+	rune.workers_nmemb = 0;
+
+	pthread_mutex_unlock(&rune.mutex_workers);
+}
+
+int worker_exec_init(void (*routine) (struct usched_exec_task *)) {
+	int errsv = 0;
+	unsigned int i = 0;
+	struct usched_worker *worker = NULL;
+
+	/* Initialize the thread-specific data key, if not already initialized */
+	if ((errno = pthread_once(&_worker_once, &_worker_key_create)) || (errno = _worker_key_errno)) {
+		errsv = errno;
+		log_warn("worker_exec_init(): pthread_key_create(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	rune.workers_routine = routine;
+	rune.workers_next = 0;
+	rune.workers_pending = 0;
+	rune.workers_stop = 0;
+
+	if (!(rune.workers = mm_alloc(rune.config.exec.thread_workers * sizeof(struct usched_worker)))) {
+		errsv = errno;
+		log_warn("worker_exec_init(): mm_alloc(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	memset(rune.workers, 0, rune.config.exec.thread_workers * sizeof(struct usched_worker));
+
+	/* Allocate the deques */
+	for (i = 0; i < rune.config.exec.thread_workers; i ++) {
+		worker = &rune.workers[i];
+
+		worker->index = i;
+		worker->size = CONFIG_USCHED_EXEC_WORKER_DEQUE_SIZE;
+
+		if (!(worker->tasks = mm_alloc(worker->size * sizeof(struct usched_exec_task *)))) {
+			errsv = errno;
+			log_warn("worker_exec_init(): mm_alloc(): %s\n", strerror(errno));
+			_worker_exec_free(i);
+			errno = errsv;
+			return -1;
+		}
+
+		if ((errno = pthread_mutex_init(&worker->mutex, NULL))) {
+			errsv = errno;
+			log_warn("worker_exec_init(): pthread_mutex_init(): %s\n", strerror(errno));
+			mm_free(worker->tasks);
+			_worker_exec_free(i);
+			errno = errsv;
+			return -1;
+		}
+	}
+
+	/* Workers may steal from each other as soon as they start */
+	rune.workers_nmemb = rune.config.exec.thread_workers;
+
+	/* Start the workers */
+	for (i = 0; i < rune.workers_nmemb; i ++) {
+		if ((errno = pthread_create(&rune.workers[i].tid, NULL, &_worker_exec_thread, &rune.workers[i]))) {
+			errsv = errno;
+			log_warn("worker_exec_init(): pthread_create(): %s\n", strerror(errno));
+			_worker_exec_stop(i);
+			_worker_exec_free(rune.workers_nmemb);
+			errno = errsv;
+			return -1;
+		}
+	}
+
+	/* All good */
+	return 0;
+}
+
+void worker_exec_destroy(void) {
+	unsigned int i = 0;
+	uint64_t executed = 0, stolen = 0;
+
+	if (!rune.workers)
+		return;
+
+	/* Workers terminate once all the queued work, and the work it generates, is done */
+	_worker_exec_stop(rune.workers_nmemb);
+
+	for (i = 0; i < rune.workers_nmemb; i ++) {
+		executed += rune.workers[i].executed;
+		stolen += rune.workers[i].stolen;
+	}
+
+	log_info("worker_exec_destroy(): %u workers ran %llu tasks (%llu stolen).\n", rune.workers_nmemb, (unsigned long long) executed, (unsigned long long) stolen);
+
+	_worker_exec_free(rune.workers_nmemb);
+}
+
+int worker_exec_submit(struct usched_exec_task *task) {
+	int errsv = 0;
+	struct usched_worker *worker = NULL;
+
+	/* Tasks submitted by a worker are queued on its own deque */
+	if (!pthread_once(&_worker_once, &_worker_key_create) && !_worker_key_errno)
+		worker = pthread_getspecific(_worker_key);
+
+	pthread_mutex_lock(&rune.mutex_workers);
+
+	if (!rune.workers_nmemb) {
+		pthread_mutex_unlock(&rune.mutex_workers);
+		log_warn("worker_exec_submit(): No workers available.\n");
+		errno = ESRCH;
+		return -1;
+	}
+
+	/* External submissions are spread across the workers */
+	if (!worker)
+		worker = &rune.workers[rune.workers_next ++ % rune.workers_nmemb];
+
+	pthread_mutex_lock(&worker->mutex);
+
+	if (_worker_push(worker, task) < 0) {
+		errsv = errno;
+		pthread_mutex_unlock(&worker->mutex);
+		pthread_mutex_unlock(&rune.mutex_workers);
+		log_warn("worker_exec_submit(): _worker_push(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	pthread_mutex_unlock(&worker->mutex);
+
+	rune.workers_pending ++;
+
+	pthread_cond_signal(&rune.cond_workers);
+
+	pthread_mutex_unlock(&rune.mutex_workers);
+
+	/* All good */
+	return 0;
+}
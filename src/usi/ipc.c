@@ -84,6 +84,18 @@ int main(int argc, char **argv) {
 int ipc_ipc_init(void) {
 	int errsv = 0;
 
+	/* Create the shared memory rings, if selected as the message transport */
+	if (runi.config.ipc.transport_shm) {
+		if (ipc_shm_create(&runi.config.ipc) < 0) {
+			errsv = errno;
+			log_warn("ipc_ipc_init(): ipc_shm_create(): %s\n", strerror(errno));
+			errno = errsv;
+			return -1;
+		}
+
+		return 0;
+	}
+
 	/* Create key */
 	runi.pipck = (pipck_t) runi.config.ipc.id_key;
 
@@ -100,6 +112,11 @@ int ipc_ipc_init(void) {
 }
 
 void ipc_ipc_destroy(void) {
+	if (runi.config.ipc.transport_shm) {
+		ipc_shm_unlink(&runi.config.ipc);
+		return;
+	}
+
 	if (pipc_master_unregister(runi.pipcd) < 0)
 		log_warn("ipc_ipc_destroy(): pipc_master_unregister(): %s\n", strerror(errno));
 }
@@ -40,6 +40,18 @@
 int ipc_stat_init(void) {
 	int errsv = 0;
 
+	/* Attach to the shared memory rings, if selected as the message transport */
+	if (runs.config.ipc.transport_shm) {
+		if (ipc_shm_attach(&runs.config.ipc, IPC_USS_ID) < 0) {
+			errsv = errno;
+			log_warn("ipc_stat_init(): ipc_shm_attach(): %s\n", strerror(errno));
+			errno = errsv;
+			return -1;
+		}
+
+		return 0;
+	}
+
 	/* Create key */
 	runs.pipck = (pipck_t) runs.config.ipc.id_key;
 
@@ -56,6 +68,11 @@ int ipc_stat_init(void) {
 }
 
 void ipc_stat_destroy(void) {
+	if (runs.config.ipc.transport_shm) {
+		ipc_shm_detach();
+		return;
+	}
+
 	if (pipc_slave_unregister(runs.pipcd) < 0)
 		log_warn("ipc_stat_destroy(): pipc_slave_unregister(): %s\n", strerror(errno));
 }
@@ -135,7 +135,7 @@ static unsigned long long _report_stat_latency_max(void) {
 	pthread_mutex_lock(&runs.mutex_spool);
 
 	for (runs.spool->rewind(runs.spool, 0); (e = runs.spool->iterate(runs.spool)); memset(&tval, 0, sizeof(struct timespec))) {
-		memcpy(&tval, &e->current.start, sizeof(struct timespec));
+		memcpy(&tval, &e->current.received, sizeof(struct timespec));
 		timespec_sub(&tval, &e->current.trigger);
 
 		if (timespec_cmp(&tval, &tmax) > 0)
@@ -157,7 +157,7 @@ static unsigned long long _report_stat_latency_min(void) {
 	pthread_mutex_lock(&runs.mutex_spool);
 
 	for (runs.spool->rewind(runs.spool, 0); (e = runs.spool->iterate(runs.spool)); memset(&tval, 0, sizeof(struct timespec))) {
-		memcpy(&tval, &e->current.start, sizeof(struct timespec));
+		memcpy(&tval, &e->current.received, sizeof(struct timespec));
 		timespec_sub(&tval, &e->current.trigger);
 
 		if (!timespec_cmp(&tmin, (struct timespec [1]) { { 0, 0 } })) {
@@ -183,7 +183,7 @@ static unsigned long long _report_stat_latency_avg(void) {
 	pthread_mutex_lock(&runs.mutex_spool);
 
 	for (runs.spool->rewind(runs.spool, 0); (e = runs.spool->iterate(runs.spool)); ) {
-		memcpy(&tval, &e->current.start, sizeof(struct timespec));
+		memcpy(&tval, &e->current.received, sizeof(struct timespec));
 		timespec_sub(&tval, &e->current.trigger);
 		timespec_add(&tavg, &tval);
 
@@ -192,6 +192,84 @@ static unsigned long long _report_stat_latency_avg(void) {
 
 	pthread_mutex_unlock(&runs.mutex_spool);
 
+	/* No executions were reported yet */
+	if (!count)
+		return 0;
+
+	ret = ((tavg.tv_sec * 1000000000) + tavg.tv_nsec) / count;
+	
+	return ret;
+}
+
+static unsigned long long _report_stat_queuewait_max(void) {
+	struct usched_stat_entry *e = NULL;
+	struct timespec tval = { 0, 0 }, tmax = { 0, 0 };
+	unsigned long long ret = 0;
+
+	pthread_mutex_lock(&runs.mutex_spool);
+
+	for (runs.spool->rewind(runs.spool, 0); (e = runs.spool->iterate(runs.spool)); memset(&tval, 0, sizeof(struct timespec))) {
+		memcpy(&tval, &e->current.start, sizeof(struct timespec));
+		timespec_sub(&tval, &e->current.received);
+
+		if (timespec_cmp(&tval, &tmax) > 0)
+			memcpy(&tmax, &tval, sizeof(struct timespec));
+	}
+
+	pthread_mutex_unlock(&runs.mutex_spool);
+
+	ret = (tmax.tv_sec * 1000000000) + tmax.tv_nsec;
+	
+	return ret;
+}
+
+static unsigned long long _report_stat_queuewait_min(void) {
+	struct usched_stat_entry *e = NULL;
+	struct timespec tval = { 0, 0 }, tmin = { 0, 0 };
+	unsigned long long ret = 0;
+
+	pthread_mutex_lock(&runs.mutex_spool);
+
+	for (runs.spool->rewind(runs.spool, 0); (e = runs.spool->iterate(runs.spool)); memset(&tval, 0, sizeof(struct timespec))) {
+		memcpy(&tval, &e->current.start, sizeof(struct timespec));
+		timespec_sub(&tval, &e->current.received);
+
+		if (!timespec_cmp(&tmin, (struct timespec [1]) { { 0, 0 } })) {
+			memcpy(&tmin, &tval, sizeof(struct timespec));
+		} else if (timespec_cmp(&tmin, &tval) > 0) {
+			memcpy(&tmin, &tval, sizeof(struct timespec));
+		}
+	}
+
+	pthread_mutex_unlock(&runs.mutex_spool);
+
+	ret = (tmin.tv_sec * 1000000000) + tmin.tv_nsec;
+	
+	return ret;
+}
+
+static unsigned long long _report_stat_queuewait_avg(void) {
+	struct usched_stat_entry *e = NULL;
+	struct timespec tval = { 0, 0 }, tavg = { 0, 0 };
+	unsigned long long ret = 0;
+	size_t count = 0;
+
+	pthread_mutex_lock(&runs.mutex_spool);
+
+	for (runs.spool->rewind(runs.spool, 0); (e = runs.spool->iterate(runs.spool)); ) {
+		memcpy(&tval, &e->current.start, sizeof(struct timespec));
+		timespec_sub(&tval, &e->current.received);
+		timespec_add(&tavg, &tval);
+
+		count ++;
+	}
+
+	pthread_mutex_unlock(&runs.mutex_spool);
+
+	/* No executions were reported yet */
+	if (!count)
+		return 0;
+
 	ret = ((tavg.tv_sec * 1000000000) + tavg.tv_nsec) / count;
 	
 	return ret;
@@ -262,12 +340,108 @@ static unsigned long _report_stat_exectime_avg(void) {
 
 	pthread_mutex_unlock(&runs.mutex_spool);
 
+	/* No executions were reported yet */
+	if (!count)
+		return 0;
+
 	ret = ((tavg.tv_sec * 1000000000) + tavg.tv_nsec) / count;
 	
 	return ret;
 }
 
+static unsigned long long _report_stat_cpu_max(void) {
+	struct usched_stat_entry *e = NULL;
+	unsigned long long ret = 0;
+
+	pthread_mutex_lock(&runs.mutex_spool);
+
+	for (runs.spool->rewind(runs.spool, 0); (e = runs.spool->iterate(runs.spool)); ) {
+		if (e->current.cpu_usec > ret)
+			ret = e->current.cpu_usec;
+	}
+
+	pthread_mutex_unlock(&runs.mutex_spool);
+
+	return ret;
+}
+
+static unsigned long long _report_stat_cpu_avg(void) {
+	struct usched_stat_entry *e = NULL;
+	unsigned long long total = 0;
+	size_t count = 0;
+
+	pthread_mutex_lock(&runs.mutex_spool);
+
+	/* Only executions accounted by a cgroup report their resource usage */
+	for (runs.spool->rewind(runs.spool, 0); (e = runs.spool->iterate(runs.spool)); ) {
+		if (!e->current.cpu_usec && !e->current.mem_peak)
+			continue;
+
+		total += e->current.cpu_usec;
+
+		count ++;
+	}
+
+	pthread_mutex_unlock(&runs.mutex_spool);
+
+	/* No accounted executions were reported yet */
+	if (!count)
+		return 0;
+
+	return total / count;
+}
+
+static unsigned long long _report_stat_mem_max(void) {
+	struct usched_stat_entry *e = NULL;
+	unsigned long long ret = 0;
+
+	pthread_mutex_lock(&runs.mutex_spool);
+
+	for (runs.spool->rewind(runs.spool, 0); (e = runs.spool->iterate(runs.spool)); ) {
+		if (e->current.mem_peak > ret)
+			ret = e->current.mem_peak;
+	}
+
+	pthread_mutex_unlock(&runs.mutex_spool);
+
+	return ret;
+}
+
+static unsigned long long _report_stat_mem_avg(void) {
+	struct usched_stat_entry *e = NULL;
+	unsigned long long total = 0;
+	size_t count = 0;
+
+	pthread_mutex_lock(&runs.mutex_spool);
+
+	/* Only executions accounted by a cgroup report their resource usage */
+	for (runs.spool->rewind(runs.spool, 0); (e = runs.spool->iterate(runs.spool)); ) {
+		if (!e->current.cpu_usec && !e->current.mem_peak)
+			continue;
+
+		total += e->current.mem_peak;
+
+		count ++;
+	}
+
+	pthread_mutex_unlock(&runs.mutex_spool);
+
+	/* No accounted executions were reported yet */
+	if (!count)
+		return 0;
+
+	return total / count;
+}
+
+static void _report_stat_counters(struct ipc_counters_hdr *counters) {
+	pthread_mutex_lock(&runs.mutex_counters);
+	memcpy(counters, &runs.counters, sizeof(struct ipc_counters_hdr));
+	pthread_mutex_unlock(&runs.mutex_counters);
+}
+
 static void _report_stat_dump(FILE *fp) {
+	struct ipc_counters_hdr counters;
+
 	log_info("_report_stat_dump(): Dumping statistical data...");
 
 	/* DUmp statistical data */
@@ -283,10 +457,31 @@ static void _report_stat_dump(FILE *fp) {
 	fprintf(fp, "Minimum scheduler latency: %.3fus\n", _report_stat_latency_min() / (float) 1000.0);
 	fprintf(fp, "Average scheduler latency: %.3fus\n", _report_stat_latency_avg() / (float) 1000.0);
 	fprintf(fp, "\n");
+	fprintf(fp, "Maximum run queue wait:    %.3fus\n", _report_stat_queuewait_max() / (float) 1000.0);
+	fprintf(fp, "Minimum run queue wait:    %.3fus\n", _report_stat_queuewait_min() / (float) 1000.0);
+	fprintf(fp, "Average run queue wait:    %.3fus\n", _report_stat_queuewait_avg() / (float) 1000.0);
+	fprintf(fp, "\n");
 	fprintf(fp, "Maximum entry exectime:    %.3fus\n", _report_stat_exectime_max() / (float) 1000.0);
 	fprintf(fp, "Minimum entry exectime:    %.3fus\n", _report_stat_exectime_min() / (float) 1000.0);
 	fprintf(fp, "Average entry exectime:    %.3fus\n", _report_stat_exectime_avg() / (float) 1000.0);
+	fprintf(fp, "\n");
+	fprintf(fp, "Maximum entry CPU time:    %lluus\n", _report_stat_cpu_max());
+	fprintf(fp, "Average entry CPU time:    %lluus\n", _report_stat_cpu_avg());
+	fprintf(fp, "Maximum entry memory peak: %llu bytes\n", _report_stat_mem_max());
+	fprintf(fp, "Average entry memory peak: %llu bytes\n", _report_stat_mem_avg());
+	fprintf(fp, "\n");
 
+	_report_stat_counters(&counters);
+
+	fprintf(fp, "Rejected by rate limit:    %llu\n", (unsigned long long) counters.admit_rate_rejected);
+	fprintf(fp, "Rejected by entries quota: %llu\n", (unsigned long long) counters.admit_quota_rejected);
+	fprintf(fp, "\n");
+	fprintf(fp, "Executer free capacity:    %u\n", counters.credit_free);
+	fprintf(fp, "Executer credits in use:   %llu\n", (unsigned long long) counters.credit_inflight);
+	fprintf(fp, "Executer credits left:     %u\n", counters.credit_available);
+	fprintf(fp, "Credit exhaustions:        %llu\n", (unsigned long long) counters.credit_exhaustions);
+	fprintf(fp, "Credit stalls:             %llu\n", (unsigned long long) counters.credit_stalls);
+	fprintf(fp, "Deferred queue depth:      %llu\n", (unsigned long long) counters.retry_pending);
 }
 
 static void *_report_stat_monitor(void *arg) {
@@ -26,6 +26,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <errno.h>
@@ -43,6 +44,7 @@
 #include "stat.h"
 #include "ipc.h"
 
+/* NOTE: Must be called with runs.mutex_spool and runs.mutex_dpool held */
 static int _stat_entry_update(
 	uint64_t id,
 	uid_t uid,
@@ -50,8 +52,12 @@ static int _stat_entry_update(
 	pid_t pid,
 	int status,
 	struct timespec *trigger,
+	struct timespec *received,
 	struct timespec *start,
 	struct timespec *end,
+	uint64_t cpu_usec,
+	uint64_t mem_peak,
+	uint64_t outdata_dropped,
 	size_t outdata_len,
 	char *outdata)
 {
@@ -65,16 +71,12 @@ static int _stat_entry_update(
 		return -1;
 	}
 
-	/* Acquire spool lock */
-	pthread_mutex_lock(&runs.mutex_spool);
-
 	/* Check if the entry already exists */
 	if (!(s = runs.spool->search(runs.spool, (struct usched_stat_entry [1]) { { id, } }))) {
 		/* If not found, allocate it */
 		if (!(s = mm_alloc(sizeof(struct usched_stat_entry)))) {
 			errsv = errno;
 			log_warn("_stat_entry_update(): mm_alloc(): %s\n", strerror(errno));
-			pthread_mutex_unlock(&runs.mutex_spool);
 			errno = errsv;
 			return -1;
 		}
@@ -89,7 +91,6 @@ static int _stat_entry_update(
 		if (runs.spool->insert(runs.spool, s) < 0) {
 			errsv = errno;
 			log_warn("_stat_entry_update(): runs.spool->insert(): %s\n", strerror(errno));
-			pthread_mutex_unlock(&runs.mutex_spool);
 			errno = errsv;
 			return -1;
 		}
@@ -101,9 +102,13 @@ static int _stat_entry_update(
 	s->current.pid = pid;
 	s->current.status = WEXITSTATUS(status);
 	memcpy(&s->current.trigger, trigger, sizeof(struct timespec));
+	memcpy(&s->current.received, received, sizeof(struct timespec));
 	memcpy(&s->current.start, start, sizeof(struct timespec));
 	memcpy(&s->current.end, end, sizeof(struct timespec));
+	s->current.cpu_usec = cpu_usec;
+	s->current.mem_peak = mem_peak;
 	s->current.outdata_len = outdata_len;
+	s->current.outdata_dropped = outdata_dropped;
 	memset(s->current.outdata, 0, CONFIG_USCHED_EXEC_OUTPUT_MAX);
 	memcpy(s->current.outdata, outdata, outdata_len);
 
@@ -118,14 +123,10 @@ static int _stat_entry_update(
 	/* Update the number of times the entry was executed */
 	s->nr_exec ++;
 
-	/* Acquire dpool mutex */
-	pthread_mutex_lock(&runs.mutex_dpool);
-
 	/* Duplicate stat entry */
 	if (!(dpool_s = stat_dup(s))) {
 		errsv = errno;
 		log_warn("_stat_entry_update(): stat_dup(): %s\n", strerror(errno));
-		pthread_mutex_unlock(&runs.mutex_spool);
 		errno = errsv;
 		return -1;
 	}
@@ -134,46 +135,83 @@ static int _stat_entry_update(
 	if (runs.dpool->push(runs.dpool, dpool_s) < 0)
 		log_warn("_stat_entry_update(): runs.dpool->push(): %s\n", strerror(errno));
 
-	/* Signal the dpool worker to start processing the queue */
-	pthread_cond_signal(&runs.cond_dpool);
+	/* All good */
+	return 0;
+}
 
-	/* Release the dpool mutex */
-	pthread_mutex_unlock(&runs.mutex_dpool);
+static int _use_process(char *msg) {
+	int errsv = 0;
+	struct ipc_uss_hdr *hdr = (struct ipc_uss_hdr *) msg;
+	char *outdata = msg + sizeof(struct ipc_uss_hdr);
 
-	/* Release spool lock */
-	pthread_mutex_unlock(&runs.mutex_spool);
+	/* Validate output data size */
+	if ((hdr->outdata_len + sizeof(struct ipc_uss_hdr) + 1) > runs.config.ipc.msg_size) {
+		errsv = errno;
+		log_crit("_use_process(): IPC message too long (%u bytes). Entry ID: 0x%016llX\n", hdr->outdata_len, hdr->id);
+		errno = errsv;
+		return -1;
+	}
+
+	/* Grant NULL termination on output data buffer */
+	outdata[hdr->outdata_len] = 0;
+
+	debug_printf(DEBUG_INFO, "_use_process(): hdr->id: 0x%016llX, hdr->status: %lu, hdr->pid: %lu, hdr->outdata_len: %lu, outdata: %s\n", hdr->id, hdr->status, hdr->pid, hdr->outdata_len, outdata);
+
+	/* Populate a usched_stat_entry structure and insert/update it on the entry stat pool */
+	if (_stat_entry_update(hdr->id, hdr->uid, hdr->gid, hdr->pid, hdr->status, &hdr->t_trigger, &hdr->t_recv, &hdr->t_start, &hdr->t_end, hdr->cpu_usec, hdr->mem_peak, hdr->outdata_dropped, hdr->outdata_len, outdata) < 0) {
+		errsv = errno;
+		log_warn("_use_process(): _stat_entry_update(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
 
 	/* All good */
 	return 0;
 }
 
+static int _usd_counters_update(const char *msg, size_t len) {
+	if (len != sizeof(struct ipc_counters_hdr)) {
+		log_warn("_usd_counters_update(): Invalid daemon counters (%zu bytes).\n", len);
+		errno = EBADMSG;
+		return -1;
+	}
+
+	/* Each message replaces the previous counters */
+	pthread_mutex_lock(&runs.mutex_counters);
+	memcpy(&runs.counters, msg, sizeof(struct ipc_counters_hdr));
+	pthread_mutex_unlock(&runs.mutex_counters);
+
+	/* All good */
+	return 0;
+}
+
+/* Messages received from other modules by the incoming worker (see ipc_recv_frames()) */
+static void _use_other(long src_id, const char *msg, size_t len) {
+	if (src_id == IPC_USD_ID) {
+		_usd_counters_update(msg, len);
+	} else {
+		log_warn("_use_other(): Unexpected message from module %ld (%zu bytes).\n", src_id, len);
+	}
+}
+
 static int _use_incoming(void) {
 	int errsv = 0;
-	struct ipc_uss_hdr *hdr = NULL;
-	char *outdata = NULL, *buf = NULL;
+	ssize_t nmemb = 0, i = 0;
+	size_t stride = IPC_RECV_BATCH_STRIDE(runs.config.ipc.msg_size), lens[CONFIG_USCHED_IPC_RECV_BATCH_MAX];
+	char *msgs = NULL;
 
-	/* Allocate uss IPC message memory */
-	if (!(buf = mm_alloc(runs.config.ipc.msg_size))) {
+	/* Acquire the uss IPC batch buffer of this thread (one stride per message) */
+	if (!(msgs = ipc_buf_get(stride * CONFIG_USCHED_IPC_RECV_BATCH_MAX))) {
 		errsv = errno;
-		log_warn("_use_process(): mm_alloc(): %s\n", strerror(errno));
+		log_warn("_use_incoming(): ipc_buf_get(): %s\n", strerror(errno));
 		errno = errsv;
 		return -1;
 	}
 
-	/* Reset message memory */
-	memset(buf, 0, runs.config.ipc.msg_size);
-
-	/* Set header address */
-	hdr = (struct ipc_uss_hdr *) buf;
-
-	/* Set output data address */
-	outdata = buf + sizeof(struct ipc_uss_hdr);
-
-	/* Wait for IPC message */
-	if (ipc_recv(runs.pipcd, (long [1]) { IPC_USE_ID }, (long [1]) { IPC_USS_ID }, buf, runs.config.ipc.msg_size) < 0) {
+	/* Wait for IPC messages */
+	if ((nmemb = ipc_recv_frames(runs.pipcd, IPC_USE_ID, IPC_USS_ID, msgs, runs.config.ipc.msg_size, CONFIG_USCHED_IPC_RECV_BATCH_MAX, lens, sizeof(struct ipc_uss_hdr), offsetof(struct ipc_uss_hdr, outdata_len), &_use_other)) < 0) {
 		errsv = errno;
-		log_warn("_use_process(): ipc_recv(): %s\n", strerror(errno));
-		mm_free(buf);
+		log_warn("_use_incoming(): ipc_recv_frames(): %s\n", strerror(errno));
 		errno = errsv;
 
 		/* Any of the following errno are a fatal condition and this module needs to
@@ -187,30 +225,25 @@ static int _use_incoming(void) {
 		return -1;
 	}
 
-	/* Validate output data size */
-	if ((hdr->outdata_len + sizeof(struct ipc_uss_hdr) + 1) > runs.config.ipc.msg_size) {
-		errsv = errno;
-		log_crit("_use_process(): IPC message too long (%u bytes). Entry ID: 0x%016llX\n", hdr->outdata_len, hdr->id);
-		mm_free(buf);
-		errno = errsv;
-		return -1;
-	}
+	/* Track the bytes written by the receive operation */
+	ipc_buf_dirty(((size_t) nmemb - 1) * stride + lens[nmemb - 1] + 1);
 
-	/* Grant NULL termination on output data buffer */
-	outdata[hdr->outdata_len] = 0;
-
-	debug_printf(DEBUG_INFO, "_use_process(): hdr->id: 0x%016llX, hdr->status: %lu, hdr->pid: %lu, hdr->outdata_len: %lu, outdata: %s\n", hdr->id, hdr->status, hdr->pid, hdr->outdata_len, outdata);
+	/* Acquire the spool and dpool locks, once for the whole batch */
+	pthread_mutex_lock(&runs.mutex_spool);
+	pthread_mutex_lock(&runs.mutex_dpool);
 
-	/* Populate a usched_stat_entry structure and insert/update it on the entry stat pool */
-	if (_stat_entry_update(hdr->id, hdr->uid, hdr->gid, hdr->pid, hdr->status, &hdr->t_trigger, &hdr->t_start, &hdr->t_end, hdr->outdata_len, outdata) < 0) {
-		errsv = errno;
-		log_warn("_use_process(): _stat_entry_update(): %s\n", strerror(errno));
-		errno = errsv;
-		return -1;
+	/* A failure only affects its own message */
+	for (i = 0; i < nmemb; i ++) {
+		if (_use_process(msgs + ((size_t) i * stride)) < 0)
+			log_warn("_use_incoming(): _use_process(): %s\n", strerror(errno));
 	}
 
-	/* Free buffer memory */
-	mm_free(buf);
+	/* Signal the dpool worker to start processing the queue */
+	pthread_cond_signal(&runs.cond_dpool);
+
+	/* Release the dpool and spool locks */
+	pthread_mutex_unlock(&runs.mutex_dpool);
+	pthread_mutex_unlock(&runs.mutex_spool);
 
 	/* All good */
 	return 0;
@@ -218,21 +251,19 @@ static int _use_incoming(void) {
 
 static int _usd_dispatch(void) {
 	int errsv = 0;
+	size_t outdata_len = 0;
 	char *msg = NULL, *outdata = NULL;
 	struct usched_stat_entry *s = NULL;
 	struct ipc_usd_hdr *hdr = NULL;
 
-	/* Allocate message size */
-	if (!(msg = mm_alloc(runs.config.ipc.msg_size))) {
+	/* Acquire the message buffer of this thread */
+	if (!(msg = ipc_buf_get(runs.config.ipc.msg_size))) {
 		errsv = errno;
-		log_warn("_usd_dispatch(): mm_alloc(): %s\n", strerror(errno));
+		log_warn("_usd_dispatch(): ipc_buf_get(): %s\n", strerror(errno));
 		errno = errsv;
 		return -1;
 	}
 
-	/* Reset message memory */
-	memset(msg, 0, runs.config.ipc.msg_size);
-
 	/* Setup pointers */
 	hdr = (struct ipc_usd_hdr *) msg;
 	outdata = msg + sizeof(struct ipc_usd_hdr);
@@ -244,7 +275,6 @@ static int _usd_dispatch(void) {
 	if (!(s = runs.dpool->pop(runs.dpool))) {
 		log_warn("_usd_dispatch(): Dispatch worker was signaled, but queue is empty.\n");
 		pthread_mutex_unlock(&runs.mutex_dpool);
-		mm_free(msg);
 		errno = ENODATA;
 		return -1;
 	}
@@ -252,17 +282,24 @@ static int _usd_dispatch(void) {
 	/* Release dispatch pool mutex */
 	pthread_mutex_unlock(&runs.mutex_dpool);
 
+	/* Assert outdata length */
+	outdata_len = strlen(s->current.outdata);
+
+	if ((outdata_len + sizeof(struct ipc_usd_hdr) + 1) > runs.config.ipc.msg_size)
+		outdata_len = (runs.config.ipc.msg_size - sizeof(struct ipc_usd_hdr) - 1);
+
+	/* Clear only the bytes that will be used by this message */
+	ipc_buf_reset(sizeof(struct ipc_usd_hdr) + outdata_len);
+
 	/* Setup header */
 	hdr->id = s->id;
 	hdr->exec_time = ((s->current.end.tv_sec * 1000000000) + s->current.end.tv_nsec) - ((s->current.start.tv_sec * 1000000000) + s->current.start.tv_nsec);
 	hdr->latency = ((s->current.start.tv_sec * 1000000000) + s->current.start.tv_nsec) - ((s->current.trigger.tv_sec * 1000000000) + s->current.trigger.tv_nsec);
+	hdr->cpu_usec = s->current.cpu_usec;
+	hdr->mem_peak = s->current.mem_peak;
 	hdr->pid = s->current.pid;
 	hdr->status = s->current.status;
-	hdr->outdata_len = strlen(s->current.outdata);
-
-	/* Assert outdata length */
-	if ((hdr->outdata_len + sizeof(struct ipc_usd_hdr) + 1) > runs.config.ipc.msg_size)
-		hdr->outdata_len = (runs.config.ipc.msg_size - sizeof(struct ipc_usd_hdr) - 1);
+	hdr->outdata_len = outdata_len;
 
 	/* Set outdata */
 	memcpy(outdata, s->current.outdata, hdr->outdata_len);
@@ -271,13 +308,12 @@ static int _usd_dispatch(void) {
 	stat_destroy(s);
 
 	/* Print extended debug information */
-	debug_printf(DEBUG_INFO, "[DISPATCH]: Entry ID: 0x%016llX, PID: %u, exec_time: %.3fus, latency: %.3fus, status: %u, outdata_len: %u\n", hdr->id, hdr->pid, (hdr->exec_time / 1000.0), (hdr->latency / 1000.0), hdr->status, hdr->outdata_len);
+	debug_printf(DEBUG_INFO, "[DISPATCH]: Entry ID: 0x%016llX, PID: %u, exec_time: %.3fus, latency: %.3fus, cpu_usec: %llu, mem_peak: %llu, status: %u, outdata_len: %u\n", hdr->id, hdr->pid, (hdr->exec_time / 1000.0), (hdr->latency / 1000.0), (unsigned long long) hdr->cpu_usec, (unsigned long long) hdr->mem_peak, hdr->status, hdr->outdata_len);
 
 	/* Dispatch message to uSched Daemon */
-	if (ipc_send_nowait(runs.pipcd, IPC_USS_ID, IPC_USD_ID, msg, (size_t) runs.config.ipc.msg_size) < 0) {
+	if (ipc_send_nowait(runs.pipcd, IPC_USS_ID, IPC_USD_ID, msg, IPC_USD_FRAME_LEN(hdr)) < 0) {
 		errsv = errno;
 		log_warn("_usd_dispatch(): ipc_send_nowait(): %s\n", strerror(errno));
-		mm_free(msg);
 		errno = errsv;
 
 		/* Any of the following errno are a fatal condition and this module needs to
@@ -291,13 +327,47 @@ static int _usd_dispatch(void) {
 		return -1;
 	}
 
-	/* Free message memory */
-	mm_free(msg);
-
 	/* All good */
 	return 0;
 }
 
+static int _usd_counters(void) {
+	int errsv = 0;
+	ssize_t ret = 0;
+	char *msg = NULL;
+
+	/* Acquire the message buffer of this thread */
+	if (!(msg = ipc_buf_get(runs.config.ipc.msg_size))) {
+		errsv = errno;
+		log_warn("_usd_counters(): ipc_buf_get(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
+	/* Wait for the daemon counters */
+	if ((ret = ipc_recv(runs.pipcd, (long [1]) { IPC_USD_ID }, (long [1]) { IPC_USS_ID }, msg, runs.config.ipc.msg_size)) < 0) {
+		errsv = errno;
+		log_warn("_usd_counters(): ipc_recv(): %s\n", strerror(errno));
+		errno = errsv;
+
+		/* Any of the following errno are a fatal condition and this module needs to
+		 * be restarted by its monitor.
+		 */
+		if (errno == EACCES || errno == EFAULT || errno == EINVAL || errno == EIDRM || errno == ENOMEM)
+			runtime_stat_fatal();
+
+		errno = errsv;
+
+		return -1;
+	}
+
+	/* Track the bytes written by the receive operation */
+	ipc_buf_dirty((size_t) ret);
+
+	/* All good */
+	return _usd_counters_update(msg, (size_t) ret);
+}
+
 static void *_worker_incoming(void *arg) {
 	/* Process incoming IPC messages */
 	for (;;) {
@@ -318,6 +388,25 @@ static void *_worker_incoming(void *arg) {
 	return NULL;
 }
 
+static void *_worker_counters(void *arg) {
+	/* Process the counters sent by uSched Daemon */
+	for (;;) {
+		/* Check if runtime was interrupted */
+		if (runtime_stat_interrupted())
+			break;
+
+		if (_usd_counters() < 0)
+			log_warn("_worker_counters(): _usd_counters(): %s\n", strerror(errno));
+	}
+
+	debug_printf(DEBUG_INFO, "_worker_counters(): Terminating...\n");
+
+	/* Runtime was interrupted */
+	pthread_exit(NULL);
+
+	return NULL;
+}
+
 static void *_worker_dispatch(void *arg) {
 	/* Monitor and dispatch rpool entries */
 	for (;;) {
@@ -365,12 +454,24 @@ static void _init(int argc, char **argv) {
 		log_crit("_init(): pthread_create(): %s\n", strerror(errno));
 		exit(EXIT_FAILURE);
 	}
+
+	/* With pipc, the daemon counters share the stat queue and are received by the incoming worker */
+	if (runs.config.ipc.transport_shm && (errno = pthread_create(&runs.tid_counters, NULL, &_worker_counters, NULL))) {
+		log_crit("_init(): pthread_create(): %s\n", strerror(errno));
+		exit(EXIT_FAILURE);
+	}
 }
 
 static void _destroy(void) {
 	/* Wait for workers to terminate */
 	pthread_cancel(runs.tid_incoming);
 	pthread_join(runs.tid_incoming, NULL);
+
+	if (runs.config.ipc.transport_shm) {
+		pthread_cancel(runs.tid_counters);
+		pthread_join(runs.tid_counters, NULL);
+	}
+
 	pthread_mutex_lock(&runs.mutex_dpool);
 	pthread_cond_signal(&runs.cond_dpool);
 	pthread_mutex_unlock(&runs.mutex_dpool);
@@ -66,6 +66,13 @@ int thread_stat_components_init(void) {
 		return -1;
 	}
 
+	if ((errno = pthread_mutex_init(&runs.mutex_counters, NULL))) {
+		errsv = errno;
+		log_crit("thread_stat_components_init(): pthread_mutex_init(): %s\n", strerror(errno));
+		errno = errsv;
+		return -1;
+	}
+
 	return 0;
 }
 
@@ -74,5 +81,6 @@ void thread_stat_components_destroy(void) {
 	pthread_cond_destroy(&runs.cond_dpool);
 	pthread_mutex_destroy(&runs.mutex_dpool);
 	pthread_mutex_destroy(&runs.mutex_spool);
+	pthread_mutex_destroy(&runs.mutex_counters);
 }
 
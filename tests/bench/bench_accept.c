@@ -0,0 +1,285 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <sys/epoll.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+
+/*
+ * Accept throughput benchmark.
+ *
+ * Compares the listener strategies of the uSched daemon (usd):
+ *
+ *  - select:    One thread, pselect() on the listener, one accept() per wakeup and a garbage
+ *               collector pass per iteration (the pre-epoll implementation).
+ *  - epoll:     One thread, epoll_pwait() and accept4() draining with a garbage collector
+ *               pass per wakeup.
+ *  - reuseport: N epoll threads, each one with its own SO_REUSEPORT listener.
+ *
+ * Usage: bench_accept <select|epoll|reuseport> [connections] [clients] [acceptors]
+ *
+ */
+
+#define BENCH_ACCEPT_BATCH	64
+#define BENCH_ACCEPT_EVENTS	8
+#define BENCH_ACCEPTORS_MAX	16
+
+static unsigned int _connections = 20000;
+static unsigned int _clients = 8;
+static unsigned int _acceptors = 4;
+static in_port_t _port = 0;
+
+static int _listeners[BENCH_ACCEPTORS_MAX];
+static volatile int _done = 0;
+
+static pthread_mutex_t _gc_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t _count_mutex = PTHREAD_MUTEX_INITIALIZER;
+static unsigned int _accepted = 0;
+static double _t_done = 0;
+
+static void _exit_failure(const char *err) {
+	fprintf(stderr, "Fatal: %s: %s\n", err, strerror(errno));
+
+	exit(EXIT_FAILURE);
+}
+
+static double _now(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void _gc_cleanup(void) {
+	/* Same locking cost as the daemon garbage collector when it's empty */
+	pthread_mutex_lock(&_gc_mutex);
+	pthread_mutex_unlock(&_gc_mutex);
+}
+
+static void _accepted_add(unsigned int n) {
+	pthread_mutex_lock(&_count_mutex);
+
+	if (((_accepted += n) >= _connections) && !_done) {
+		_t_done = _now();
+		_done = 1;
+	}
+
+	pthread_mutex_unlock(&_count_mutex);
+}
+
+static int _listener(int reuseport) {
+	int fd = -1;
+	struct sockaddr_in sin;
+	socklen_t len = sizeof(sin);
+
+	if ((fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)) < 0)
+		_exit_failure("socket()");
+
+	if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, (int [1]) { 1 }, sizeof(int)) < 0)
+		_exit_failure("setsockopt(SO_REUSEADDR)");
+
+	if (reuseport && (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, (int [1]) { 1 }, sizeof(int)) < 0))
+		_exit_failure("setsockopt(SO_REUSEPORT)");
+
+	memset(&sin, 0, sizeof(sin));
+
+	sin.sin_family = AF_INET;
+	sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	sin.sin_port = _port;
+
+	if (bind(fd, (struct sockaddr *) &sin, sizeof(sin)) < 0)
+		_exit_failure("bind()");
+
+	if (listen(fd, SOMAXCONN) < 0)
+		_exit_failure("listen()");
+
+	if (!_port) {
+		if (getsockname(fd, (struct sockaddr *) &sin, &len) < 0)
+			_exit_failure("getsockname()");
+
+		_port = sin.sin_port;
+	}
+
+	return fd;
+}
+
+static void *_accept_select(void *arg) {
+	int fd = _listeners[0], cfd = -1;
+	fd_set rset;
+	struct timespec ts = { 0, 100000000 };
+
+	while (!_done) {
+		_gc_cleanup();
+
+		FD_ZERO(&rset);
+		FD_SET(fd, &rset);
+
+		if (pselect(fd + 1, &rset, NULL, NULL, &ts, NULL) <= 0)
+			continue;
+
+		if ((cfd = accept(fd, NULL, NULL)) < 0)
+			continue;
+
+		close(cfd);
+
+		_accepted_add(1);
+	}
+
+	return NULL;
+}
+
+static void *_accept_epoll(void *arg) {
+	int fd = _listeners[(uintptr_t) arg], cfd = -1, epfd = -1, i = 0, nfds = 0;
+	unsigned int n = 0, count = 0;
+	struct epoll_event ev, events[BENCH_ACCEPT_EVENTS];
+
+	if ((epfd = epoll_create1(EPOLL_CLOEXEC)) < 0)
+		_exit_failure("epoll_create1()");
+
+	memset(&ev, 0, sizeof(ev));
+
+	ev.events = EPOLLIN;
+	ev.data.fd = fd;
+
+	if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev) < 0)
+		_exit_failure("epoll_ctl()");
+
+	while (!_done) {
+		if ((nfds = epoll_pwait(epfd, events, BENCH_ACCEPT_EVENTS, 100, NULL)) <= 0)
+			continue;
+
+		for (i = 0, count = 0; i < nfds; i ++) {
+			for (n = 0; n < BENCH_ACCEPT_BATCH; n ++) {
+				if ((cfd = accept4(events[i].data.fd, NULL, NULL, SOCK_CLOEXEC)) < 0)
+					break;
+
+				close(cfd);
+
+				count ++;
+			}
+		}
+
+		_gc_cleanup();
+
+		if (count)
+			_accepted_add(count);
+	}
+
+	close(epfd);
+
+	return NULL;
+}
+
+static void *_client(void *arg) {
+	unsigned int i = 0, n = (unsigned int) (uintptr_t) arg;
+	int fd = -1;
+	struct sockaddr_in sin;
+
+	memset(&sin, 0, sizeof(sin));
+
+	sin.sin_family = AF_INET;
+	sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	sin.sin_port = _port;
+
+	for (i = 0; i < n; i ++) {
+		if ((fd = socket(AF_INET, SOCK_STREAM, 0)) < 0)
+			_exit_failure("socket()");
+
+		if (connect(fd, (struct sockaddr *) &sin, sizeof(sin)) < 0)
+			_exit_failure("connect()");
+
+		/* Connections are accounted once accepted. Don't wait for the server. */
+		close(fd);
+	}
+
+	return NULL;
+}
+
+int main(int argc, char **argv) {
+	unsigned int i = 0, nacceptors = 1;
+	int reuseport = 0;
+	void *(*acceptor)(void *) = NULL;
+	pthread_t t_acceptors[BENCH_ACCEPTORS_MAX], *t_clients = NULL;
+	double t_start = 0, t_elapsed = 0;
+
+	if (argc < 2) {
+		fprintf(stderr, "Usage: %s <select|epoll|reuseport> [connections] [clients] [acceptors]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	if (argc > 2)
+		_connections = strtoul(argv[2], NULL, 10);
+
+	if (argc > 3)
+		_clients = strtoul(argv[3], NULL, 10);
+
+	if (argc > 4)
+		_acceptors = strtoul(argv[4], NULL, 10);
+
+	if (!_connections || !_clients || !_acceptors || (_acceptors > BENCH_ACCEPTORS_MAX)) {
+		errno = EINVAL;
+		_exit_failure("Invalid arguments");
+	}
+
+	if (!strcmp(argv[1], "select")) {
+		acceptor = &_accept_select;
+	} else if (!strcmp(argv[1], "epoll")) {
+		acceptor = &_accept_epoll;
+	} else if (!strcmp(argv[1], "reuseport")) {
+		acceptor = &_accept_epoll;
+		nacceptors = _acceptors;
+		reuseport = 1;
+	} else {
+		errno = EINVAL;
+		_exit_failure(argv[1]);
+	}
+
+	signal(SIGPIPE, SIG_IGN);
+
+	for (i = 0; i < nacceptors; i ++)
+		_listeners[i] = _listener(reuseport);
+
+	if (!(t_clients = calloc(_clients, sizeof(pthread_t))))
+		_exit_failure("calloc()");
+
+	for (i = 0; i < nacceptors; i ++) {
+		if ((errno = pthread_create(&t_acceptors[i], NULL, acceptor, (void *) (uintptr_t) i)))
+			_exit_failure("pthread_create()");
+	}
+
+	t_start = _now();
+
+	for (i = 0; i < _clients; i ++) {
+		if ((errno = pthread_create(&t_clients[i], NULL, &_client, (void *) (uintptr_t) (_connections / _clients + (i < (_connections % _clients))))))
+			_exit_failure("pthread_create()");
+	}
+
+	for (i = 0; i < _clients; i ++)
+		pthread_join(t_clients[i], NULL);
+
+	/* Acceptors stop once all the connections are accepted */
+	for (i = 0; i < nacceptors; i ++) {
+		pthread_join(t_acceptors[i], NULL);
+		close(_listeners[i]);
+	}
+
+	t_elapsed = _t_done - t_start;
+
+	printf("%-10s acceptors: %2u, clients: %3u, connections: %u, elapsed: %.3fs, rate: %.0f conn/s\n", argv[1], nacceptors, _clients, _accepted, t_elapsed, _accepted / t_elapsed);
+
+	free(t_clients);
+
+	return EXIT_SUCCESS;
+}
+
@@ -0,0 +1,352 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/mman.h>
+#include <sys/ipc.h>
+#include <sys/msg.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+/*
+ * Inter-module IPC transport benchmark.
+ *
+ * Compares the message transports available between usd, use and uss:
+ *
+ *  - msgq: System V message queues, with one message type per direction (what pipc uses).
+ *  - ring: Single-producer, single-consumer shared memory rings, one per direction, with
+ *          futex wakeups issued only when the other side is sleeping (the 'shm' transport).
+ *
+ * Two processes are used. Both tests move fixed size messages, as the modules do:
+ *
+ *  - throughput: The parent sends all the messages to the child as fast as possible.
+ *  - latency:    The parent sends one message and waits for the child to echo it back.
+ *                Each round trip is measured and the one-way latency is reported.
+ *
+ * Usage: bench_ipc <msgq|ring> [messages] [size] [slots]
+ *
+ */
+
+#define BENCH_IPC_CACHELINE	64
+
+static unsigned int _messages = 1000000;
+static unsigned int _size = 1024;	/* Default ipc.msg.size */
+static unsigned int _slots = 128;	/* Default ipc.msg.max */
+
+static void _exit_failure(const char *err) {
+	fprintf(stderr, "Fatal: %s: %s\n", err, strerror(errno));
+
+	exit(EXIT_FAILURE);
+}
+
+static double _now(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int _double_compare(const void *a, const void *b) {
+	return (*(const double *) a > *(const double *) b) - (*(const double *) a < *(const double *) b);
+}
+
+
+/* System V message queues */
+struct bench_msg {
+	long mtype;
+	char mtext[1];
+};
+
+static int _msqid = -1;
+static struct bench_msg *_msg = NULL;
+
+static void _msgq_init(void) {
+	if ((_msqid = msgget(IPC_PRIVATE, IPC_CREAT | 0600)) < 0)
+		_exit_failure("msgget()");
+
+	if (!(_msg = malloc(sizeof(long) + _size)))
+		_exit_failure("malloc()");
+}
+
+static void _msgq_destroy(void) {
+	msgctl(_msqid, IPC_RMID, NULL);
+	free(_msg);
+}
+
+static void _msgq_send(int dir, const char *buf) {
+	_msg->mtype = dir + 1;
+	memcpy(_msg->mtext, buf, _size);
+
+	while (msgsnd(_msqid, _msg, _size, 0) < 0) {
+		if (errno != EINTR)
+			_exit_failure("msgsnd()");
+	}
+}
+
+static void _msgq_recv(int dir, char *buf) {
+	while (msgrcv(_msqid, _msg, _size, dir + 1, 0) < 0) {
+		if (errno != EINTR)
+			_exit_failure("msgrcv()");
+	}
+
+	memcpy(buf, _msg->mtext, _size);
+}
+
+
+/* Shared memory rings (same protocol as src/common/ring.c) */
+struct bench_ring {
+	uint32_t head;
+	uint32_t data_seq;
+	uint32_t data_waiters;
+	char _pad0[BENCH_IPC_CACHELINE - (3 * sizeof(uint32_t))];
+	uint32_t tail;
+	uint32_t space_seq;
+	uint32_t space_waiters;
+	char _pad1[BENCH_IPC_CACHELINE - (3 * sizeof(uint32_t))];
+};
+
+static struct bench_ring *_rings[2];
+static char *_ring_slots[2];
+static size_t _ring_stride = 0;
+static size_t _ring_size = 0;
+
+static void _futex_wait(uint32_t *word, uint32_t val) {
+	syscall(SYS_futex, word, FUTEX_WAIT, val, NULL, NULL, 0);
+}
+
+static void _futex_wake(uint32_t *word) {
+	syscall(SYS_futex, word, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+static void _ring_init(void) {
+	int i = 0;
+
+	_ring_stride = sizeof(uint64_t) + ((_size + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1));
+	_ring_size = sizeof(struct bench_ring) + (_slots * _ring_stride);
+
+	for (i = 0; i < 2; i ++) {
+		if ((_rings[i] = mmap(NULL, _ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0)) == MAP_FAILED)
+			_exit_failure("mmap()");
+
+		_ring_slots[i] = ((char *) _rings[i]) + sizeof(struct bench_ring);
+	}
+}
+
+static void _ring_destroy(void) {
+	munmap(_rings[0], _ring_size);
+	munmap(_rings[1], _ring_size);
+}
+
+static void _ring_send(int dir, const char *buf) {
+	struct bench_ring *r = _rings[dir];
+	uint32_t head = __atomic_load_n(&r->head, __ATOMIC_RELAXED), seq = 0, len = _size;
+	char *slot = NULL;
+
+	while ((uint32_t) (head - __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE)) >= _slots) {
+		__atomic_add_fetch(&r->space_waiters, 1, __ATOMIC_SEQ_CST);
+
+		seq = __atomic_load_n(&r->space_seq, __ATOMIC_SEQ_CST);
+
+		if ((uint32_t) (head - __atomic_load_n(&r->tail, __ATOMIC_SEQ_CST)) >= _slots)
+			_futex_wait(&r->space_seq, seq);
+
+		__atomic_sub_fetch(&r->space_waiters, 1, __ATOMIC_SEQ_CST);
+	}
+
+	slot = _ring_slots[dir] + ((size_t) (head & (_slots - 1)) * _ring_stride);
+
+	memcpy(slot, &len, sizeof(uint32_t));
+	memcpy(slot + sizeof(uint64_t), buf, _size);
+
+	__atomic_store_n(&r->head, head + 1, __ATOMIC_RELEASE);
+	__atomic_add_fetch(&r->data_seq, 1, __ATOMIC_SEQ_CST);
+
+	if (__atomic_load_n(&r->data_waiters, __ATOMIC_SEQ_CST))
+		_futex_wake(&r->data_seq);
+}
+
+static void _ring_recv(int dir, char *buf) {
+	struct bench_ring *r = _rings[dir];
+	uint32_t tail = __atomic_load_n(&r->tail, __ATOMIC_RELAXED), seq = 0, len = 0;
+	const char *slot = NULL;
+
+	while (__atomic_load_n(&r->head, __ATOMIC_ACQUIRE) == tail) {
+		__atomic_add_fetch(&r->data_waiters, 1, __ATOMIC_SEQ_CST);
+
+		seq = __atomic_load_n(&r->data_seq, __ATOMIC_SEQ_CST);
+
+		if (__atomic_load_n(&r->head, __ATOMIC_SEQ_CST) == tail)
+			_futex_wait(&r->data_seq, seq);
+
+		__atomic_sub_fetch(&r->data_waiters, 1, __ATOMIC_SEQ_CST);
+	}
+
+	slot = _ring_slots[dir] + ((size_t) (tail & (_slots - 1)) * _ring_stride);
+
+	memcpy(&len, slot, sizeof(uint32_t));
+	memcpy(buf, slot + sizeof(uint64_t), len);
+
+	__atomic_store_n(&r->tail, tail + 1, __ATOMIC_RELEASE);
+	__atomic_add_fetch(&r->space_seq, 1, __ATOMIC_SEQ_CST);
+
+	if (__atomic_load_n(&r->space_waiters, __ATOMIC_SEQ_CST))
+		_futex_wake(&r->space_seq);
+}
+
+
+/* Benchmark */
+static void (*_send) (int dir, const char *buf) = NULL;
+static void (*_recv) (int dir, char *buf) = NULL;
+
+static pid_t _child(unsigned int count, int echo) {
+	pid_t pid = 0;
+	unsigned int i = 0;
+	char *buf = NULL;
+
+	if ((pid = fork()) < 0)
+		_exit_failure("fork()");
+
+	if (pid)
+		return pid;
+
+	if (!(buf = calloc(1, _size)))
+		_exit_failure("calloc()");
+
+	for (i = 0; i < count; i ++) {
+		_recv(0, buf);
+
+		if (echo)
+			_send(1, buf);
+	}
+
+	/* Report completion */
+	if (!echo)
+		_send(1, buf);
+
+	free(buf);
+
+	_exit(EXIT_SUCCESS);
+}
+
+static void _throughput(void) {
+	unsigned int i = 0;
+	char *buf = NULL;
+	pid_t pid = 0;
+	double t_start = 0, t_elapsed = 0;
+
+	if (!(buf = calloc(1, _size)))
+		_exit_failure("calloc()");
+
+	pid = _child(_messages, 0);
+
+	t_start = _now();
+
+	for (i = 0; i < _messages; i ++) {
+		memcpy(buf, &i, sizeof(i));
+		_send(0, buf);
+	}
+
+	_recv(1, buf);
+
+	t_elapsed = _now() - t_start;
+
+	waitpid(pid, NULL, 0);
+
+	printf("throughput: %u messages of %u bytes in %.3f s (%.0f msg/s, %.1f MiB/s)\n", _messages, _size, t_elapsed, _messages / t_elapsed, ((double) _messages * _size) / t_elapsed / 1048576.0);
+
+	free(buf);
+}
+
+static void _latency(void) {
+	unsigned int i = 0, count = _messages / 10 ? _messages / 10 : 1;
+	char *buf = NULL;
+	double *samples = NULL, t_start = 0, total = 0;
+	pid_t pid = 0;
+
+	if (!(buf = calloc(1, _size)))
+		_exit_failure("calloc()");
+
+	if (!(samples = calloc(count, sizeof(double))))
+		_exit_failure("calloc()");
+
+	pid = _child(count, 1);
+
+	for (i = 0; i < count; i ++) {
+		t_start = _now();
+
+		_send(0, buf);
+		_recv(1, buf);
+
+		samples[i] = (_now() - t_start) / 2;
+		total += samples[i];
+	}
+
+	waitpid(pid, NULL, 0);
+
+	qsort(samples, count, sizeof(double), &_double_compare);
+
+	printf("latency: %u round trips, one-way avg %.2f us, p50 %.2f us, p99 %.2f us\n", count, total / count * 1e6, samples[count / 2] * 1e6, samples[(count * 99) / 100] * 1e6);
+
+	free(samples);
+	free(buf);
+}
+
+int main(int argc, char **argv) {
+	int ring = 0;
+
+	if (argc < 2) {
+		fprintf(stderr, "Usage: %s <msgq|ring> [messages] [size] [slots]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	if (argc > 2)
+		_messages = strtoul(argv[2], NULL, 10);
+
+	if (argc > 3)
+		_size = strtoul(argv[3], NULL, 10);
+
+	if (argc > 4)
+		_slots = strtoul(argv[4], NULL, 10);
+
+	/* The ring requires a power of two slot count, like ring_create() */
+	if (!_messages || (_size < sizeof(unsigned int)) || !_slots || (_slots & (_slots - 1))) {
+		errno = EINVAL;
+		_exit_failure("Invalid arguments");
+	}
+
+	if (!strcmp(argv[1], "msgq")) {
+		ring = 0;
+		_msgq_init();
+		_send = &_msgq_send;
+		_recv = &_msgq_recv;
+	} else if (!strcmp(argv[1], "ring")) {
+		ring = 1;
+		_ring_init();
+		_send = &_ring_send;
+		_recv = &_ring_recv;
+	} else {
+		errno = EINVAL;
+		_exit_failure(argv[1]);
+	}
+
+	printf("%s:\n", argv[1]);
+
+	_throughput();
+	_latency();
+
+	if (ring) {
+		_ring_destroy();
+	} else {
+		_msgq_destroy();
+	}
+
+	return EXIT_SUCCESS;
+}
+
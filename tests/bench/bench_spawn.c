@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <signal.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/mman.h>
+
+/*
+ * Executer process creation benchmark.
+ *
+ * Compares the ways the executer (use) can create the children that run the entries:
+ *
+ *  - fork:  fork() followed by execl(), as done before the spawn path. The page tables of the
+ *           parent are copied on every call, so the cost grows with its resident memory.
+ *  - spawn: clone(CLONE_VM | CLONE_VFORK) followed by execl(), as done by the spawn path. The
+ *           child borrows the memory of the parent until execl() returns.
+ *
+ * Before measuring, a ballast of the requested size is allocated and touched, so the benchmark
+ * process has the resident set size of a large executer. Each child executes /bin/true and is
+ * waited for before the next one is created.
+ *
+ * Usage: bench_spawn <fork|spawn> [spawns] [rss_mb]
+ *
+ */
+
+#define BENCH_SPAWN_STACK_SIZE	65536
+#define BENCH_SPAWN_BIN		"/bin/true"
+
+static unsigned int _spawns = 2000;
+static unsigned int _rss_mb = 1024;
+
+static void _exit_failure(const char *err) {
+	fprintf(stderr, "Fatal: %s: %s\n", err, strerror(errno));
+
+	exit(EXIT_FAILURE);
+}
+
+static double _now(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static char *_ballast_init(size_t size) {
+	char *ballast = NULL;
+	size_t i = 0;
+
+	if (!size)
+		return NULL;
+
+	if ((ballast = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)) == MAP_FAILED)
+		_exit_failure("mmap()");
+
+	/* Make it resident */
+	for (i = 0; i < size; i += 4096)
+		ballast[i] = (char) i;
+
+	return ballast;
+}
+
+
+/* fork() */
+static pid_t _fork_spawn(void) {
+	pid_t pid = 0;
+
+	if ((pid = fork()) < 0)
+		_exit_failure("fork()");
+
+	if (!pid) {
+		execl(BENCH_SPAWN_BIN, BENCH_SPAWN_BIN, (char *) NULL);
+		_exit(127);
+	}
+
+	return pid;
+}
+
+
+/* clone(CLONE_VM | CLONE_VFORK) */
+static char _stack[BENCH_SPAWN_STACK_SIZE];
+
+static int _clone_child(void *arg) {
+	(void) arg;
+
+	execl(BENCH_SPAWN_BIN, BENCH_SPAWN_BIN, (char *) NULL);
+	_exit(127);
+}
+
+static pid_t _clone_spawn(void) {
+	pid_t pid = 0;
+
+	if ((pid = clone(&_clone_child, (void *) (((uintptr_t) (_stack + sizeof(_stack))) & ~((uintptr_t) 15)), CLONE_VM | CLONE_VFORK | SIGCHLD, NULL)) < 0)
+		_exit_failure("clone()");
+
+	return pid;
+}
+
+
+/* Benchmark */
+int main(int argc, char **argv) {
+	unsigned int i = 0;
+	int status = 0;
+	char *ballast = NULL;
+	size_t size = 0;
+	pid_t (*spawn) (void) = NULL;
+	double t_start = 0, t_elapsed = 0;
+
+	if (argc < 2) {
+		fprintf(stderr, "Usage: %s <fork|spawn> [spawns] [rss_mb]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	if (argc > 2)
+		_spawns = strtoul(argv[2], NULL, 10);
+
+	if (argc > 3)
+		_rss_mb = strtoul(argv[3], NULL, 10);
+
+	if (!_spawns) {
+		errno = EINVAL;
+		_exit_failure("Invalid arguments");
+	}
+
+	if (!strcmp(argv[1], "fork")) {
+		spawn = &_fork_spawn;
+	} else if (!strcmp(argv[1], "spawn")) {
+		spawn = &_clone_spawn;
+	} else {
+		errno = EINVAL;
+		_exit_failure(argv[1]);
+	}
+
+	size = (size_t) _rss_mb * 1048576;
+	ballast = _ballast_init(size);
+
+	t_start = _now();
+
+	for (i = 0; i < _spawns; i ++) {
+		if (waitpid(spawn(), &status, 0) < 0)
+			_exit_failure("waitpid()");
+
+		if (!WIFEXITED(status) || WEXITSTATUS(status)) {
+			errno = ECHILD;
+			_exit_failure(BENCH_SPAWN_BIN);
+		}
+	}
+
+	t_elapsed = _now() - t_start;
+
+	printf("%s: %u spawns with %u MiB resident in %.3f s (%.0f spawns/s, %.1f us/spawn)\n", argv[1], _spawns, _rss_mb, t_elapsed, _spawns / t_elapsed, t_elapsed / _spawns * 1e6);
+
+	if (ballast)
+		munmap(ballast, size);
+
+	return EXIT_SUCCESS;
+}
+
@@ -0,0 +1,162 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+
+#include <usched/lib.h>
+
+/*
+ * Remote submit throughput benchmark.
+ *
+ * Submits NEW requests to a remote uSched daemon (usd) through the client library:
+ *
+ *  - cold: The library is initialized and destroyed around each request, so every request
+ *          opens a new connection and performs a full CHREKE key exchange (the behaviour before
+ *          persistent connections and session tickets).
+ *  - warm: The library is initialized once. Requests reuse the connection and resume the
+ *          session from the ticket issued on the first request.
+ *
+ * All the installed entries are removed when the benchmark finishes.
+ *
+ * Usage: bench_submit <cold|warm> <hostname> <port> <username> <password> [requests]
+ *
+ */
+
+static unsigned int _requests = 1000;
+static uint64_t *_entries = NULL;
+static size_t _entries_nmemb = 0;
+
+static void _exit_failure(const char *err) {
+	fprintf(stderr, "Fatal: %s: %s\n", err, strerror(errno));
+
+	exit(EXIT_FAILURE);
+}
+
+static double _now(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void _remote_set(char **argv) {
+	if (usched_opt_set_remote_hostname(argv[2]) < 0)
+		_exit_failure("usched_opt_set_remote_hostname()");
+
+	if (usched_opt_set_remote_port(argv[3]) < 0)
+		_exit_failure("usched_opt_set_remote_port()");
+
+	if (usched_opt_set_remote_username(argv[4]) < 0)
+		_exit_failure("usched_opt_set_remote_username()");
+
+	if (usched_opt_set_remote_password(argv[5]) < 0)
+		_exit_failure("usched_opt_set_remote_password()");
+}
+
+static void _submit(void) {
+	uint64_t *v = NULL;
+	size_t nmemb = 0;
+
+	if (usched_request("run '/bin/true' in 1 day") < 0)
+		_exit_failure("usched_request()");
+
+	usched_result_get_run(&v, &nmemb);
+
+	if (nmemb) {
+		if (!(_entries = realloc(_entries, (_entries_nmemb + nmemb) * sizeof(uint64_t))))
+			_exit_failure("realloc()");
+
+		memcpy(&_entries[_entries_nmemb], v, nmemb * sizeof(uint64_t));
+		_entries_nmemb += nmemb;
+	}
+
+	usched_result_free_run();
+}
+
+static void _cleanup(char **argv) {
+	size_t i = 0;
+	char req[64];
+
+	if (usched_init() < 0)
+		_exit_failure("usched_init()");
+
+	_remote_set(argv);
+
+	for (i = 0; i < _entries_nmemb; i ++) {
+		snprintf(req, sizeof(req), "stop 0x%016llX", (unsigned long long) _entries[i]);
+
+		if (usched_request(req) < 0)
+			fprintf(stderr, "Warning: Unable to remove entry 0x%016llX\n", (unsigned long long) _entries[i]);
+
+		usched_result_free_stop();
+	}
+
+	usched_destroy();
+
+	free(_entries);
+}
+
+int main(int argc, char **argv) {
+	unsigned int i = 0;
+	int warm = 0;
+	double t_start = 0, t_elapsed = 0;
+
+	if (argc < 6) {
+		fprintf(stderr, "Usage: %s <cold|warm> <hostname> <port> <username> <password> [requests]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	if (argc > 6)
+		_requests = strtoul(argv[6], NULL, 10);
+
+	if (!_requests) {
+		errno = EINVAL;
+		_exit_failure("Invalid arguments");
+	}
+
+	if (!strcmp(argv[1], "cold")) {
+		warm = 0;
+	} else if (!strcmp(argv[1], "warm")) {
+		warm = 1;
+	} else {
+		errno = EINVAL;
+		_exit_failure(argv[1]);
+	}
+
+	t_start = _now();
+
+	if (warm) {
+		if (usched_init() < 0)
+			_exit_failure("usched_init()");
+
+		_remote_set(argv);
+
+		for (i = 0; i < _requests; i ++)
+			_submit();
+
+		usched_destroy();
+	} else {
+		for (i = 0; i < _requests; i ++) {
+			if (usched_init() < 0)
+				_exit_failure("usched_init()");
+
+			_remote_set(argv);
+
+			_submit();
+
+			usched_destroy();
+		}
+	}
+
+	t_elapsed = _now() - t_start;
+
+	printf("%s: %u requests in %.3f s (%.0f req/s)\n", argv[1], _requests, t_elapsed, _requests / t_elapsed);
+
+	_cleanup(argv);
+
+	return EXIT_SUCCESS;
+}
+